@@ -84,6 +84,11 @@
 #define MAX_BITS_EVENT_GROUPS     24U
 
 #define THREAD_FLAGS_INVALID_BITS (~((1UL << MAX_BITS_TASK_NOTIFY)  - 1U))
+
+/* Thread flags are kept in the last task notification index, away from index 0
+   which stream buffers, message buffers and the non-indexed notification API
+   use. With a single notification index they have to share index 0. */
+#define THREAD_FLAGS_NOTIFY_INDEX ((UBaseType_t)configTASK_NOTIFICATION_ARRAY_ENTRIES - 1U)
 #define EVENT_FLAGS_INVALID_BITS  (~((1UL << MAX_BITS_EVENT_GROUPS) - 1U))
 
 /* Kernel version and identification string definition (major.minor.rev: mmnnnrrrr dec) */
@@ -740,14 +745,14 @@ uint32_t osThreadFlagsSet (osThreadId_t thread_id, uint32_t flags) {
     if (IS_IRQ()) {
       yield = pdFALSE;
 
-      (void)xTaskNotifyFromISR (hTask, flags, eSetBits, &yield);
-      (void)xTaskNotifyAndQueryFromISR (hTask, 0, eNoAction, &rflags, NULL);
+      (void)xTaskNotifyIndexedFromISR (hTask, THREAD_FLAGS_NOTIFY_INDEX, flags, eSetBits, &yield);
+      (void)xTaskNotifyAndQueryIndexedFromISR (hTask, THREAD_FLAGS_NOTIFY_INDEX, 0, eNoAction, &rflags, NULL);
 
       portYIELD_FROM_ISR (yield);
     }
     else {
-      (void)xTaskNotify (hTask, flags, eSetBits);
-      (void)xTaskNotifyAndQuery (hTask, 0, eNoAction, &rflags);
+      (void)xTaskNotifyIndexed (hTask, THREAD_FLAGS_NOTIFY_INDEX, flags, eSetBits);
+      (void)xTaskNotifyAndQueryIndexed (hTask, THREAD_FLAGS_NOTIFY_INDEX, 0, eNoAction, &rflags);
     }
   }
   /* Return flags after setting */
@@ -767,11 +772,11 @@ uint32_t osThreadFlagsClear (uint32_t flags) {
   else {
     hTask = xTaskGetCurrentTaskHandle();
 
-    if (xTaskNotifyAndQuery (hTask, 0, eNoAction, &cflags) == pdPASS) {
+    if (xTaskNotifyAndQueryIndexed (hTask, THREAD_FLAGS_NOTIFY_INDEX, 0, eNoAction, &cflags) == pdPASS) {
       rflags = cflags;
       cflags &= ~flags;
 
-      if (xTaskNotify (hTask, cflags, eSetValueWithOverwrite) != pdPASS) {
+      if (xTaskNotifyIndexed (hTask, THREAD_FLAGS_NOTIFY_INDEX, cflags, eSetValueWithOverwrite) != pdPASS) {
         rflags = (uint32_t)osError;
       }
     }
@@ -794,7 +799,7 @@ uint32_t osThreadFlagsGet (void) {
   else {
     hTask = xTaskGetCurrentTaskHandle();
 
-    if (xTaskNotifyAndQuery (hTask, 0, eNoAction, &rflags) != pdPASS) {
+    if (xTaskNotifyAndQueryIndexed (hTask, THREAD_FLAGS_NOTIFY_INDEX, 0, eNoAction, &rflags) != pdPASS) {
       rflags = (uint32_t)osError;
     }
   }
@@ -826,7 +831,7 @@ uint32_t osThreadFlagsWait (uint32_t flags, uint32_t options, uint32_t timeout)
 
     t0 = xTaskGetTickCount();
     do {
-      rval = xTaskNotifyWait (0, clear, &nval, tout);
+      rval = xTaskNotifyWaitIndexed (THREAD_FLAGS_NOTIFY_INDEX, 0, clear, &nval, tout);
 
       if (rval == pdPASS) {
         rflags &= flags;
@@ -39,6 +39,10 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "event_groups.h"
 
+#if ( configUSE_KERNEL_OBJECT_SLABS == 1 )
+	#include "slab.h"
+#endif
+
 /* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
 for the header files above, but not in this file, in order to generate the
@@ -63,12 +67,17 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 typedef struct EventGroupDef_t
 {
 	EventBits_t uxEventBits;
-	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
+	List_t xTasksWaitingForBits[ configEVENT_GROUP_WAITER_BUCKETS ];	/*< Lists of tasks waiting for a bit to be set, bucketed by the lowest bit each task waits for. */
+	EventBits_t uxWaiterBits[ configEVENT_GROUP_WAITER_BUCKETS ];		/*< The bits the tasks in each bucket wait for.  May include bits of tasks that have since timed out. */
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxEventGroupNumber;
 	#endif
 
+	#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+		UBaseType_t uxMaxDirectWaiters;	/*< Zero for an ordinary event group, otherwise the maximum number of tasks that can wait on an event group that interrupts set directly. */
+	#endif
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
 	#endif
@@ -86,6 +95,99 @@ typedef struct EventGroupDef_t
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Waiting tasks are held in configEVENT_GROUP_WAITER_BUCKETS lists, each task
+ * going in the bucket selected by the lowest bit it waits for.  Alongside each
+ * bucket is the set of bits its tasks wait for, so setting bits only walks the
+ * buckets that hold a task waiting for one of those bits.  When tasks wait for
+ * distinct bits, and there are at least as many buckets as bits in use, each
+ * set only examines the tasks waiting for the bits being set.
+ */
+static void prvInitialiseWaiterBuckets( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the bucket a task waiting for uxBitsToWaitFor must be placed in,
+ * and records that a task in that bucket waits for those bits.
+ */
+static List_t *prvGetWaiterBucket( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock every task whose wait condition is met by the event bits after
+ * uxBitsToSet have been set, then clear the bits of any unblocked task that
+ * asked for its bits to be cleared on exit.  Must be called with the scheduler
+ * suspended, or from a critical section if xFromISR is pdTRUE.  Returns pdTRUE
+ * if xFromISR is pdTRUE and an unblocked task has a priority above that of the
+ * running task.
+ */
+static BaseType_t prvUnblockWaitingTasks( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* Interrupts access the list of waiting tasks of an event group created by
+xEventGroupCreateDirect(), so tasks must access it from a critical section
+rather than just with the scheduler suspended.  The number of waiting tasks is
+limited so the time spent in the critical section is bounded. */
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+	#define eventIS_DIRECT( pxEventBits )	( ( pxEventBits )->uxMaxDirectWaiters != ( UBaseType_t ) 0 )
+
+	#define eventENTER_WAITERS_CRITICAL( pxEventBits )	\
+	{													\
+		if( eventIS_DIRECT( pxEventBits ) )				\
+		{												\
+			taskENTER_CRITICAL();						\
+		}												\
+	}
+
+	#define eventEXIT_WAITERS_CRITICAL( pxEventBits )	\
+	{													\
+		if( eventIS_DIRECT( pxEventBits ) )				\
+		{												\
+			taskEXIT_CRITICAL();						\
+		}												\
+	}
+
+	#define eventWAITER_LIMIT_REACHED( pxEventBits )	\
+		( ( eventIS_DIRECT( pxEventBits ) && ( prvGetNumberOfWaiters( pxEventBits ) >= ( pxEventBits )->uxMaxDirectWaiters ) ) ? pdTRUE : pdFALSE )
+
+	/*
+	 * Returns the number of tasks waiting on the event group.
+	 */
+	static UBaseType_t prvGetNumberOfWaiters( const EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Set bits in an event group created by xEventGroupCreateDirect(), and
+	 * unblock the tasks whose wait condition is then met, from an interrupt.
+	 */
+	static void prvSetBitsDirectFromISR( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#else
+
+	#define eventENTER_WAITERS_CRITICAL( pxEventBits )
+	#define eventEXIT_WAITERS_CRITICAL( pxEventBits )
+	#define eventWAITER_LIMIT_REACHED( pxEventBits )	pdFALSE
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+
+/*-----------------------------------------------------------*/
+
+/* Event groups are taken from a slab cache, if one is configured, so creating
+and deleting them does not fragment the heap. */
+#if ( configUSE_KERNEL_OBJECT_SLABS == 1 )
+
+	PRIVILEGED_DATA static EventGroup_t xEventGroupSlabObjects[ configSLAB_EVENT_GROUP_COUNT ];
+	PRIVILEGED_DATA static SlabCache_t xEventGroupSlab = slabCACHE_INITIALISER( xEventGroupSlabObjects, "EventGroup" );
+
+	#define eventALLOCATE_EVENT_GROUP()			( ( EventGroup_t * ) pvSlabAllocate( &xEventGroupSlab ) )
+	#define eventFREE_EVENT_GROUP( pxEventBits )	vSlabFree( &xEventGroupSlab, ( pxEventBits ) )
+
+#else
+
+	#define eventALLOCATE_EVENT_GROUP()			( ( EventGroup_t * ) pvPortMalloc( sizeof( EventGroup_t ) ) )
+	#define eventFREE_EVENT_GROUP( pxEventBits )	vPortFree( pxEventBits )
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -113,7 +215,13 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaiterBuckets( pxEventBits );
+
+			#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+			{
+				pxEventBits->uxMaxDirectWaiters = 0;
+			}
+			#endif
 
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
@@ -159,12 +267,18 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		sizeof( TickType_t ), the TickType_t variables will be accessed in two
 		or more reads operations, and the alignment requirements is only that
 		of each individual read. */
-		pxEventBits = ( EventGroup_t * ) pvPortMalloc( sizeof( EventGroup_t ) ); /*lint !e9087 !e9079 see comment above. */
+		pxEventBits = eventALLOCATE_EVENT_GROUP(); /*lint !e9087 !e9079 see comment above. */
 
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaiterBuckets( pxEventBits );
+
+			#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+			{
+				pxEventBits->uxMaxDirectWaiters = 0;
+			}
+			#endif
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -188,6 +302,56 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	EventGroupHandle_t xEventGroupCreateDirect( UBaseType_t uxMaxWaiters )
+	{
+	EventGroup_t *pxEventBits;
+
+		configASSERT( uxMaxWaiters > ( UBaseType_t ) 0 );
+
+		pxEventBits = xEventGroupCreate();
+
+		if( pxEventBits != NULL )
+		{
+			pxEventBits->uxMaxDirectWaiters = uxMaxWaiters;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxEventBits;
+	}
+
+#endif /* ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	EventGroupHandle_t xEventGroupCreateDirectStatic( UBaseType_t uxMaxWaiters, StaticEventGroup_t *pxEventGroupBuffer )
+	{
+	EventGroup_t *pxEventBits;
+
+		configASSERT( uxMaxWaiters > ( UBaseType_t ) 0 );
+
+		pxEventBits = xEventGroupCreateStatic( pxEventGroupBuffer );
+
+		if( pxEventBits != NULL )
+		{
+			pxEventBits->uxMaxDirectWaiters = uxMaxWaiters;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxEventBits;
+	}
+
+#endif /* ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
 EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, const EventBits_t uxBitsToWaitFor, TickType_t xTicksToWait )
 {
 EventBits_t uxOriginalBitValue, uxReturn;
@@ -204,6 +368,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventENTER_WAITERS_CRITICAL( pxEventBits );
 	{
 		uxOriginalBitValue = pxEventBits->uxEventBits;
 
@@ -222,14 +387,14 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 		}
 		else
 		{
-			if( xTicksToWait != ( TickType_t ) 0 )
+			if( ( xTicksToWait != ( TickType_t ) 0 ) && ( eventWAITER_LIMIT_REACHED( pxEventBits ) == pdFALSE ) )
 			{
 				traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor );
 
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				vTaskPlaceOnUnorderedEventList( prvGetWaiterBucket( pxEventBits, uxBitsToWaitFor ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -240,12 +405,15 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			else
 			{
 				/* The rendezvous bits were not set, but no block time was
-				specified - just return the current event bit value. */
+				specified, or the event group already has as many waiting tasks
+				as it allows - just return the current event bit value. */
 				uxReturn = pxEventBits->uxEventBits;
+				xTicksToWait = 0;
 				xTimeoutOccurred = pdTRUE;
 			}
 		}
 	}
+	eventEXIT_WAITERS_CRITICAL( pxEventBits );
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -327,6 +495,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventENTER_WAITERS_CRITICAL( pxEventBits );
 	{
 		const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -350,11 +519,13 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		else if( xTicksToWait == ( TickType_t ) 0 )
+		else if( ( xTicksToWait == ( TickType_t ) 0 ) || ( eventWAITER_LIMIT_REACHED( pxEventBits ) != pdFALSE ) )
 		{
 			/* The wait condition has not been met, but no block time was
-			specified, so just return the current value. */
+			specified, or the event group already has as many waiting tasks as
+			it allows, so just return the current value. */
 			uxReturn = uxCurrentEventBits;
+			xTicksToWait = ( TickType_t ) 0;
 			xTimeoutOccurred = pdTRUE;
 		}
 		else
@@ -384,7 +555,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			vTaskPlaceOnUnorderedEventList( prvGetWaiterBucket( pxEventBits, uxBitsToWaitFor ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -394,6 +565,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
 		}
 	}
+	eventEXIT_WAITERS_CRITICAL( pxEventBits );
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -485,14 +657,45 @@ EventBits_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if ( ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) || ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) )
 
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
 	{
 		BaseType_t xReturn;
 
 		traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
-		xReturn = xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+
+		#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+		if( eventIS_DIRECT( xEventGroup ) )
+		{
+		UBaseType_t uxSavedInterruptStatus;
+
+			/* Clearing bits never unblocks a task, so can always be done
+			directly. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				xEventGroup->uxEventBits &= ~uxBitsToClear;
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+			xReturn = pdPASS;
+		}
+		else
+		#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+		{
+			#if( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+			{
+				xReturn = xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+			}
+			#else
+			{
+				/* Without the timer task only event groups created by
+				xEventGroupCreateDirect() can be used from an interrupt. */
+				configASSERT( eventIS_DIRECT( xEventGroup ) );
+				xReturn = pdFAIL;
+			}
+			#endif
+		}
 
 		return xReturn;
 	}
@@ -518,92 +721,25 @@ EventBits_t uxReturn;
 
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
 {
-ListItem_t *pxListItem, *pxNext;
-ListItem_t const *pxListEnd;
-List_t const * pxList;
-EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
 EventGroup_t *pxEventBits = xEventGroup;
-BaseType_t xMatchFound = pdFALSE;
 
 	/* Check the user is not attempting to set the bits used by the kernel
 	itself. */
 	configASSERT( xEventGroup );
 	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-	pxList = &( pxEventBits->xTasksWaitingForBits );
-	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 	vTaskSuspendAll();
+	eventENTER_WAITERS_CRITICAL( pxEventBits );
 	{
 		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-		pxListItem = listGET_HEAD_ENTRY( pxList );
-
 		/* Set the bits. */
 		pxEventBits->uxEventBits |= uxBitsToSet;
 
 		/* See if the new bit value should unblock any tasks. */
-		while( pxListItem != pxListEnd )
-		{
-			pxNext = listGET_NEXT( pxListItem );
-			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-			xMatchFound = pdFALSE;
-
-			/* Split the bits waited for from the control bits. */
-			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-			if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-			{
-				/* Just looking for single bit being set. */
-				if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-				{
-					xMatchFound = pdTRUE;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-			}
-			else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-			{
-				/* All bits are set. */
-				xMatchFound = pdTRUE;
-			}
-			else
-			{
-				/* Need all bits to be set, but not all the bits were set. */
-			}
-
-			if( xMatchFound != pdFALSE )
-			{
-				/* The bits match.  Should the bits be cleared on exit? */
-				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-				{
-					uxBitsToClear |= uxBitsWaitedFor;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-
-				/* Store the actual event flag value in the task's event list
-				item before removing the task from the event list.  The
-				eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-				that is was unblocked due to its required bits matching, rather
-				than because it timed out. */
-				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
-			}
-
-			/* Move onto the next list item.  Note pxListItem->pxNext is not
-			used here as the list item may have been removed from the event list
-			and inserted into the ready/pending reading list. */
-			pxListItem = pxNext;
-		}
-
-		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-		bit was set in the control word. */
-		pxEventBits->uxEventBits &= ~uxBitsToClear;
+		( void ) prvUnblockWaitingTasks( pxEventBits, uxBitsToSet, pdFALSE );
 	}
+	eventEXIT_WAITERS_CRITICAL( pxEventBits );
 	( void ) xTaskResumeAll();
 
 	return pxEventBits->uxEventBits;
@@ -613,25 +749,33 @@ BaseType_t xMatchFound = pdFALSE;
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
 EventGroup_t *pxEventBits = xEventGroup;
-const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+const List_t *pxTasksWaitingForBits;
+UBaseType_t uxBucket;
 
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
-		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+		eventENTER_WAITERS_CRITICAL( pxEventBits );
+		for( uxBucket = 0; uxBucket < ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS; uxBucket++ )
 		{
-			/* Unblock the task, returning 0 as the event list is being deleted
-			and cannot therefore have any bits set. */
-			configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits[ uxBucket ] );
+
+			while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+			{
+				/* Unblock the task, returning 0 as the event list is being
+				deleted and cannot therefore have any bits set. */
+				configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+				vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			}
 		}
+		eventEXIT_WAITERS_CRITICAL( pxEventBits );
 
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
 			/* The event group can only have been allocated dynamically - free
 			it again. */
-			vPortFree( pxEventBits );
+			eventFREE_EVENT_GROUP( pxEventBits );
 		}
 		#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 		{
@@ -639,7 +783,7 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 			dynamically, so check before attempting to free the memory. */
 			if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
 			{
-				vPortFree( pxEventBits );
+				eventFREE_EVENT_GROUP( pxEventBits );
 			}
 			else
 			{
@@ -668,6 +812,164 @@ void vEventGroupClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToCl
 }
 /*-----------------------------------------------------------*/
 
+static void prvInitialiseWaiterBuckets( EventGroup_t *pxEventBits )
+{
+UBaseType_t uxBucket;
+
+	for( uxBucket = 0; uxBucket < ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS; uxBucket++ )
+	{
+		vListInitialise( &( pxEventBits->xTasksWaitingForBits[ uxBucket ] ) );
+		pxEventBits->uxWaiterBits[ uxBucket ] = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static List_t *prvGetWaiterBucket( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor )
+{
+UBaseType_t uxBucket = 0;
+
+	#if( configEVENT_GROUP_WAITER_BUCKETS > 1 )
+	{
+	EventBits_t uxBits = uxBitsToWaitFor;
+
+		/* Select the bucket from the lowest bit waited for.  uxBitsToWaitFor
+		is never zero. */
+		while( ( uxBits & ( EventBits_t ) 1 ) == ( EventBits_t ) 0 )
+		{
+			uxBits >>= 1;
+			uxBucket++;
+		}
+
+		uxBucket &= ( UBaseType_t ) ( configEVENT_GROUP_WAITER_BUCKETS - 1 );
+	}
+	#endif /* configEVENT_GROUP_WAITER_BUCKETS */
+
+	pxEventBits->uxWaiterBits[ uxBucket ] |= uxBitsToWaitFor;
+
+	return &( pxEventBits->xTasksWaitingForBits[ uxBucket ] );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockWaitingTasks( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR )
+{
+ListItem_t *pxListItem, *pxNext;
+ListItem_t const *pxListEnd;
+List_t const * pxList;
+EventBits_t uxBitsToClear = 0, uxBitsStillWaitedFor, uxBitsWaitedFor, uxControlBits;
+BaseType_t xMatchFound, xReturn = pdFALSE;
+UBaseType_t uxBucket;
+
+	for( uxBucket = 0; uxBucket < ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS; uxBucket++ )
+	{
+		/* A task can only be unblocked by bits it is waiting for, so skip
+		buckets that do not have a task waiting for any of the bits being
+		set. */
+		if( ( pxEventBits->uxWaiterBits[ uxBucket ] & uxBitsToSet ) != ( EventBits_t ) 0 )
+		{
+			pxList = &( pxEventBits->xTasksWaitingForBits[ uxBucket ] );
+			pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+			pxListItem = listGET_HEAD_ENTRY( pxList );
+			uxBitsStillWaitedFor = 0;
+
+			while( pxListItem != pxListEnd )
+			{
+				pxNext = listGET_NEXT( pxListItem );
+				uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+				xMatchFound = pdFALSE;
+
+				/* Split the bits waited for from the control bits. */
+				uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+				uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+				if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+				{
+					/* Just looking for single bit being set. */
+					if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+					{
+						xMatchFound = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+				{
+					/* All bits are set. */
+					xMatchFound = pdTRUE;
+				}
+				else
+				{
+					/* Need all bits to be set, but not all the bits were set. */
+				}
+
+				if( xMatchFound != pdFALSE )
+				{
+					/* The bits match.  Should the bits be cleared on exit? */
+					if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+					{
+						uxBitsToClear |= uxBitsWaitedFor;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Store the actual event flag value in the task's event list
+					item before removing the task from the event list.  The
+					eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+					that is was unblocked due to its required bits matching, rather
+					than because it timed out. */
+					#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+					if( xFromISR != pdFALSE )
+					{
+						if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+						{
+							xReturn = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+					{
+						vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+					}
+				}
+				else
+				{
+					uxBitsStillWaitedFor |= uxBitsWaitedFor;
+				}
+
+				/* Move onto the next list item.  Note pxListItem->pxNext is not
+				used here as the list item may have been removed from the event list
+				and inserted into the ready/pending reading list. */
+				pxListItem = pxNext;
+			}
+
+			/* Drop the bits of tasks that have been unblocked or have timed out
+			since the bucket was last walked. */
+			pxEventBits->uxWaiterBits[ uxBucket ] = uxBitsStillWaitedFor;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+	bit was set in the control word. */
+	pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+	/* Prevent compiler warnings when configUSE_EVENT_GROUP_DIRECT_ISR is 0. */
+	( void ) xFromISR;
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits )
 {
 BaseType_t xWaitConditionMet = pdFALSE;
@@ -703,14 +1005,37 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if ( ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) || ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	BaseType_t xReturn;
 
 		traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
-		xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+
+		#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+		if( eventIS_DIRECT( xEventGroup ) )
+		{
+			prvSetBitsDirectFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken );
+			xReturn = pdPASS;
+		}
+		else
+		#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+		{
+			#if( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+			{
+				xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+			}
+			#else
+			{
+				/* Without the timer task only event groups created by
+				xEventGroupCreateDirect() can be used from an interrupt. */
+				( void ) pxHigherPriorityTaskWoken;
+				configASSERT( eventIS_DIRECT( xEventGroup ) );
+				xReturn = pdFAIL;
+			}
+			#endif
+		}
 
 		return xReturn;
 	}
@@ -718,6 +1043,55 @@ BaseType_t xWaitConditionMet = pdFALSE;
 #endif
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+	static void prvSetBitsDirectFromISR( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		/* Tasks only access the lists of waiting tasks from within a critical
+		section, and there can be no more than uxMaxDirectWaiters tasks in the
+		lists, so the time spent here is bounded. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pxEventBits->uxEventBits |= uxBitsToSet;
+
+			if( prvUnblockWaitingTasks( pxEventBits, uxBitsToSet, pdTRUE ) != pdFALSE )
+			{
+				if( pxHigherPriorityTaskWoken != NULL )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+	static UBaseType_t prvGetNumberOfWaiters( const EventGroup_t *pxEventBits )
+	{
+	UBaseType_t uxBucket, uxWaiters = 0;
+
+		for( uxBucket = 0; uxBucket < ( UBaseType_t ) configEVENT_GROUP_WAITER_BUCKETS; uxBucket++ )
+		{
+			uxWaiters += listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBits[ uxBucket ] ) );
+		}
+
+		return uxWaiters;
+	}
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+/*-----------------------------------------------------------*/
+
 #if (configUSE_TRACE_FACILITY == 1)
 
 	UBaseType_t uxEventGroupGetNumber( void* xEventGroup )
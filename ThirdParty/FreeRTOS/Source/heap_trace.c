@@ -0,0 +1,282 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_trace.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to trace the heap.  This #if is closed at the very bottom of this file. */
+#if( configUSE_HEAP_TRACE == 1 )
+
+/* The number of records vHeapTraceWriteRecords() copies out of the ring at a
+time, and the length of each line it writes. */
+#define heapTRACE_RECORDS_PER_READ	( ( UBaseType_t ) 4U )
+#define heapTRACE_LINE_LENGTH		( 100 )
+
+/*
+ * Add a record to the ring, overwriting the oldest record if the ring is full.
+ */
+static void prvAddRecord( uint8_t ucEvent, void *pvAddress, size_t xSize, void *pvCaller );
+
+/*-----------------------------------------------------------*/
+
+/* The ring.  uxNextRecord is the index the next record is written to, and the
+uxRecordCount records before it have not been read yet. */
+PRIVILEGED_DATA static HeapTraceRecord_t xHeapTraceRing[ configHEAP_TRACE_RECORDS ];
+PRIVILEGED_DATA static UBaseType_t uxNextRecord = 0U;
+PRIVILEGED_DATA static UBaseType_t uxRecordCount = 0U;
+PRIVILEGED_DATA static UBaseType_t uxLostRecords = 0U;
+
+/* Used by vHeapTraceWriteSnapshot(). */
+PRIVILEGED_DATA static HeapRegion_t xSnapshotRegions[ configHEAP_MAX_REGIONS ];
+PRIVILEGED_DATA static HeapRegion_t xSnapshotFreeBlocks[ configHEAP_TRACE_SNAPSHOT_BLOCKS ];
+
+/*-----------------------------------------------------------*/
+
+void vHeapTraceRecordMalloc( void *pvAddress, size_t xSize, void *pvCaller )
+{
+	prvAddRecord( heapTRACE_MALLOC, pvAddress, xSize, pvCaller );
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTraceRecordFree( void *pvAddress, size_t xSize, void *pvCaller )
+{
+	prvAddRecord( heapTRACE_FREE, pvAddress, xSize, pvCaller );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddRecord( uint8_t ucEvent, void *pvAddress, size_t xSize, void *pvCaller )
+{
+HeapTraceRecord_t *pxRecord;
+TaskHandle_t xTask;
+uint32_t ulTimeStamp;
+
+	/* The heap is used to create tasks before the scheduler starts, when the
+	current task handle does not yet mean a task is running. */
+	if( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED )
+	{
+		xTask = NULL;
+	}
+	else
+	{
+		xTask = xTaskGetCurrentTaskHandle();
+	}
+
+	ulTimeStamp = configHEAP_TRACE_TIMESTAMP();
+
+	taskENTER_CRITICAL();
+	{
+		pxRecord = &( xHeapTraceRing[ uxNextRecord ] );
+		pxRecord->pvAddress = pvAddress;
+		pxRecord->pvCaller = pvCaller;
+		pxRecord->xTask = xTask;
+		pxRecord->ulTimeStamp = ulTimeStamp;
+		pxRecord->xSize = xSize;
+		pxRecord->ucEvent = ucEvent;
+
+		uxNextRecord++;
+
+		if( uxNextRecord >= ( UBaseType_t ) configHEAP_TRACE_RECORDS )
+		{
+			uxNextRecord = 0U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxRecordCount < ( UBaseType_t ) configHEAP_TRACE_RECORDS )
+		{
+			uxRecordCount++;
+		}
+		else
+		{
+			/* The oldest record has just been overwritten. */
+			uxLostRecords++;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxHeapTraceRead( HeapTraceRecord_t *pxRecords, UBaseType_t uxMaxRecords )
+{
+UBaseType_t uxRead = 0U, uxOldestRecord;
+
+	taskENTER_CRITICAL();
+	{
+		while( ( uxRead < uxMaxRecords ) && ( uxRecordCount > 0U ) )
+		{
+			if( uxRecordCount > uxNextRecord )
+			{
+				uxOldestRecord = ( ( UBaseType_t ) configHEAP_TRACE_RECORDS - uxRecordCount ) + uxNextRecord;
+			}
+			else
+			{
+				uxOldestRecord = uxNextRecord - uxRecordCount;
+			}
+
+			pxRecords[ uxRead ] = xHeapTraceRing[ uxOldestRecord ];
+			uxRecordCount--;
+			uxRead++;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return uxRead;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxHeapTraceGetLostRecordCount( void )
+{
+UBaseType_t uxReturn;
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = uxLostRecords;
+		uxLostRecords = 0U;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTraceWriteRecords( HeapTraceWriteFunction_t pxWriteLine )
+{
+HeapTraceRecord_t xRecords[ heapTRACE_RECORDS_PER_READ ];
+char cLine[ heapTRACE_LINE_LENGTH ];
+UBaseType_t uxRemaining, uxRead, ux, uxLost;
+
+	uxLost = uxHeapTraceGetLostRecordCount();
+
+	if( uxLost > 0U )
+	{
+		( void ) snprintf( cLine, sizeof( cLine ), "HT L %lu", ( unsigned long ) uxLost );
+		pxWriteLine( cLine );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Only write the records that are already in the ring, as pxWriteLine()
+	might allocate memory and so add more. */
+	taskENTER_CRITICAL();
+	{
+		uxRemaining = uxRecordCount;
+	}
+	taskEXIT_CRITICAL();
+
+	while( uxRemaining > 0U )
+	{
+		uxRead = uxHeapTraceRead( xRecords, ( uxRemaining < heapTRACE_RECORDS_PER_READ ) ? uxRemaining : heapTRACE_RECORDS_PER_READ );
+
+		if( uxRead == 0U )
+		{
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( ux = 0U; ux < uxRead; ux++ )
+		{
+			( void ) snprintf( cLine, sizeof( cLine ), "HT %c %lu %lx %lu %lx %lx",
+							   ( xRecords[ ux ].ucEvent == heapTRACE_MALLOC ) ? 'M' : 'F',
+							   ( unsigned long ) xRecords[ ux ].ulTimeStamp,
+							   ( unsigned long ) ( size_t ) xRecords[ ux ].pvAddress,
+							   ( unsigned long ) xRecords[ ux ].xSize,
+							   ( unsigned long ) ( size_t ) xRecords[ ux ].pvCaller,
+							   ( unsigned long ) ( size_t ) xRecords[ ux ].xTask );
+			pxWriteLine( cLine );
+		}
+
+		uxRemaining -= uxRead;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTraceWriteSnapshot( HeapTraceWriteFunction_t pxWriteLine )
+{
+char cLine[ heapTRACE_LINE_LENGTH ];
+UBaseType_t uxRegions, uxBlocks, ux;
+size_t xFreeBytes;
+
+	/* Gather everything before writing anything, so the snapshot is not
+	changed by allocations made by pxWriteLine(). */
+	uxRegions = uxPortGetHeapRegions( xSnapshotRegions, ( UBaseType_t ) configHEAP_MAX_REGIONS );
+	uxBlocks = uxPortGetHeapFreeBlocks( xSnapshotFreeBlocks, ( UBaseType_t ) configHEAP_TRACE_SNAPSHOT_BLOCKS );
+	xFreeBytes = xPortGetFreeHeapSize();
+
+	( void ) snprintf( cLine, sizeof( cLine ), "HT S %lu %lu %lu", ( unsigned long ) configHEAP_TRACE_TIMESTAMP(), ( unsigned long ) xFreeBytes, ( unsigned long ) uxBlocks );
+	pxWriteLine( cLine );
+
+	for( ux = 0U; ux < uxRegions; ux++ )
+	{
+		( void ) snprintf( cLine, sizeof( cLine ), "HT R %lx %lu", ( unsigned long ) ( size_t ) xSnapshotRegions[ ux ].pucStartAddress, ( unsigned long ) xSnapshotRegions[ ux ].xSizeInBytes );
+		pxWriteLine( cLine );
+	}
+
+	if( uxBlocks > ( UBaseType_t ) configHEAP_TRACE_SNAPSHOT_BLOCKS )
+	{
+		uxBlocks = ( UBaseType_t ) configHEAP_TRACE_SNAPSHOT_BLOCKS;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	for( ux = 0U; ux < uxBlocks; ux++ )
+	{
+		( void ) snprintf( cLine, sizeof( cLine ), "HT B %lx %lu", ( unsigned long ) ( size_t ) xSnapshotFreeBlocks[ ux ].pucStartAddress, ( unsigned long ) xSnapshotFreeBlocks[ ux ].xSizeInBytes );
+		pxWriteLine( cLine );
+	}
+
+	pxWriteLine( "HT E" );
+}
+
+/* This entire source file will be skipped if the application is not configured
+to trace the heap.  This #if is closed at the very bottom of this file. */
+#endif /* configUSE_HEAP_TRACE == 1 */
@@ -568,6 +568,31 @@ hold explicit before calling the code. */
 	#define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )
 #endif
 
+#ifndef configUSE_HEAP_TRACE
+	/* Set to 1 to record every pvPortMalloc() and vPortFree() call in a ring
+	buffer.  See heap_trace.h. */
+	#define configUSE_HEAP_TRACE 0
+#endif
+
+#if( configUSE_HEAP_TRACE == 1 )
+	#if defined( traceMALLOC ) || defined( traceFREE )
+		#error configUSE_HEAP_TRACE uses traceMALLOC() and traceFREE(), so they cannot also be defined in FreeRTOSConfig.h
+	#endif
+
+	#ifndef configHEAP_TRACE_CALLER
+		/* The address the heap function will return to, recorded as the call
+		site of each allocation and free. */
+		#if defined( __GNUC__ )
+			#define configHEAP_TRACE_CALLER() __builtin_return_address( 0 )
+		#else
+			#define configHEAP_TRACE_CALLER() NULL
+		#endif
+	#endif
+
+	#define traceMALLOC( pvAddress, uiSize ) vHeapTraceRecordMalloc( ( pvAddress ), ( uiSize ), configHEAP_TRACE_CALLER() )
+	#define traceFREE( pvAddress, uiSize ) vHeapTraceRecordFree( ( pvAddress ), ( uiSize ), configHEAP_TRACE_CALLER() )
+#endif
+
 #ifndef traceMALLOC
     #define traceMALLOC( pvAddress, uiSize )
 #endif
@@ -704,6 +729,10 @@ hold explicit before calling the code. */
 	#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef traceBLOCKING_ON_READY_SET_WAIT
+	#define traceBLOCKING_ON_READY_SET_WAIT( xReadySet )
+#endif
+
 #ifndef traceSTREAM_BUFFER_RECEIVE_FAILED
 	#define traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer )
 #endif
@@ -790,6 +819,54 @@ hold explicit before calling the code. */
 	#define portDONT_DISCARD
 #endif
 
+#ifndef portCOUNT_LEADING_ZEROS
+	/* Used by the kernel bitmaps when the port has no count leading zeros
+	instruction.  A binary search, so the cost does not depend on the value.
+	Like the instruction, returns 32 when ulBitmap is zero. */
+	static portINLINE uint8_t ucCountLeadingZerosGeneric( uint32_t ulBitmap )
+	{
+	uint8_t ucZeros = ( uint8_t ) 0U;
+
+		if( ulBitmap == 0UL )
+		{
+			return ( uint8_t ) 32U;
+		}
+
+		if( ( ulBitmap & 0xffff0000UL ) == 0UL )
+		{
+			ulBitmap <<= 16;
+			ucZeros += ( uint8_t ) 16U;
+		}
+
+		if( ( ulBitmap & 0xff000000UL ) == 0UL )
+		{
+			ulBitmap <<= 8;
+			ucZeros += ( uint8_t ) 8U;
+		}
+
+		if( ( ulBitmap & 0xf0000000UL ) == 0UL )
+		{
+			ulBitmap <<= 4;
+			ucZeros += ( uint8_t ) 4U;
+		}
+
+		if( ( ulBitmap & 0xc0000000UL ) == 0UL )
+		{
+			ulBitmap <<= 2;
+			ucZeros += ( uint8_t ) 2U;
+		}
+
+		if( ( ulBitmap & 0x80000000UL ) == 0UL )
+		{
+			ucZeros += ( uint8_t ) 1U;
+		}
+
+		return ucZeros;
+	}
+
+	#define portCOUNT_LEADING_ZEROS( ulBitmap ) ucCountLeadingZerosGeneric( ( ulBitmap ) )
+#endif
+
 #ifndef configUSE_TIME_SLICING
 	#define configUSE_TIME_SLICING 1
 #endif
@@ -826,6 +903,230 @@ hold explicit before calling the code. */
 	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
 #endif
 
+#ifndef configUSE_TWO_LEVEL_TASK_SELECTION
+	/* Set to 1 to select the highest priority ready task using a two level
+	bitmap, which keeps selection constant time for up to 1024 priorities.
+	configUSE_PORT_OPTIMISED_TASK_SELECTION must be set to 0 when this is used. */
+	#define configUSE_TWO_LEVEL_TASK_SELECTION 0
+#endif
+
+#if( ( configUSE_TWO_LEVEL_TASK_SELECTION == 1 ) && ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) )
+	#error configUSE_PORT_OPTIMISED_TASK_SELECTION must be 0 when configUSE_TWO_LEVEL_TASK_SELECTION is 1
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+	/* Set to 1 to schedule the tasks at configEDF_TASK_PRIORITY earliest
+	deadline first rather than round robin.  See vTaskSetPeriodicDeadline(). */
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#ifndef configEDF_TASK_PRIORITY
+	/* The priority reserved for EDF tasks.  Only EDF tasks should be created at
+	this priority. */
+	#define configEDF_TASK_PRIORITY ( configMAX_PRIORITIES - 1 )
+#endif
+
+#if( ( configUSE_EDF_SCHEDULING == 1 ) && ( INCLUDE_vTaskDelayUntil != 1 ) )
+	#error INCLUDE_vTaskDelayUntil must be set to 1 if configUSE_EDF_SCHEDULING is set to 1
+#endif
+
+#ifndef configUSE_PREEMPTION_THRESHOLD
+	/* Set to 1 to allow a running task to be shielded from preemption by tasks
+	at or below a per task threshold.  See vTaskPreemptionThresholdSet(). */
+	#define configUSE_PREEMPTION_THRESHOLD 0
+#endif
+
+#ifndef configUSE_TASK_BUDGETS
+	/* Set to 1 to limit how much CPU time a task can use at its own priority
+	in each period.  See vTaskSetBudget(). */
+	#define configUSE_TASK_BUDGETS 0
+#endif
+
+#ifndef configTASK_BUDGET_BACKGROUND_PRIORITY
+	/* The priority a task runs at after exhausting its budget. */
+	#define configTASK_BUDGET_BACKGROUND_PRIORITY tskIDLE_PRIORITY
+#endif
+
+#if( ( configUSE_TASK_BUDGETS == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 if configUSE_TASK_BUDGETS is set to 1
+#endif
+
+#ifndef configUSE_KERNEL_OBJECT_SLABS
+	/* Set to 1 to allocate task control blocks, semaphores, timers and event
+	groups from fixed size slab caches rather than directly from the heap.  See
+	slab.h. */
+	#define configUSE_KERNEL_OBJECT_SLABS 0
+#endif
+
+#ifndef configSLAB_TASK_COUNT
+	#define configSLAB_TASK_COUNT 8
+#endif
+
+#ifndef configSLAB_SEMAPHORE_COUNT
+	#define configSLAB_SEMAPHORE_COUNT 8
+#endif
+
+#ifndef configSLAB_TIMER_COUNT
+	#define configSLAB_TIMER_COUNT 4
+#endif
+
+#ifndef configSLAB_EVENT_GROUP_COUNT
+	#define configSLAB_EVENT_GROUP_COUNT 4
+#endif
+
+#ifndef configUSE_EVENT_GROUP_DIRECT_ISR
+	/* Set to 1 to allow event groups created with xEventGroupCreateDirect() to
+	be set and cleared from interrupts directly, rather than by deferring the
+	operation to the RTOS daemon task. */
+	#define configUSE_EVENT_GROUP_DIRECT_ISR 0
+#endif
+
+#ifndef configEVENT_GROUP_WAITER_BUCKETS
+	/* The number of lists the tasks waiting on an event group are spread
+	across, selected by the lowest bit each task waits for.  Setting bits only
+	examines the lists holding tasks that wait for those bits.  Each bucket
+	adds a list and an EventBits_t to every event group.  Must be a power of
+	two, and at least 1. */
+	#define configEVENT_GROUP_WAITER_BUCKETS 1
+#endif
+
+#if( ( configEVENT_GROUP_WAITER_BUCKETS < 1 ) || ( ( configEVENT_GROUP_WAITER_BUCKETS & ( configEVENT_GROUP_WAITER_BUCKETS - 1 ) ) != 0 ) )
+	#error configEVENT_GROUP_WAITER_BUCKETS must be a power of two, and at least 1
+#endif
+
+#ifndef configUSE_READY_SETS
+	/* Set to 1 to include ready sets, which let a task wait for data on many
+	queues and stream buffers without the members copying their handles into a
+	queue.  Each queue and stream buffer then contains a ReadySetMember_t. */
+	#define configUSE_READY_SETS 0
+#endif
+
+#ifndef configUSE_PRIORITY_QUEUES
+	/* Set to 1 to include xQueueCreatePriority(), which creates queues that
+	deliver items in priority order rather than FIFO order.  Adds a pointer to
+	every queue. */
+	#define configUSE_PRIORITY_QUEUES 0
+#endif
+
+#ifndef configUSE_CONFLATING_QUEUES
+	/* Set to 1 to include xQueueCreateConflating(), which creates queues in
+	which an item sent with a key replaces any queued item that has the same
+	key.  Adds a pointer to every queue. */
+	#define configUSE_CONFLATING_QUEUES 0
+#endif
+
+#ifndef configUSE_QUEUE_STATS
+	/* Set to 1 to keep depth, throughput, failure, blocking and wait time
+	statistics for every queue, semaphore and mutex.  See QueueStats_t in
+	queue.h. */
+	#define configUSE_QUEUE_STATS 0
+#endif
+
+#ifndef configQUEUE_STATS_TIMESTAMP
+	#define configQUEUE_STATS_TIMESTAMP() ( ( uint32_t ) xTaskGetTickCount() )
+#endif
+
+#ifndef configUSE_TIMER_PENDING_COMMANDS
+	/* Set to 1 to have xTimerStart(), xTimerStop() and the other timer
+	commands record the command in the timer itself rather than send it through
+	the timer queue, so commands cannot fail because the timer queue is full.
+	Adds a pointer, two TickType_t values and a byte to every timer. */
+	#define configUSE_TIMER_PENDING_COMMANDS 0
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+	/* Set to 1 to hold active software timers in a hierarchical timing wheel
+	rather than in a list sorted by expiry time, so starting and stopping a
+	timer takes the same time however many timers are active. */
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+	/* Each level of the timing wheel has 2 ^ configTIMER_WHEEL_SLOT_BITS slots,
+	and there are enough levels to cover every bit of the tick count.  Each slot
+	is a List_t, so the default of 4 uses 16 slots at each of 8 levels with 32
+	bit ticks.  Higher values take more RAM but move timers between levels less
+	often. */
+	#define configTIMER_WHEEL_SLOT_BITS 4
+#endif
+
+#if( ( configUSE_TIMER_WHEEL == 1 ) && ( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 5 ) ) )
+	#error configTIMER_WHEEL_SLOT_BITS must be between 1 and 5.
+#endif
+
+#ifndef configUSE_TIMER_SLACK
+	/* Set to 1 to allow each software timer to be given a slack, set using
+	vTimerSetSlack(), by which it may expire late so that timers with similar
+	expiry times expire together and the timer service task wakes less often. */
+	#define configUSE_TIMER_SLACK 0
+#endif
+
+#ifndef configUSE_TIMER_STATS
+	/* Set to 1 to record, for every software timer, how late its callback
+	runs after the timer's expiry time and how long the callback takes, in log2
+	histograms.  See TimerStats_t in timers.h. */
+	#define configUSE_TIMER_STATS 0
+#endif
+
+#ifndef configTIMER_STATS_TIMESTAMP
+	/* Used to time timer callbacks.  Defining this as a free running cycle
+	counter, such as DWT->CYCCNT on Cortex-M, gives the callback run times in
+	cycles. */
+	#define configTIMER_STATS_TIMESTAMP() ( ( uint32_t ) xTaskGetTickCount() )
+#endif
+
+#ifndef configTIMER_STATS_BUCKETS
+	/* The number of buckets in each timer statistics histogram.  Bucket 0
+	counts values of 0, bucket n values from 2 ^ ( n - 1 ) to ( 2 ^ n ) - 1, and
+	the last bucket also counts every larger value. */
+	#define configTIMER_STATS_BUCKETS 16
+#endif
+
+#if( ( configUSE_TIMER_STATS == 1 ) && ( ( configTIMER_STATS_BUCKETS < 2 ) || ( configTIMER_STATS_BUCKETS > 33 ) ) )
+	#error configTIMER_STATS_BUCKETS must be between 2 and 33.
+#endif
+
+#ifndef configSTACK_ALLOCATION_FROM_SEPARATE_HEAP
+	/* Set to 1 if the heap implementation provides pvPortMallocStack() and
+	vPortFreeStack() to place task stacks separately from other memory. */
+	#define configSTACK_ALLOCATION_FROM_SEPARATE_HEAP 0
+#endif
+
+#ifndef configHEAP_MAX_REGIONS
+	/* The number of regions heap_regions.c can manage. */
+	#define configHEAP_MAX_REGIONS 4
+#endif
+
+#ifndef configHEAP_DEFAULT_REGION
+	/* Set to 0 if the application adds its own general region to heap_regions.c
+	before the first allocation, so the configTOTAL_HEAP_SIZE byte default
+	region is not defined. */
+	#define configHEAP_DEFAULT_REGION 1
+#endif
+
+#ifndef configHEAP_TRACE_RECORDS
+	/* The number of allocations and frees the heap trace ring can hold before
+	the oldest are overwritten. */
+	#define configHEAP_TRACE_RECORDS 64
+#endif
+
+#ifndef configHEAP_TRACE_SNAPSHOT_BLOCKS
+	/* The maximum number of free blocks written by vHeapTraceWriteSnapshot(). */
+	#define configHEAP_TRACE_SNAPSHOT_BLOCKS 32
+#endif
+
+#ifndef configHEAP_TRACE_TIMESTAMP
+	#define configHEAP_TRACE_TIMESTAMP() ( ( uint32_t ) xTaskGetTickCount() )
+#endif
+
+#if( ( configUSE_HEAP_TRACE == 1 ) && ( configUSE_MUTEXES != 1 ) && ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) )
+	#error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 if configUSE_HEAP_TRACE is set to 1
+#endif
+
+#if( ( configUSE_HEAP_TRACE == 1 ) && ( configUSE_TIMERS != 1 ) && ( INCLUDE_xTaskGetSchedulerState != 1 ) )
+	#error INCLUDE_xTaskGetSchedulerState must be set to 1 if configUSE_HEAP_TRACE is set to 1
+#endif
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
 	#define configAPPLICATION_ALLOCATED_HEAP 0
 #endif
@@ -834,10 +1135,28 @@ hold explicit before calling the code. */
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+/* The number of notification slots each task has.  Index 0 is used by the
+non-indexed notification API, and by stream buffers and message buffers. */
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
 #ifndef configUSE_POSIX_ERRNO
 	#define configUSE_POSIX_ERRNO 0
 #endif
 
+#ifndef configUSE_PRIORITY_INDEXED_EVENT_LISTS
+	/* Set to 1 to keep a per priority index alongside the event lists of
+	queues and semaphores so blocking on and waking from them does not walk the
+	list of waiting tasks.  Costs ( configMAX_PRIORITIES + 1 ) pointers plus a
+	bitmap per event list. */
+	#define configUSE_PRIORITY_INDEXED_EVENT_LISTS 0
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
 	#define portTICK_TYPE_IS_ATOMIC 0
 #endif
@@ -1091,6 +1410,9 @@ typedef struct xSTATIC_LIST
 	UBaseType_t uxDummy2;
 	void *pvDummy3;
 	StaticMiniListItem_t xDummy4;
+	#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+		void *pvDummy6;
+	#endif
 	#if( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
 		TickType_t xDummy5;
 	#endif
@@ -1144,8 +1466,8 @@ typedef struct xSTATIC_TCB
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
 		uint8_t			uxDummy20;
@@ -1157,8 +1479,29 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_POSIX_ERRNO == 1 )
 		int				iDummy22;
 	#endif
+	#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		UBaseType_t		uxDummy25;
+		void			*pxDummy26;
+	#endif
+	#if ( configUSE_TASK_BUDGETS == 1 )
+		TickType_t		xDummy27[ 4 ];
+		UBaseType_t		uxDummy28;
+		StaticListItem_t	xDummy29;
+	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy23[ 4 ];
+		UBaseType_t		uxDummy24;
+	#endif
 } StaticTask_t;
 
+/* Mirrors the ReadySetMember_t structure contained in queues and stream
+buffers when configUSE_READY_SETS is 1. */
+typedef struct xSTATIC_READY_SET_MEMBER
+{
+	void *pvDummy1[ 4 ];
+	uint8_t ucDummy2;
+} StaticReadySetMember_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1184,6 +1527,13 @@ typedef struct xSTATIC_QUEUE
 	} u;
 
 	StaticList_t xDummy3[ 2 ];
+	#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+		struct
+		{
+			void *pvDummy10[ configMAX_PRIORITIES + 1 ];
+			uint32_t ulDummy11[ ( configMAX_PRIORITIES + 32 ) / 32 ];
+		} xDummy12[ 2 ];
+	#endif
 	UBaseType_t uxDummy4[ 3 ];
 	uint8_t ucDummy5[ 2 ];
 
@@ -1200,6 +1550,26 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if ( configUSE_READY_SETS == 1 )
+		StaticReadySetMember_t xDummy13;
+	#endif
+
+	#if ( configUSE_PRIORITY_QUEUES == 1 )
+		void *pvDummy14;
+	#endif
+
+	#if ( configUSE_CONFLATING_QUEUES == 1 )
+		void *pvDummy15;
+	#endif
+
+	#if ( configUSE_QUEUE_STATS == 1 )
+		struct
+		{
+			UBaseType_t uxDummy1;
+			uint32_t ulDummy2[ 9 ];
+		} xDummy16;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1220,12 +1590,17 @@ typedef StaticQueue_t StaticSemaphore_t;
 typedef struct xSTATIC_EVENT_GROUP
 {
 	TickType_t xDummy1;
-	StaticList_t xDummy2;
+	StaticList_t xDummy2[ configEVENT_GROUP_WAITER_BUCKETS ];
+	TickType_t xDummy6[ configEVENT_GROUP_WAITER_BUCKETS ];
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy3;
 	#endif
 
+	#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+		UBaseType_t uxDummy5;
+	#endif
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 			uint8_t ucDummy4;
 	#endif
@@ -1257,6 +1632,17 @@ typedef struct xSTATIC_TIMER
 		UBaseType_t		uxDummy7;
 	#endif
 	uint8_t 			ucDummy8;
+	#if( configUSE_TIMER_PENDING_COMMANDS == 1 )
+		void			*pvDummy9;
+		TickType_t		xDummy10[ 2 ];
+		uint8_t			ucDummy11;
+	#endif
+	#if( configUSE_TIMER_SLACK == 1 )
+		TickType_t		xDummy12[ 2 ];
+	#endif
+	#if( configUSE_TIMER_STATS == 1 )
+		uint32_t		ulDummy13[ 4 + ( 2 * configTIMER_STATS_BUCKETS ) ];
+	#endif
 
 } StaticTimer_t;
 
@@ -1282,11 +1668,43 @@ typedef struct xSTATIC_STREAM_BUFFER
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy4;
 	#endif
+	#if ( configUSE_READY_SETS == 1 )
+		StaticReadySetMember_t xDummy5;
+	#endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+* In line with software engineering best practice, FreeRTOS implements a strict
+* data hiding policy, so the real log buffer structure is not accessible to
+* the application.  The StaticLogBuffer_t structure below is provided so the
+* application can statically allocate a log buffer.  Its size and alignment
+* requirements match those of the real structure.
+*/
+typedef struct xSTATIC_LOG_BUFFER
+{
+	uint32_t ulDummy1[ 3 ];
+	void * pvDummy2[ 2 ];
+	uint32_t ulDummy3;
+	uint8_t ucDummy4;
+} StaticLogBuffer_t;
+
+/*
+* In line with software engineering best practice, FreeRTOS implements a strict
+* data hiding policy, so the real ready set structure is not accessible to the
+* application.  The StaticReadySet_t structure below is provided so the
+* application can statically allocate a ready set.  Its size and alignment
+* requirements match those of the real structure.
+*/
+typedef struct xSTATIC_READY_SET
+{
+	void *pvDummy1[ 3 ];
+	UBaseType_t uxDummy2[ 2 ];
+	uint8_t ucDummy3;
+} StaticReadySet_t;
+
 #ifdef __cplusplus
 }
 #endif
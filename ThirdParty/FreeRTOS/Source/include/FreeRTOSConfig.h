@@ -75,6 +75,11 @@
 #define configUSE_COUNTING_SEMAPHORES     1
 #define configGENERATE_RUN_TIME_STATS     0
 
+/* Memory allocation definitions.  Setting this to 1 needs heap = heap_regions
+in platformio.ini: main() then adds the free CCM RAM as the fast region that
+task stacks are allocated from. */
+#define configSTACK_ALLOCATION_FROM_SEPARATE_HEAP 0
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES           0
 #define configMAX_CO_ROUTINE_PRIORITIES (2)
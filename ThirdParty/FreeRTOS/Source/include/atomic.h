@@ -84,6 +84,21 @@ extern "C" {
 	#define portFORCE_INLINE
 #endif
 
+/*
+ * GCC and Clang provide __atomic builtins that compile to the processor's own
+ * atomic instructions where it has them - LDREX/STREX on ARMv7-M, LOCK CMPXCHG
+ * on x86 - and define __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4 when they do.  In that
+ * case the 32-bit compare-and-swap, add and increment functions use them
+ * rather than a critical section, so they are lock free and never mask
+ * interrupts.  Cores without such instructions, such as ARMv6-M, keep the
+ * critical section.
+ */
+#if defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4 )
+	#define atomicLOCK_FREE_32_BIT	1
+#else
+	#define atomicLOCK_FREE_32_BIT	0
+#endif
+
 #define ATOMIC_COMPARE_AND_SWAP_SUCCESS	 0x1U		/**< Compare and swap succeeded, swapped. */
 #define ATOMIC_COMPARE_AND_SWAP_FAILURE	 0x0U		/**< Compare and swap failed, did not swap. */
 
@@ -110,11 +125,10 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u32( uint32_t volatile *
 {
 uint32_t ulReturnValue;
 
-	ATOMIC_ENTER_CRITICAL();
+	#if( atomicLOCK_FREE_32_BIT == 1 )
 	{
-		if( *pulDestination == ulComparand )
+		if( __atomic_compare_exchange_n( pulDestination, &ulComparand, ulExchange, pdFALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) )
 		{
-			*pulDestination = ulExchange;
 			ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
 		}
 		else
@@ -122,7 +136,23 @@ uint32_t ulReturnValue;
 			ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
 		}
 	}
-	ATOMIC_EXIT_CRITICAL();
+	#else
+	{
+		ATOMIC_ENTER_CRITICAL();
+		{
+			if( *pulDestination == ulComparand )
+			{
+				*pulDestination = ulExchange;
+				ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+			}
+			else
+			{
+				ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+			}
+		}
+		ATOMIC_EXIT_CRITICAL();
+	}
+	#endif
 
 	return ulReturnValue;
 }
@@ -210,12 +240,20 @@ static portFORCE_INLINE uint32_t Atomic_Add_u32( uint32_t volatile * pulAddend,
 {
 	uint32_t ulCurrent;
 
-	ATOMIC_ENTER_CRITICAL();
+	#if( atomicLOCK_FREE_32_BIT == 1 )
 	{
-		ulCurrent = *pulAddend;
-		*pulAddend += ulCount;
+		ulCurrent = __atomic_fetch_add( pulAddend, ulCount, __ATOMIC_SEQ_CST );
 	}
-	ATOMIC_EXIT_CRITICAL();
+	#else
+	{
+		ATOMIC_ENTER_CRITICAL();
+		{
+			ulCurrent = *pulAddend;
+			*pulAddend += ulCount;
+		}
+		ATOMIC_EXIT_CRITICAL();
+	}
+	#endif
 
 	return ulCurrent;
 }
@@ -263,12 +301,20 @@ static portFORCE_INLINE uint32_t Atomic_Increment_u32( uint32_t volatile * pulAd
 {
 uint32_t ulCurrent;
 
-	ATOMIC_ENTER_CRITICAL();
+	#if( atomicLOCK_FREE_32_BIT == 1 )
 	{
-		ulCurrent = *pulAddend;
-		*pulAddend += 1;
+		ulCurrent = __atomic_fetch_add( pulAddend, 1U, __ATOMIC_SEQ_CST );
 	}
-	ATOMIC_EXIT_CRITICAL();
+	#else
+	{
+		ATOMIC_ENTER_CRITICAL();
+		{
+			ulCurrent = *pulAddend;
+			*pulAddend += 1;
+		}
+		ATOMIC_EXIT_CRITICAL();
+	}
+	#endif
 
 	return ulCurrent;
 }
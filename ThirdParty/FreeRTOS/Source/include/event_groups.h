@@ -200,6 +200,57 @@ typedef TickType_t EventBits_t;
 	EventGroupHandle_t xEventGroupCreateStatic( StaticEventGroup_t *pxEventGroupBuffer ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * event_groups.h
+ *<pre>
+ EventGroupHandle_t xEventGroupCreateDirect( UBaseType_t uxMaxWaiters );
+ EventGroupHandle_t xEventGroupCreateDirectStatic( UBaseType_t uxMaxWaiters, StaticEventGroup_t *pxEventGroupBuffer );
+ </pre>
+ *
+ * Create a new event group that interrupts can set and clear directly.
+ * configUSE_EVENT_GROUP_DIRECT_ISR must be set to 1 in FreeRTOSConfig.h for
+ * these functions to be available.
+ *
+ * xEventGroupSetBitsFromISR() and xEventGroupClearBitsFromISR() normally defer
+ * their work to the RTOS daemon task, because setting bits can unblock any
+ * number of tasks and that is not a deterministic operation.  For an event
+ * group created by one of these functions the bits are instead updated, and
+ * any waiting tasks unblocked, within the interrupt itself.  That removes the
+ * timer command queue send, the daemon task wake up and the extra context
+ * switch from the path between the interrupt and the waiting task, and means
+ * the call cannot fail because the timer command queue is full.
+ *
+ * To keep the time spent in the interrupt bounded no more than uxMaxWaiters
+ * tasks can wait on the event group at once.  A task that attempts to wait
+ * when uxMaxWaiters tasks are already waiting does not block, and returns as if
+ * its block time had expired.  The list of waiting tasks is accessed from a
+ * critical section, rather than with the scheduler suspended, so task level
+ * event group calls on these event groups mask interrupts for a time
+ * proportional to uxMaxWaiters.
+ *
+ * @param uxMaxWaiters The maximum number of tasks that can wait on the event
+ * group at once.  Must be greater than zero.
+ *
+ * @param pxEventGroupBuffer Must point to a variable of type
+ * StaticEventGroup_t, which will be used to hold the event group's data
+ * structures.
+ *
+ * @return If the event group was created then a handle to the event group is
+ * returned, otherwise NULL is returned.
+ *
+ * \defgroup xEventGroupCreateDirect xEventGroupCreateDirect
+ * \ingroup EventGroup
+ */
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		EventGroupHandle_t xEventGroupCreateDirect( UBaseType_t uxMaxWaiters ) PRIVILEGED_FUNCTION;
+	#endif
+
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		EventGroupHandle_t xEventGroupCreateDirectStatic( UBaseType_t uxMaxWaiters, StaticEventGroup_t *pxEventGroupBuffer ) PRIVILEGED_FUNCTION;
+	#endif
+#endif
+
 /**
  * event_groups.h
  *<pre>
@@ -369,6 +420,9 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
  * timer task to have the clear operation performed in the context of the timer
  * task.
  *
+ * Event groups created with xEventGroupCreateDirect() are the exception - their
+ * bits are cleared directly and pdPASS is always returned.
+ *
  * @param xEventGroup The event group in which the bits are to be cleared.
  *
  * @param uxBitsToClear A bitwise value that indicates the bit or bits to clear.
@@ -404,7 +458,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
  * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) )
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupClearBitsFromISR( xEventGroup, uxBitsToClear ) xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL )
@@ -500,6 +554,12 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * Event groups created with xEventGroupCreateDirect() are the exception - their
+ * bits are set, and waiting tasks unblocked, directly from the interrupt.  In
+ * that case *pxHigherPriorityTaskWoken is set to pdTRUE if an unblocked task
+ * has a priority above the currently running task, and pdPASS is always
+ * returned.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -556,7 +616,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) )
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken ) xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken )
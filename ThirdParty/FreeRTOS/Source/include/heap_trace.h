@@ -0,0 +1,186 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * The heap trace records every pvPortMalloc() and vPortFree() call - the block,
+ * its size, the address of the call site, the task that made the call and a
+ * timestamp - in a ring buffer, so the application can find out who holds heap
+ * memory and why the largest free block shrinks.  It uses the traceMALLOC() and
+ * traceFREE() hooks, so it works with any heap implementation and any port.
+ *
+ * Set configUSE_HEAP_TRACE to 1 in FreeRTOSConfig.h to enable the trace and
+ * build heap_trace.c.  The ring holds configHEAP_TRACE_RECORDS records; once
+ * it is full the oldest records are overwritten and counted as lost, so it
+ * should be drained regularly with vHeapTraceWriteRecords() or
+ * uxHeapTraceRead().  configHEAP_TRACE_TIMESTAMP() defaults to the tick count
+ * and can be defined to read a cycle counter instead.
+ *
+ * vHeapTraceWriteRecords() and vHeapTraceWriteSnapshot() format the records
+ * and the layout of the free blocks as text lines, passed one at a time to a
+ * function provided by the application that writes them to a UART, a file,
+ * stdout on the POSIX port, etc.  Each line starts with "HT", so the trace can
+ * be mixed with other output:
+ *
+ * HT M <time> <address> <size> <caller> <task>   pvPortMalloc(), address 0 if it failed
+ * HT F <time> <address> <size> <caller> <task>   vPortFree()
+ * HT L <count>                                   records lost because the ring was full
+ * HT S <time> <free bytes> <free blocks>         start of a snapshot
+ * HT R <address> <size>                          a heap region
+ * HT B <address> <size>                          a free block
+ * HT E                                           end of a snapshot
+ *
+ * Addresses, callers and task handles are hexadecimal, other values decimal.
+ * Sizes are the size of the heap block including its header.
+ * tools/heap_trace.py turns a captured trace into a report of the top
+ * allocators, the memory still held, and a fragmentation map over time.
+ */
+
+#ifndef HEAP_TRACE_H
+#define HEAP_TRACE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include heap_trace.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* Values for the ucEvent member of HeapTraceRecord_t. */
+#define heapTRACE_MALLOC	( ( uint8_t ) 0U )
+#define heapTRACE_FREE		( ( uint8_t ) 1U )
+
+/* One pvPortMalloc() or vPortFree() call. */
+typedef struct xHEAP_TRACE_RECORD
+{
+	void *pvAddress;		/*< The block allocated or freed.  NULL if an allocation failed. */
+	void *pvCaller;			/*< The address the heap function returned to, see configHEAP_TRACE_CALLER(). */
+	TaskHandle_t xTask;		/*< The running task, or NULL if the scheduler had not been started. */
+	uint32_t ulTimeStamp;	/*< configHEAP_TRACE_TIMESTAMP() when the call was made. */
+	size_t xSize;			/*< The size of the block, including the heap's block header. */
+	uint8_t ucEvent;		/*< heapTRACE_MALLOC or heapTRACE_FREE. */
+} HeapTraceRecord_t;
+
+/* Writes one line of text, which does not include a line terminator. */
+typedef void ( *HeapTraceWriteFunction_t )( const char *pcLine );
+
+/**
+ * heap_trace.h
+ * <pre>UBaseType_t uxHeapTraceRead( HeapTraceRecord_t *pxRecords, UBaseType_t uxMaxRecords );</pre>
+ *
+ * configUSE_HEAP_TRACE must be defined as 1 for this function to be available.
+ *
+ * Removes up to uxMaxRecords records from the ring, oldest first.
+ *
+ * @param pxRecords A pointer to an array of HeapTraceRecord_t structures.
+ *
+ * @param uxMaxRecords The number of structures in pxRecords.
+ *
+ * @return The number of records copied into pxRecords.
+ *
+ * \defgroup uxHeapTraceRead uxHeapTraceRead
+ * \ingroup Heap
+ */
+UBaseType_t uxHeapTraceRead( HeapTraceRecord_t *pxRecords, UBaseType_t uxMaxRecords ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ * <pre>UBaseType_t uxHeapTraceGetLostRecordCount( void );</pre>
+ *
+ * configUSE_HEAP_TRACE must be defined as 1 for this function to be available.
+ *
+ * @return The number of records that have been overwritten before they were
+ * read, and clears the count.
+ *
+ * \defgroup uxHeapTraceGetLostRecordCount uxHeapTraceGetLostRecordCount
+ * \ingroup Heap
+ */
+UBaseType_t uxHeapTraceGetLostRecordCount( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ * <pre>void vHeapTraceWriteRecords( HeapTraceWriteFunction_t pxWriteLine );</pre>
+ *
+ * configUSE_HEAP_TRACE must be defined as 1 for this function to be available.
+ *
+ * Removes all the records from the ring and passes each to pxWriteLine as a
+ * line of text in the format described at the top of this file.  Allocations
+ * made by pxWriteLine itself are recorded, and written by the next call.
+ *
+ * @param pxWriteLine The function that writes each line.
+ *
+ * \defgroup vHeapTraceWriteRecords vHeapTraceWriteRecords
+ * \ingroup Heap
+ */
+void vHeapTraceWriteRecords( HeapTraceWriteFunction_t pxWriteLine ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ * <pre>void vHeapTraceWriteSnapshot( HeapTraceWriteFunction_t pxWriteLine );</pre>
+ *
+ * configUSE_HEAP_TRACE must be defined as 1 for this function to be available.
+ *
+ * Passes the regions of the heap and the address and size of its free blocks
+ * to pxWriteLine as lines of text in the format described at the top of this
+ * file.  At most configHEAP_TRACE_SNAPSHOT_BLOCKS free blocks are written; the
+ * free block count in the "S" line is always the total.  The heap must
+ * provide uxPortGetHeapFreeBlocks() and uxPortGetHeapRegions(), as heap_4.c,
+ * heap_tlsf.c and heap_regions.c do.  The free blocks are gathered into a
+ * static buffer, so only one task should call this function.
+ *
+ * Example usage:
+   <pre>
+ void vWriteHeapTraceLine( const char *pcLine )
+ {
+     printf( "%s\r\n", pcLine );
+ }
+
+ void vHeapMonitorTask( void *pvParameters )
+ {
+     for( ;; )
+     {
+         vTaskDelay( pdMS_TO_TICKS( 1000 ) );
+         vHeapTraceWriteRecords( vWriteHeapTraceLine );
+         vHeapTraceWriteSnapshot( vWriteHeapTraceLine );
+     }
+ }
+   </pre>
+ *
+ * @param pxWriteLine The function that writes each line.
+ *
+ * \defgroup vHeapTraceWriteSnapshot vHeapTraceWriteSnapshot
+ * \ingroup Heap
+ */
+void vHeapTraceWriteSnapshot( HeapTraceWriteFunction_t pxWriteLine ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( HEAP_TRACE_H ) */
@@ -158,6 +158,31 @@ struct xMINI_LIST_ITEM
 };
 typedef struct xMINI_LIST_ITEM MiniListItem_t;
 
+#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+
+	/* Event list item values are configMAX_PRIORITIES minus the priority of the
+	owning task, so range from 1 to configMAX_PRIORITIES inclusive.  One level
+	is provided per possible value, plus level 0 so the value can be used as an
+	index directly. */
+	#define listPRIORITY_INDEX_LEVELS		( ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 1 )
+	#define listPRIORITY_INDEX_MAP_WORDS	( ( listPRIORITY_INDEX_LEVELS + ( UBaseType_t ) 31 ) / ( UBaseType_t ) 32 )
+
+	/*
+	 * An optional index that can be attached to a list that is only ever
+	 * inserted into using vListInsert() with item values below
+	 * listPRIORITY_INDEX_LEVELS - in practice the event lists of queues and
+	 * semaphores.  It records the last item held at each item value, and a
+	 * bitmap of the item values that are present, so vListInsert() can locate
+	 * the insertion point without walking the list.
+	 */
+	typedef struct xLIST_PRIORITY_INDEX
+	{
+		struct xLIST_ITEM * pxLevelTail[ listPRIORITY_INDEX_LEVELS ];	/*< The last item in the list that has each item value, or NULL if there is no item with that value. */
+		uint32_t ulLevelMap[ listPRIORITY_INDEX_MAP_WORDS ];			/*< Bit n is set if pxLevelTail[ n ] is not NULL. */
+	} ListPriorityIndex_t;
+
+#endif /* configUSE_PRIORITY_INDEXED_EVENT_LISTS */
+
 /*
  * Definition of the type of queue used by the scheduler.
  */
@@ -167,6 +192,9 @@ typedef struct xLIST
 	volatile UBaseType_t uxNumberOfItems;
 	ListItem_t * configLIST_VOLATILE pxIndex;			/*< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
 	MiniListItem_t xListEnd;							/*< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
+	#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+		ListPriorityIndex_t * pxPriorityIndex;			/*< Set by vListInitialisePriorityIndex(), NULL if the list is not indexed. */
+	#endif
 	listSECOND_LIST_INTEGRITY_CHECK_VALUE				/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
@@ -355,6 +383,26 @@ void vListInitialise( List_t * const pxList ) PRIVILEGED_FUNCTION;
  */
 void vListInitialiseItem( ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+
+	/*
+	 * Attach a priority index to an initialised and empty list.  Subsequent
+	 * calls to vListInsert() on the list complete in constant time, and
+	 * uxListRemove() keeps the index up to date.  vListInsertEnd() must not be
+	 * used on an indexed list.
+	 *
+	 * @param pxList Pointer to the list to index.
+	 *
+	 * @param pxPriorityIndex Pointer to the index storage, which must remain
+	 * valid for as long as the list is in use.
+	 *
+	 * \page vListInitialisePriorityIndex vListInitialisePriorityIndex
+	 * \ingroup LinkedList
+	 */
+	void vListInitialisePriorityIndex( List_t * const pxList, ListPriorityIndex_t * const pxPriorityIndex ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_PRIORITY_INDEXED_EVENT_LISTS */
+
 /*
  * Insert a list item into a list.  The item will be inserted into the list in
  * a position determined by its item value (descending item value order).
@@ -0,0 +1,282 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Log buffers pass variable length records, such as log messages and event
+ * records, from any number of tasks and interrupts to a single reading task.
+ * Unlike stream and message buffers, which allow only one writer, any task or
+ * interrupt can write to a log buffer at any time without a critical section.
+ *
+ * Writers claim space for a record by advancing the buffer's head with an
+ * atomic compare-and-swap (LDREX/STREX on ARMv7-M, see atomic.h), copy the
+ * record in, then publish it.  Records are read in the order their space was
+ * claimed: a record that has been claimed but not yet published holds back the
+ * records claimed after it until it is published, so a writer that is
+ * interrupted part way through a record never causes records to be lost or
+ * reordered.  Writers never block - if there is no space the record is dropped
+ * and counted.
+ *
+ * The buffer size must be a power of two, and each record uses its length
+ * rounded up to a multiple of eight, plus eight bytes of header.  A record
+ * never wraps around the end of the buffer, so the space at the end of the
+ * buffer that is too small for a record is skipped.
+ */
+
+#ifndef LOG_BUFFER_H
+#define LOG_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include log_buffer.h"
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which log buffers are referenced.  For example, a call to
+ * xLogBufferCreate() returns a LogBufferHandle_t variable that can then be
+ * used as a parameter to xLogBufferSend(), xLogBufferReceive(), etc.
+ */
+struct LogBufferDef_t;
+typedef struct LogBufferDef_t * LogBufferHandle_t;
+
+/**
+ * log_buffer.h
+ *
+<pre>
+LogBufferHandle_t xLogBufferCreate( size_t xBufferSizeBytes );
+</pre>
+ *
+ * Creates a new log buffer using dynamically allocated memory.
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xLogBufferCreate() to be available.
+ *
+ * @param xBufferSizeBytes The total number of bytes the log buffer can hold,
+ * which must be a power of two.
+ *
+ * @return If NULL is returned, then the log buffer cannot be created because
+ * there is insufficient heap memory available.  A non-NULL value being
+ * returned indicates that the log buffer has been created successfully.
+ *
+ * \defgroup xLogBufferCreate xLogBufferCreate
+ * \ingroup LogBufferManagement
+ */
+LogBufferHandle_t xLogBufferCreate( size_t xBufferSizeBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * log_buffer.h
+ *
+<pre>
+LogBufferHandle_t xLogBufferCreateStatic( size_t xBufferSizeBytes,
+                                          uint8_t *pucLogBufferStorageArea,
+                                          StaticLogBuffer_t *pxStaticLogBuffer );
+</pre>
+ *
+ * Creates a new log buffer using statically allocated memory.
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xLogBufferCreateStatic() to be available.
+ *
+ * @param xBufferSizeBytes The size, in bytes, of the buffer pointed to by the
+ * pucLogBufferStorageArea parameter, which must be a power of two.
+ *
+ * @param pucLogBufferStorageArea Must point to a uint32_t aligned array of at
+ * least xBufferSizeBytes bytes.
+ *
+ * @param pxStaticLogBuffer Must point to a variable of type StaticLogBuffer_t,
+ * which will be used to hold the log buffer's data structure.
+ *
+ * @return If the log buffer is created successfully then a handle to the
+ * created log buffer is returned.  If either pucLogBufferStorageArea or
+ * pxStaticLogBuffer are NULL then NULL is returned.
+ *
+ * \defgroup xLogBufferCreateStatic xLogBufferCreateStatic
+ * \ingroup LogBufferManagement
+ */
+LogBufferHandle_t xLogBufferCreateStatic( size_t xBufferSizeBytes,
+										  uint8_t * const pucLogBufferStorageArea,
+										  StaticLogBuffer_t * const pxStaticLogBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * log_buffer.h
+ *
+<pre>
+size_t xLogBufferSend( LogBufferHandle_t xLogBuffer,
+                       const void *pvTxData,
+                       size_t xDataLengthBytes );
+</pre>
+ *
+ * Writes a record to a log buffer from a task.  Any number of tasks and
+ * interrupts can write to the same log buffer at the same time.  The function
+ * does not block: if there is not enough space the record is dropped, and
+ * counted by uxLogBufferGetDroppedCount().
+ *
+ * @param xLogBuffer The handle of the log buffer to write to.
+ *
+ * @param pvTxData A pointer to the record to copy into the log buffer.
+ *
+ * @param xDataLengthBytes The length of the record in bytes.  Must be greater
+ * than zero.
+ *
+ * @return xDataLengthBytes if the record was written, otherwise 0.
+ *
+ * \defgroup xLogBufferSend xLogBufferSend
+ * \ingroup LogBufferManagement
+ */
+size_t xLogBufferSend( LogBufferHandle_t xLogBuffer,
+					   const void *pvTxData,
+					   size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * log_buffer.h
+ *
+<pre>
+size_t xLogBufferSendFromISR( LogBufferHandle_t xLogBuffer,
+                              const void *pvTxData,
+                              size_t xDataLengthBytes,
+                              BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xLogBufferSend() that can be called from an interrupt service
+ * routine (ISR).
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if writing the record
+ * unblocked the reading task and the reading task has a priority above that
+ * of the currently running task, in which case a context switch should be
+ * requested before the interrupt is exited.  *pxHigherPriorityTaskWoken
+ * should be initialised to pdFALSE before it is passed in.
+ *
+ * \defgroup xLogBufferSendFromISR xLogBufferSendFromISR
+ * \ingroup LogBufferManagement
+ */
+size_t xLogBufferSendFromISR( LogBufferHandle_t xLogBuffer,
+							  const void *pvTxData,
+							  size_t xDataLengthBytes,
+							  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * log_buffer.h
+ *
+<pre>
+size_t xLogBufferReceive( LogBufferHandle_t xLogBuffer,
+                          void *pvRxData,
+                          size_t xBufferLengthBytes,
+                          TickType_t xTicksToWait );
+</pre>
+ *
+ * Reads the oldest record from a log buffer.  Only one task may read from a
+ * log buffer.
+ *
+ * Example use:
+<pre>
+void vLogTask( void *pvParameters )
+{
+char cRecord[ 128 ];
+size_t xLength;
+
+    for( ;; )
+    {
+        xLength = xLogBufferReceive( xLogBuffer, cRecord, sizeof( cRecord ), portMAX_DELAY );
+
+        if( xLength > 0 )
+        {
+            vWriteToUART( cRecord, xLength );
+        }
+    }
+}
+</pre>
+ *
+ * @param xLogBuffer The handle of the log buffer to read from.
+ *
+ * @param pvRxData A pointer to the buffer into which the record is copied.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by pvRxData.
+ * If the next record is longer it is left in the log buffer and 0 is
+ * returned; xLogBufferNextLengthBytes() gives its length.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for a record to be published.
+ *
+ * @return The length of the record read, or 0 if no record was read.
+ *
+ * \defgroup xLogBufferReceive xLogBufferReceive
+ * \ingroup LogBufferManagement
+ */
+size_t xLogBufferReceive( LogBufferHandle_t xLogBuffer,
+						  void *pvRxData,
+						  size_t xBufferLengthBytes,
+						  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * log_buffer.h
+ *
+<pre>
+size_t xLogBufferNextLengthBytes( LogBufferHandle_t xLogBuffer );
+</pre>
+ *
+ * @return The length of the next published record, or 0 if there is none.
+ *
+ * \defgroup xLogBufferNextLengthBytes xLogBufferNextLengthBytes
+ * \ingroup LogBufferManagement
+ */
+size_t xLogBufferNextLengthBytes( LogBufferHandle_t xLogBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * log_buffer.h
+ *
+<pre>
+UBaseType_t uxLogBufferGetDroppedCount( LogBufferHandle_t xLogBuffer );
+</pre>
+ *
+ * @return The number of records that have been dropped because the log buffer
+ * was full.
+ *
+ * \defgroup uxLogBufferGetDroppedCount uxLogBufferGetDroppedCount
+ * \ingroup LogBufferManagement
+ */
+UBaseType_t uxLogBufferGetDroppedCount( LogBufferHandle_t xLogBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * log_buffer.h
+ *
+<pre>
+void vLogBufferDelete( LogBufferHandle_t xLogBuffer );
+</pre>
+ *
+ * Deletes a log buffer that was previously created using a call to
+ * xLogBufferCreate() or xLogBufferCreateStatic().
+ *
+ * \defgroup vLogBufferDelete vLogBufferDelete
+ * \ingroup LogBufferManagement
+ */
+void vLogBufferDelete( LogBufferHandle_t xLogBuffer ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( LOG_BUFFER_H ) */
@@ -717,6 +717,56 @@ size_t xMessageBufferSpaceAvailable( MessageBufferHandle_t xMessageBuffer ) );
  */
 #define xMessageBufferNextLengthBytes( xMessageBuffer ) xStreamBufferNextMessageLengthBytes( ( StreamBufferHandle_t ) xMessageBuffer ) PRIVILEGED_FUNCTION;
 
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferSendReserve( MessageBufferHandle_t xMessageBuffer, void **ppvData, TickType_t xTicksToWait );
+size_t xMessageBufferSendReserveFromISR( MessageBufferHandle_t xMessageBuffer, void **ppvData );
+size_t xMessageBufferSendCommit( MessageBufferHandle_t xMessageBuffer, size_t xDataLengthBytes );
+size_t xMessageBufferSendCommitFromISR( MessageBufferHandle_t xMessageBuffer, size_t xDataLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Write a message in place rather than copying it in with
+ * xMessageBufferSend().  The reserve functions return the largest message that
+ * can be written without wrapping around the end of the message buffer's
+ * storage area, and the commit functions send the first xDataLengthBytes bytes
+ * of it as one message.  See xStreamBufferSendReserve() and
+ * xStreamBufferSendCommit().
+ *
+ * \defgroup xMessageBufferSendReserve xMessageBufferSendReserve
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendReserve( xMessageBuffer, ppvData, xTicksToWait ) xStreamBufferSendReserve( ( StreamBufferHandle_t ) xMessageBuffer, ppvData, xTicksToWait )
+#define xMessageBufferSendReserveFromISR( xMessageBuffer, ppvData ) xStreamBufferSendReserveFromISR( ( StreamBufferHandle_t ) xMessageBuffer, ppvData )
+#define xMessageBufferSendCommit( xMessageBuffer, xDataLengthBytes ) xStreamBufferSendCommit( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes )
+#define xMessageBufferSendCommitFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferSendCommitFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferReceivePeek( MessageBufferHandle_t xMessageBuffer, void **ppvData, TickType_t xTicksToWait );
+size_t xMessageBufferReceivePeekFromISR( MessageBufferHandle_t xMessageBuffer, void **ppvData );
+size_t xMessageBufferReceiveConsume( MessageBufferHandle_t xMessageBuffer, size_t xDataLengthBytes );
+size_t xMessageBufferReceiveConsumeFromISR( MessageBufferHandle_t xMessageBuffer, size_t xDataLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Read a message in place rather than copying it out with
+ * xMessageBufferReceive().  The peek functions return the length of the next
+ * message and set *ppvData to it, or to NULL if the message wraps around the
+ * end of the storage area and so must be read by xMessageBufferReceive().  The
+ * consume functions remove the message.  See xStreamBufferReceivePeek() and
+ * xStreamBufferReceiveConsume().
+ *
+ * \defgroup xMessageBufferReceivePeek xMessageBufferReceivePeek
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceivePeek( xMessageBuffer, ppvData, xTicksToWait ) xStreamBufferReceivePeek( ( StreamBufferHandle_t ) xMessageBuffer, ppvData, xTicksToWait )
+#define xMessageBufferReceivePeekFromISR( xMessageBuffer, ppvData ) xStreamBufferReceivePeekFromISR( ( StreamBufferHandle_t ) xMessageBuffer, ppvData )
+#define xMessageBufferReceiveConsume( xMessageBuffer, xDataLengthBytes ) xStreamBufferReceiveConsume( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes )
+#define xMessageBufferReceiveConsumeFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferReceiveConsumeFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken )
+
 /**
  * message_buffer.h
  *
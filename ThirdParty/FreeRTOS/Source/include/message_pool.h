@@ -0,0 +1,247 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Message pools pass large messages between tasks and interrupts without
+ * copying them.  A pool holds a fixed number of fixed size message blocks.  A
+ * producer allocates a block from the pool, fills it in, and sends it through
+ * an ordinary FreeRTOS queue - only the pointer to the block is copied into the
+ * queue.  The consumer receives the pointer, uses the message in place, then
+ * releases the block back to the pool.
+ *
+ * Any queue created with an item size of sizeof( void * ) can carry messages,
+ * and one queue can carry messages from one pool only.
+ *
+ * When configASSERT() is defined each block records which task (or interrupt)
+ * owns it, and the functions below assert if a message is sent, received or
+ * released by anything other than its owner - catching messages that are
+ * released twice, or used after they have been sent.
+ */
+
+#ifndef MESSAGE_POOL_H
+#define MESSAGE_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include message_pool.h"
+#endif
+
+#include "queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which message pools are referenced.  For example, a call to
+ * xMessagePoolCreate() returns a MessagePoolHandle_t variable that can then be
+ * used as a parameter to pvMessagePoolAllocate(), xMessagePoolSend(), etc.
+ */
+struct MessagePoolDef_t;
+typedef struct MessagePoolDef_t * MessagePoolHandle_t;
+
+/**
+ * message_pool.h
+ *
+<pre>
+MessagePoolHandle_t xMessagePoolCreate( UBaseType_t uxMessageCount, size_t xMessageSize );
+</pre>
+ *
+ * Creates a message pool using dynamically allocated memory.
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for message pools to be available.
+ *
+ * @param uxMessageCount The number of messages the pool holds.
+ *
+ * @param xMessageSize The size of each message in bytes.  Messages are aligned
+ * to portBYTE_ALIGNMENT.
+ *
+ * @return The handle of the pool, or NULL if there was insufficient heap.
+ *
+ * \defgroup xMessagePoolCreate xMessagePoolCreate
+ * \ingroup MessagePoolManagement
+ */
+MessagePoolHandle_t xMessagePoolCreate( UBaseType_t uxMessageCount, size_t xMessageSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * message_pool.h
+ *
+<pre>
+void *pvMessagePoolAllocate( MessagePoolHandle_t xMessagePool, TickType_t xTicksToWait );
+void *pvMessagePoolAllocateFromISR( MessagePoolHandle_t xMessagePool );
+</pre>
+ *
+ * Takes a message from the pool.  The calling task (or interrupt) owns the
+ * message until it sends or releases it.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for a message to be released back to the pool should all the messages be in
+ * use.
+ *
+ * @return A pointer to the message, or NULL if none became free in time.
+ *
+ * \defgroup pvMessagePoolAllocate pvMessagePoolAllocate
+ * \ingroup MessagePoolManagement
+ */
+void *pvMessagePoolAllocate( MessagePoolHandle_t xMessagePool, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+void *pvMessagePoolAllocateFromISR( MessagePoolHandle_t xMessagePool ) PRIVILEGED_FUNCTION;
+
+/**
+ * message_pool.h
+ *
+<pre>
+BaseType_t xMessagePoolSend( MessagePoolHandle_t xMessagePool,
+                             QueueHandle_t xQueue,
+                             void *pvMessage,
+                             TickType_t xTicksToWait );
+BaseType_t xMessagePoolSendFromISR( MessagePoolHandle_t xMessagePool,
+                                    QueueHandle_t xQueue,
+                                    void *pvMessage,
+                                    BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Sends a message to the back of a queue by reference.  If the message is
+ * sent the sender no longer owns it and must not access it again.
+ *
+ * @param xMessagePool The pool the message was allocated from.
+ *
+ * @param xQueue The queue to send the message to.  Its item size must be
+ * sizeof( void * ).
+ *
+ * @param pvMessage A message owned by the caller.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available on the queue, should it be full.
+ *
+ * @return pdPASS if the message was sent, otherwise errQUEUE_FULL, in which
+ * case the caller still owns the message.
+ *
+ * \defgroup xMessagePoolSend xMessagePoolSend
+ * \ingroup MessagePoolManagement
+ */
+BaseType_t xMessagePoolSend( MessagePoolHandle_t xMessagePool,
+							 QueueHandle_t xQueue,
+							 void *pvMessage,
+							 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xMessagePoolSendFromISR( MessagePoolHandle_t xMessagePool,
+									QueueHandle_t xQueue,
+									void *pvMessage,
+									BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * message_pool.h
+ *
+<pre>
+void *pvMessagePoolReceive( MessagePoolHandle_t xMessagePool,
+                            QueueHandle_t xQueue,
+                            TickType_t xTicksToWait );
+</pre>
+ *
+ * Receives a message from a queue.  The calling task owns the message until
+ * it sends or releases it.
+ *
+ * Example usage:
+<pre>
+void vDisplayTask( void *pvParameters )
+{
+DisplayCommand_t *pxCommand;
+
+    for( ;; )
+    {
+        pxCommand = pvMessagePoolReceive( xCommandPool, xCommandQueue, portMAX_DELAY );
+
+        if( pxCommand != NULL )
+        {
+            prvExecuteCommand( pxCommand );
+            vMessagePoolRelease( xCommandPool, pxCommand );
+        }
+    }
+}
+</pre>
+ *
+ * @return A pointer to the message, or NULL if the queue stayed empty for
+ * xTicksToWait ticks.
+ *
+ * \defgroup pvMessagePoolReceive pvMessagePoolReceive
+ * \ingroup MessagePoolManagement
+ */
+void *pvMessagePoolReceive( MessagePoolHandle_t xMessagePool,
+							QueueHandle_t xQueue,
+							TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * message_pool.h
+ *
+<pre>
+void vMessagePoolRelease( MessagePoolHandle_t xMessagePool, void *pvMessage );
+void vMessagePoolReleaseFromISR( MessagePoolHandle_t xMessagePool,
+                                 void *pvMessage,
+                                 BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Returns a message owned by the caller to the pool it was allocated from.
+ *
+ * \defgroup vMessagePoolRelease vMessagePoolRelease
+ * \ingroup MessagePoolManagement
+ */
+void vMessagePoolRelease( MessagePoolHandle_t xMessagePool, void *pvMessage ) PRIVILEGED_FUNCTION;
+void vMessagePoolReleaseFromISR( MessagePoolHandle_t xMessagePool,
+								 void *pvMessage,
+								 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * message_pool.h
+ *
+<pre>
+UBaseType_t uxMessagePoolGetFreeCount( MessagePoolHandle_t xMessagePool );
+</pre>
+ *
+ * @return The number of messages that can be allocated from the pool.
+ *
+ * \defgroup uxMessagePoolGetFreeCount uxMessagePoolGetFreeCount
+ * \ingroup MessagePoolManagement
+ */
+UBaseType_t uxMessagePoolGetFreeCount( MessagePoolHandle_t xMessagePool ) PRIVILEGED_FUNCTION;
+
+/**
+ * message_pool.h
+ *
+<pre>
+void vMessagePoolDelete( MessagePoolHandle_t xMessagePool );
+</pre>
+ *
+ * Deletes a message pool.  Every message must have been released first.
+ *
+ * \defgroup vMessagePoolDelete vMessagePoolDelete
+ * \ingroup MessagePoolManagement
+ */
+void vMessagePoolDelete( MessagePoolHandle_t xMessagePool ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( MESSAGE_POOL_H ) */
@@ -79,10 +79,10 @@ only for ports that are using the MPU. */
 		#define vTaskGetRunTimeStats					MPU_vTaskGetRunTimeStats
 		#define ulTaskGetIdleRunTimeCounter				MPU_ulTaskGetIdleRunTimeCounter
 		#define xTaskGenericNotify						MPU_xTaskGenericNotify
-		#define xTaskNotifyWait							MPU_xTaskNotifyWait
-		#define ulTaskNotifyTake						MPU_ulTaskNotifyTake
-		#define xTaskNotifyStateClear					MPU_xTaskNotifyStateClear
-		#define ulTaskNotifyValueClear					MPU_ulTaskNotifyValueClear
+		#define xTaskGenericNotifyWait					MPU_xTaskGenericNotifyWait
+		#define ulTaskGenericNotifyTake					MPU_ulTaskGenericNotifyTake
+		#define xTaskGenericNotifyStateClear			MPU_xTaskGenericNotifyStateClear
+		#define ulTaskGenericNotifyValueClear			MPU_ulTaskGenericNotifyValueClear
 		#define xTaskCatchUpTicks						MPU_xTaskCatchUpTicks
 
 		#define xTaskGetCurrentTaskHandle				MPU_xTaskGetCurrentTaskHandle
@@ -130,9 +130,12 @@ only for ports that are using the MPU. */
 		#define pcTimerGetName							MPU_pcTimerGetName
 		#define vTimerSetReloadMode						MPU_vTimerSetReloadMode
 		#define uxTimerGetReloadMode					MPU_uxTimerGetReloadMode
+		#define vTimerSetSlack							MPU_vTimerSetSlack
+		#define xTimerGetSlack							MPU_xTimerGetSlack
 		#define xTimerGetPeriod							MPU_xTimerGetPeriod
 		#define xTimerGetExpiryTime						MPU_xTimerGetExpiryTime
 		#define xTimerGenericCommand					MPU_xTimerGenericCommand
+		#define uxTimerGenericCommandMultiple			MPU_uxTimerGenericCommandMultiple
 
 		/* Map standard event_group.h API functions to the MPU equivalents. */
 		#define xEventGroupCreate						MPU_xEventGroupCreate
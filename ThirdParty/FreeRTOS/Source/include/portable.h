@@ -126,6 +126,17 @@ typedef struct HeapRegion
 	size_t xSizeInBytes;
 } HeapRegion_t;
 
+/* Used by heap_regions.c to describe what a region of memory is suitable
+for. */
+typedef enum
+{
+	eHeapPlacementGeneral = 0,	/* Internal RAM suitable for any use.  Also assumed to be DMA capable. */
+	eHeapPlacementFast,			/* Fast RAM, such as core coupled memory, for stacks and other hot data. */
+	eHeapPlacementBulk,			/* Large but slower RAM, such as external SDRAM, for frame buffers and logs. */
+	eHeapPlacementDMA,			/* RAM reserved for peripheral DMA buffers. */
+	eHeapPlacementCount
+} eHeapPlacement;
+
 /* Used to pass information about the heap out of vPortGetHeapStats(). */
 typedef struct xHeapStats
 {
@@ -151,12 +162,54 @@ typedef struct xHeapStats
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/*
+ * Used by heap_regions.c to add a region of memory with the given placement to
+ * the heap.  Regions can be added at any time, for example once external
+ * memory has been initialised, but are never removed.
+ */
+void vPortAddHeapRegion( const HeapRegion_t * const pxHeapRegion, eHeapPlacement ePlacement ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used by heap_regions.c to allocate memory from the regions with the given
+ * placement, or from the general regions if those are full.  The memory is
+ * freed with vPortFree().
+ */
+void *pvPortMallocPlaced( size_t xSize, eHeapPlacement ePlacement ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used by heap_regions.c to return the number of free bytes in the regions with
+ * the given placement.
+ */
+size_t xPortGetFreeHeapSizePlaced( eHeapPlacement ePlacement ) PRIVILEGED_FUNCTION;
+
 /*
  * Returns a HeapStats_t structure filled with information about the current
  * heap state.
  */
 void vPortGetHeapStats( HeapStats_t *pxHeapStats );
 
+/*
+ * Copies the start address and size of each free block into pxFreeBlocks, in
+ * address order within each heap region, so the layout of the free space can
+ * be inspected.  Returns the total number of free blocks, which can be larger
+ * than uxMaxBlocks, in which case only the first uxMaxBlocks are copied.
+ */
+UBaseType_t uxPortGetHeapFreeBlocks( HeapRegion_t *pxFreeBlocks, UBaseType_t uxMaxBlocks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the start address and size of each region of memory managed by the
+ * heap into pxRegions.  Returns the number of regions, which is zero until the
+ * heap has been initialised by the first call to pvPortMalloc().
+ */
+UBaseType_t uxPortGetHeapRegions( HeapRegion_t *pxRegions, UBaseType_t uxMaxRegions ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the traceMALLOC() and traceFREE() macros when configUSE_HEAP_TRACE
+ * is set to 1.  See heap_trace.h.
+ */
+void vHeapTraceRecordMalloc( void *pvAddress, size_t xSize, void *pvCaller ) PRIVILEGED_FUNCTION;
+void vHeapTraceRecordFree( void *pvAddress, size_t xSize, void *pvCaller ) PRIVILEGED_FUNCTION;
+
 /*
  * Map to the memory management routines required for the port.
  */
@@ -166,6 +219,19 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Task stacks are allocated with pvPortMallocStack(), which is the same as
+ * pvPortMalloc() unless configSTACK_ALLOCATION_FROM_SEPARATE_HEAP is 1, in
+ * which case the heap implementation provides it.
+ */
+#if( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
+	void *pvPortMallocStack( size_t xSize ) PRIVILEGED_FUNCTION;
+	void vPortFreeStack( void *pv ) PRIVILEGED_FUNCTION;
+#else
+	#define pvPortMallocStack pvPortMalloc
+	#define vPortFreeStack vPortFree
+#endif
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
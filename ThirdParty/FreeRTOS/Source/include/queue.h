@@ -61,10 +61,51 @@ typedef struct QueueDefinition * QueueSetHandle_t;
  */
 typedef struct QueueDefinition * QueueSetMemberHandle_t;
 
+/*
+ * The statistics kept for each queue, semaphore and mutex when
+ * configUSE_QUEUE_STATS is set to 1.  Times are measured with
+ * configQUEUE_STATS_TIMESTAMP(), which defaults to the tick count.  A wait
+ * starts when a call finds the queue full (or empty) and has a block time, and
+ * ends when the call returns, so it includes any time spent competing with
+ * other tasks after being unblocked.
+ */
+typedef struct xQUEUE_STATS
+{
+	UBaseType_t uxMaxMessagesWaiting;	/*< The most items the queue has held, or the highest count of a semaphore. */
+	uint32_t ulSends;					/*< Items sent, and semaphores and mutexes given. */
+	uint32_t ulReceives;				/*< Items received, and semaphores and mutexes taken. */
+	uint32_t ulSendsFailed;				/*< Sends that failed because the queue was full. */
+	uint32_t ulReceivesFailed;			/*< Receives that failed because the queue was empty. */
+	uint32_t ulSendBlocks;				/*< The number of times a task blocked to send. */
+	uint32_t ulReceiveBlocks;			/*< The number of times a task blocked to receive or peek. */
+	uint32_t ulTotalWaitTime;			/*< The sum of the times calls waited. */
+	uint32_t ulMaxWaitTime;				/*< The longest time a call waited. */
+	uint32_t ulPriorityInheritances;	/*< The number of times a mutex holder inherited the priority of a task waiting for it. */
+} QueueStats_t;
+
+/*
+ * A snapshot of the statistics of an object in the queue registry, as filled in
+ * by uxQueueGetRegistryStats().
+ */
+typedef struct xQUEUE_REGISTRY_STATS
+{
+	const char *pcQueueName;	/*< The name the object was registered with. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	QueueHandle_t xHandle;		/*< The handle of the object. */
+	UBaseType_t uxLength;		/*< The length of the queue, or the maximum count of a semaphore. */
+	UBaseType_t uxMessagesWaiting;	/*< The items held, or the count of a semaphore, when the snapshot was taken. */
+	uint8_t ucQueueType;		/*< One of the queueQUEUE_TYPE_ values below. */
+	QueueStats_t xStats;		/*< The statistics of the object. */
+} QueueRegistryStats_t;
+
+/* Writes one line of text, which does not include a line terminator. */
+typedef void ( *QueueStatsWriteFunction_t )( const char *pcLine );
+
 /* For internal use only. */
 #define	queueSEND_TO_BACK		( ( BaseType_t ) 0 )
 #define	queueSEND_TO_FRONT		( ( BaseType_t ) 1 )
 #define queueOVERWRITE			( ( BaseType_t ) 2 )
+#define queueSEND_BY_PRIORITY	( ( BaseType_t ) 0x100 )
+#define queueSEND_BY_KEY		( ( BaseType_t ) 0x200 )
 
 /* For internal use only.  These definitions *must* match those in queue.c. */
 #define queueQUEUE_TYPE_BASE				( ( uint8_t ) 0U )
@@ -232,6 +273,154 @@ typedef struct QueueDefinition * QueueSetMemberHandle_t;
 	#define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_BASE ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreatePriority(
+							  UBaseType_t uxQueueLength,
+							  UBaseType_t uxItemSize,
+							  UBaseType_t uxPriorityLevels
+						  );
+ * </pre>
+ *
+ * Creates a new queue that delivers items in priority order instead of the
+ * order in which they were sent.  Items are sent with a priority between 0
+ * (the lowest) and ( uxPriorityLevels - 1 ) using xQueueSendWithPriority() or
+ * xQueueSendWithPriorityFromISR(), and are received highest priority first.
+ * Items that have the same priority are received in the order they were sent.
+ *
+ * Each priority level keeps its own FIFO list of the queue's item slots, and a
+ * two level bitmap records which levels hold items, so the time taken to send
+ * and receive an item does not depend on the number of items queued or on the
+ * number of priority levels.
+ *
+ * The queue is otherwise used like any other queue - tasks can block on it,
+ * and it can be added to queue sets.  xQueueSend() and xQueueSendToBack() send
+ * with priority 0.  xQueueSendToFront(), xQueueOverwrite(),
+ * xQueueSendMultiple() and xQueueReceiveMultiple() cannot be used with it.
+ *
+ * configUSE_PRIORITY_QUEUES must be set to 1 in FreeRTOSConfig.h for
+ * xQueueCreatePriority() to be available.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold, summed
+ * over all priority levels.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must not be zero.
+ *
+ * @param uxPriorityLevels The number of priority levels, from 1 to 256.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then NULL is
+ * returned.
+ *
+ * Example usage:
+   <pre>
+ struct AMessage
+ {
+	char ucMessageID;
+	char ucData[ 20 ];
+ };
+
+ #define mainALARM_PRIORITY		( 3 )
+
+ void vATask( void *pvParameters )
+ {
+ QueueHandle_t xQueue;
+ struct AMessage xMessage;
+
+	// Create a queue capable of containing 10 AMessage structures at four
+	// priority levels.
+	xQueue = xQueueCreatePriority( 10, sizeof( struct AMessage ), 4 );
+
+	// An alarm is received before any routine messages that are already
+	// queued.
+	xQueueSendWithPriority( xQueue, &xMessage, mainALARM_PRIORITY, portMAX_DELAY );
+ }
+ </pre>
+ * \defgroup xQueueCreatePriority xQueueCreatePriority
+ * \ingroup QueueManagement
+ */
+#if( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	QueueHandle_t xQueueCreatePriority( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, const UBaseType_t uxPriorityLevels ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreateConflating(
+							  UBaseType_t uxQueueLength,
+							  UBaseType_t uxItemSize,
+							  UBaseType_t uxKeyCount
+						  );
+ * </pre>
+ *
+ * Creates a new conflating queue.  Items sent to a conflating queue using
+ * xQueueSendWithKey() or xQueueSendWithKeyFromISR() carry a key between 0 and
+ * ( uxKeyCount - 1 ).  If the queue already holds an item with the same key
+ * then that item is overwritten in place, keeping its position in the queue,
+ * instead of a new item being added.  A receiver therefore only sees the most
+ * recent item for each key, and a sender never blocks when updating a key
+ * that is already queued, even if the queue is full.
+ *
+ * This suits producers that post the latest state of many things - such as
+ * the text for each region of a display - to a consumer that can fall behind.
+ * xQueueOverwrite() does the same for a single item.
+ *
+ * The queue records which slot holds the pending item for each key, so
+ * replacing an item does not search the queue.  Items sent with xQueueSend()
+ * or xQueueSendToBack() have no key and are never replaced.
+ * xQueueSendToFront(), xQueueOverwrite(), xQueueSendMultiple() and
+ * xQueueReceiveMultiple() cannot be used with a conflating queue.
+ *
+ * configUSE_CONFLATING_QUEUES must be set to 1 in FreeRTOSConfig.h for
+ * xQueueCreateConflating() to be available.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must not be zero.
+ *
+ * @param uxKeyCount The number of keys, from 1 to 256.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then NULL is
+ * returned.
+ *
+ * Example usage:
+   <pre>
+ struct ARegionUpdate
+ {
+	char cText[ 16 ];
+ };
+
+ #define mainNUMBER_OF_REGIONS	( 8 )
+
+ void vATask( void *pvParameters )
+ {
+ QueueHandle_t xQueue;
+ struct ARegionUpdate xUpdate;
+ uint8_t ucRegion;
+
+	xQueue = xQueueCreateConflating( mainNUMBER_OF_REGIONS, sizeof( struct ARegionUpdate ), mainNUMBER_OF_REGIONS );
+
+	for( ;; )
+	{
+		// ... Update the text of region ucRegion in xUpdate.
+
+		// Replaces any update for the same region that has not yet been
+		// drawn, so the queue never holds more than one update per region.
+		xQueueSendWithKey( xQueue, &xUpdate, ucRegion, portMAX_DELAY );
+	}
+ }
+ </pre>
+ * \defgroup xQueueCreateConflating xQueueCreateConflating
+ * \ingroup QueueManagement
+ */
+#if( ( configUSE_CONFLATING_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	QueueHandle_t xQueueCreateConflating( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, const UBaseType_t uxKeyCount ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * queue. h
  * <pre>
@@ -561,6 +750,89 @@ typedef struct QueueDefinition * QueueSetMemberHandle_t;
  */
 #define xQueueOverwrite( xQueue, pvItemToQueue ) xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), 0, queueOVERWRITE )
 
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendWithPriority(
+								   QueueHandle_t xQueue,
+								   const void *pvItemToQueue,
+								   uint8_t ucPriority,
+								   TickType_t xTicksToWait
+							   );
+ * </pre>
+ *
+ * Only for use with queues created using xQueueCreatePriority().
+ *
+ * Post an item on a priority ordered queue.  The item is received after all
+ * queued items that have the same or a higher priority, and before all queued
+ * items that have a lower priority.  The item is queued by copy, not by
+ * reference.
+ *
+ * This function must not be called from an interrupt service routine.
+ * See xQueueSendWithPriorityFromISR() for an alternative which may be used in
+ * an ISR.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param ucPriority The priority of the item, which must be less than the
+ * number of priority levels the queue was created with.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already
+ * be full.
+ *
+ * @return pdTRUE if the item was successfully posted, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xQueueSendWithPriority xQueueSendWithPriority
+ * \ingroup QueueManagement
+ */
+#define xQueueSendWithPriority( xQueue, pvItemToQueue, ucPriority, xTicksToWait ) xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), ( queueSEND_BY_PRIORITY | ( BaseType_t ) ( ucPriority ) ) )
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendWithKey(
+							  QueueHandle_t xQueue,
+							  const void *pvItemToQueue,
+							  uint8_t ucKey,
+							  TickType_t xTicksToWait
+						  );
+ * </pre>
+ *
+ * Only for use with queues created using xQueueCreateConflating().
+ *
+ * Post an item with a key on a conflating queue.  If the queue already holds
+ * an item with the same key then that item is overwritten in place and the
+ * function returns immediately.  Otherwise the item is posted to the back of
+ * the queue, blocking for up to xTicksToWait ticks if the queue is full.
+ *
+ * This function must not be called from an interrupt service routine.
+ * See xQueueSendWithKeyFromISR() for an alternative which may be used in an
+ * ISR.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param ucKey The key of the item, which must be less than the number of
+ * keys the queue was created with.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it be full and
+ * hold no item with the same key.
+ *
+ * @return pdTRUE if the item was posted or replaced a queued item, otherwise
+ * errQUEUE_FULL.
+ *
+ * \defgroup xQueueSendWithKey xQueueSendWithKey
+ * \ingroup QueueManagement
+ */
+#define xQueueSendWithKey( xQueue, pvItemToQueue, ucKey, xTicksToWait ) xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), ( queueSEND_BY_KEY | ( BaseType_t ) ( ucKey ) ) )
+
 
 /**
  * queue. h
@@ -867,6 +1139,109 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue, void * const pvBuffer ) PRIV
  */
 BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendMultiple(
+								QueueHandle_t xQueue,
+								const void *pvItemsToQueue,
+								UBaseType_t uxItemCount,
+								TickType_t xTicksToWait
+							);</pre>
+ *
+ * Post a burst of items to the back of a queue.  As many items as there is
+ * space for are copied in a single critical section, using at most two
+ * memcpy() calls, and only as many tasks as there are new items are woken, so
+ * sending n items costs much less than n calls to xQueueSendToBack().
+ *
+ * If the queue does not have space for all the items the task blocks until
+ * space becomes available, then carries on sending, until either every item
+ * has been sent or xTicksToWait expires.  Items from other tasks can be
+ * interleaved with the burst if the task has to block.
+ *
+ * This function must not be used in an interrupt service routine, and cannot
+ * be used with semaphores or mutexes.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items, each the
+ * size defined when the queue was created.
+ *
+ * @param uxItemCount The number of items in the pvItemsToQueue array.  Must be
+ * at least 1.  A count of 0 fails configASSERT(), or returns 0 at once if
+ * configASSERT() is not defined.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available on the queue, should it be full.
+ *
+ * @return The number of items that were posted, which is uxItemCount unless
+ * xTicksToWait expired first.
+ *
+ * Example usage:
+   <pre>
+ void vDisplayTask( void *pvParameters )
+ {
+ DisplayCommand_t xCommands[ 16 ];
+ UBaseType_t uxCount;
+
+	for( ;; )
+	{
+		uxCount = uxBuildFrameCommands( xCommands, 16 );
+
+		// Post all the commands for the frame, blocking as long as necessary.
+		// A frame can have no commands, and a count of 0 must not be passed.
+		if( uxCount > 0 )
+		{
+			( void ) xQueueSendMultiple( xDisplayQueue, xCommands, uxCount, portMAX_DELAY );
+		}
+	}
+ }
+ </pre>
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItemsToQueue, UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReceiveMultiple(
+								QueueHandle_t xQueue,
+								void *pvBuffer,
+								UBaseType_t uxMaxItems,
+								TickType_t xTicksToWait
+							);</pre>
+ *
+ * Receive up to uxMaxItems items from a queue in one call.  Every item that is
+ * available, up to uxMaxItems, is copied out in a single critical section
+ * using at most two memcpy() calls.
+ *
+ * The task only blocks if the queue is empty, and returns as soon as at least
+ * one item has been received.
+ *
+ * This function must not be used in an interrupt service routine, and cannot
+ * be used with semaphores or mutexes.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.  Must be at least
+ * 1.  A count of 0 fails configASSERT(), or returns 0 at once if
+ * configASSERT() is not defined.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to receive should the queue be empty at the time of the call.
+ *
+ * @return The number of items received, or 0 if xTicksToWait expired while the
+ * queue was empty.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * <pre>UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue );</pre>
@@ -1215,6 +1590,76 @@ uint32_t ulVarToSend, ulValReceived;
  */
 #define xQueueSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_TO_BACK )
 
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendWithPriorityFromISR(
+										  QueueHandle_t xQueue,
+										  const void *pvItemToQueue,
+										  uint8_t ucPriority,
+										  BaseType_t *pxHigherPriorityTaskWoken
+									  );
+ </pre>
+ *
+ * A version of xQueueSendWithPriority() that can be called from an interrupt
+ * service routine.  Only for use with queues created using
+ * xQueueCreatePriority().
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param ucPriority The priority of the item, which must be less than the
+ * number of priority levels the queue was created with.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending to the queue
+ * caused a task to unblock, and the unblocked task has a priority higher than
+ * the currently running task.
+ *
+ * @return pdTRUE if the data was successfully sent to the queue, otherwise
+ * errQUEUE_FULL.
+ *
+ * \defgroup xQueueSendWithPriorityFromISR xQueueSendWithPriorityFromISR
+ * \ingroup QueueManagement
+ */
+#define xQueueSendWithPriorityFromISR( xQueue, pvItemToQueue, ucPriority, pxHigherPriorityTaskWoken ) xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), ( queueSEND_BY_PRIORITY | ( BaseType_t ) ( ucPriority ) ) )
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendWithKeyFromISR(
+									 QueueHandle_t xQueue,
+									 const void *pvItemToQueue,
+									 uint8_t ucKey,
+									 BaseType_t *pxHigherPriorityTaskWoken
+								 );
+ </pre>
+ *
+ * A version of xQueueSendWithKey() that can be called from an interrupt
+ * service routine.  Only for use with queues created using
+ * xQueueCreateConflating().
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param ucKey The key of the item, which must be less than the number of
+ * keys the queue was created with.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending to the queue
+ * caused a task to unblock, and the unblocked task has a priority higher than
+ * the currently running task.
+ *
+ * @return pdTRUE if the item was posted or replaced a queued item, otherwise
+ * errQUEUE_FULL.
+ *
+ * \defgroup xQueueSendWithKeyFromISR xQueueSendWithKeyFromISR
+ * \ingroup QueueManagement
+ */
+#define xQueueSendWithKeyFromISR( xQueue, pvItemToQueue, ucKey, pxHigherPriorityTaskWoken ) xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), ( queueSEND_BY_KEY | ( BaseType_t ) ( ucKey ) ) )
+
 /**
  * queue. h
  * <pre>
@@ -1487,6 +1932,148 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
 	const char *pcQueueGetName( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 #endif
 
+/**
+ * queue. h
+ * <pre>
+ void vQueueGetStats( QueueHandle_t xQueue, QueueStats_t *pxStats );
+ </pre>
+ *
+ * configUSE_QUEUE_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * Copies the statistics of a queue, semaphore or mutex into pxStats.  The copy
+ * is made in a critical section, so the values are consistent with each other.
+ *
+ * @param xQueue The handle of the queue, semaphore or mutex.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ *
+ * \defgroup vQueueGetStats vQueueGetStats
+ * \ingroup QueueManagement
+ */
+#if( configUSE_QUEUE_STATS == 1 )
+	void vQueueGetStats( QueueHandle_t xQueue, QueueStats_t *pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ void vQueueResetStats( QueueHandle_t xQueue );
+ </pre>
+ *
+ * configUSE_QUEUE_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * Clears the statistics of a queue, semaphore or mutex, for example at the
+ * start of each measurement interval.  The high water mark restarts from the
+ * number of items currently held.
+ *
+ * @param xQueue The handle of the queue, semaphore or mutex.
+ *
+ * \defgroup vQueueResetStats vQueueResetStats
+ * \ingroup QueueManagement
+ */
+#if( configUSE_QUEUE_STATS == 1 )
+	void vQueueResetStats( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t uxQueueGetRegistryStats( QueueRegistryStats_t *pxStats, UBaseType_t uxMaxEntries );
+ </pre>
+ *
+ * configUSE_QUEUE_STATS must be defined as 1, and configQUEUE_REGISTRY_SIZE
+ * must be greater than 0, for this function to be available.
+ *
+ * Takes a snapshot of the statistics of every queue, semaphore and mutex in the
+ * queue registry.  No memory is allocated - the caller provides an array of up
+ * to configQUEUE_REGISTRY_SIZE entries, which can be on the stack of the
+ * calling task.  Each entry is copied in its own critical section, so
+ * interrupts are only disabled for the time taken to copy one entry.
+ *
+ * @param pxStats An array into which the snapshots are written.
+ *
+ * @param uxMaxEntries The number of entries in pxStats.
+ *
+ * @return The number of entries written.
+ *
+ * Example usage:
+   <pre>
+ void vFindBottleneck( void )
+ {
+ QueueRegistryStats_t xStats[ configQUEUE_REGISTRY_SIZE ];
+ UBaseType_t uxCount, ux;
+
+	uxCount = uxQueueGetRegistryStats( xStats, configQUEUE_REGISTRY_SIZE );
+
+	for( ux = 0; ux < uxCount; ux++ )
+	{
+		if( xStats[ ux ].xStats.uxMaxMessagesWaiting == xStats[ ux ].uxLength )
+		{
+			// xStats[ ux ].pcQueueName has been full.
+		}
+	}
+ }
+ </pre>
+ * \defgroup uxQueueGetRegistryStats uxQueueGetRegistryStats
+ * \ingroup QueueManagement
+ */
+#if( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+	UBaseType_t uxQueueGetRegistryStats( QueueRegistryStats_t *pxStats, UBaseType_t uxMaxEntries ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ void vQueueWriteStats( QueueStatsWriteFunction_t pxWriteLine );
+ </pre>
+ *
+ * configUSE_QUEUE_STATS must be defined as 1, and configQUEUE_REGISTRY_SIZE
+ * must be greater than 0, for this function to be available.
+ *
+ * Writes the statistics of every object in the queue registry as lines of
+ * text, passed one at a time to a function provided by the application that
+ * writes them to a UART, a file, stdout, etc.  No memory is allocated.  Each
+ * line starts with "QS", so the report can be mixed with other output:
+ *
+ * QS S <time>                                  start of a report
+ * QS Q <handle> <type> <length> <waiting> <max waiting> <sends> <receives>
+ *      <sends failed> <receives failed> <send blocks> <receive blocks>
+ *      <total wait> <max wait> <inheritances> <name>
+ *                                              one object, on a single line
+ * QS E                                         end of a report
+ *
+ * The handle is hexadecimal, other values are decimal.  The type is a
+ * queueQUEUE_TYPE_ value and times are in configQUEUE_STATS_TIMESTAMP() units.
+ * tools/queue_stats.py turns captured reports into a table ranking the objects
+ * by the time tasks spent waiting on them.
+ *
+ * Example usage:
+   <pre>
+ void vWriteStatsLine( const char *pcLine )
+ {
+     printf( "%s\r\n", pcLine );
+ }
+
+ void vMonitorTask( void *pvParameters )
+ {
+     for( ;; )
+     {
+         vTaskDelay( pdMS_TO_TICKS( 1000 ) );
+         vQueueWriteStats( vWriteStatsLine );
+     }
+ }
+ </pre>
+ * @param pxWriteLine The function that writes each line.
+ *
+ * \defgroup vQueueWriteStats vQueueWriteStats
+ * \ingroup QueueManagement
+ */
+#if( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+	void vQueueWriteStats( QueueStatsWriteFunction_t pxWriteLine ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Generic version of the function used to creaet a queue using dynamic memory
  * allocation.  This is called by other functions and macros that create other
@@ -0,0 +1,343 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Ready sets let one task wait for data on many queues, semaphores, stream
+ * buffers and message buffers at once, in the way epoll() does on POSIX
+ * systems.  Unlike a queue set, which is itself a queue that every send to a
+ * member posts the member's handle to, a member of a ready set links itself
+ * into the set's ready list at most once, however many times it is written
+ * to.  The waiting task collects every ready member in one call to
+ * uxReadySetWait(), then reads from each member using the member's own API.
+ *
+ * Each member is added in one of two modes:
+ *
+ * eReadySetLevel - the member is reported by every call to uxReadySetWait()
+ * for as long as it holds data, so data left in the member is not forgotten.
+ *
+ * eReadySetEdge - the member is reported once each time data is written to it,
+ * so the waiting task is responsible for draining the member before it waits
+ * again.
+ *
+ * A queue or semaphore is ready while it holds at least one item, and a stream
+ * or message buffer is ready while it is not empty.  configUSE_READY_SETS must
+ * be set to 1 in FreeRTOSConfig.h for ready sets to be available.  Only one
+ * task can wait on a ready set, and the ready set uses that task's direct to
+ * task notification while it waits.
+ */
+
+#ifndef READY_SET_H
+#define READY_SET_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include ready_set.h"
+#endif
+
+#include "queue.h"
+#include "stream_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which ready sets are referenced.  For example, a call to
+ * xReadySetCreate() returns a ReadySetHandle_t variable that can then be used
+ * as a parameter to xReadySetAddQueue(), uxReadySetWait(), etc.
+ */
+struct ReadySetDef_t;
+typedef struct ReadySetDef_t * ReadySetHandle_t;
+
+/* How a member of a ready set is reported - see the description at the top
+of this file. */
+typedef enum
+{
+	eReadySetLevel = 0,	/* Reported while the member holds data. */
+	eReadySetEdge		/* Reported once each time data is written to the member. */
+} eReadySetTrigger_t;
+
+/* Filled in by uxReadySetWait() for each ready member. */
+typedef struct xREADY_SET_EVENT
+{
+	void *pvMember;		/* The handle of the queue, semaphore, stream buffer or message buffer that is ready. */
+	void *pvTag;		/* The value passed as pvTag when the member was added to the set. */
+} ReadySetEvent_t;
+
+/*
+ * For internal use only.  Every queue and stream buffer contains one of these
+ * so it can be linked into the ready list of the set it belongs to without
+ * allocating memory.
+ */
+typedef struct ReadySetMember_t
+{
+	struct ReadySetDef_t *pxReadySet;			/* The set the object belongs to, or NULL if it does not belong to a set. */
+	struct ReadySetMember_t *pxNextReady;		/* The next member in the set's ready list. */
+	void *pvMember;								/* The queue or stream buffer that contains this structure. */
+	void *pvTag;								/* Reported along with pvMember. */
+	uint8_t ucFlags;							/* readysetFLAGS_ bits, defined in ready_set.c. */
+} ReadySetMember_t;
+
+/**
+ * ready_set.h
+ *
+<pre>
+ReadySetHandle_t xReadySetCreate( void );
+</pre>
+ *
+ * Creates a new ready set using dynamically allocated memory.
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xReadySetCreate() to be available.
+ *
+ * Unlike xQueueCreateSet(), the size of a ready set does not depend on how many
+ * members it has, so any number of members can be added.
+ *
+ * @return If NULL is returned, then the ready set cannot be created because
+ * there is insufficient heap memory available.  A non-NULL value being
+ * returned indicates that the ready set has been created successfully.
+ *
+ * \defgroup xReadySetCreate xReadySetCreate
+ * \ingroup ReadySetManagement
+ */
+ReadySetHandle_t xReadySetCreate( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * ready_set.h
+ *
+<pre>
+ReadySetHandle_t xReadySetCreateStatic( StaticReadySet_t *pxReadySetBuffer );
+</pre>
+ *
+ * Creates a new ready set using statically allocated memory.
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xReadySetCreateStatic() to be available.
+ *
+ * @param pxReadySetBuffer Must point to a variable of type StaticReadySet_t,
+ * which will be used to hold the ready set's data structure.
+ *
+ * @return If pxReadySetBuffer is NULL then NULL is returned, otherwise a handle
+ * to the created ready set is returned.
+ *
+ * \defgroup xReadySetCreateStatic xReadySetCreateStatic
+ * \ingroup ReadySetManagement
+ */
+ReadySetHandle_t xReadySetCreateStatic( StaticReadySet_t *pxReadySetBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * ready_set.h
+ *
+<pre>
+BaseType_t xReadySetAddQueue( ReadySetHandle_t xReadySet,
+                              QueueHandle_t xQueueOrSemaphore,
+                              eReadySetTrigger_t eTrigger,
+                              void *pvTag );
+</pre>
+ *
+ * Adds a queue, semaphore or mutex to a ready set.  If the queue already holds
+ * data it is reported by the next call to uxReadySetWait().
+ *
+ * @param xReadySet The ready set to add the queue to.
+ *
+ * @param xQueueOrSemaphore The queue or semaphore being added.  An object can
+ * belong to at most one ready set, and cannot belong to a ready set and a
+ * queue set at the same time.
+ *
+ * @param eTrigger eReadySetLevel or eReadySetEdge.
+ *
+ * @param pvTag A value returned in the pvTag member of the ReadySetEvent_t
+ * structure that reports the queue, for example a pointer to the function that
+ * handles the queue's data.
+ *
+ * @return pdPASS if the queue was added, or pdFAIL if it already belongs to a
+ * ready set.
+ *
+ * \defgroup xReadySetAddQueue xReadySetAddQueue
+ * \ingroup ReadySetManagement
+ */
+BaseType_t xReadySetAddQueue( ReadySetHandle_t xReadySet,
+							  QueueHandle_t xQueueOrSemaphore,
+							  eReadySetTrigger_t eTrigger,
+							  void *pvTag ) PRIVILEGED_FUNCTION;
+
+/**
+ * ready_set.h
+ *
+<pre>
+BaseType_t xReadySetAddStreamBuffer( ReadySetHandle_t xReadySet,
+                                     StreamBufferHandle_t xStreamBuffer,
+                                     eReadySetTrigger_t eTrigger,
+                                     void *pvTag );
+</pre>
+ *
+ * As xReadySetAddQueue(), but adds a stream buffer or message buffer.  A
+ * stream buffer is ready as soon as it holds any data, regardless of its
+ * trigger level.
+ *
+ * \defgroup xReadySetAddStreamBuffer xReadySetAddStreamBuffer
+ * \ingroup ReadySetManagement
+ */
+BaseType_t xReadySetAddStreamBuffer( ReadySetHandle_t xReadySet,
+									 StreamBufferHandle_t xStreamBuffer,
+									 eReadySetTrigger_t eTrigger,
+									 void *pvTag ) PRIVILEGED_FUNCTION;
+
+/**
+ * ready_set.h
+ *
+<pre>
+BaseType_t xReadySetRemoveQueue( ReadySetHandle_t xReadySet,
+                                 QueueHandle_t xQueueOrSemaphore );
+BaseType_t xReadySetRemoveStreamBuffer( ReadySetHandle_t xReadySet,
+                                        StreamBufferHandle_t xStreamBuffer );
+</pre>
+ *
+ * Removes a member from a ready set.  A member must be removed from its ready
+ * set before it is deleted.
+ *
+ * @return pdPASS if the member was removed, or pdFAIL if it does not belong to
+ * xReadySet.
+ *
+ * \defgroup xReadySetRemoveQueue xReadySetRemoveQueue
+ * \ingroup ReadySetManagement
+ */
+BaseType_t xReadySetRemoveQueue( ReadySetHandle_t xReadySet,
+								 QueueHandle_t xQueueOrSemaphore ) PRIVILEGED_FUNCTION;
+BaseType_t xReadySetRemoveStreamBuffer( ReadySetHandle_t xReadySet,
+										StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * ready_set.h
+ *
+<pre>
+UBaseType_t uxReadySetWait( ReadySetHandle_t xReadySet,
+                            ReadySetEvent_t *pxEvents,
+                            UBaseType_t uxMaxEvents,
+                            TickType_t xTicksToWait );
+</pre>
+ *
+ * Waits for one or more members of a ready set to hold data, then reports up
+ * to uxMaxEvents of them in the order they became ready.  Members that were
+ * not reported because pxEvents was full are reported by the next call.
+ *
+ * Example use:
+<pre>
+void vControlTask( void *pvParameters )
+{
+ReadySetEvent_t xEvents[ 8 ];
+UBaseType_t uxEvent, uxCount;
+
+    xReadySetAddQueue( xReadySet, xButtonQueue, eReadySetLevel, prvHandleButtons );
+    xReadySetAddStreamBuffer( xReadySet, xUARTStreamBuffer, eReadySetLevel, prvHandleUART );
+
+    for( ;; )
+    {
+        uxCount = uxReadySetWait( xReadySet, xEvents, 8, portMAX_DELAY );
+
+        for( uxEvent = 0; uxEvent < uxCount; uxEvent++ )
+        {
+            ( ( HandlerFunction_t ) xEvents[ uxEvent ].pvTag )( xEvents[ uxEvent ].pvMember );
+        }
+    }
+}
+</pre>
+ *
+ * @param xReadySet The ready set to wait on.  Only one task can wait on a ready
+ * set.
+ *
+ * @param pxEvents An array of at least uxMaxEvents ReadySetEvent_t structures
+ * into which the ready members are written.
+ *
+ * @param uxMaxEvents The maximum number of members to report.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for a member to become ready.
+ *
+ * @return The number of members written to pxEvents, or 0 if the call timed
+ * out.
+ *
+ * \defgroup uxReadySetWait uxReadySetWait
+ * \ingroup ReadySetManagement
+ */
+UBaseType_t uxReadySetWait( ReadySetHandle_t xReadySet,
+							ReadySetEvent_t * const pxEvents,
+							UBaseType_t uxMaxEvents,
+							TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * ready_set.h
+ *
+<pre>
+void vReadySetDelete( ReadySetHandle_t xReadySet );
+</pre>
+ *
+ * Deletes a ready set that was previously created using a call to
+ * xReadySetCreate() or xReadySetCreateStatic().  All the members must be
+ * removed from the set first.
+ *
+ * \defgroup vReadySetDelete vReadySetDelete
+ * \ingroup ReadySetManagement
+ */
+void vReadySetDelete( ReadySetHandle_t xReadySet ) PRIVILEGED_FUNCTION;
+
+/* Functions beyond this part are not part of the public API and are intended
+for use by the kernel only. */
+
+/*
+ * Called by the queue and stream buffer implementations after data has been
+ * written to an object that belongs to a ready set.
+ */
+void vReadySetSignal( ReadySetMember_t * const pxMember ) PRIVILEGED_FUNCTION;
+void vReadySetSignalFromISR( ReadySetMember_t * const pxMember, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the ReadySetMember_t structure contained in a queue or stream
+ * buffer.  Implemented in queue.c and stream_buffer.c respectively.
+ */
+ReadySetMember_t *pxQueueGetReadySetMember( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+ReadySetMember_t *pxStreamBufferGetReadySetMember( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/* Used by the queue and stream buffer implementations to signal a ready set.
+The set pointer is read outside of a critical section first so objects that do
+not belong to a ready set only pay for one load and compare. */
+#if( configUSE_READY_SETS == 1 )
+	#define readysetSIGNAL( pxMember )											\
+		if( ( pxMember )->pxReadySet != NULL )									\
+		{																		\
+			vReadySetSignal( pxMember );										\
+		}
+
+	#define readysetSIGNAL_FROM_ISR( pxMember, pxHigherPriorityTaskWoken )		\
+		if( ( pxMember )->pxReadySet != NULL )									\
+		{																		\
+			vReadySetSignalFromISR( ( pxMember ), ( pxHigherPriorityTaskWoken ) );	\
+		}
+#endif /* configUSE_READY_SETS */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( READY_SET_H ) */
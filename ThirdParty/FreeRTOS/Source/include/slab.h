@@ -0,0 +1,143 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Slab caches hold fixed size kernel objects (task control blocks, semaphores,
+ * timers and event groups) in statically allocated arrays so creating and
+ * deleting those objects does not fragment the heap.  Each cache hands out
+ * objects from a free list in constant time and falls back to pvPortMalloc()
+ * once its array is full.
+ *
+ * The caches are declared and used by the kernel itself when
+ * configUSE_KERNEL_OBJECT_SLABS is set to 1 in FreeRTOSConfig.h.  The number
+ * of objects in each cache is set by configSLAB_TASK_COUNT,
+ * configSLAB_SEMAPHORE_COUNT, configSLAB_TIMER_COUNT and
+ * configSLAB_EVENT_GROUP_COUNT.  The application only needs uxSlabGetStats().
+ */
+
+#ifndef SLAB_H
+#define SLAB_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include slab.h"
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/*
+ * A cache of objects of one type.  Objects that have never been used are taken
+ * from the unused part of the array, objects that have been freed are kept on
+ * a free list threaded through the objects themselves.  Declare caches using
+ * slabCACHE_INITIALISER() - the members should not be accessed directly.
+ */
+typedef struct xSLAB_CACHE
+{
+	uint8_t *pucStart;							/*< The first object in the cache. */
+	uint8_t *pucEnd;							/*< One past the last object in the cache. */
+	uint8_t *pucNextUnused;						/*< The first object that has never been allocated. */
+	void *pvFreeList;							/*< Objects that have been allocated and freed again. */
+	size_t xObjectSize;							/*< The size of each object. */
+	const char *pcName;							/*< Reported by uxSlabGetStats(). */
+	UBaseType_t uxObjectsInUse;
+	UBaseType_t uxMaximumObjectsInUse;
+	size_t xNumberOfFallbackAllocations;		/*< Allocations passed to pvPortMalloc() because the cache was full. */
+	struct xSLAB_CACHE *pxNextCache;			/*< Links the caches that have been used, for uxSlabGetStats(). */
+	BaseType_t xRegistered;
+} SlabCache_t;
+
+/* Used with uxSlabGetStats(). */
+typedef struct xSLAB_STATS
+{
+	const char *pcName;							/* The type of object held by the cache. */
+	size_t xObjectSize;							/* The size of each object in bytes. */
+	UBaseType_t uxObjectCount;					/* The number of objects the cache can hold. */
+	UBaseType_t uxObjectsInUse;					/* The number of objects currently allocated from the cache. */
+	UBaseType_t uxMaximumObjectsInUse;			/* The largest value uxObjectsInUse has had. */
+	size_t xNumberOfFallbackAllocations;		/* The number of allocations that were passed to pvPortMalloc() because the cache was full. */
+} SlabStats_t;
+
+/*
+ * Statically initialise a cache that holds the objects in the array
+ * xObjectArray.
+ */
+#define slabCACHE_INITIALISER( xObjectArray, pcCacheName )														\
+	{																											\
+		( uint8_t * ) ( xObjectArray ),																			\
+		( uint8_t * ) ( xObjectArray ) + sizeof( xObjectArray ),												\
+		( uint8_t * ) ( xObjectArray ),																			\
+		NULL,																									\
+		sizeof( ( xObjectArray )[ 0 ] ),																		\
+		( pcCacheName ),																						\
+		( UBaseType_t ) 0U,																						\
+		( UBaseType_t ) 0U,																						\
+		( size_t ) 0U,																							\
+		NULL,																									\
+		pdFALSE																									\
+	}
+
+/*
+ * Allocate an object from pxCache, or from the FreeRTOS heap if the cache is
+ * full.  Returns NULL if neither has space.
+ */
+void *pvSlabAllocate( SlabCache_t *pxCache ) PRIVILEGED_FUNCTION;
+
+/*
+ * Free an object allocated by pvSlabAllocate( pxCache ).  The object is
+ * returned to the heap if it did not come from the cache.
+ */
+void vSlabFree( SlabCache_t *pxCache, void *pv ) PRIVILEGED_FUNCTION;
+
+/**
+ * slab.h
+ * <pre>UBaseType_t uxSlabGetStats( SlabStats_t *pxSlabStatsArray, const UBaseType_t uxArraySize );</pre>
+ *
+ * configUSE_KERNEL_OBJECT_SLABS must be defined as 1 for this function to be
+ * available.
+ *
+ * Populates a SlabStats_t structure for each kernel object cache that has been
+ * used.  Comparing uxMaximumObjectsInUse with uxObjectCount shows whether the
+ * configSLAB_..._COUNT settings are larger than necessary, and a non zero
+ * xNumberOfFallbackAllocations shows they are too small.
+ *
+ * @param pxSlabStatsArray A pointer to an array of SlabStats_t structures.
+ *
+ * @param uxArraySize The number of structures in pxSlabStatsArray.
+ *
+ * @return The number of SlabStats_t structures that were populated.
+ *
+ * \defgroup uxSlabGetStats uxSlabGetStats
+ * \ingroup Heap
+ */
+UBaseType_t uxSlabGetStats( SlabStats_t *pxSlabStatsArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( SLAB_H ) */
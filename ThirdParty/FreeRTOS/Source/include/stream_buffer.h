@@ -754,6 +754,249 @@ BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer, siz
  */
 BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+                                 void **ppvData,
+                                 TickType_t xTicksToWait );
+</pre>
+ *
+ * Returns a region of the stream buffer's storage area that data can be
+ * written into directly, for example by a DMA engine, instead of being copied
+ * in by xStreamBufferSend().  The data does not become available to the reader
+ * until it is passed to xStreamBufferSendCommit().
+ *
+ * The region is contiguous, so it ends at the end of the storage area even if
+ * there is more space at its start.  Commit the data written to the region then
+ * call xStreamBufferSendReserve() again to get the space at the start of the
+ * storage area.
+ *
+ * Used with a message buffer the region is where the next message will be
+ * held, and committing it sends one message.  A message written this way never
+ * wraps around the end of the storage area, so it can always be read in place
+ * by xStreamBufferReceivePeek().
+ *
+ * As with xStreamBufferSend(), only one task or interrupt may write to a
+ * stream buffer at a time.  Use xStreamBufferSendReserveFromISR() to reserve
+ * space from an interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param ppvData Set to the start of the region, or NULL if there is no space.
+ * The region has no particular alignment.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for space to become available if the buffer is full.
+ *
+ * @return The number of bytes that can be written at *ppvData.
+ *
+ * \defgroup xStreamBufferSendReserve xStreamBufferSendReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+								 void **ppvData,
+								 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        void **ppvData );
+</pre>
+ *
+ * A version of xStreamBufferSendReserve() that can be called from an interrupt
+ * service routine (ISR).  It does not block.
+ *
+ * \defgroup xStreamBufferSendReserveFromISR xStreamBufferSendReserveFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+										void **ppvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+                                size_t xDataLengthBytes );
+</pre>
+ *
+ * Makes xDataLengthBytes bytes that have been written into the region returned
+ * by xStreamBufferSendReserve() available to the reader.  A task blocked on the
+ * buffer is unblocked in the same way as by xStreamBufferSend(), once the
+ * trigger level is reached.  Use xStreamBufferSendCommitFromISR() from an
+ * interrupt service routine.
+ *
+ * Example use, starting a UART receive DMA transfer into a stream buffer:
+<pre>
+void vStartReceive( StreamBufferHandle_t xStreamBuffer )
+{
+void *pvData;
+size_t xLength;
+
+    xLength = xStreamBufferSendReserve( xStreamBuffer, &pvData, 0 );
+
+    if( xLength > 0 )
+    {
+        HAL_UART_Receive_DMA( &huart, pvData, xLength );
+    }
+}
+
+void HAL_UART_RxCpltCallback( UART_HandleTypeDef *huart )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    xStreamBufferSendCommitFromISR( xStreamBuffer, huart->RxXferSize, &xHigherPriorityTaskWoken );
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+</pre>
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was written to.
+ *
+ * @param xDataLengthBytes The number of bytes written, which must not be more
+ * than the number of bytes reserved.  For a message buffer this is the length
+ * of the message.
+ *
+ * @return The number of bytes committed.
+ *
+ * \defgroup xStreamBufferSendCommit xStreamBufferSendCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+								size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                       size_t xDataLengthBytes,
+                                       BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xStreamBufferSendCommit() that can be called from an interrupt
+ * service routine (ISR).  pxHigherPriorityTaskWoken is used as by
+ * xStreamBufferSendFromISR().
+ *
+ * \defgroup xStreamBufferSendCommitFromISR xStreamBufferSendCommitFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+									   size_t xDataLengthBytes,
+									   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceivePeek( StreamBufferHandle_t xStreamBuffer,
+                                 void **ppvData,
+                                 TickType_t xTicksToWait );
+</pre>
+ *
+ * Returns the data at the front of the stream buffer in place, so it can be
+ * processed, or transmitted by a DMA engine, without first being copied out
+ * by xStreamBufferReceive().  The data stays in the buffer until it is removed
+ * by xStreamBufferReceiveConsume().
+ *
+ * For a stream buffer the returned data ends at the end of the storage area,
+ * so if the data wraps around, consume the returned data then call
+ * xStreamBufferReceivePeek() again to get the rest.
+ *
+ * For a message buffer the returned length is the length of the next message.
+ * A message that was written by xMessageBufferSend() can wrap around the end
+ * of the storage area, in which case it cannot be returned in place: *ppvData
+ * is set to NULL and the message must be read by xMessageBufferReceive().
+ * Messages written by xStreamBufferSendReserve() never wrap.
+ *
+ * As with xStreamBufferReceive(), only one task or interrupt may read from a
+ * stream buffer at a time.  Use xStreamBufferReceivePeekFromISR() from an
+ * interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param ppvData Set to the start of the data, or NULL if there is none.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data to become available if the buffer is empty.
+ *
+ * @return The number of bytes that can be read at *ppvData.
+ *
+ * \defgroup xStreamBufferReceivePeek xStreamBufferReceivePeek
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceivePeek( StreamBufferHandle_t xStreamBuffer,
+								 void **ppvData,
+								 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceivePeekFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        void **ppvData );
+</pre>
+ *
+ * A version of xStreamBufferReceivePeek() that can be called from an
+ * interrupt service routine (ISR).  It does not block.
+ *
+ * \defgroup xStreamBufferReceivePeekFromISR xStreamBufferReceivePeekFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceivePeekFromISR( StreamBufferHandle_t xStreamBuffer,
+										void **ppvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceiveConsume( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xDataLengthBytes );
+</pre>
+ *
+ * Removes xDataLengthBytes bytes returned by xStreamBufferReceivePeek() from
+ * the front of the stream buffer, making the space available to the writer.  A
+ * task blocked waiting for space is unblocked in the same way as by
+ * xStreamBufferReceive().  Use xStreamBufferReceiveConsumeFromISR() from an
+ * interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was read.
+ *
+ * @param xDataLengthBytes The number of bytes to remove.  For a message buffer
+ * this must be the length returned by xStreamBufferReceivePeek(), as a
+ * message is always removed whole.
+ *
+ * @return The number of bytes removed.
+ *
+ * \defgroup xStreamBufferReceiveConsume xStreamBufferReceiveConsume
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveConsume( StreamBufferHandle_t xStreamBuffer,
+									size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceiveConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           size_t xDataLengthBytes,
+                                           BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xStreamBufferReceiveConsume() that can be called from an
+ * interrupt service routine (ISR).  pxHigherPriorityTaskWoken is used as by
+ * xStreamBufferReceiveFromISR().
+ *
+ * \defgroup xStreamBufferReceiveConsumeFromISR xStreamBufferReceiveConsumeFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+										   size_t xDataLengthBytes,
+										   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
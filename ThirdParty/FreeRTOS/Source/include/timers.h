@@ -87,6 +87,28 @@ typedef void (*TimerCallbackFunction_t)( TimerHandle_t xTimer );
  */
 typedef void (*PendedFunction_t)( void *, uint32_t );
 
+/*
+ * The statistics kept for each software timer when configUSE_TIMER_STATS is
+ * set to 1.  Lateness is the number of ticks between the time returned by
+ * xTimerGetExpiryTime() and the time the timer service task calls the timer's
+ * callback function.  Run times are measured with configTIMER_STATS_TIMESTAMP(),
+ * which defaults to the tick count.  In both histograms bucket 0 counts values
+ * of 0, bucket n counts values from 2 ^ ( n - 1 ) to ( 2 ^ n ) - 1, and the last
+ * bucket also counts every larger value.
+ */
+typedef struct xTIMER_STATS
+{
+	uint32_t ulCallbacks;									/*< The number of times the callback function has been called. */
+	uint32_t ulMaxLateness;									/*< The latest a callback has run, in ticks. */
+	uint32_t ulMaxRunTime;									/*< The longest a callback has taken. */
+	uint32_t ulTotalRunTime;								/*< The sum of the times the callbacks have taken. */
+	uint32_t ulLateness[ configTIMER_STATS_BUCKETS ];		/*< Histogram of how late callbacks have run. */
+	uint32_t ulRunTime[ configTIMER_STATS_BUCKETS ];		/*< Histogram of how long callbacks have taken. */
+} TimerStats_t;
+
+/* Writes one line of text, which does not include a line terminator. */
+typedef void ( *TimerStatsWriteFunction_t )( const char *pcLine );
+
 /**
  * TimerHandle_t xTimerCreate( 	const char * const pcTimerName,
  * 								TickType_t xTimerPeriodInTicks,
@@ -1262,6 +1284,146 @@ void vTimerSetReloadMode( TimerHandle_t xTimer, const UBaseType_t uxAutoReload )
 */
 UBaseType_t uxTimerGetReloadMode( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlackInTicks );
+ *
+ * Allow a timer to expire up to xSlackInTicks ticks after its expiry time, so
+ * it can expire at the same time as other timers and the timer service task
+ * wakes less often.  The timer expires at the first multiple of the slack
+ * after its expiry time, so timers given the same slack expire together even
+ * if they have different periods or were started at different times.  The
+ * slack is rounded down to one less than a power of two.  An auto-reload timer
+ * does not drift, as each period is measured from when the timer should have
+ * expired rather than from when it did.
+ *
+ * A timer has no slack when it is created.  The slack is used from the next
+ * time the timer is started, reset or reloaded.
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param xSlackInTicks The number of ticks by which the timer may expire late.
+ *
+ * Example usage:
+ * @verbatim
+ * // Status LEDs and housekeeping do not need to run on the exact tick, so let
+ * // them expire on the same 64 tick boundaries.
+ * vTimerSetSlack( xLedTimer, 63 );
+ * vTimerSetSlack( xHousekeepingTimer, 63 );
+ * @endverbatim
+ */
+#if( configUSE_TIMER_SLACK == 1 )
+	void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlackInTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * TickType_t xTimerGetSlack( TimerHandle_t xTimer );
+ *
+ * Returns the slack of a timer, as rounded by vTimerSetSlack().
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The number of ticks by which the timer may expire late.
+ */
+#if( configUSE_TIMER_SLACK == 1 )
+	TickType_t xTimerGetSlack( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTimerGetStats( TimerHandle_t xTimer, TimerStats_t *pxStats );
+ *
+ * Copies the statistics of a timer into pxStats.  The copy is made in a
+ * critical section, so the values are consistent with each other.
+ *
+ * configUSE_TIMER_STATS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ *
+ * Example usage:
+ * @verbatim
+ * // Check the control loop timer has never run more than a tick late.
+ * TimerStats_t xStats;
+ * UBaseType_t x;
+ *
+ *     vTimerGetStats( xControlTimer, &xStats );
+ *     for( x = 2; x < configTIMER_STATS_BUCKETS; x++ )
+ *     {
+ *         configASSERT( xStats.ulLateness[ x ] == 0 );
+ *     }
+ * @endverbatim
+ */
+#if( configUSE_TIMER_STATS == 1 )
+	void vTimerGetStats( TimerHandle_t xTimer, TimerStats_t *pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTimerResetStats( TimerHandle_t xTimer );
+ *
+ * Clears the statistics of a timer, for example at the start of each
+ * measurement interval.
+ *
+ * configUSE_TIMER_STATS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * @param xTimer The handle of the timer being updated.
+ */
+#if( configUSE_TIMER_STATS == 1 )
+	void vTimerResetStats( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTimerWriteStats( TimerHandle_t const *pxTimers,
+ *                        UBaseType_t uxTimerCount,
+ *                        TimerStatsWriteFunction_t pxWriteLine );
+ *
+ * Writes the statistics of uxTimerCount timers as lines of text, one call to
+ * pxWriteLine() per line, so they can be captured from a console or log and
+ * compared.  The kernel does not keep a list of timers, so the timers are
+ * passed in.  A report is written as:
+ *
+ * "TS S <timestamp>" - the start of the report.
+ * "TS T <handle> <callbacks> <max lateness> <max run time> <total run time> <name>"
+ * "TS L <handle> <lateness histogram buckets>"
+ * "TS R <handle> <run time histogram buckets>"
+ *     - for each timer.
+ * "TS E" - the end of the report.
+ *
+ * Each timer's statistics are copied in a critical section, and pxWriteLine()
+ * is called outside of it, so it may block.
+ *
+ * configUSE_TIMER_STATS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * @param pxTimers An array of the handles of the timers to report on.
+ *
+ * @param uxTimerCount The number of handles in pxTimers.
+ *
+ * @param pxWriteLine Called with each line of the report.
+ *
+ * Example usage:
+ * @verbatim
+ * static void prvWriteLine( const char *pcLine )
+ * {
+ *     printf( "%s\r\n", pcLine );
+ * }
+ *
+ * void vReportTimers( void )
+ * {
+ * TimerHandle_t xTimers[] = { xControlTimer, xLedTimer, xHousekeepingTimer };
+ *
+ *     vTimerWriteStats( xTimers, sizeof( xTimers ) / sizeof( xTimers[ 0 ] ), prvWriteLine );
+ * }
+ * @endverbatim
+ */
+#if( configUSE_TIMER_STATS == 1 )
+	void vTimerWriteStats( TimerHandle_t const * const pxTimers, const UBaseType_t uxTimerCount, TimerStatsWriteFunction_t pxWriteLine ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * TickType_t xTimerGetPeriod( TimerHandle_t xTimer );
  *
@@ -1288,12 +1450,74 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * UBaseType_t xTimerStartMultiple( TimerHandle_t const *pxTimers,
+ *                                  UBaseType_t uxTimerCount,
+ *                                  TickType_t xTicksToWait );
+ * UBaseType_t xTimerStopMultiple( TimerHandle_t const *pxTimers,
+ *                                 UBaseType_t uxTimerCount,
+ *                                 TickType_t xTicksToWait );
+ * UBaseType_t xTimerResetMultiple( TimerHandle_t const *pxTimers,
+ *                                  UBaseType_t uxTimerCount,
+ *                                  TickType_t xTicksToWait );
+ * UBaseType_t xTimerChangePeriodMultiple( TimerHandle_t const *pxTimers,
+ *                                         UBaseType_t uxTimerCount,
+ *                                         TickType_t xNewPeriod,
+ *                                         TickType_t xTicksToWait );
+ *
+ * Send the same command to each of an array of timers, as if xTimerStart(),
+ * xTimerStop(), xTimerReset() or xTimerChangePeriod() had been called for each
+ * timer in turn.  Start and reset commands use the same tick count for every
+ * timer, so timers started together expire together.  Must not be called from
+ * an interrupt service routine.
+ *
+ * If configUSE_TIMER_PENDING_COMMANDS is set to 1 in FreeRTOSConfig.h then the
+ * commands are recorded in the timers themselves rather than sent on the timer
+ * command queue, and the timer service task is sent at most one message however
+ * many timers there are.  The commands cannot then fail, and xTicksToWait is
+ * not used.  If a timer is given another command before the timer service task
+ * has processed the first then only the last command takes effect.
+ *
+ * @param pxTimers An array of the handles of the timers.
+ *
+ * @param uxTimerCount The number of handles in the pxTimers array.
+ *
+ * @param xNewPeriod The new period for every timer, in ticks.
+ *
+ * @param xTicksToWait As per the single timer functions, and applied to each
+ * command in turn.
+ *
+ * @return The number of timers the command was sent to.  This is uxTimerCount
+ * unless the timer command queue stayed full for xTicksToWait ticks.
+ *
+ * Example usage:
+ * @verbatim
+ * #define NUM_ALARMS 32
+ * TimerHandle_t xAlarms[ NUM_ALARMS ];
+ *
+ * void vArmAlarms( void )
+ * {
+ *     // Start all the alarms from the same tick, waking the timer service
+ *     // task once rather than NUM_ALARMS times.
+ *     if( xTimerStartMultiple( xAlarms, NUM_ALARMS, 0 ) != NUM_ALARMS )
+ *     {
+ *         // Not all the alarms could be started.
+ *     }
+ * }
+ * @endverbatim
+ */
+#define xTimerStartMultiple( pxTimers, uxTimerCount, xTicksToWait ) uxTimerGenericCommandMultiple( ( pxTimers ), ( uxTimerCount ), tmrCOMMAND_START, ( xTaskGetTickCount() ), ( xTicksToWait ) )
+#define xTimerStopMultiple( pxTimers, uxTimerCount, xTicksToWait ) uxTimerGenericCommandMultiple( ( pxTimers ), ( uxTimerCount ), tmrCOMMAND_STOP, 0U, ( xTicksToWait ) )
+#define xTimerResetMultiple( pxTimers, uxTimerCount, xTicksToWait ) uxTimerGenericCommandMultiple( ( pxTimers ), ( uxTimerCount ), tmrCOMMAND_RESET, ( xTaskGetTickCount() ), ( xTicksToWait ) )
+#define xTimerChangePeriodMultiple( pxTimers, uxTimerCount, xNewPeriod, xTicksToWait ) uxTimerGenericCommandMultiple( ( pxTimers ), ( uxTimerCount ), tmrCOMMAND_CHANGE_PERIOD, ( xNewPeriod ), ( xTicksToWait ) )
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
  */
 BaseType_t xTimerCreateTimerTask( void ) PRIVILEGED_FUNCTION;
 BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTimerGenericCommandMultiple( TimerHandle_t const * const pxTimers, const UBaseType_t uxTimerCount, const BaseType_t xCommandID, const TickType_t xOptionalValue, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
 #if( configUSE_TRACE_FACILITY == 1 )
 	void vTimerSetTimerNumber( TimerHandle_t xTimer, UBaseType_t uxTimerNumber ) PRIVILEGED_FUNCTION;
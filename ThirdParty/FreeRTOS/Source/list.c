@@ -27,9 +27,38 @@
 
 
 #include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* task.h declares taskDISABLE_INTERRUPTS(), which configASSERT() may use. */
 #include "FreeRTOS.h"
+#include "task.h"
 #include "list.h"
 
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+
+	/* The number of the most significant set bit in ulBitmap, which must not
+	be zero. */
+	#define listHIGHEST_SET_BIT( ulBitmap )	( ( UBaseType_t ) 31U - ( UBaseType_t ) portCOUNT_LEADING_ZEROS( ( ulBitmap ) ) )
+
+	/*
+	 * Returns the item after which pxNewListItem must be inserted into the
+	 * indexed list pxList to keep the list sorted, and records pxNewListItem
+	 * as the last item at its level.
+	 */
+	static ListItem_t * prvListIndexedInsertPosition( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_PRIORITY_INDEXED_EVENT_LISTS */
+
 /*-----------------------------------------------------------
  * PUBLIC LIST API documented in list.h
  *----------------------------------------------------------*/
@@ -52,6 +81,12 @@ void vListInitialise( List_t * const pxList )
 
 	pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
 
+	#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+	{
+		pxList->pxPriorityIndex = NULL;
+	}
+	#endif
+
 	/* Write known values into the list if
 	configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 	listSET_LIST_INTEGRITY_CHECK_1_VALUE( pxList );
@@ -71,6 +106,32 @@ void vListInitialiseItem( ListItem_t * const pxItem )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+
+	void vListInitialisePriorityIndex( List_t * const pxList, ListPriorityIndex_t * const pxPriorityIndex )
+	{
+	UBaseType_t ux;
+
+		/* The index can only be attached while the list is empty, otherwise it
+		would not describe the items already in the list. */
+		configASSERT( listLIST_IS_EMPTY( pxList ) != pdFALSE );
+
+		for( ux = ( UBaseType_t ) 0U; ux < listPRIORITY_INDEX_LEVELS; ux++ )
+		{
+			pxPriorityIndex->pxLevelTail[ ux ] = NULL;
+		}
+
+		for( ux = ( UBaseType_t ) 0U; ux < listPRIORITY_INDEX_MAP_WORDS; ux++ )
+		{
+			pxPriorityIndex->ulLevelMap[ ux ] = 0UL;
+		}
+
+		pxList->pxPriorityIndex = pxPriorityIndex;
+	}
+
+#endif /* configUSE_PRIORITY_INDEXED_EVENT_LISTS */
+/*-----------------------------------------------------------*/
+
 void vListInsertEnd( List_t * const pxList, ListItem_t * const pxNewListItem )
 {
 ListItem_t * const pxIndex = pxList->pxIndex;
@@ -81,6 +142,13 @@ ListItem_t * const pxIndex = pxList->pxIndex;
 	listTEST_LIST_INTEGRITY( pxList );
 	listTEST_LIST_ITEM_INTEGRITY( pxNewListItem );
 
+	#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+	{
+		/* Appending to an indexed list would break its sort order. */
+		configASSERT( pxList->pxPriorityIndex == NULL );
+	}
+	#endif
+
 	/* Insert a new list item into pxList, but rather than sort the list,
 	makes the new list item the last item to be removed by a call to
 	listGET_OWNER_OF_NEXT_ENTRY(). */
@@ -118,7 +186,15 @@ const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 	stored in ready lists (all of which have the same xItemValue value) get a
 	share of the CPU.  However, if the xItemValue is the same as the back marker
 	the iteration loop below will not end.  Therefore the value is checked
-	first, and the algorithm slightly modified if necessary. */
+	first, and the algorithm slightly modified if necessary.  Lists that carry
+	a priority index locate the insertion point without walking the list. */
+	#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+	if( pxList->pxPriorityIndex != NULL )
+	{
+		pxIterator = prvListIndexedInsertPosition( pxList, pxNewListItem );
+	}
+	else
+	#endif /* configUSE_PRIORITY_INDEXED_EVENT_LISTS */
 	if( xValueOfInsertion == portMAX_DELAY )
 	{
 		pxIterator = pxList->xListEnd.pxPrevious;
@@ -189,6 +265,33 @@ List_t * const pxList = pxItemToRemove->pxContainer;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
+	#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+	{
+	ListPriorityIndex_t * const pxPriorityIndex = pxList->pxPriorityIndex;
+	const TickType_t xLevel = pxItemToRemove->xItemValue;
+
+		/* If the item was the last at its level then the level either ends at
+		the previous item or is now empty.  The list end marker holds
+		portMAX_DELAY so never matches a level. */
+		if( ( pxPriorityIndex != NULL ) && ( pxPriorityIndex->pxLevelTail[ xLevel ] == pxItemToRemove ) )
+		{
+			if( pxItemToRemove->pxPrevious->xItemValue == xLevel )
+			{
+				pxPriorityIndex->pxLevelTail[ xLevel ] = pxItemToRemove->pxPrevious;
+			}
+			else
+			{
+				pxPriorityIndex->pxLevelTail[ xLevel ] = NULL;
+				pxPriorityIndex->ulLevelMap[ xLevel >> 5 ] &= ~( 1UL << ( xLevel & ( TickType_t ) 0x1f ) );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_PRIORITY_INDEXED_EVENT_LISTS */
+
 	pxItemToRemove->pxContainer = NULL;
 	( pxList->uxNumberOfItems )--;
 
@@ -196,3 +299,57 @@ List_t * const pxList = pxItemToRemove->pxContainer;
 }
 /*-----------------------------------------------------------*/
 
+
+#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+
+	static ListItem_t * prvListIndexedInsertPosition( List_t * const pxList, ListItem_t * const pxNewListItem )
+	{
+	ListPriorityIndex_t * const pxPriorityIndex = pxList->pxPriorityIndex;
+	const TickType_t xLevel = pxNewListItem->xItemValue;
+	ListItem_t *pxIterator;
+	UBaseType_t uxWord;
+	uint32_t ulLowerLevels;
+
+		configASSERT( xLevel < ( TickType_t ) listPRIORITY_INDEX_LEVELS );
+
+		pxIterator = pxPriorityIndex->pxLevelTail[ xLevel ];
+
+		if( pxIterator == NULL )
+		{
+			/* Nothing is held at this level yet, so the new item goes after
+			the last item of the nearest lower (higher priority) level that is
+			occupied, or at the head of the list if there is none. */
+			pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+			uxWord = ( UBaseType_t ) ( xLevel >> 5 );
+			ulLowerLevels = pxPriorityIndex->ulLevelMap[ uxWord ] & ( ( 1UL << ( xLevel & ( TickType_t ) 0x1f ) ) - 1UL );
+
+			for( ;; )
+			{
+				if( ulLowerLevels != 0UL )
+				{
+					pxIterator = pxPriorityIndex->pxLevelTail[ ( uxWord << 5 ) + listHIGHEST_SET_BIT( ulLowerLevels ) ];
+					break;
+				}
+
+				if( uxWord == ( UBaseType_t ) 0U )
+				{
+					break;
+				}
+
+				uxWord--;
+				ulLowerLevels = pxPriorityIndex->ulLevelMap[ uxWord ];
+			}
+
+			pxPriorityIndex->ulLevelMap[ xLevel >> 5 ] |= ( 1UL << ( xLevel & ( TickType_t ) 0x1f ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxPriorityIndex->pxLevelTail[ xLevel ] = pxNewListItem;
+
+		return pxIterator;
+	}
+
+#endif /* configUSE_PRIORITY_INDEXED_EVENT_LISTS */
@@ -0,0 +1,601 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "log_buffer.h"
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build log_buffer.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* Records are padded to a multiple of logRECORD_ALIGNMENT bytes so every
+record header is aligned. */
+#define logRECORD_ALIGNMENT			( ( uint32_t ) 8U )
+#define logRECORD_ALIGNMENT_MASK	( logRECORD_ALIGNMENT - ( uint32_t ) 1U )
+
+/* Set in the length of a record that only fills the end of the buffer, so the
+next record can start at the beginning of the buffer. */
+#define logRECORD_IS_PADDING		( ( uint32_t ) 0x80000000UL )
+
+/* Bits used in the ucFlags member of a log buffer. */
+#define logFLAGS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 1 )
+
+/* A writer publishes a record by storing its position plus one in the
+ulSequence member of the record's header.  The release store makes sure the
+reader cannot see the sequence number before it can see the record's length
+and data.  Where the compiler does not provide atomic builtins the core is
+assumed to be uniprocessor, where a compiler barrier is sufficient. */
+#if( atomicLOCK_FREE_32_BIT == 1 )
+	#define logSTORE_RELEASE( pulDestination, ulValue )	__atomic_store_n( ( pulDestination ), ( ulValue ), __ATOMIC_RELEASE )
+	#define logLOAD_ACQUIRE( pulSource )					__atomic_load_n( ( pulSource ), __ATOMIC_ACQUIRE )
+#else
+	#define logSTORE_RELEASE( pulDestination, ulValue )	{ portMEMORY_BARRIER(); *( pulDestination ) = ( ulValue ); }
+	#define logLOAD_ACQUIRE( pulSource )					prvLoadAcquire( pulSource )
+#endif
+
+/* If the reading task is blocked waiting for a record then unblock it.  The
+reader is only notified when it is waiting, so writers that find no task
+waiting do not touch the scheduler. */
+#ifndef logSEND_COMPLETED
+	#define logSEND_COMPLETED( pxLogBuffer )												\
+		if( ( pxLogBuffer )->xTaskWaitingToReceive != NULL )								\
+		{																					\
+			vTaskSuspendAll();																\
+			{																				\
+				if( ( pxLogBuffer )->xTaskWaitingToReceive != NULL )						\
+				{																			\
+					( void ) xTaskNotify( ( pxLogBuffer )->xTaskWaitingToReceive,			\
+										  ( uint32_t ) 0,									\
+										  eNoAction );										\
+					( pxLogBuffer )->xTaskWaitingToReceive = NULL;							\
+				}																			\
+			}																				\
+			( void ) xTaskResumeAll();														\
+		}
+#endif /* logSEND_COMPLETED */
+
+#ifndef logSEND_COMPLETED_FROM_ISR
+	#define logSEND_COMPLETED_FROM_ISR( pxLogBuffer, pxHigherPriorityTaskWoken )			\
+		if( ( pxLogBuffer )->xTaskWaitingToReceive != NULL )								\
+		{																					\
+		UBaseType_t uxSavedInterruptStatus;													\
+																							\
+			uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();		\
+			{																				\
+				if( ( pxLogBuffer )->xTaskWaitingToReceive != NULL )						\
+				{																			\
+					( void ) xTaskNotifyFromISR( ( pxLogBuffer )->xTaskWaitingToReceive,	\
+												 ( uint32_t ) 0,							\
+												 eNoAction,									\
+												 pxHigherPriorityTaskWoken );				\
+					( pxLogBuffer )->xTaskWaitingToReceive = NULL;							\
+				}																			\
+			}																				\
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );					\
+		}
+#endif /* logSEND_COMPLETED_FROM_ISR */
+
+/*-----------------------------------------------------------*/
+
+/* Each record in the buffer starts with this header. */
+typedef struct LogRecordHeader_t
+{
+	uint32_t ulLength;				/* Length of the record's data, or logRECORD_IS_PADDING plus the length of the padding. */
+	uint32_t ulSequence;			/* Position of the record plus one once the record has been published. */
+} LogRecordHeader_t;
+
+/* Structure that hold state information on the buffer.  ulReserveHead and
+ulTail are free running byte counts - the offset into the buffer is obtained by
+masking them with ulMask. */
+typedef struct LogBufferDef_t /*lint !e9058 Style convention uses tag. */
+{
+	volatile uint32_t ulReserveHead;				/* Position at which the next record will be written.  Advanced by writers using compare-and-swap. */
+	volatile uint32_t ulTail;						/* Position of the next record to read.  Only written by the reader. */
+	uint32_t ulMask;								/* The size of the buffer minus one. */
+	uint8_t *pucBuffer;								/* Points to the buffer itself. */
+	volatile TaskHandle_t xTaskWaitingToReceive;	/* Holds the handle of the reading task if it is blocked waiting for a record. */
+	volatile uint32_t ulDroppedCount;				/* Number of records that did not fit. */
+	uint8_t ucFlags;
+} LogBuffer_t;
+
+/*
+ * Called by both the task and interrupt versions of the send function to
+ * reserve space for a record, copy it in, and publish it.  Returns
+ * xDataLengthBytes, or 0 if the record was dropped.
+ */
+static size_t prvWriteRecordToBuffer( LogBuffer_t * const pxLogBuffer,
+									  const void * pvTxData,
+									  size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the header of the next published record, releasing any padding
+ * that precedes it, or NULL if the next record has not been published yet.
+ */
+static LogRecordHeader_t *prvGetNextRecord( LogBuffer_t * const pxLogBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clears the ulSpaceBytes bytes at the tail of the buffer then moves the tail
+ * past them so writers can reuse the space.
+ */
+static void prvReleaseSpace( LogBuffer_t * const pxLogBuffer,
+							 uint32_t ulSpaceBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both xLogBufferCreate() and xLogBufferCreateStatic() to
+ * initialise the members of the newly created log buffer structure.
+ */
+static void prvInitialiseNewLogBuffer( LogBuffer_t * const pxLogBuffer,
+									   uint8_t * const pucBuffer,
+									   size_t xBufferSizeBytes,
+									   uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+#if( atomicLOCK_FREE_32_BIT == 0 )
+	static portFORCE_INLINE uint32_t prvLoadAcquire( const volatile uint32_t *pulSource )
+	{
+	uint32_t ulValue;
+
+		ulValue = *pulSource;
+		portMEMORY_BARRIER();
+
+		return ulValue;
+	}
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	LogBufferHandle_t xLogBufferCreate( size_t xBufferSizeBytes )
+	{
+	uint8_t *pucAllocatedMemory;
+
+		/* The buffer size must be a power of two so the free running head and
+		tail positions wrap cleanly, and large enough for a record. */
+		configASSERT( xBufferSizeBytes >= ( size_t ) ( 2U * logRECORD_ALIGNMENT ) );
+		configASSERT( ( xBufferSizeBytes & ( xBufferSizeBytes - ( size_t ) 1 ) ) == ( size_t ) 0 );
+
+		/* The LogBuffer_t structure is placed at the start of the allocated
+		memory and the buffer follows immediately after. */
+		pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( xBufferSizeBytes + sizeof( LogBuffer_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pucAllocatedMemory != NULL )
+		{
+			prvInitialiseNewLogBuffer( ( LogBuffer_t * ) pucAllocatedMemory, /* Structure at the start of the allocated memory. */ /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+									   pucAllocatedMemory + sizeof( LogBuffer_t ),  /* Storage area follows. */
+									   xBufferSizeBytes,
+									   ( uint8_t ) 0 );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ( LogBufferHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	LogBufferHandle_t xLogBufferCreateStatic( size_t xBufferSizeBytes,
+											  uint8_t * const pucLogBufferStorageArea,
+											  StaticLogBuffer_t * const pxStaticLogBuffer )
+	{
+	LogBuffer_t * const pxLogBuffer = ( LogBuffer_t * ) pxStaticLogBuffer; /*lint !e740 !e9087 Safe cast as StaticLogBuffer_t is opaque LogBuffer_t. */
+	LogBufferHandle_t xReturn;
+
+		configASSERT( pucLogBufferStorageArea );
+		configASSERT( pxStaticLogBuffer );
+		configASSERT( xBufferSizeBytes >= ( size_t ) ( 2U * logRECORD_ALIGNMENT ) );
+		configASSERT( ( xBufferSizeBytes & ( xBufferSizeBytes - ( size_t ) 1 ) ) == ( size_t ) 0 );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticLogBuffer_t equals the size of the real log
+			buffer structure. */
+			volatile size_t xSize = sizeof( StaticLogBuffer_t );
+			configASSERT( xSize == sizeof( LogBuffer_t ) );
+		} /*lint !e529 xSize is referenced is configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		if( ( pucLogBufferStorageArea != NULL ) && ( pxStaticLogBuffer != NULL ) )
+		{
+			prvInitialiseNewLogBuffer( pxLogBuffer,
+									   pucLogBufferStorageArea,
+									   xBufferSizeBytes,
+									   logFLAGS_IS_STATICALLY_ALLOCATED );
+
+			xReturn = ( LogBufferHandle_t ) pxStaticLogBuffer; /*lint !e9087 Data hiding requires cast to opaque type. */
+		}
+		else
+		{
+			xReturn = NULL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vLogBufferDelete( LogBufferHandle_t xLogBuffer )
+{
+LogBuffer_t * pxLogBuffer = xLogBuffer;
+
+	configASSERT( pxLogBuffer );
+
+	if( ( pxLogBuffer->ucFlags & logFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			/* Both the structure and the buffer were allocated using a single call
+			to pvPortMalloc(), hence only one call to vPortFree() is required. */
+			vPortFree( ( void * ) pxLogBuffer ); /*lint !e9087 Standard free() semantics require void *, plus pxLogBuffer was allocated by pvPortMalloc(). */
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucFlags must be corrupt.
+			Force an assert. */
+			configASSERT( xLogBuffer == ( LogBufferHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* The structure and buffer were not allocated dynamically and cannot be
+		freed - just scrub the structure so future use will assert. */
+		( void ) memset( pxLogBuffer, 0x00, sizeof( LogBuffer_t ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xLogBufferSend( LogBufferHandle_t xLogBuffer,
+					   const void *pvTxData,
+					   size_t xDataLengthBytes )
+{
+LogBuffer_t * const pxLogBuffer = xLogBuffer;
+size_t xReturn;
+
+	configASSERT( pvTxData );
+	configASSERT( pxLogBuffer );
+
+	xReturn = prvWriteRecordToBuffer( pxLogBuffer, pvTxData, xDataLengthBytes );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		logSEND_COMPLETED( pxLogBuffer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xLogBufferSendFromISR( LogBufferHandle_t xLogBuffer,
+							  const void *pvTxData,
+							  size_t xDataLengthBytes,
+							  BaseType_t * const pxHigherPriorityTaskWoken )
+{
+LogBuffer_t * const pxLogBuffer = xLogBuffer;
+size_t xReturn;
+
+	configASSERT( pvTxData );
+	configASSERT( pxLogBuffer );
+
+	xReturn = prvWriteRecordToBuffer( pxLogBuffer, pvTxData, xDataLengthBytes );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		logSEND_COMPLETED_FROM_ISR( pxLogBuffer, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteRecordToBuffer( LogBuffer_t * const pxLogBuffer,
+									  const void * pvTxData,
+									  size_t xDataLengthBytes )
+{
+uint32_t ulHead, ulTail, ulOffset, ulPaddingBytes, ulRecordBytes;
+const uint32_t ulBufferSize = pxLogBuffer->ulMask + ( uint32_t ) 1;
+LogRecordHeader_t *pxHeader;
+size_t xReturn = 0;
+
+	configASSERT( xDataLengthBytes > ( size_t ) 0 );
+
+	if( xDataLengthBytes <= ( size_t ) ( ulBufferSize - ( uint32_t ) sizeof( LogRecordHeader_t ) ) )
+	{
+		ulRecordBytes = ( ( uint32_t ) xDataLengthBytes + logRECORD_ALIGNMENT_MASK ) & ~logRECORD_ALIGNMENT_MASK;
+		ulRecordBytes += ( uint32_t ) sizeof( LogRecordHeader_t );
+
+		/* Claim space for the record by advancing the head.  If another task
+		or interrupt claims space between the head being read and updated the
+		compare-and-swap fails and the space is recalculated.  The tail is
+		read before the head, so the tail read is never ahead of the head
+		read. */
+		do
+		{
+			ulTail = logLOAD_ACQUIRE( &( pxLogBuffer->ulTail ) );
+			ulHead = pxLogBuffer->ulReserveHead;
+			ulOffset = ulHead & pxLogBuffer->ulMask;
+
+			/* A record never wraps, so if it does not fit before the end of
+			the buffer the end of the buffer is skipped. */
+			if( ( ulOffset + ulRecordBytes ) > ulBufferSize )
+			{
+				ulPaddingBytes = ulBufferSize - ulOffset;
+			}
+			else
+			{
+				ulPaddingBytes = 0;
+			}
+
+			if( ( ( ulHead - ulTail ) + ulPaddingBytes + ulRecordBytes ) > ulBufferSize )
+			{
+				break;
+			}
+
+			if( Atomic_CompareAndSwap_u32( &( pxLogBuffer->ulReserveHead ), ulHead + ulPaddingBytes + ulRecordBytes, ulHead ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+			{
+				xReturn = xDataLengthBytes;
+				break;
+			}
+		} while( xReturn == ( size_t ) 0 );
+	}
+
+	if( xReturn != ( size_t ) 0 )
+	{
+		/* The space between ulHead and ulHead + ulPaddingBytes +
+		ulRecordBytes is now owned by this writer. */
+		if( ulPaddingBytes != ( uint32_t ) 0 )
+		{
+			pxHeader = ( LogRecordHeader_t * ) &( pxLogBuffer->pucBuffer[ ulOffset ] ); /*lint !e9087 !e826 Record positions are aligned. */
+			pxHeader->ulLength = logRECORD_IS_PADDING | ulPaddingBytes;
+			logSTORE_RELEASE( &( pxHeader->ulSequence ), ulHead + ( uint32_t ) 1 );
+
+			ulHead += ulPaddingBytes;
+			ulOffset = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxHeader = ( LogRecordHeader_t * ) &( pxLogBuffer->pucBuffer[ ulOffset ] ); /*lint !e9087 !e826 Record positions are aligned. */
+		pxHeader->ulLength = ( uint32_t ) xDataLengthBytes;
+		( void ) memcpy( ( void * ) &( pxHeader[ 1 ] ), pvTxData, xDataLengthBytes ); /*lint !e9087 The header is followed by the record data. */
+		logSTORE_RELEASE( &( pxHeader->ulSequence ), ulHead + ( uint32_t ) 1 );
+	}
+	else
+	{
+		( void ) Atomic_Increment_u32( &( pxLogBuffer->ulDroppedCount ) );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xLogBufferReceive( LogBufferHandle_t xLogBuffer,
+						  void *pvRxData,
+						  size_t xBufferLengthBytes,
+						  TickType_t xTicksToWait )
+{
+LogBuffer_t * const pxLogBuffer = xLogBuffer;
+LogRecordHeader_t *pxHeader;
+size_t xReceivedLength = 0;
+
+	configASSERT( pvRxData );
+	configASSERT( pxLogBuffer );
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		/* Checking for a record and clearing the notification state must be
+		performed atomically. */
+		taskENTER_CRITICAL();
+		{
+			pxHeader = prvGetNextRecord( pxLogBuffer );
+
+			if( pxHeader == NULL )
+			{
+				/* Clear notification state as going to wait for a record. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Should only be one reader. */
+				configASSERT( pxLogBuffer->xTaskWaitingToReceive == NULL );
+				pxLogBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( pxHeader == NULL )
+		{
+			/* Wait for a record to be published. */
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+			pxLogBuffer->xTaskWaitingToReceive = NULL;
+
+			/* Recheck after blocking.  A writer that claimed space earlier
+			may still be writing its record, in which case nothing is read. */
+			pxHeader = prvGetNextRecord( pxLogBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		pxHeader = prvGetNextRecord( pxLogBuffer );
+	}
+
+	if( pxHeader != NULL )
+	{
+		/* A record that does not fit in the caller's buffer is left in the
+		log buffer so the caller can retry with a larger buffer. */
+		if( ( size_t ) pxHeader->ulLength <= xBufferLengthBytes )
+		{
+			xReceivedLength = ( size_t ) pxHeader->ulLength;
+			( void ) memcpy( pvRxData, ( const void * ) &( pxHeader[ 1 ] ), xReceivedLength ); /*lint !e9087 The header is followed by the record data. */
+
+			prvReleaseSpace( pxLogBuffer, ( ( pxHeader->ulLength + logRECORD_ALIGNMENT_MASK ) & ~logRECORD_ALIGNMENT_MASK ) + ( uint32_t ) sizeof( LogRecordHeader_t ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+size_t xLogBufferNextLengthBytes( LogBufferHandle_t xLogBuffer )
+{
+LogBuffer_t * const pxLogBuffer = xLogBuffer;
+LogRecordHeader_t *pxHeader;
+size_t xReturn;
+
+	configASSERT( pxLogBuffer );
+
+	pxHeader = prvGetNextRecord( pxLogBuffer );
+
+	if( pxHeader != NULL )
+	{
+		xReturn = ( size_t ) pxHeader->ulLength;
+	}
+	else
+	{
+		xReturn = 0;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxLogBufferGetDroppedCount( LogBufferHandle_t xLogBuffer )
+{
+const LogBuffer_t * const pxLogBuffer = xLogBuffer;
+
+	configASSERT( pxLogBuffer );
+
+	return ( UBaseType_t ) pxLogBuffer->ulDroppedCount;
+}
+/*-----------------------------------------------------------*/
+
+static LogRecordHeader_t *prvGetNextRecord( LogBuffer_t * const pxLogBuffer )
+{
+LogRecordHeader_t *pxHeader;
+uint32_t ulTail;
+
+	for( ;; )
+	{
+		/* Only the reader moves the tail, so it can be read directly. */
+		ulTail = pxLogBuffer->ulTail;
+		pxHeader = ( LogRecordHeader_t * ) &( pxLogBuffer->pucBuffer[ ulTail & pxLogBuffer->ulMask ] ); /*lint !e9087 !e826 Record positions are aligned. */
+
+		if( logLOAD_ACQUIRE( &( pxHeader->ulSequence ) ) != ( ulTail + ( uint32_t ) 1 ) )
+		{
+			/* Either the buffer is empty or the record at the tail has been
+			claimed but not yet published. */
+			pxHeader = NULL;
+			break;
+		}
+		else if( ( pxHeader->ulLength & logRECORD_IS_PADDING ) != ( uint32_t ) 0 )
+		{
+			prvReleaseSpace( pxLogBuffer, pxHeader->ulLength & ~logRECORD_IS_PADDING );
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	return pxHeader;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseSpace( LogBuffer_t * const pxLogBuffer,
+							 uint32_t ulSpaceBytes )
+{
+uint32_t ulTail = pxLogBuffer->ulTail;
+
+	/* Clear the space so that stale headers and data are never mistaken for
+	a published record once the positions have wrapped round.  Published
+	sequence numbers are always odd, so can never be zero. */
+	( void ) memset( ( void * ) &( pxLogBuffer->pucBuffer[ ulTail & pxLogBuffer->ulMask ] ), 0x00, ( size_t ) ulSpaceBytes );
+	logSTORE_RELEASE( &( pxLogBuffer->ulTail ), ulTail + ulSpaceBytes );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewLogBuffer( LogBuffer_t * const pxLogBuffer,
+									   uint8_t * const pucBuffer,
+									   size_t xBufferSizeBytes,
+									   uint8_t ucFlags )
+{
+	/* Record headers are accessed as uint32_t. */
+	configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucBuffer ) & ( portPOINTER_SIZE_TYPE ) ( sizeof( uint32_t ) - 1U ) ) == 0UL ); /*lint !e923 Pointer to integer for alignment check. */
+
+	( void ) memset( ( void * ) pxLogBuffer, 0x00, sizeof( LogBuffer_t ) );
+	( void ) memset( ( void * ) pucBuffer, 0x00, xBufferSizeBytes );
+	pxLogBuffer->pucBuffer = pucBuffer;
+	pxLogBuffer->ulMask = ( uint32_t ) xBufferSizeBytes - ( uint32_t ) 1;
+	pxLogBuffer->ucFlags = ucFlags;
+}
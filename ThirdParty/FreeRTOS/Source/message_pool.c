@@ -0,0 +1,517 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "message_pool.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* Message pools allocate the pool and its semaphore from the heap. */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+/* Owners are only tracked when configASSERT() is defined, as the only use of
+the information is to assert when a message is used by something that does not
+own it. */
+#if( ( configASSERT_DEFINED == 1 ) && ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) )
+	#define msgpoolTRACK_OWNERS		1
+#else
+	#define msgpoolTRACK_OWNERS		0
+#endif
+
+/* Values recorded as the owner of a message that is not owned by a task. */
+#define msgpoolOWNER_FREE			( ( void * ) 0 )	/* In the pool. */
+#define msgpoolOWNER_QUEUED			( ( void * ) 1 )	/* In a queue, waiting to be received. */
+#define msgpoolOWNER_ISR			( ( void * ) 2 )	/* Allocated or released by an interrupt. */
+
+#if( msgpoolTRACK_OWNERS == 1 )
+	#define msgpoolCHANGE_OWNER( pxMessagePool, pvMessage, pvFrom, pvTo ) prvChangeOwner( ( pxMessagePool ), ( pvMessage ), ( pvFrom ), ( pvTo ) )
+	#define msgpoolCURRENT_TASK() ( ( void * ) xTaskGetCurrentTaskHandle() )
+#else
+	#define msgpoolCHANGE_OWNER( pxMessagePool, pvMessage, pvFrom, pvTo )
+#endif
+
+/* The size of a structure rounded up so the array that follows it is
+aligned. */
+#define msgpoolALIGNED_SIZE( xSize ) ( ( ( xSize ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* Structure that holds the state of a message pool.  The structure, the owner
+of each message (in debug builds) and the messages themselves are allocated in
+one block, in that order.  Free messages are kept on a list threaded through
+their first word, so allocating and releasing a message only takes a short
+critical section.  The semaphore is only used when a task has to wait for a
+message to be released. */
+typedef struct MessagePoolDef_t /*lint !e9058 Style convention uses tag. */
+{
+	uint8_t *pucMessages;					/* The first message in the pool. */
+	size_t xMessageSize;					/* The size of each message, rounded up to keep messages aligned. */
+	UBaseType_t uxMessageCount;				/* The number of messages in the pool. */
+	void *pvFreeList;						/* The most recently released message. */
+	volatile UBaseType_t uxFreeCount;		/* The number of messages on the free list. */
+	UBaseType_t uxTasksWaiting;				/* The number of tasks blocked in pvMessagePoolAllocate(). */
+	SemaphoreHandle_t xMessageReleased;		/* Given when a message is released while a task is waiting. */
+
+	#if( msgpoolTRACK_OWNERS == 1 )
+		void * volatile *ppvOwners;	/* The owner of each message - a task handle or one of the msgpoolOWNER_ values. */
+	#endif
+} MessagePool_t;
+
+/*
+ * Take a message from, and return a message to, the free list.  Must be
+ * called from a critical section.
+ */
+static void *prvPopFreeMessage( MessagePool_t * const pxMessagePool ) PRIVILEGED_FUNCTION;
+static BaseType_t prvPushFreeMessage( MessagePool_t * const pxMessagePool, void * const pvMessage ) PRIVILEGED_FUNCTION;
+
+#if( msgpoolTRACK_OWNERS == 1 )
+	/*
+	 * Asserts that pvMessage is a message from pxMessagePool owned by pvFrom,
+	 * then records pvTo as its owner.
+	 */
+	static void prvChangeOwner( MessagePool_t * const pxMessagePool,
+								const void * const pvMessage,
+								void * const pvFrom,
+								void * const pvTo ) PRIVILEGED_FUNCTION;
+#endif
+
+/*-----------------------------------------------------------*/
+
+MessagePoolHandle_t xMessagePoolCreate( UBaseType_t uxMessageCount, size_t xMessageSize )
+{
+MessagePool_t *pxMessagePool;
+size_t xHeaderSize;
+UBaseType_t ux;
+
+	configASSERT( uxMessageCount > ( UBaseType_t ) 0 );
+	configASSERT( xMessageSize > ( size_t ) 0 );
+
+	/* Free messages hold the free list pointer. */
+	xMessageSize = msgpoolALIGNED_SIZE( configMAX( xMessageSize, sizeof( void * ) ) );
+	xHeaderSize = msgpoolALIGNED_SIZE( sizeof( MessagePool_t ) );
+
+	#if( msgpoolTRACK_OWNERS == 1 )
+	{
+		xHeaderSize = msgpoolALIGNED_SIZE( xHeaderSize + ( ( size_t ) uxMessageCount * sizeof( void * ) ) );
+	}
+	#endif
+
+	pxMessagePool = ( MessagePool_t * ) pvPortMalloc( xHeaderSize + ( ( size_t ) uxMessageCount * xMessageSize ) ); /*lint !e9087 !e9079 pvPortMalloc() only returns void*. */
+
+	if( pxMessagePool != NULL )
+	{
+		pxMessagePool->pucMessages = ( ( uint8_t * ) pxMessagePool ) + xHeaderSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+		pxMessagePool->xMessageSize = xMessageSize;
+		pxMessagePool->uxMessageCount = uxMessageCount;
+		pxMessagePool->pvFreeList = NULL;
+		pxMessagePool->uxFreeCount = 0;
+		pxMessagePool->uxTasksWaiting = 0;
+		pxMessagePool->xMessageReleased = xSemaphoreCreateCounting( uxMessageCount, 0 );
+
+		if( pxMessagePool->xMessageReleased != NULL )
+		{
+			#if( msgpoolTRACK_OWNERS == 1 )
+			{
+				pxMessagePool->ppvOwners = ( void * volatile * ) ( ( ( uint8_t * ) pxMessagePool ) + msgpoolALIGNED_SIZE( sizeof( MessagePool_t ) ) ); /*lint !e9087 !e826 Safe cast as memory is aligned. */
+			}
+			#endif
+
+			/* Put every message on the free list, last message first so the
+			first allocation returns the first message. */
+			for( ux = uxMessageCount; ux > ( UBaseType_t ) 0; ux-- )
+			{
+				( void ) prvPushFreeMessage( pxMessagePool, pxMessagePool->pucMessages + ( ( size_t ) ( ux - ( UBaseType_t ) 1 ) * xMessageSize ) );
+
+				#if( msgpoolTRACK_OWNERS == 1 )
+				{
+					pxMessagePool->ppvOwners[ ux - ( UBaseType_t ) 1 ] = msgpoolOWNER_FREE;
+				}
+				#endif
+			}
+		}
+		else
+		{
+			vPortFree( pxMessagePool );
+			pxMessagePool = NULL;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxMessagePool;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMessagePoolAllocate( MessagePoolHandle_t xMessagePool, TickType_t xTicksToWait )
+{
+MessagePool_t * const pxMessagePool = xMessagePool;
+void *pvMessage;
+TimeOut_t xTimeOut;
+BaseType_t xEntryTimeSet = pdFALSE;
+
+	configASSERT( pxMessagePool );
+
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			pvMessage = prvPopFreeMessage( pxMessagePool );
+
+			if( ( pvMessage == NULL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+			{
+				/* Registering as a waiter inside the critical section means a
+				message released after this point gives the semaphore, so the
+				take below cannot miss it. */
+				( pxMessagePool->uxTasksWaiting )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( pvMessage != NULL ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+		else if( xEntryTimeSet == pdFALSE )
+		{
+			vTaskSetTimeOutState( &xTimeOut );
+			xEntryTimeSet = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		( void ) xSemaphoreTake( pxMessagePool->xMessageReleased, xTicksToWait );
+
+		taskENTER_CRITICAL();
+		{
+			( pxMessagePool->uxTasksWaiting )--;
+		}
+		taskEXIT_CRITICAL();
+
+		/* Another task may have taken the released message first, so try
+		again - without blocking if the block time has expired. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			xTicksToWait = ( TickType_t ) 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	if( pvMessage != NULL )
+	{
+		msgpoolCHANGE_OWNER( pxMessagePool, pvMessage, msgpoolOWNER_FREE, msgpoolCURRENT_TASK() );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvMessage;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMessagePoolAllocateFromISR( MessagePoolHandle_t xMessagePool )
+{
+MessagePool_t * const pxMessagePool = xMessagePool;
+void *pvMessage;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxMessagePool );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pvMessage = prvPopFreeMessage( pxMessagePool );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( pvMessage != NULL )
+	{
+		msgpoolCHANGE_OWNER( pxMessagePool, pvMessage, msgpoolOWNER_FREE, msgpoolOWNER_ISR );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvMessage;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMessagePoolSend( MessagePoolHandle_t xMessagePool,
+							 QueueHandle_t xQueue,
+							 void *pvMessage,
+							 TickType_t xTicksToWait )
+{
+MessagePool_t * const pxMessagePool = xMessagePool;
+BaseType_t xReturn;
+
+	configASSERT( pxMessagePool );
+	configASSERT( xQueue );
+
+	/* Ownership is given up before the message is sent, as the receiving task
+	may run before xQueueSendToBack() returns. */
+	msgpoolCHANGE_OWNER( pxMessagePool, pvMessage, msgpoolCURRENT_TASK(), msgpoolOWNER_QUEUED );
+
+	xReturn = xQueueSendToBack( xQueue, &pvMessage, xTicksToWait );
+
+	if( xReturn != pdPASS )
+	{
+		/* The message was not sent so still belongs to the caller. */
+		msgpoolCHANGE_OWNER( pxMessagePool, pvMessage, msgpoolOWNER_QUEUED, msgpoolCURRENT_TASK() );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Prevent compiler warnings when configASSERT() is not defined. */
+	( void ) pxMessagePool;
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMessagePoolSendFromISR( MessagePoolHandle_t xMessagePool,
+									QueueHandle_t xQueue,
+									void *pvMessage,
+									BaseType_t * const pxHigherPriorityTaskWoken )
+{
+MessagePool_t * const pxMessagePool = xMessagePool;
+BaseType_t xReturn;
+
+	configASSERT( pxMessagePool );
+	configASSERT( xQueue );
+
+	msgpoolCHANGE_OWNER( pxMessagePool, pvMessage, msgpoolOWNER_ISR, msgpoolOWNER_QUEUED );
+
+	xReturn = xQueueSendToBackFromISR( xQueue, &pvMessage, pxHigherPriorityTaskWoken );
+
+	if( xReturn != pdPASS )
+	{
+		msgpoolCHANGE_OWNER( pxMessagePool, pvMessage, msgpoolOWNER_QUEUED, msgpoolOWNER_ISR );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Prevent compiler warnings when configASSERT() is not defined. */
+	( void ) pxMessagePool;
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMessagePoolReceive( MessagePoolHandle_t xMessagePool,
+							QueueHandle_t xQueue,
+							TickType_t xTicksToWait )
+{
+MessagePool_t * const pxMessagePool = xMessagePool;
+void *pvMessage = NULL;
+
+	configASSERT( pxMessagePool );
+	configASSERT( xQueue );
+
+	if( xQueueReceive( xQueue, &pvMessage, xTicksToWait ) == pdPASS )
+	{
+		msgpoolCHANGE_OWNER( pxMessagePool, pvMessage, msgpoolOWNER_QUEUED, msgpoolCURRENT_TASK() );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Prevent compiler warnings when configASSERT() is not defined. */
+	( void ) pxMessagePool;
+
+	return pvMessage;
+}
+/*-----------------------------------------------------------*/
+
+void vMessagePoolRelease( MessagePoolHandle_t xMessagePool, void *pvMessage )
+{
+MessagePool_t * const pxMessagePool = xMessagePool;
+BaseType_t xTaskWaiting;
+
+	configASSERT( pxMessagePool );
+	configASSERT( pvMessage );
+
+	msgpoolCHANGE_OWNER( pxMessagePool, pvMessage, msgpoolCURRENT_TASK(), msgpoolOWNER_FREE );
+
+	taskENTER_CRITICAL();
+	{
+		xTaskWaiting = prvPushFreeMessage( pxMessagePool, pvMessage );
+	}
+	taskEXIT_CRITICAL();
+
+	if( xTaskWaiting != pdFALSE )
+	{
+		( void ) xSemaphoreGive( pxMessagePool->xMessageReleased );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vMessagePoolReleaseFromISR( MessagePoolHandle_t xMessagePool,
+								 void *pvMessage,
+								 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+MessagePool_t * const pxMessagePool = xMessagePool;
+BaseType_t xTaskWaiting;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxMessagePool );
+	configASSERT( pvMessage );
+
+	msgpoolCHANGE_OWNER( pxMessagePool, pvMessage, msgpoolOWNER_ISR, msgpoolOWNER_FREE );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		xTaskWaiting = prvPushFreeMessage( pxMessagePool, pvMessage );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( xTaskWaiting != pdFALSE )
+	{
+		( void ) xSemaphoreGiveFromISR( pxMessagePool->xMessageReleased, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMessagePoolGetFreeCount( MessagePoolHandle_t xMessagePool )
+{
+	configASSERT( xMessagePool );
+
+	return xMessagePool->uxFreeCount;
+}
+/*-----------------------------------------------------------*/
+
+void vMessagePoolDelete( MessagePoolHandle_t xMessagePool )
+{
+MessagePool_t * const pxMessagePool = xMessagePool;
+
+	configASSERT( pxMessagePool );
+
+	/* Messages that are still in use would point into freed memory. */
+	configASSERT( pxMessagePool->uxFreeCount == pxMessagePool->uxMessageCount );
+	configASSERT( pxMessagePool->uxTasksWaiting == ( UBaseType_t ) 0 );
+
+	vSemaphoreDelete( pxMessagePool->xMessageReleased );
+	vPortFree( pxMessagePool );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvPopFreeMessage( MessagePool_t * const pxMessagePool )
+{
+void *pvMessage = pxMessagePool->pvFreeList;
+
+	if( pvMessage != NULL )
+	{
+		pxMessagePool->pvFreeList = *( ( void ** ) pvMessage );
+		( pxMessagePool->uxFreeCount )--;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvMessage;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPushFreeMessage( MessagePool_t * const pxMessagePool, void * const pvMessage )
+{
+	*( ( void ** ) pvMessage ) = pxMessagePool->pvFreeList;
+	pxMessagePool->pvFreeList = pvMessage;
+	( pxMessagePool->uxFreeCount )++;
+
+	/* Return pdTRUE if a task is waiting for the message. */
+	return ( pxMessagePool->uxTasksWaiting > ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+#if( msgpoolTRACK_OWNERS == 1 )
+
+	static void prvChangeOwner( MessagePool_t * const pxMessagePool,
+								const void * const pvMessage,
+								void * const pvFrom,
+								void * const pvTo )
+	{
+	const uint8_t * const pucMessage = ( const uint8_t * ) pvMessage;
+	size_t xIndex;
+
+		/* The message must be the start of a message in this pool. */
+		configASSERT( pucMessage >= pxMessagePool->pucMessages );
+		xIndex = ( size_t ) ( pucMessage - pxMessagePool->pucMessages ) / pxMessagePool->xMessageSize; /*lint !e946 !e947 Pointer subtraction within the pool. */
+		configASSERT( xIndex < ( size_t ) pxMessagePool->uxMessageCount );
+		configASSERT( ( ( size_t ) ( pucMessage - pxMessagePool->pucMessages ) % pxMessagePool->xMessageSize ) == ( size_t ) 0 );
+
+		/* Catches messages released twice, sent or released by a task that
+		does not own them, and messages received from a queue they were never
+		sent to. */
+		configASSERT( pxMessagePool->ppvOwners[ xIndex ] == pvFrom );
+		pxMessagePool->ppvOwners[ xIndex ] = pvTo;
+	}
+
+#endif /* msgpoolTRACK_OWNERS */
+/*-----------------------------------------------------------*/
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION == 1 */
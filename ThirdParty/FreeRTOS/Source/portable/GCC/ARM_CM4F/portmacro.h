@@ -124,16 +124,19 @@ not necessary for to use this port.  They are defined so the common demo files
 	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
 #endif
 
-#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+/* Generic helper function.  Also used by the kernel bitmaps that are not tied
+to configUSE_PORT_OPTIMISED_TASK_SELECTION. */
+__attribute__( ( always_inline ) ) static inline uint8_t ucPortCountLeadingZeros( uint32_t ulBitmap )
+{
+uint8_t ucReturn;
 
-	/* Generic helper function. */
-	__attribute__( ( always_inline ) ) static inline uint8_t ucPortCountLeadingZeros( uint32_t ulBitmap )
-	{
-	uint8_t ucReturn;
+	__asm volatile ( "clz %0, %1" : "=r" ( ucReturn ) : "r" ( ulBitmap ) : "memory" );
+	return ucReturn;
+}
 
-		__asm volatile ( "clz %0, %1" : "=r" ( ucReturn ) : "r" ( ulBitmap ) : "memory" );
-		return ucReturn;
-	}
+#define portCOUNT_LEADING_ZEROS( ulBitmap ) ucPortCountLeadingZeros( ( ulBitmap ) )
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
 
 	/* Check the configuration. */
 	#if( configMAX_PRIORITIES > 32 )
@@ -490,3 +490,68 @@ size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY use
 	taskEXIT_CRITICAL();
 }
 
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetHeapFreeBlocks( HeapRegion_t *pxFreeBlocks, UBaseType_t uxMaxBlocks )
+{
+BlockLink_t *pxBlock;
+UBaseType_t uxBlocks = 0;
+
+	vTaskSuspendAll();
+	{
+		pxBlock = xStart.pxNextFreeBlock;
+
+		/* pxBlock will be NULL if the heap has not been initialised. */
+		if( pxBlock != NULL )
+		{
+			while( pxBlock != pxEnd )
+			{
+				if( uxBlocks < uxMaxBlocks )
+				{
+					pxFreeBlocks[ uxBlocks ].pucStartAddress = ( uint8_t * ) pxBlock;
+					pxFreeBlocks[ uxBlocks ].xSizeInBytes = pxBlock->xBlockSize;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				uxBlocks++;
+				pxBlock = pxBlock->pxNextFreeBlock;
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return uxBlocks;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetHeapRegions( HeapRegion_t *pxRegions, UBaseType_t uxMaxRegions )
+{
+size_t uxAddress;
+UBaseType_t uxRegions = 0;
+
+	if( ( pxEnd != NULL ) && ( uxMaxRegions > 0 ) )
+	{
+		/* Find the aligned start of the heap the same way prvHeapInit()
+		does.  The region ends after the pxEnd marker. */
+		uxAddress = ( size_t ) ucHeap;
+
+		if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+		{
+			uxAddress += ( portBYTE_ALIGNMENT - 1 );
+			uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		}
+
+		pxRegions[ 0 ].pucStartAddress = ( uint8_t * ) uxAddress;
+		pxRegions[ 0 ].xSizeInBytes = ( ( size_t ) pxEnd + xHeapStructSize ) - uxAddress;
+		uxRegions = 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return uxRegions;
+}
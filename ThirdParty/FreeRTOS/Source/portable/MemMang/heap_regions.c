@@ -0,0 +1,801 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that manages
+ * several separate memory regions, each of which has a placement.  The
+ * placement describes what the memory is good for - for example fast core
+ * coupled RAM for stacks, large external SDRAM for frame buffers and logs, or
+ * DMA capable SRAM for peripheral buffers.  pvPortMallocPlaced() allocates from
+ * the regions with the requested placement, falling back to the general
+ * regions if they are full, and pvPortMalloc() allocates from the general
+ * regions.  Each region combines adjacent free blocks as they are freed in the
+ * same way as heap_4.c.
+ *
+ * Regions are added with vPortAddHeapRegion() (or vPortDefineHeapRegions(),
+ * which adds general regions as heap_5.c does).  If no general region has been
+ * added when the first allocation is made then a general region is created
+ * from a configTOTAL_HEAP_SIZE byte array, so the file can be used in place of
+ * heap_4.c without any application changes.  An application that adds its own
+ * general regions sets configHEAP_DEFAULT_REGION to 0 so the array is not
+ * defined.
+ *
+ * If configSTACK_ALLOCATION_FROM_SEPARATE_HEAP is set to 1 then task stacks
+ * are allocated from the eHeapPlacementFast regions.
+ *
+ * See heap_4.c for an alternative implementation, and the memory management
+ * pages of http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( xHeapStructSize << 1 ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* The public allocation functions share prvMallocPlaced(), so they capture
+the address of their own call site for the heap trace. */
+#if( configUSE_HEAP_TRACE == 1 )
+	#define heapCALLER_ADDRESS()	configHEAP_TRACE_CALLER()
+#else
+	#define heapCALLER_ADDRESS()	NULL
+#endif
+
+/* The default general region, only used if the application does not add a
+general region of its own before the first allocation. */
+#if( configHEAP_DEFAULT_REGION == 1 )
+	#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+		/* The application writer has already defined the array used for the RTOS
+		heap - probably so it can be placed in a special segment or address. */
+		extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#else
+		static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#endif /* configAPPLICATION_ALLOCATED_HEAP */
+#endif /* configHEAP_DEFAULT_REGION */
+
+/* Define the linked list structure.  This is used to link free blocks in order
+of their memory address. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
+	size_t xBlockSize;						/*<< The size of the free block. */
+} BlockLink_t;
+
+/* The state of one region.  Each region has its own free list, so blocks are
+never merged across regions. */
+typedef struct A_HEAP_REGION
+{
+	BlockLink_t xStart;						/*<< Holds a pointer to the first free block in the region. */
+	BlockLink_t *pxEnd;						/*<< Marks the end of the free list, and the end of the region. */
+	uint8_t *pucRegionStart;				/*<< The first block in the region, used to find the region a block belongs to. */
+	size_t xFreeBytesRemaining;
+	eHeapPlacement ePlacement;
+} HeapRegionState_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * the free list of pxRegion.  The block being freed will be merged with the
+ * block in front it and/or the block behind it if the memory blocks are
+ * adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList( HeapRegionState_t *pxRegion, BlockLink_t *pxBlockToInsert );
+
+/*
+ * Prepare the memory pucStartAddress to pucStartAddress + xSizeInBytes for use
+ * as a region with the given placement.
+ */
+static void prvAddRegion( uint8_t *pucStartAddress, size_t xSizeInBytes, eHeapPlacement ePlacement );
+
+/*
+ * Allocate a block of xWantedSize bytes, which already includes the block
+ * header and alignment, from the first region with the given placement that
+ * has space.  Returns NULL if there is no such region.
+ */
+static void *prvAllocateFromPlacement( size_t xWantedSize, eHeapPlacement ePlacement );
+
+/*
+ * The implementation of pvPortMalloc(), pvPortMallocPlaced() and
+ * pvPortMallocStack().  pvCaller is the address the public function will
+ * return to, recorded by the heap trace.
+ */
+static void *prvMallocPlaced( size_t xWantedSize, eHeapPlacement ePlacement, void *pvCaller );
+
+/*
+ * Called automatically to create the default general region the first time
+ * pvPortMalloc() is called, if the application has not added a general region.
+ */
+#if( configHEAP_DEFAULT_REGION == 1 )
+	static void prvHeapInit( void );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+block must by correctly byte aligned. */
+static const size_t xHeapStructSize	= ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The regions, in the order they were added. */
+static HeapRegionState_t xRegions[ configHEAP_MAX_REGIONS ];
+static BaseType_t xNumberOfRegions = 0;
+static BaseType_t xGeneralRegionAdded = pdFALSE;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+number of free bytes remaining in all regions, but says nothing about
+fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/* The top bit of an size_t type.  When this bit in the xBlockSize
+member of an BlockLink_t structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+static const size_t xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMallocPlaced( size_t xWantedSize, eHeapPlacement ePlacement )
+{
+	return prvMallocPlaced( xWantedSize, ePlacement, heapCALLER_ADDRESS() );
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+	return prvMallocPlaced( xWantedSize, eHeapPlacementGeneral, heapCALLER_ADDRESS() );
+}
+/*-----------------------------------------------------------*/
+
+#if( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
+
+	void *pvPortMallocStack( size_t xSize )
+	{
+		return prvMallocPlaced( xSize, eHeapPlacementFast, heapCALLER_ADDRESS() );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortFreeStack( void *pv )
+	{
+		vPortFree( pv );
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configSTACK_ALLOCATION_FROM_SEPARATE_HEAP */
+
+static void *prvMallocPlaced( size_t xWantedSize, eHeapPlacement ePlacement, void *pvCaller )
+{
+void *pvReturn = NULL;
+
+	configASSERT( ePlacement < eHeapPlacementCount );
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc and the application has not
+		provided a general region then create the default one.  Without a
+		default region the application must add a general region before the
+		first allocation. */
+		#if( configHEAP_DEFAULT_REGION == 1 )
+		{
+			if( xGeneralRegionAdded == pdFALSE )
+			{
+				prvHeapInit();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			configASSERT( xGeneralRegionAdded != pdFALSE );
+		}
+		#endif /* configHEAP_DEFAULT_REGION */
+
+		/* Check the requested block size is not so large that the top bit is
+		set.  The top bit of the block size member of the BlockLink_t structure
+		is used to determine who owns the block - the application or the
+		kernel, so it must be free. */
+		if( ( xWantedSize & xBlockAllocatedBit ) == 0 )
+		{
+			/* The wanted size is increased so it can contain a BlockLink_t
+			structure in addition to the requested amount of bytes. */
+			if( xWantedSize > 0 )
+			{
+				xWantedSize += xHeapStructSize;
+
+				/* Ensure that blocks are always aligned to the required number
+				of bytes. */
+				if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+				{
+					/* Byte alignment required. */
+					xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+					configASSERT( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+			{
+				pvReturn = prvAllocateFromPlacement( xWantedSize, ePlacement );
+
+				/* Memory of the requested kind is preferred but not required,
+				so fall back to the general regions.  Allocations from the
+				general regions fall back to the bulk regions, so large buffers
+				that were not given a placement can still use external
+				memory. */
+				if( pvReturn == NULL )
+				{
+					if( ePlacement != eHeapPlacementGeneral )
+					{
+						pvReturn = prvAllocateFromPlacement( xWantedSize, eHeapPlacementGeneral );
+					}
+					else
+					{
+						pvReturn = prvAllocateFromPlacement( xWantedSize, eHeapPlacementBulk );
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( pvReturn != NULL )
+				{
+					if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+					{
+						xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xNumberOfSuccessfulAllocations++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configUSE_HEAP_TRACE == 1 )
+		{
+			vHeapTraceRecordMalloc( pvReturn, xWantedSize, pvCaller );
+		}
+		#else
+		{
+			( void ) pvCaller;
+			traceMALLOC( pvReturn, xWantedSize );
+		}
+		#endif
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink;
+HeapRegionState_t *pxRegion = NULL;
+BaseType_t x;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have an BlockLink_t structure immediately
+		before it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+		configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+		/* Find the region the block came from.  There are only ever a few
+		regions. */
+		for( x = 0; x < xNumberOfRegions; x++ )
+		{
+			if( ( puc >= xRegions[ x ].pucRegionStart ) && ( puc < ( uint8_t * ) xRegions[ x ].pxEnd ) )
+			{
+				pxRegion = &( xRegions[ x ] );
+				break;
+			}
+		}
+
+		configASSERT( pxRegion != NULL );
+
+		if( ( pxRegion != NULL ) && ( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 ) )
+		{
+			if( pxLink->pxNextFreeBlock == NULL )
+			{
+				/* The block is being returned to the heap - it is no longer
+				allocated. */
+				pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+				vTaskSuspendAll();
+				{
+					/* Add this block to the list of free blocks. */
+					xFreeBytesRemaining += pxLink->xBlockSize;
+					pxRegion->xFreeBytesRemaining += pxLink->xBlockSize;
+					traceFREE( pv, pxLink->xBlockSize );
+					prvInsertBlockIntoFreeList( pxRegion, ( ( BlockLink_t * ) pxLink ) );
+					xNumberOfSuccessfulFrees++;
+				}
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSizePlaced( eHeapPlacement ePlacement )
+{
+size_t xReturn = 0U;
+BaseType_t x;
+
+	vTaskSuspendAll();
+	{
+		for( x = 0; x < xNumberOfRegions; x++ )
+		{
+			if( xRegions[ x ].ePlacement == ePlacement )
+			{
+				xReturn += xRegions[ x ].xFreeBytesRemaining;
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortAddHeapRegion( const HeapRegion_t * const pxHeapRegion, eHeapPlacement ePlacement )
+{
+	configASSERT( ePlacement < eHeapPlacementCount );
+
+	vTaskSuspendAll();
+	{
+		prvAddRegion( pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes, ePlacement );
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+const HeapRegion_t *pxHeapRegion = pxHeapRegions;
+
+	/* The array is terminated by a region of size 0, as with heap_5.c. */
+	while( pxHeapRegion->xSizeInBytes > 0 )
+	{
+		vPortAddHeapRegion( pxHeapRegion, eHeapPlacementGeneral );
+		pxHeapRegion++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_DEFAULT_REGION == 1 )
+
+	static void prvHeapInit( void )
+	{
+		prvAddRegion( ucHeap, ( size_t ) configTOTAL_HEAP_SIZE, eHeapPlacementGeneral );
+	}
+
+#endif /* configHEAP_DEFAULT_REGION */
+/*-----------------------------------------------------------*/
+
+static void prvAddRegion( uint8_t *pucStartAddress, size_t xSizeInBytes, eHeapPlacement ePlacement )
+{
+HeapRegionState_t *pxRegion;
+BlockLink_t *pxFirstFreeBlock;
+size_t uxAddress;
+size_t xTotalRegionSize = xSizeInBytes;
+
+	configASSERT( xNumberOfRegions < configHEAP_MAX_REGIONS );
+
+	if( xNumberOfRegions < configHEAP_MAX_REGIONS )
+	{
+		pxRegion = &( xRegions[ xNumberOfRegions ] );
+
+		/* Ensure the region starts on a correctly aligned boundary. */
+		uxAddress = ( size_t ) pucStartAddress;
+
+		if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+		{
+			uxAddress += ( portBYTE_ALIGNMENT - 1 );
+			uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+			xTotalRegionSize -= uxAddress - ( size_t ) pucStartAddress;
+		}
+
+		pxRegion->pucRegionStart = ( uint8_t * ) uxAddress;
+		pxRegion->ePlacement = ePlacement;
+
+		/* xStart is used to hold a pointer to the first item in the list of
+		free blocks.  The void cast is used to prevent compiler warnings. */
+		pxRegion->xStart.pxNextFreeBlock = ( void * ) pxRegion->pucRegionStart;
+		pxRegion->xStart.xBlockSize = ( size_t ) 0;
+
+		/* pxEnd is used to mark the end of the list of free blocks and is
+		inserted at the end of the region. */
+		uxAddress = ( ( size_t ) pxRegion->pucRegionStart ) + xTotalRegionSize;
+		uxAddress -= xHeapStructSize;
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		pxRegion->pxEnd = ( void * ) uxAddress;
+		pxRegion->pxEnd->xBlockSize = 0;
+		pxRegion->pxEnd->pxNextFreeBlock = NULL;
+
+		/* To start with there is a single free block that is sized to take up
+		the entire region, minus the space taken by pxEnd. */
+		pxFirstFreeBlock = ( void * ) pxRegion->pucRegionStart;
+		pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
+		pxFirstFreeBlock->pxNextFreeBlock = pxRegion->pxEnd;
+
+		pxRegion->xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+		xFreeBytesRemaining += pxFirstFreeBlock->xBlockSize;
+		xMinimumEverFreeBytesRemaining += pxFirstFreeBlock->xBlockSize;
+
+		if( ePlacement == eHeapPlacementGeneral )
+		{
+			xGeneralRegionAdded = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xNumberOfRegions++;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void *prvAllocateFromPlacement( size_t xWantedSize, eHeapPlacement ePlacement )
+{
+HeapRegionState_t *pxRegion;
+BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+void *pvReturn = NULL;
+BaseType_t x;
+
+	for( x = 0; ( x < xNumberOfRegions ) && ( pvReturn == NULL ); x++ )
+	{
+		pxRegion = &( xRegions[ x ] );
+
+		if( ( pxRegion->ePlacement == ePlacement ) && ( xWantedSize <= pxRegion->xFreeBytesRemaining ) )
+		{
+			/* Traverse the list from the start	(lowest address) block until
+			one	of adequate size is found. */
+			pxPreviousBlock = &( pxRegion->xStart );
+			pxBlock = pxRegion->xStart.pxNextFreeBlock;
+			while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+			{
+				pxPreviousBlock = pxBlock;
+				pxBlock = pxBlock->pxNextFreeBlock;
+			}
+		}
+		else
+		{
+			/* The region cannot satisfy the request. */
+			pxBlock = pxRegion->pxEnd;
+		}
+
+		/* If the end marker was reached then a block of adequate size was not
+		found in this region. */
+		if( pxBlock != pxRegion->pxEnd )
+		{
+			/* Return the memory space pointed to - jumping over the
+			BlockLink_t structure at its start. */
+			pvReturn = ( void * ) ( ( ( uint8_t * ) pxPreviousBlock->pxNextFreeBlock ) + xHeapStructSize );
+
+			/* This block is being returned for use so must be taken out of
+			the list of free blocks. */
+			pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+			/* If the block is larger than required it can be split into
+			two. */
+			if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+			{
+				/* This block is to be split into two.  Create a new block
+				following the number of bytes requested. The void cast is used
+				to prevent byte alignment warnings from the compiler. */
+				pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+				configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+				/* Calculate the sizes of two blocks split from the single
+				block. */
+				pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+				pxBlock->xBlockSize = xWantedSize;
+
+				/* Insert the new block into the list of free blocks. */
+				prvInsertBlockIntoFreeList( pxRegion, pxNewBlockLink );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxRegion->xFreeBytesRemaining -= pxBlock->xBlockSize;
+			xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+			/* The block is being returned - it is allocated and owned by the
+			application and has no "next" block. */
+			pxBlock->xBlockSize |= xBlockAllocatedBit;
+			pxBlock->pxNextFreeBlock = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( HeapRegionState_t *pxRegion, BlockLink_t *pxBlockToInsert )
+{
+BlockLink_t *pxIterator;
+uint8_t *puc;
+
+	/* Iterate through the list until a block is found that has a higher address
+	than the block being inserted. */
+	for( pxIterator = &( pxRegion->xStart ); pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+	{
+		/* Nothing to do here, just iterate to the right position. */
+	}
+
+	/* Do the block being inserted, and the block it is being inserted after
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxIterator;
+	if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+	{
+		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+		pxBlockToInsert = pxIterator;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Do the block being inserted, and the block it is being inserted before
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxBlockToInsert;
+	if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+	{
+		if( pxIterator->pxNextFreeBlock != pxRegion->pxEnd )
+		{
+			/* Form one big block from the two blocks. */
+			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+		}
+		else
+		{
+			pxBlockToInsert->pxNextFreeBlock = pxRegion->pxEnd;
+		}
+	}
+	else
+	{
+		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+	}
+
+	/* If the block being inserted plugged a gab, so was merged with the block
+	before and the block after, then it's pxNextFreeBlock pointer will have
+	already been set, and should not be set here as that would make it point
+	to itself. */
+	if( pxIterator != pxBlockToInsert )
+	{
+		pxIterator->pxNextFreeBlock = pxBlockToInsert;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+BlockLink_t *pxBlock;
+size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+BaseType_t x;
+
+	vTaskSuspendAll();
+	{
+		for( x = 0; x < xNumberOfRegions; x++ )
+		{
+			pxBlock = xRegions[ x ].xStart.pxNextFreeBlock;
+
+			while( pxBlock != xRegions[ x ].pxEnd )
+			{
+				/* Increment the number of blocks and record the largest block
+				seen so far. */
+				xBlocks++;
+
+				if( pxBlock->xBlockSize > xMaxSize )
+				{
+					xMaxSize = pxBlock->xBlockSize;
+				}
+
+				if( pxBlock->xBlockSize < xMinSize )
+				{
+					xMinSize = pxBlock->xBlockSize;
+				}
+
+				/* Move to the next block in the chain until the last block is
+				reached. */
+				pxBlock = pxBlock->pxNextFreeBlock;
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+	pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+	taskENTER_CRITICAL();
+	{
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetHeapFreeBlocks( HeapRegion_t *pxFreeBlocks, UBaseType_t uxMaxBlocks )
+{
+BlockLink_t *pxBlock;
+UBaseType_t uxBlocks = 0;
+BaseType_t x;
+
+	vTaskSuspendAll();
+	{
+		for( x = 0; x < xNumberOfRegions; x++ )
+		{
+			for( pxBlock = xRegions[ x ].xStart.pxNextFreeBlock; pxBlock != xRegions[ x ].pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				if( uxBlocks < uxMaxBlocks )
+				{
+					pxFreeBlocks[ uxBlocks ].pucStartAddress = ( uint8_t * ) pxBlock;
+					pxFreeBlocks[ uxBlocks ].xSizeInBytes = pxBlock->xBlockSize;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				uxBlocks++;
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return uxBlocks;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetHeapRegions( HeapRegion_t *pxRegions, UBaseType_t uxMaxRegions )
+{
+UBaseType_t uxRegions = 0;
+
+	vTaskSuspendAll();
+	{
+		while( ( uxRegions < uxMaxRegions ) && ( uxRegions < ( UBaseType_t ) xNumberOfRegions ) )
+		{
+			/* Each region ends after its pxEnd marker. */
+			pxRegions[ uxRegions ].pucStartAddress = xRegions[ uxRegions ].pucRegionStart;
+			pxRegions[ uxRegions ].xSizeInBytes = ( size_t ) ( ( ( uint8_t * ) xRegions[ uxRegions ].pxEnd ) - xRegions[ uxRegions ].pucRegionStart ) + xHeapStructSize;
+			uxRegions++;
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return uxRegions;
+}
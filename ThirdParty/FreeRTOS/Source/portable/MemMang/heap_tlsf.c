@@ -0,0 +1,729 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() that uses a two level
+ * segregated fit (TLSF) allocator.  Free blocks are kept in lists segregated by
+ * size, with a bitmap recording which lists are not empty, so both allocating
+ * and freeing take a bounded number of steps no matter how fragmented the heap
+ * has become.  Adjacent free blocks are combined as they are freed, as in
+ * heap_4.c.
+ *
+ * The first level splits block sizes into power of two ranges and the second
+ * level splits each range into heapSL_INDEX_COUNT equal parts.  A request is
+ * rounded up to the next second level boundary before the lists are searched,
+ * so the first block found is always large enough.  This wastes at most
+ * 1 / heapSL_INDEX_COUNT of each allocation.
+ *
+ * See heap_4.c for an alternative implementation, and the memory management
+ * pages of http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* Each first level range is split into 2 ^ heapSL_INDEX_COUNT_LOG2 second level
+lists. */
+#define heapSL_INDEX_COUNT_LOG2	( 4U )
+#define heapSL_INDEX_COUNT		( 1U << heapSL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE are all held in the first first
+level range, which is split linearly. */
+#define heapFL_INDEX_SHIFT		( heapSL_INDEX_COUNT_LOG2 + 3U )
+#define heapSMALL_BLOCK_SIZE	( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* The largest block the heap can hold is below 2 ^ heapFL_INDEX_MAX bytes. */
+#define heapFL_INDEX_MAX		( 30U )
+#define heapFL_INDEX_COUNT		( heapFL_INDEX_MAX - heapFL_INDEX_SHIFT + 1U )
+
+/* The number of the highest or lowest set bit in ulBitmap, which must not be
+zero.  Isolating the lowest set bit allows it to be found as the highest. */
+#define heapHIGHEST_SET_BIT( ulBitmap )	( ( UBaseType_t ) 31U - ( UBaseType_t ) portCOUNT_LEADING_ZEROS( ( ulBitmap ) ) )
+#define heapLOWEST_SET_BIT( ulBitmap )	heapHIGHEST_SET_BIT( ( ulBitmap ) & ( ~( ulBitmap ) + 1UL ) )
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The header at the start of each block.  Blocks are kept in address order
+through pxPreviousPhysBlock and xBlockSize, so the neighbours of a block being
+freed are found without searching.  pxNextFreeBlock and pxPreviousFreeBlock are
+only used while the block is free, so they overlap the memory returned to the
+application. */
+typedef struct A_TLSF_BLOCK
+{
+	struct A_TLSF_BLOCK *pxPreviousPhysBlock;	/*<< The block immediately below this block in memory, or NULL for the first block. */
+	size_t xBlockSize;							/*<< The size of the block, including this header. */
+	struct A_TLSF_BLOCK *pxNextFreeBlock;		/*<< The next block in the same free list. */
+	struct A_TLSF_BLOCK *pxPreviousFreeBlock;	/*<< The previous block in the same free list. */
+} TLSFBlock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Work out the first and second level list indexes for a block of xSize bytes.
+ */
+static void prvMapBlockSize( size_t xSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel );
+
+/*
+ * Add a free block to, or remove a free block from, the list for its size.
+ */
+static void prvInsertFreeBlock( TLSFBlock_t *pxBlock );
+static void prvRemoveFreeBlock( TLSFBlock_t *pxBlock );
+
+/*
+ * Find a free block of at least xWantedSize bytes, or return NULL if there is
+ * none.  The block is not removed from its list.
+ */
+static TLSFBlock_t *prvFindFreeBlock( size_t xWantedSize );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the part of the header that is kept while a block is allocated
+must by correctly byte aligned. */
+static const size_t xHeapStructSize	= ( offsetof( TLSFBlock_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* A free block must be large enough to hold the whole header. */
+static const size_t xMinimumBlockSize = ( sizeof( TLSFBlock_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The first and second level bitmaps, and the heads of the free lists they
+describe.  Bit n of ulFirstLevelMap is set if any bit of ulSecondLevelMap[ n ]
+is set, and bit m of ulSecondLevelMap[ n ] is set if pxFreeBlocks[ n ][ m ] is
+not empty. */
+static uint32_t ulFirstLevelMap = 0UL;
+static uint32_t ulSecondLevelMap[ heapFL_INDEX_COUNT ];
+static TLSFBlock_t *pxFreeBlocks[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+
+/* The first block in the heap, and the zero sized block that marks the end of
+the heap. */
+static TLSFBlock_t *pxFirstBlock = NULL, *pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+number of free bytes remaining, but says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of an TLSFBlock_t structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+static size_t xBlockAllocatedBit = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+TLSFBlock_t *pxBlock, *pxNewBlock, *pxNextPhysBlock;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the free lists. */
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Check the requested block size is not so large that the top bit is
+		set.  The top bit of the block size member of the TLSFBlock_t structure
+		is used to determine who owns the block - the application or the
+		kernel, so it must be free. */
+		if( ( xWantedSize & xBlockAllocatedBit ) == 0 )
+		{
+			/* The wanted size is increased so it can contain the block header
+			in addition to the requested amount of bytes. */
+			if( xWantedSize > 0 )
+			{
+				xWantedSize += xHeapStructSize;
+
+				/* Ensure that blocks are always aligned to the required number
+				of bytes. */
+				if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+				{
+					/* Byte alignment required. */
+					xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+					configASSERT( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The block must be able to hold the free list links once it
+				is freed again. */
+				if( xWantedSize < xMinimumBlockSize )
+				{
+					xWantedSize = xMinimumBlockSize;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+			{
+				pxBlock = prvFindFreeBlock( xWantedSize );
+
+				if( pxBlock != NULL )
+				{
+					/* This block is being returned for use so must be taken out
+					of its free list. */
+					prvRemoveFreeBlock( pxBlock );
+
+					/* If the block is larger than required it can be split into
+					two. */
+					if( ( pxBlock->xBlockSize - xWantedSize ) >= xMinimumBlockSize )
+					{
+						/* This block is to be split into two.  Create a new
+						block following the number of bytes requested. The void
+						cast is used to prevent byte alignment warnings from the
+						compiler. */
+						pxNewBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+						configASSERT( ( ( ( size_t ) pxNewBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+						/* Calculate the sizes of two blocks split from the
+						single block, and link the new block in between the
+						block and the block that follows it. */
+						pxNewBlock->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+						pxNewBlock->pxPreviousPhysBlock = pxBlock;
+						pxBlock->xBlockSize = xWantedSize;
+
+						pxNextPhysBlock = ( void * ) ( ( ( uint8_t * ) pxNewBlock ) + pxNewBlock->xBlockSize );
+						pxNextPhysBlock->pxPreviousPhysBlock = pxNewBlock;
+
+						/* The block that follows cannot be free, as free blocks
+						are always merged, so the new block goes straight into
+						a free list. */
+						prvInsertFreeBlock( pxNewBlock );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+					if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+					{
+						xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* The block is being returned - it is allocated and owned
+					by the application. */
+					pxBlock->xBlockSize |= xBlockAllocatedBit;
+					xNumberOfSuccessfulAllocations++;
+
+					/* Return the memory space pointed to - jumping over the
+					block header at its start. */
+					pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+TLSFBlock_t *pxBlock, *pxNeighbour;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have a block header immediately before
+		it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxBlock = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxBlock->xBlockSize & xBlockAllocatedBit ) != 0 );
+
+		if( ( pxBlock->xBlockSize & xBlockAllocatedBit ) != 0 )
+		{
+			/* The block is being returned to the heap - it is no longer
+			allocated. */
+			pxBlock->xBlockSize &= ~xBlockAllocatedBit;
+
+			vTaskSuspendAll();
+			{
+				xFreeBytesRemaining += pxBlock->xBlockSize;
+				traceFREE( pv, pxBlock->xBlockSize );
+
+				/* Merge with the block below if it is free. */
+				pxNeighbour = pxBlock->pxPreviousPhysBlock;
+
+				if( ( pxNeighbour != NULL ) && ( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 ) )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxNeighbour->xBlockSize += pxBlock->xBlockSize;
+					pxBlock = pxNeighbour;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Merge with the block above if it is free.  The end marker is
+				marked as allocated so is never merged. */
+				pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize );
+
+				if( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxBlock->xBlockSize += pxNeighbour->xBlockSize;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The block above now follows the merged block. */
+				pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize );
+				pxNeighbour->pxPreviousPhysBlock = pxBlock;
+
+				prvInsertFreeBlock( pxBlock );
+				xNumberOfSuccessfulFrees++;
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+uint8_t *pucAlignedHeap;
+size_t uxAddress;
+size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+	/* The first level index cannot describe a block of 2 ^ heapFL_INDEX_MAX
+	bytes or more.  configTOTAL_HEAP_SIZE usually contains a cast, so this
+	cannot be checked by the preprocessor. */
+	configASSERT( xTotalHeapSize < ( ( size_t ) 1 << heapFL_INDEX_MAX ) );
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) ucHeap;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+	}
+
+	pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+	/* Work out the position of the top bit in a size_t variable. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+	/* pxEnd is used to mark the end of the heap.  It is marked as allocated so
+	the block below it is never merged with it. */
+	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( void * ) uxAddress;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd. */
+	pxFirstBlock = ( void * ) pucAlignedHeap;
+	pxFirstBlock->xBlockSize = uxAddress - ( size_t ) pxFirstBlock;
+	pxFirstBlock->pxPreviousPhysBlock = NULL;
+
+	pxEnd->xBlockSize = xBlockAllocatedBit;
+	pxEnd->pxPreviousPhysBlock = pxFirstBlock;
+
+	prvInsertFreeBlock( pxFirstBlock );
+
+	/* Only one block exists - and it covers the entire usable heap space. */
+	xMinimumEverFreeBytesRemaining = pxFirstBlock->xBlockSize;
+	xFreeBytesRemaining = pxFirstBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapBlockSize( size_t xSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel )
+{
+UBaseType_t uxFirstLevel;
+
+	if( xSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* Small blocks share the first range, split linearly. */
+		*puxFirstLevel = 0U;
+		*puxSecondLevel = ( UBaseType_t ) ( xSize / ( heapSMALL_BLOCK_SIZE / heapSL_INDEX_COUNT ) );
+	}
+	else
+	{
+		/* The first level is the position of the most significant bit and the
+		second level is taken from the heapSL_INDEX_COUNT_LOG2 bits below
+		it. */
+		uxFirstLevel = heapHIGHEST_SET_BIT( ( uint32_t ) xSize );
+		*puxSecondLevel = ( UBaseType_t ) ( ( xSize >> ( uxFirstLevel - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT );
+		*puxFirstLevel = uxFirstLevel - ( heapFL_INDEX_SHIFT - 1U );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( TLSFBlock_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMapBlockSize( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	pxBlock->pxPreviousFreeBlock = NULL;
+	pxBlock->pxNextFreeBlock = pxFreeBlocks[ uxFirstLevel ][ uxSecondLevel ];
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeBlocks[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+	ulFirstLevelMap |= ( 1UL << uxFirstLevel );
+	ulSecondLevelMap[ uxFirstLevel ] |= ( 1UL << uxSecondLevel );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( TLSFBlock_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMapBlockSize( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPreviousFreeBlock != NULL )
+	{
+		pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was at the head of its list.  Clear the bitmaps if the
+		list is now empty. */
+		pxFreeBlocks[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+		if( pxBlock->pxNextFreeBlock == NULL )
+		{
+			ulSecondLevelMap[ uxFirstLevel ] &= ~( 1UL << uxSecondLevel );
+
+			if( ulSecondLevelMap[ uxFirstLevel ] == 0UL )
+			{
+				ulFirstLevelMap &= ~( 1UL << uxFirstLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TLSFBlock_t *prvFindFreeBlock( size_t xWantedSize )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+uint32_t ulMap;
+TLSFBlock_t *pxReturn = NULL;
+
+	/* Round the size up to the next second level boundary so that every block
+	in the list found is large enough. */
+	if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xWantedSize += ( ( size_t ) 1 << ( heapHIGHEST_SET_BIT( ( uint32_t ) xWantedSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1;
+	}
+	else
+	{
+		xWantedSize += ( heapSMALL_BLOCK_SIZE / heapSL_INDEX_COUNT ) - ( size_t ) 1;
+	}
+
+	if( xWantedSize < ( ( size_t ) 1 << heapFL_INDEX_MAX ) )
+	{
+		prvMapBlockSize( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+		/* Look for a non-empty list in the same range first, then for the
+		smallest non-empty list in a larger range. */
+		ulMap = ulSecondLevelMap[ uxFirstLevel ] & ( ~0UL << uxSecondLevel );
+
+		if( ulMap == 0UL )
+		{
+			ulMap = ulFirstLevelMap & ( ~0UL << ( uxFirstLevel + 1U ) );
+
+			if( ulMap != 0UL )
+			{
+				uxFirstLevel = heapLOWEST_SET_BIT( ulMap );
+				ulMap = ulSecondLevelMap[ uxFirstLevel ];
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ulMap != 0UL )
+		{
+			uxSecondLevel = heapLOWEST_SET_BIT( ulMap );
+			pxReturn = pxFreeBlocks[ uxFirstLevel ][ uxSecondLevel ];
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+TLSFBlock_t *pxBlock;
+size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+	vTaskSuspendAll();
+	{
+		pxBlock = pxFirstBlock;
+
+		/* pxBlock will be NULL if the heap has not been initialised.  The heap
+		is initialised automatically when the first allocation is made. */
+		if( pxBlock != NULL )
+		{
+			/* Walk the blocks in address order up to the end marker. */
+			while( pxBlock != pxEnd )
+			{
+				if( ( pxBlock->xBlockSize & xBlockAllocatedBit ) == 0 )
+				{
+					/* Increment the number of blocks and record the largest
+					block seen so far. */
+					xBlocks++;
+
+					if( pxBlock->xBlockSize > xMaxSize )
+					{
+						xMaxSize = pxBlock->xBlockSize;
+					}
+
+					if( pxBlock->xBlockSize < xMinSize )
+					{
+						xMinSize = pxBlock->xBlockSize;
+					}
+				}
+
+				pxBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + ( pxBlock->xBlockSize & ~xBlockAllocatedBit ) );
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+	pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+	taskENTER_CRITICAL();
+	{
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetHeapFreeBlocks( HeapRegion_t *pxFreeBlocks, UBaseType_t uxMaxBlocks )
+{
+TLSFBlock_t *pxBlock;
+UBaseType_t uxBlocks = 0;
+
+	vTaskSuspendAll();
+	{
+		/* pxFirstBlock will be NULL if the heap has not been initialised.
+		Walk the blocks in address order rather than the free lists so the
+		free blocks are reported in address order. */
+		for( pxBlock = pxFirstBlock; ( pxBlock != NULL ) && ( pxBlock != pxEnd ); pxBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + ( pxBlock->xBlockSize & ~xBlockAllocatedBit ) ) )
+		{
+			if( ( pxBlock->xBlockSize & xBlockAllocatedBit ) == 0 )
+			{
+				if( uxBlocks < uxMaxBlocks )
+				{
+					pxFreeBlocks[ uxBlocks ].pucStartAddress = ( uint8_t * ) pxBlock;
+					pxFreeBlocks[ uxBlocks ].xSizeInBytes = pxBlock->xBlockSize;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				uxBlocks++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return uxBlocks;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetHeapRegions( HeapRegion_t *pxRegions, UBaseType_t uxMaxRegions )
+{
+UBaseType_t uxRegions = 0;
+
+	if( ( pxFirstBlock != NULL ) && ( uxMaxRegions > 0 ) )
+	{
+		/* The region ends after the pxEnd marker. */
+		pxRegions[ 0 ].pucStartAddress = ( uint8_t * ) pxFirstBlock;
+		pxRegions[ 0 ].xSizeInBytes = ( size_t ) ( ( ( uint8_t * ) pxEnd ) - ( ( uint8_t * ) pxFirstBlock ) ) + xHeapStructSize;
+		uxRegions = 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return uxRegions;
+}
@@ -37,10 +37,23 @@ task.h is included from an application file. */
 #include "task.h"
 #include "queue.h"
 
+#if( configUSE_READY_SETS == 1 )
+	#include "ready_set.h"
+#endif
+
+#if ( configUSE_KERNEL_OBJECT_SLABS == 1 )
+	#include "slab.h"
+#endif
+
 #if ( configUSE_CO_ROUTINES == 1 )
 	#include "croutine.h"
 #endif
 
+#if ( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+	/* snprintf() is used by vQueueWriteStats(). */
+	#include <stdio.h>
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
 for the header files above, but not in this file, in order to generate the
@@ -89,6 +102,142 @@ zero. */
 	#define queueYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+#if( configUSE_PRIORITY_QUEUES == 1 )
+
+	/* A priority ordered queue keeps a FIFO list of item slots for each
+	priority level.  The lists are linked through puxNextSlot, which also links
+	the free slots.  Bit n of ulLevelMap[ g ] is set when level ( g * 32 ) + n
+	holds items, and bit g of ulGroupMap is set when ulLevelMap[ g ] is not
+	zero, so the highest level that holds items is found with two bit scans. */
+	#define queuePRIORITY_LEVELS_MAX		( ( UBaseType_t ) 256U )
+	#define queuePRIORITY_GROUPS			( queuePRIORITY_LEVELS_MAX / 32U )
+	#define queueNO_SLOT					( ( UBaseType_t ) ~( UBaseType_t ) 0U )
+
+	/* Items are sent to a priority ordered queue with a priority, or to the
+	back, which is the same as sending with priority 0.  Other queues cannot be
+	sent to with a priority. */
+	#define queuePRIORITY_POSITION_IS_VALID( pxQueue, xCopyPosition )	( ( ( pxQueue )->pxPriorityOrder != NULL ) ?															\
+																			( ( ( xCopyPosition ) == queueSEND_TO_BACK ) || ( ( ( xCopyPosition ) & queueSEND_BY_PRIORITY ) != 0 ) ) :	\
+																			( ( ( xCopyPosition ) & queueSEND_BY_PRIORITY ) == 0 ) )
+
+	#define queueHIGHEST_SET_BIT( ulBitmap )	( ( UBaseType_t ) 31U - ( UBaseType_t ) portCOUNT_LEADING_ZEROS( ( ulBitmap ) ) )
+
+	typedef struct QueuePriorityOrder
+	{
+		uint32_t ulGroupMap;							/*< Bit g is set when ulLevelMap[ g ] is not zero. */
+		uint32_t ulLevelMap[ queuePRIORITY_GROUPS ];	/*< One bit per priority level that holds items. */
+		UBaseType_t uxLevels;							/*< The number of priority levels. */
+		UBaseType_t uxFreeSlot;							/*< The first free slot, or queueNO_SLOT. */
+		UBaseType_t *puxNextSlot;						/*< The slot after each slot in its level or in the free list. */
+		UBaseType_t *puxLevelHead;						/*< The oldest slot in each level, or queueNO_SLOT. */
+		UBaseType_t *puxLevelTail;						/*< The newest slot in each level. */
+	} QueuePriorityOrder_t;
+
+#else
+
+	#define queuePRIORITY_POSITION_IS_VALID( pxQueue, xCopyPosition )	( ( ( xCopyPosition ) & queueSEND_BY_PRIORITY ) == 0 )
+
+#endif /* configUSE_PRIORITY_QUEUES */
+
+#if( configUSE_CONFLATING_QUEUES == 1 )
+
+	/* A conflating queue records the key of the item held in each slot, and
+	the slot holding the pending item for each key, so an item sent with a key
+	can replace the pending item that has the same key without searching the
+	queue. */
+	#define queueKEYS_MAX					( ( UBaseType_t ) 256U )
+	#define queueNO_KEY						( ( UBaseType_t ) ~( UBaseType_t ) 0U )
+	#define queueNO_KEY_SLOT				( ( UBaseType_t ) ~( UBaseType_t ) 0U )
+
+	/* Items are sent to a conflating queue with a key, or to the back without
+	a key, in which case they are never replaced.  Other queues cannot be sent
+	to with a key. */
+	#define queueKEY_POSITION_IS_VALID( pxQueue, xCopyPosition )		( ( ( pxQueue )->pxKeyIndex != NULL ) ?														\
+																			( ( ( xCopyPosition ) == queueSEND_TO_BACK ) || ( ( ( xCopyPosition ) & queueSEND_BY_KEY ) != 0 ) ) :	\
+																			( ( ( xCopyPosition ) & queueSEND_BY_KEY ) == 0 ) )
+
+	typedef struct QueueKeyIndex
+	{
+		UBaseType_t uxKeys;			/*< The number of keys. */
+		UBaseType_t *puxKeySlot;	/*< The slot holding the pending item for each key, or queueNO_KEY_SLOT. */
+		UBaseType_t *puxSlotKey;	/*< The key of the item held in each slot, or queueNO_KEY. */
+	} QueueKeyIndex_t;
+
+#else
+
+	#define queueKEY_POSITION_IS_VALID( pxQueue, xCopyPosition )		( ( ( xCopyPosition ) & queueSEND_BY_KEY ) == 0 )
+
+#endif /* configUSE_CONFLATING_QUEUES */
+
+#if( configUSE_QUEUE_STATS == 1 )
+
+	/* The length of each line written by vQueueWriteStats().  Longer queue
+	names are truncated. */
+	#define queueSTATS_LINE_LENGTH	( 200 )
+
+	/* Update the statistics of a queue.  Other than queueSTATS_WAIT_STARTED()
+	and queueSTATS_TIMED_OUT() these must be called from a critical section, or
+	with the scheduler suspended and the queue locked for counters that are not
+	updated from interrupts. */
+	#define queueSTATS_INCREMENT( pxQueue, ulCounter )	( ( pxQueue )->xStats.ulCounter )++
+
+	#define queueSTATS_SENT( pxQueue, uxItems )															\
+	{																									\
+		( pxQueue )->xStats.ulSends += ( uint32_t ) ( uxItems );										\
+		if( ( pxQueue )->uxMessagesWaiting > ( pxQueue )->xStats.uxMaxMessagesWaiting )				\
+		{																								\
+			( pxQueue )->xStats.uxMaxMessagesWaiting = ( pxQueue )->uxMessagesWaiting;					\
+		}																								\
+	}
+
+	#define queueSTATS_RECEIVED( pxQueue, uxItems )		( pxQueue )->xStats.ulReceives += ( uint32_t ) ( uxItems )
+
+	#define queueSTATS_PRIORITY_INHERITED( pxQueue, xInherited )										\
+	{																									\
+		if( ( xInherited ) != pdFALSE )																	\
+		{																								\
+			( ( pxQueue )->xStats.ulPriorityInheritances )++;											\
+		}																								\
+	}
+
+	/* A call that has to wait notes the time it started waiting in a local
+	variable, ulWaitStart, and adds the time it waited to the statistics when it
+	returns.  xEntryTimeSet is only set once the call has started waiting. */
+	#define queueSTATS_WAIT_STARTED( ulWaitStart )		( ulWaitStart ) = configQUEUE_STATS_TIMESTAMP()
+
+	#define queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart )								\
+	{																									\
+		if( ( xEntryTimeSet ) != pdFALSE )																\
+		{																								\
+			prvRecordWaitTime( ( pxQueue ), ( ulWaitStart ) );											\
+		}																								\
+	}
+
+	/* Called outside of a critical section when a wait times out. */
+	#define queueSTATS_TIMED_OUT( pxQueue, ulCounter, ulWaitStart )										\
+	{																									\
+		taskENTER_CRITICAL();																			\
+		{																								\
+			queueSTATS_INCREMENT( ( pxQueue ), ulCounter );												\
+			prvRecordWaitTime( ( pxQueue ), ( ulWaitStart ) );											\
+		}																								\
+		taskEXIT_CRITICAL();																			\
+	}
+
+#else
+
+	#define queueSTATS_INCREMENT( pxQueue, ulCounter )
+	#define queueSTATS_SENT( pxQueue, uxItems )
+	#define queueSTATS_RECEIVED( pxQueue, uxItems )
+	#define queueSTATS_PRIORITY_INHERITED( pxQueue, xInherited )
+	#define queueSTATS_WAIT_STARTED( ulWaitStart )
+	#define queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart )
+	#define queueSTATS_TIMED_OUT( pxQueue, ulCounter, ulWaitStart )
+
+#endif /* configUSE_QUEUE_STATS */
+
+#define queueIS_VALID_COPY_POSITION( pxQueue, xCopyPosition )	( queuePRIORITY_POSITION_IS_VALID( ( pxQueue ), ( xCopyPosition ) ) && queueKEY_POSITION_IS_VALID( ( pxQueue ), ( xCopyPosition ) ) )
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -108,6 +257,11 @@ typedef struct QueueDefinition 		/* The old naming convention is used to prevent
 	List_t xTasksWaitingToSend;		/*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
 	List_t xTasksWaitingToReceive;	/*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
 
+	#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+		ListPriorityIndex_t xTasksWaitingToSendIndex;		/*< Per priority index into xTasksWaitingToSend. */
+		ListPriorityIndex_t xTasksWaitingToReceiveIndex;	/*< Per priority index into xTasksWaitingToReceive. */
+	#endif
+
 	volatile UBaseType_t uxMessagesWaiting;/*< The number of items currently in the queue. */
 	UBaseType_t uxLength;			/*< The length of the queue defined as the number of items it will hold, not the number of bytes. */
 	UBaseType_t uxItemSize;			/*< The size of each items that the queue will hold. */
@@ -128,6 +282,22 @@ typedef struct QueueDefinition 		/* The old naming convention is used to prevent
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_READY_SETS == 1 )
+		ReadySetMember_t xReadySetMember;	/*< Links the queue into the ready list of the ready set it belongs to. */
+	#endif
+
+	#if ( configUSE_PRIORITY_QUEUES == 1 )
+		QueuePriorityOrder_t *pxPriorityOrder;	/*< NULL unless the queue was created by xQueueCreatePriority(). */
+	#endif
+
+	#if ( configUSE_CONFLATING_QUEUES == 1 )
+		QueueKeyIndex_t *pxKeyIndex;	/*< NULL unless the queue was created by xQueueCreateConflating(). */
+	#endif
+
+	#if ( configUSE_QUEUE_STATS == 1 )
+		QueueStats_t xStats;
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -136,6 +306,27 @@ typedef xQUEUE Queue_t;
 
 /*-----------------------------------------------------------*/
 
+/* Queues that have no storage area, which includes all semaphores and mutexes,
+are taken from a slab cache, if one is configured, so creating and deleting them
+does not fragment the heap.  Queues with storage are allocated from the heap as
+their size varies. */
+#if ( configUSE_KERNEL_OBJECT_SLABS == 1 )
+
+	PRIVILEGED_DATA static Queue_t xSemaphoreSlabObjects[ configSLAB_SEMAPHORE_COUNT ];
+	PRIVILEGED_DATA static SlabCache_t xSemaphoreSlab = slabCACHE_INITIALISER( xSemaphoreSlabObjects, "Semaphore" );
+
+	#define queueALLOCATE_QUEUE( xQueueSizeInBytes )	( ( ( xQueueSizeInBytes ) == ( size_t ) 0 ) ? ( Queue_t * ) pvSlabAllocate( &xSemaphoreSlab ) : ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + ( xQueueSizeInBytes ) ) )
+	#define queueFREE_QUEUE( pxQueue )					vSlabFree( &xSemaphoreSlab, ( pxQueue ) )
+
+#else
+
+	#define queueALLOCATE_QUEUE( xQueueSizeInBytes )	( ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + ( xQueueSizeInBytes ) ) )
+	#define queueFREE_QUEUE( pxQueue )					vPortFree( pxQueue )
+
+#endif
+
+/*-----------------------------------------------------------*/
+
 /*
  * The queue registry is just a means for kernel aware debuggers to locate
  * queue structures.  It has no other purpose so is an optional component.
@@ -198,6 +389,91 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvIte
  */
 static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies the item that would be received next out of a queue, leaving it in
+ * the queue.
+ */
+static void prvPeekDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_PRIORITY_QUEUES == 1 )
+	/*
+	 * Versions of prvCopyDataToQueue() and prvCopyDataFromQueue() for queues
+	 * created by xQueueCreatePriority().  The item is copied from the highest
+	 * priority level that holds items, and is only removed from the queue if
+	 * xRemove is pdTRUE.
+	 */
+	static void prvCopyDataToPriorityQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+	static void prvCopyDataFromPriorityQueue( Queue_t * const pxQueue, void * const pvBuffer, const BaseType_t xRemove ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Empties every priority level and places all the slots in the free list.
+	 */
+	static void prvResetPriorityOrder( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configUSE_CONFLATING_QUEUES == 1 )
+	/*
+	 * Version of prvCopyDataToQueue() for queues created by
+	 * xQueueCreateConflating() that copies the item to the back of the queue
+	 * and records its key.
+	 */
+	static void prvCopyDataToConflatingQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * If xPosition carries a key, and the queue holds an item with that key,
+	 * overwrite the held item with pvItemToQueue in place and return pdTRUE.
+	 * Otherwise return pdFALSE without altering the queue.  Must be called from
+	 * a critical section.
+	 */
+	static BaseType_t prvReplacePendingItem( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Clears the key of the item in the slot pcItem, which has just been
+	 * received.
+	 */
+	static void prvReleaseItemKey( const Queue_t * const pxQueue, const int8_t * const pcItem ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Marks every key as having no pending item.
+	 */
+	static void prvResetKeyIndex( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configUSE_QUEUE_STATS == 1 )
+	/*
+	 * Adds the time since ulWaitStart to the wait time statistics of a queue.
+	 * Must be called from a critical section.
+	 */
+	static void prvRecordWaitTime( Queue_t * const pxQueue, const uint32_t ulWaitStart ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+	/*
+	 * Fills in a snapshot of the queue in a queue registry entry.  Returns
+	 * pdFALSE if the registry entry is empty.
+	 */
+	static BaseType_t prvGetRegistryEntryStats( const UBaseType_t uxEntry, QueueRegistryStats_t * const pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Copy uxItemCount items to the back of, or from the front of, a queue that
+ * has space for or holds at least that many items.  The copy is split into at
+ * most two memcpy() calls around the end of the queue storage area.  Must be
+ * called from a critical section.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock up to one task per item added to, or removed from, a queue by
+ * xQueueSendMultiple() or xQueueReceiveMultiple().  Must be called from a
+ * critical section.
+ *
+ * @return pdTRUE if an unblocked task has a priority above the calling task.
+ */
+static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue, const UBaseType_t uxItemsAdded ) PRIVILEGED_FUNCTION;
+static BaseType_t prvUnblockSenders( Queue_t * const pxQueue, const UBaseType_t uxItemsRemoved ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 	/*
 	 * Checks to see if a queue is a member of a queue set, and if so, notifies
@@ -267,6 +543,32 @@ Queue_t * const pxQueue = xQueue;
 		pxQueue->cRxLock = queueUNLOCKED;
 		pxQueue->cTxLock = queueUNLOCKED;
 
+		#if( configUSE_PRIORITY_QUEUES == 1 )
+		{
+			if( pxQueue->pxPriorityOrder != NULL )
+			{
+				prvResetPriorityOrder( pxQueue );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_PRIORITY_QUEUES */
+
+		#if( configUSE_CONFLATING_QUEUES == 1 )
+		{
+			if( pxQueue->pxKeyIndex != NULL )
+			{
+				prvResetKeyIndex( pxQueue );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_CONFLATING_QUEUES */
+
 		if( xNewQueue == pdFALSE )
 		{
 			/* If there are tasks blocked waiting to read from the queue, then
@@ -295,6 +597,13 @@ Queue_t * const pxQueue = xQueue;
 			/* Ensure the event queues start in the correct state. */
 			vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
 			vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+
+			#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+			{
+				vListInitialisePriorityIndex( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->xTasksWaitingToSendIndex ) );
+				vListInitialisePriorityIndex( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->xTasksWaitingToReceiveIndex ) );
+			}
+			#endif
 		}
 	}
 	taskEXIT_CRITICAL();
@@ -387,7 +696,7 @@ Queue_t * const pxQueue = xQueue;
 		are greater than or equal to the pointer to char requirements the cast
 		is safe.  In other cases alignment requirements are not strict (one or
 		two bytes). */
-		pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+		pxNewQueue = queueALLOCATE_QUEUE( xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
 
 		if( pxNewQueue != NULL )
 		{
@@ -419,6 +728,118 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreatePriority( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, const UBaseType_t uxPriorityLevels )
+	{
+	Queue_t *pxNewQueue;
+	size_t xStorageSizeInBytes, xQueueSizeInBytes;
+	uint8_t *pucQueueStorage;
+	QueuePriorityOrder_t *pxOrder;
+	UBaseType_t *puxIndices;
+
+		configASSERT( uxQueueLength > ( UBaseType_t ) 0 );
+		configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+		configASSERT( ( uxPriorityLevels > ( UBaseType_t ) 0 ) && ( uxPriorityLevels <= queuePRIORITY_LEVELS_MAX ) );
+
+		/* The storage area is followed by the priority order, which is
+		followed by the next slot index of each slot and the head and tail
+		slot index of each level. */
+		xStorageSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		xStorageSizeInBytes = ( xStorageSizeInBytes + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xQueueSizeInBytes = xStorageSizeInBytes + sizeof( QueuePriorityOrder_t ) + ( ( ( size_t ) uxQueueLength + ( ( size_t ) uxPriorityLevels * ( size_t ) 2 ) ) * sizeof( UBaseType_t ) );
+
+		pxNewQueue = queueALLOCATE_QUEUE( xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment in xQueueGenericCreate(). */
+
+		if( pxNewQueue != NULL )
+		{
+			pucQueueStorage = ( uint8_t * ) pxNewQueue;
+			pucQueueStorage += sizeof( Queue_t ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+
+			pxOrder = ( QueuePriorityOrder_t * ) ( pucQueueStorage + xStorageSizeInBytes ); /*lint !e9087 !e9079 !e9016 Aligned by rounding up the storage size above. */
+			puxIndices = ( UBaseType_t * ) &( pxOrder[ 1 ] ); /*lint !e9087 !e9079 The indices follow the priority order. */
+			pxOrder->uxLevels = uxPriorityLevels;
+			pxOrder->puxNextSlot = puxIndices;
+			pxOrder->puxLevelHead = &( puxIndices[ uxQueueLength ] );
+			pxOrder->puxLevelTail = &( puxIndices[ uxQueueLength + uxPriorityLevels ] );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			prvInitialiseNewQueue( uxQueueLength, uxItemSize, pucQueueStorage, queueQUEUE_TYPE_BASE, pxNewQueue );
+
+			pxNewQueue->pxPriorityOrder = pxOrder;
+			prvResetPriorityOrder( pxNewQueue );
+		}
+		else
+		{
+			traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_BASE );
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_CONFLATING_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateConflating( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, const UBaseType_t uxKeyCount )
+	{
+	Queue_t *pxNewQueue;
+	size_t xStorageSizeInBytes, xQueueSizeInBytes;
+	uint8_t *pucQueueStorage;
+	QueueKeyIndex_t *pxKeyIndex;
+
+		configASSERT( uxQueueLength > ( UBaseType_t ) 0 );
+		configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+		configASSERT( ( uxKeyCount > ( UBaseType_t ) 0 ) && ( uxKeyCount <= queueKEYS_MAX ) );
+
+		/* The storage area is followed by the key index, which is followed by
+		the slot of each key and the key of each slot. */
+		xStorageSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		xStorageSizeInBytes = ( xStorageSizeInBytes + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xQueueSizeInBytes = xStorageSizeInBytes + sizeof( QueueKeyIndex_t ) + ( ( ( size_t ) uxKeyCount + ( size_t ) uxQueueLength ) * sizeof( UBaseType_t ) );
+
+		pxNewQueue = queueALLOCATE_QUEUE( xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment in xQueueGenericCreate(). */
+
+		if( pxNewQueue != NULL )
+		{
+			pucQueueStorage = ( uint8_t * ) pxNewQueue;
+			pucQueueStorage += sizeof( Queue_t ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+
+			pxKeyIndex = ( QueueKeyIndex_t * ) ( pucQueueStorage + xStorageSizeInBytes ); /*lint !e9087 !e9079 !e9016 Aligned by rounding up the storage size above. */
+			pxKeyIndex->uxKeys = uxKeyCount;
+			pxKeyIndex->puxKeySlot = ( UBaseType_t * ) &( pxKeyIndex[ 1 ] ); /*lint !e9087 !e9079 The indices follow the key index. */
+			pxKeyIndex->puxSlotKey = &( pxKeyIndex->puxKeySlot[ uxKeyCount ] );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			prvInitialiseNewQueue( uxQueueLength, uxItemSize, pucQueueStorage, queueQUEUE_TYPE_BASE, pxNewQueue );
+
+			pxNewQueue->pxKeyIndex = pxKeyIndex;
+			prvResetKeyIndex( pxNewQueue );
+		}
+		else
+		{
+			traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_BASE );
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* ( ( configUSE_CONFLATING_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, uint8_t *pucQueueStorage, const uint8_t ucQueueType, Queue_t *pxNewQueue )
 {
 	/* Remove compiler warnings about unused parameters should
@@ -443,6 +864,28 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	defined. */
 	pxNewQueue->uxLength = uxQueueLength;
 	pxNewQueue->uxItemSize = uxItemSize;
+
+	#if( configUSE_PRIORITY_QUEUES == 1 )
+	{
+		/* xQueueCreatePriority() attaches the priority order after the queue
+		has been initialised. */
+		pxNewQueue->pxPriorityOrder = NULL;
+	}
+	#endif /* configUSE_PRIORITY_QUEUES */
+
+	#if( configUSE_CONFLATING_QUEUES == 1 )
+	{
+		/* Likewise xQueueCreateConflating() attaches the key index. */
+		pxNewQueue->pxKeyIndex = NULL;
+	}
+	#endif /* configUSE_CONFLATING_QUEUES */
+
+	#if( configUSE_QUEUE_STATS == 1 )
+	{
+		( void ) memset( ( void * ) &( pxNewQueue->xStats ), 0x00, sizeof( QueueStats_t ) );
+	}
+	#endif /* configUSE_QUEUE_STATS */
+
 	( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
 	#if ( configUSE_TRACE_FACILITY == 1 )
@@ -457,6 +900,16 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_READY_SETS == 1 )
+	{
+		pxNewQueue->xReadySetMember.pxReadySet = NULL;
+		pxNewQueue->xReadySetMember.pxNextReady = NULL;
+		pxNewQueue->xReadySetMember.pvMember = ( void * ) pxNewQueue;
+		pxNewQueue->xReadySetMember.pvTag = NULL;
+		pxNewQueue->xReadySetMember.ucFlags = 0U;
+	}
+	#endif /* configUSE_READY_SETS */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -741,11 +1194,15 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQ
 {
 BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
 TimeOut_t xTimeOut;
+#if ( configUSE_QUEUE_STATS == 1 )
+	uint32_t ulWaitStart = 0UL;
+#endif
 Queue_t * const pxQueue = xQueue;
 
 	configASSERT( pxQueue );
 	configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
 	configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+	configASSERT( queueIS_VALID_COPY_POSITION( pxQueue, xCopyPosition ) );
 	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 	{
 		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
@@ -760,6 +1217,34 @@ Queue_t * const pxQueue = xQueue;
 	{
 		taskENTER_CRITICAL();
 		{
+			#if ( configUSE_CONFLATING_QUEUES == 1 )
+			{
+				/* If the queue already holds an item with the same key then
+				that item is updated in place.  The number of items in the queue
+				does not change, so there is no need for space, and no task or
+				queue set needs to be told about it. */
+				if( prvReplacePendingItem( pxQueue, pvItemToQueue, xCopyPosition ) != pdFALSE )
+				{
+					traceQUEUE_SEND( pxQueue );
+
+					#if ( configUSE_READY_SETS == 1 )
+					{
+						readysetSIGNAL( &( pxQueue->xReadySetMember ) );
+					}
+					#endif /* configUSE_READY_SETS */
+
+					queueSTATS_SENT( pxQueue, 1 );
+					queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
+					taskEXIT_CRITICAL();
+					return pdPASS;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_CONFLATING_QUEUES */
+
 			/* Is there room on the queue now?  The running task must be the
 			highest priority task wanting to access the queue.  If the head item
 			in the queue is to be overwritten then it does not matter if the
@@ -864,6 +1349,14 @@ Queue_t * const pxQueue = xQueue;
 				}
 				#endif /* configUSE_QUEUE_SETS */
 
+				#if ( configUSE_READY_SETS == 1 )
+				{
+					readysetSIGNAL( &( pxQueue->xReadySetMember ) );
+				}
+				#endif /* configUSE_READY_SETS */
+
+				queueSTATS_SENT( pxQueue, 1 );
+				queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
 				taskEXIT_CRITICAL();
 				return pdPASS;
 			}
@@ -873,6 +1366,8 @@ Queue_t * const pxQueue = xQueue;
 				{
 					/* The queue was full and no block time is specified (or
 					the block time has expired) so leave now. */
+					queueSTATS_INCREMENT( pxQueue, ulSendsFailed );
+					queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
 					taskEXIT_CRITICAL();
 
 					/* Return to the original privilege level before exiting
@@ -886,6 +1381,7 @@ Queue_t * const pxQueue = xQueue;
 					configure the timeout structure. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+					queueSTATS_WAIT_STARTED( ulWaitStart );
 				}
 				else
 				{
@@ -908,6 +1404,7 @@ Queue_t * const pxQueue = xQueue;
 			if( prvIsQueueFull( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				queueSTATS_INCREMENT( pxQueue, ulSendBlocks );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
 
 				/* Unlocking the queue means queue events can effect the
@@ -940,6 +1437,7 @@ Queue_t * const pxQueue = xQueue;
 			prvUnlockQueue( pxQueue );
 			( void ) xTaskResumeAll();
 
+			queueSTATS_TIMED_OUT( pxQueue, ulSendsFailed, ulWaitStart );
 			traceQUEUE_SEND_FAILED( pxQueue );
 			return errQUEUE_FULL;
 		}
@@ -956,6 +1454,7 @@ Queue_t * const pxQueue = xQueue;
 	configASSERT( pxQueue );
 	configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
 	configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+	configASSERT( queueIS_VALID_COPY_POSITION( pxQueue, xCopyPosition ) );
 
 	/* RTOS ports that support interrupt nesting have the concept of a maximum
 	system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -980,6 +1479,25 @@ Queue_t * const pxQueue = xQueue;
 	post). */
 	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
+		#if ( configUSE_CONFLATING_QUEUES == 1 )
+		if( prvReplacePendingItem( pxQueue, pvItemToQueue, xCopyPosition ) != pdFALSE )
+		{
+			/* An item with the same key was updated in place, so the number of
+			items in the queue has not changed and there is nothing to unblock,
+			even if the queue is locked. */
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+			queueSTATS_SENT( pxQueue, 1 );
+
+			#if ( configUSE_READY_SETS == 1 )
+			{
+				readysetSIGNAL_FROM_ISR( &( pxQueue->xReadySetMember ), pxHigherPriorityTaskWoken );
+			}
+			#endif /* configUSE_READY_SETS */
+
+			xReturn = pdPASS;
+		}
+		else
+		#endif /* configUSE_CONFLATING_QUEUES */
 		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
 		{
 			const int8_t cTxLock = pxQueue->cTxLock;
@@ -993,6 +1511,15 @@ Queue_t * const pxQueue = xQueue;
 			called here even though the disinherit function does not check if
 			the scheduler is suspended before accessing the ready lists. */
 			( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+			queueSTATS_SENT( pxQueue, 1 );
+
+			/* A ready set is signalled even if the queue is locked as doing so
+			does not touch the queue's event lists. */
+			#if ( configUSE_READY_SETS == 1 )
+			{
+				readysetSIGNAL_FROM_ISR( &( pxQueue->xReadySetMember ), pxHigherPriorityTaskWoken );
+			}
+			#endif /* configUSE_READY_SETS */
 
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
@@ -1100,6 +1627,7 @@ Queue_t * const pxQueue = xQueue;
 		else
 		{
 			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			queueSTATS_INCREMENT( pxQueue, ulSendsFailed );
 			xReturn = errQUEUE_FULL;
 		}
 	}
@@ -1168,6 +1696,13 @@ Queue_t * const pxQueue = xQueue;
 			priority disinheritance is needed.  Simply increase the count of
 			messages (semaphores) available. */
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+			queueSTATS_SENT( pxQueue, 1 );
+
+			#if ( configUSE_READY_SETS == 1 )
+			{
+				readysetSIGNAL_FROM_ISR( &( pxQueue->xReadySetMember ), pxHigherPriorityTaskWoken );
+			}
+			#endif /* configUSE_READY_SETS */
 
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
@@ -1265,6 +1800,7 @@ Queue_t * const pxQueue = xQueue;
 		else
 		{
 			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			queueSTATS_INCREMENT( pxQueue, ulSendsFailed );
 			xReturn = errQUEUE_FULL;
 		}
 	}
@@ -1278,6 +1814,9 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_
 {
 BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
+#if ( configUSE_QUEUE_STATS == 1 )
+	uint32_t ulWaitStart = 0UL;
+#endif
 Queue_t * const pxQueue = xQueue;
 
 	/* Check the pointer is not NULL. */
@@ -1312,6 +1851,8 @@ Queue_t * const pxQueue = xQueue;
 				prvCopyDataFromQueue( pxQueue, pvBuffer );
 				traceQUEUE_RECEIVE( pxQueue );
 				pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+				queueSTATS_RECEIVED( pxQueue, 1 );
+				queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
 
 				/* There is now space in the queue, were any tasks waiting to
 				post to the queue?  If so, unblock the highest priority waiting
@@ -1341,6 +1882,8 @@ Queue_t * const pxQueue = xQueue;
 				{
 					/* The queue was empty and no block time is specified (or
 					the block time has expired) so leave now. */
+					queueSTATS_INCREMENT( pxQueue, ulReceivesFailed );
+					queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
 					taskEXIT_CRITICAL();
 					traceQUEUE_RECEIVE_FAILED( pxQueue );
 					return errQUEUE_EMPTY;
@@ -1351,6 +1894,7 @@ Queue_t * const pxQueue = xQueue;
 					configure the timeout structure. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+					queueSTATS_WAIT_STARTED( ulWaitStart );
 				}
 				else
 				{
@@ -1375,6 +1919,7 @@ Queue_t * const pxQueue = xQueue;
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				queueSTATS_INCREMENT( pxQueue, ulReceiveBlocks );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1403,6 +1948,7 @@ Queue_t * const pxQueue = xQueue;
 
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
+				queueSTATS_TIMED_OUT( pxQueue, ulReceivesFailed, ulWaitStart );
 				traceQUEUE_RECEIVE_FAILED( pxQueue );
 				return errQUEUE_EMPTY;
 			}
@@ -1415,32 +1961,376 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItemsToQueue, UBaseType_t uxItemCount, TickType_t xTicksToWait )
 {
 BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
-Queue_t * const pxQueue = xQueue;
-
-#if( configUSE_MUTEXES == 1 )
-	BaseType_t xInheritanceOccurred = pdFALSE;
+#if ( configUSE_QUEUE_STATS == 1 )
+	uint32_t ulWaitStart = 0UL;
 #endif
+Queue_t * const pxQueue = xQueue;
+const int8_t *pcNextItem = ( const int8_t * ) pvItemsToQueue; /*lint !e9079 Pointer arithmetic on char types ok. */
+UBaseType_t uxItemsSent = 0, uxItemsToCopy;
 
-	/* Check the queue pointer is not NULL. */
-	configASSERT( ( pxQueue ) );
+	configASSERT( pxQueue );
+	configASSERT( pvItemsToQueue );
 
-	/* Check this really is a semaphore, in which case the item size will be
-	0. */
-	configASSERT( pxQueue->uxItemSize == 0 );
+	/* Semaphores and mutexes hold no data so cannot be sent to in bulk. */
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	#if( configUSE_PRIORITY_QUEUES == 1 )
+	{
+		configASSERT( pxQueue->pxPriorityOrder == NULL );
+	}
+	#endif
+	#if( configUSE_CONFLATING_QUEUES == 1 )
+	{
+		configASSERT( pxQueue->pxKeyIndex == NULL );
+	}
+	#endif
 
-	/* Cannot block if the scheduler is suspended. */
 	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 	{
 		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
 	}
 	#endif
 
+	/* A burst of no items can never be completed, so without this check the
+	task would retry until xTicksToWait expired, or for ever if it is
+	portMAX_DELAY. */
+	configASSERT( uxItemCount > ( UBaseType_t ) 0 );
+	if( uxItemCount == ( UBaseType_t ) 0 )
+	{
+		return ( BaseType_t ) 0;
+	}
 
-	/*lint -save -e904 This function relaxes the coding standard somewhat to allow return
+	/*lint -save -e904 This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Send as many of the remaining items as there is room for. */
+			uxItemsToCopy = configMIN( pxQueue->uxLength - pxQueue->uxMessagesWaiting, uxItemCount - uxItemsSent );
+
+			if( uxItemsToCopy > ( UBaseType_t ) 0 )
+			{
+				traceQUEUE_SEND( pxQueue );
+
+				prvCopyItemsToQueue( pxQueue, pcNextItem, uxItemsToCopy );
+				queueSTATS_SENT( pxQueue, uxItemsToCopy );
+				pcNextItem += uxItemsToCopy * pxQueue->uxItemSize;
+				uxItemsSent += uxItemsToCopy;
+
+				if( prvUnblockReceivers( pxQueue, uxItemsToCopy ) != pdFALSE )
+				{
+					/* Yes it is ok to do this from within the critical section
+					- the kernel takes care of that. */
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				#if ( configUSE_READY_SETS == 1 )
+				{
+					readysetSIGNAL( &( pxQueue->xReadySetMember ) );
+				}
+				#endif /* configUSE_READY_SETS */
+
+				if( uxItemsSent == uxItemCount )
+				{
+					queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
+					taskEXIT_CRITICAL();
+					return ( BaseType_t ) uxItemsSent;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The queue is full and there are items left to send. */
+			if( xTicksToWait == ( TickType_t ) 0 )
+			{
+				if( uxItemsSent == ( UBaseType_t ) 0 )
+				{
+					queueSTATS_INCREMENT( pxQueue, ulSendsFailed );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
+				taskEXIT_CRITICAL();
+
+				if( uxItemsSent == ( UBaseType_t ) 0 )
+				{
+					traceQUEUE_SEND_FAILED( pxQueue );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				return ( BaseType_t ) uxItemsSent;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskInternalSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+				queueSTATS_WAIT_STARTED( ulWaitStart );
+			}
+			else
+			{
+				/* Entry time was already set. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Interrupts and other tasks can send to and receive from the queue
+		now the critical section has been exited. */
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				queueSTATS_INCREMENT( pxQueue, ulSendBlocks );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			if( uxItemsSent == ( UBaseType_t ) 0 )
+			{
+				queueSTATS_TIMED_OUT( pxQueue, ulSendsFailed, ulWaitStart );
+				traceQUEUE_SEND_FAILED( pxQueue );
+			}
+			else
+			{
+				/* Some items were sent so the call did not fail, but the time
+				spent waiting for the rest still counts. */
+				#if ( configUSE_QUEUE_STATS == 1 )
+				{
+					taskENTER_CRITICAL();
+					{
+						prvRecordWaitTime( pxQueue, ulWaitStart );
+					}
+					taskEXIT_CRITICAL();
+				}
+				#endif
+			}
+
+			return ( BaseType_t ) uxItemsSent;
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+#if ( configUSE_QUEUE_STATS == 1 )
+	uint32_t ulWaitStart = 0UL;
+#endif
+Queue_t * const pxQueue = xQueue;
+UBaseType_t uxItemsToCopy;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	#if( configUSE_PRIORITY_QUEUES == 1 )
+	{
+		configASSERT( pxQueue->pxPriorityOrder == NULL );
+	}
+	#endif
+	#if( configUSE_CONFLATING_QUEUES == 1 )
+	{
+		configASSERT( pxQueue->pxKeyIndex == NULL );
+	}
+	#endif
+
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/* Receiving no items can never succeed, so without this check the task
+	would retry until xTicksToWait expired, or for ever if it is
+	portMAX_DELAY. */
+	configASSERT( uxMaxItems > ( UBaseType_t ) 0 );
+	if( uxMaxItems == ( UBaseType_t ) 0 )
+	{
+		return ( BaseType_t ) 0;
+	}
+
+	/*lint -save -e904  This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			uxItemsToCopy = configMIN( pxQueue->uxMessagesWaiting, uxMaxItems );
+
+			if( uxItemsToCopy > ( UBaseType_t ) 0 )
+			{
+				prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxItemsToCopy ); /*lint !e9079 Buffer is just bytes. */
+				traceQUEUE_RECEIVE( pxQueue );
+				queueSTATS_RECEIVED( pxQueue, uxItemsToCopy );
+				queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
+
+				/* There is now space in the queue, so unblock one waiting
+				sender per item removed. */
+				if( prvUnblockSenders( pxQueue, uxItemsToCopy ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return ( BaseType_t ) uxItemsToCopy;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue was empty and no block time is specified (or
+					the block time has expired) so leave now. */
+					queueSTATS_INCREMENT( pxQueue, ulReceivesFailed );
+					queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+					queueSTATS_WAIT_STARTED( ulWaitStart );
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				queueSTATS_INCREMENT( pxQueue, ulReceiveBlocks );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The queue contains data again.  Loop back to try and read the
+				data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* Timed out.  If there is no data in the queue exit, otherwise loop
+			back and attempt to read the data. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				queueSTATS_TIMED_OUT( pxQueue, ulReceivesFailed, ulWaitStart );
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+#if ( configUSE_QUEUE_STATS == 1 )
+	uint32_t ulWaitStart = 0UL;
+#endif
+Queue_t * const pxQueue = xQueue;
+
+#if( configUSE_MUTEXES == 1 )
+	BaseType_t xInheritanceOccurred = pdFALSE;
+#endif
+
+	/* Check the queue pointer is not NULL. */
+	configASSERT( ( pxQueue ) );
+
+	/* Check this really is a semaphore, in which case the item size will be
+	0. */
+	configASSERT( pxQueue->uxItemSize == 0 );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+
+	/*lint -save -e904 This function relaxes the coding standard somewhat to allow return
 	statements within the function itself.  This is done in the interest
 	of execution time efficiency. */
 	for( ;; )
@@ -1460,6 +2350,8 @@ Queue_t * const pxQueue = xQueue;
 				/* Semaphores are queues with a data size of zero and where the
 				messages waiting is the semaphore's count.  Reduce the count. */
 				pxQueue->uxMessagesWaiting = uxSemaphoreCount - ( UBaseType_t ) 1;
+				queueSTATS_RECEIVED( pxQueue, 1 );
+				queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
 
 				#if ( configUSE_MUTEXES == 1 )
 				{
@@ -1512,6 +2404,8 @@ Queue_t * const pxQueue = xQueue;
 
 					/* The semaphore count was 0 and no block time is specified
 					(or the block time has expired) so exit now. */
+					queueSTATS_INCREMENT( pxQueue, ulReceivesFailed );
+					queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
 					taskEXIT_CRITICAL();
 					traceQUEUE_RECEIVE_FAILED( pxQueue );
 					return errQUEUE_EMPTY;
@@ -1522,6 +2416,7 @@ Queue_t * const pxQueue = xQueue;
 					so configure the timeout structure ready to block. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+					queueSTATS_WAIT_STARTED( ulWaitStart );
 				}
 				else
 				{
@@ -1548,6 +2443,7 @@ Queue_t * const pxQueue = xQueue;
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				queueSTATS_INCREMENT( pxQueue, ulReceiveBlocks );
 
 				#if ( configUSE_MUTEXES == 1 )
 				{
@@ -1556,6 +2452,7 @@ Queue_t * const pxQueue = xQueue;
 						taskENTER_CRITICAL();
 						{
 							xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+							queueSTATS_PRIORITY_INHERITED( pxQueue, xInheritanceOccurred );
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1621,6 +2518,7 @@ Queue_t * const pxQueue = xQueue;
 				}
 				#endif /* configUSE_MUTEXES */
 
+				queueSTATS_TIMED_OUT( pxQueue, ulReceivesFailed, ulWaitStart );
 				traceQUEUE_RECEIVE_FAILED( pxQueue );
 				return errQUEUE_EMPTY;
 			}
@@ -1637,7 +2535,9 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue, void * const pvBuffer, TickType_t x
 {
 BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
-int8_t *pcOriginalReadPosition;
+#if ( configUSE_QUEUE_STATS == 1 )
+	uint32_t ulWaitStart = 0UL;
+#endif
 Queue_t * const pxQueue = xQueue;
 
 	/* Check the pointer is not NULL. */
@@ -1668,16 +2568,10 @@ Queue_t * const pxQueue = xQueue;
 			must be the highest priority task wanting to access the queue. */
 			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
 			{
-				/* Remember the read position so it can be reset after the data
-				is read from the queue as this function is only peeking the
-				data, not removing it. */
-				pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-
-				prvCopyDataFromQueue( pxQueue, pvBuffer );
+				/* This function is only peeking the data, not removing it. */
+				prvPeekDataFromQueue( pxQueue, pvBuffer );
 				traceQUEUE_PEEK( pxQueue );
-
-				/* The data is not being removed, so reset the read pointer. */
-				pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+				queueSTATS_WAIT_ENDED( pxQueue, xEntryTimeSet, ulWaitStart );
 
 				/* The data is being left in the queue, so see if there are
 				any other tasks waiting for the data. */
@@ -1718,6 +2612,7 @@ Queue_t * const pxQueue = xQueue;
 					state. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+					queueSTATS_WAIT_STARTED( ulWaitStart );
 				}
 				else
 				{
@@ -1742,6 +2637,7 @@ Queue_t * const pxQueue = xQueue;
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+				queueSTATS_INCREMENT( pxQueue, ulReceiveBlocks );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1770,6 +2666,18 @@ Queue_t * const pxQueue = xQueue;
 
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
+				/* Peeks are not counted as receives, but the time spent
+				waiting to peek is. */
+				#if ( configUSE_QUEUE_STATS == 1 )
+				{
+					taskENTER_CRITICAL();
+					{
+						prvRecordWaitTime( pxQueue, ulWaitStart );
+					}
+					taskEXIT_CRITICAL();
+				}
+				#endif
+
 				traceQUEUE_PEEK_FAILED( pxQueue );
 				return errQUEUE_EMPTY;
 			}
@@ -1820,6 +2728,7 @@ Queue_t * const pxQueue = xQueue;
 
 			prvCopyDataFromQueue( pxQueue, pvBuffer );
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+			queueSTATS_RECEIVED( pxQueue, 1 );
 
 			/* If the queue is locked the event list will not be modified.
 			Instead update the lock count so the task that unlocks the queue
@@ -1865,6 +2774,7 @@ Queue_t * const pxQueue = xQueue;
 		{
 			xReturn = pdFAIL;
 			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+			queueSTATS_INCREMENT( pxQueue, ulReceivesFailed );
 		}
 	}
 	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
@@ -1877,7 +2787,6 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,  void * const pvBuffer )
 {
 BaseType_t xReturn;
 UBaseType_t uxSavedInterruptStatus;
-int8_t *pcOriginalReadPosition;
 Queue_t * const pxQueue = xQueue;
 
 	configASSERT( pxQueue );
@@ -1907,11 +2816,8 @@ Queue_t * const pxQueue = xQueue;
 		{
 			traceQUEUE_PEEK_FROM_ISR( pxQueue );
 
-			/* Remember the read position so it can be reset as nothing is
-			actually being removed from the queue. */
-			pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-			prvCopyDataFromQueue( pxQueue, pvBuffer );
-			pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+			/* Nothing is actually being removed from the queue. */
+			prvPeekDataFromQueue( pxQueue, pvBuffer );
 
 			xReturn = pdPASS;
 		}
@@ -1979,6 +2885,13 @@ Queue_t * const pxQueue = xQueue;
 	configASSERT( pxQueue );
 	traceQUEUE_DELETE( pxQueue );
 
+	#if ( configUSE_READY_SETS == 1 )
+	{
+		/* The queue must be removed from its ready set before it is deleted. */
+		configASSERT( pxQueue->xReadySetMember.pxReadySet == NULL );
+	}
+	#endif
+
 	#if ( configQUEUE_REGISTRY_SIZE > 0 )
 	{
 		vQueueUnregisterQueue( pxQueue );
@@ -1989,7 +2902,7 @@ Queue_t * const pxQueue = xQueue;
 	{
 		/* The queue can only have been allocated dynamically - free it
 		again. */
-		vPortFree( pxQueue );
+		queueFREE_QUEUE( pxQueue );
 	}
 	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 	{
@@ -1997,7 +2910,7 @@ Queue_t * const pxQueue = xQueue;
 		check before attempting to free the memory. */
 		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
 		{
-			vPortFree( pxQueue );
+			queueFREE_QUEUE( pxQueue );
 		}
 		else
 		{
@@ -2016,91 +2929,484 @@ Queue_t * const pxQueue = xQueue;
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-	UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
-	{
-		return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+	UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+	{
+		return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber )
+	{
+		( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+	{
+		return ( ( Queue_t * ) xQueue )->ucQueueType;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEXES == 1 )
+
+	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+	{
+	UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+		/* If a task waiting for a mutex causes the mutex holder to inherit a
+		priority, but the waiting task times out, then the holder should
+		disinherit the priority - but only down to the highest priority of any
+		other tasks that are waiting for the same mutex.  For this purpose,
+		return the priority of the highest priority task that is waiting for the
+		mutex. */
+		if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+		{
+			uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+		}
+		else
+		{
+			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+		}
+
+		return uxHighestPriorityOfWaitingTasks;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
+{
+BaseType_t xReturn = pdFALSE;
+UBaseType_t uxMessagesWaiting;
+
+	/* This function is called from a critical section. */
+
+	uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+	if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+	{
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+			{
+				/* The mutex is no longer being held. */
+				xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+				pxQueue->u.xSemaphore.xMutexHolder = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_MUTEXES */
+	}
+	#if( configUSE_PRIORITY_QUEUES == 1 )
+	else if( pxQueue->pxPriorityOrder != NULL )
+	{
+		prvCopyDataToPriorityQueue( pxQueue, pvItemToQueue, xPosition );
+	}
+	#endif /* configUSE_PRIORITY_QUEUES */
+	#if( configUSE_CONFLATING_QUEUES == 1 )
+	else if( pxQueue->pxKeyIndex != NULL )
+	{
+		prvCopyDataToConflatingQueue( pxQueue, pvItemToQueue, xPosition );
+	}
+	#endif /* configUSE_CONFLATING_QUEUES */
+	else if( xPosition == queueSEND_TO_BACK )
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+		pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+		if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
+		pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
+		if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xPosition == queueOVERWRITE )
+		{
+			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			{
+				/* An item is not being added but overwritten, so subtract
+				one from the recorded number of items in the queue so when
+				one is added again below the number of recorded items remains
+				correct. */
+				--uxMessagesWaiting;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
+{
+	#if( configUSE_PRIORITY_QUEUES == 1 )
+	if( pxQueue->pxPriorityOrder != NULL )
+	{
+		prvCopyDataFromPriorityQueue( pxQueue, pvBuffer, pdTRUE );
+	}
+	else
+	#endif /* configUSE_PRIORITY_QUEUES */
+	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+	{
+		pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+		if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		{
+			pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+
+		#if( configUSE_CONFLATING_QUEUES == 1 )
+		{
+			if( pxQueue->pxKeyIndex != NULL )
+			{
+				prvReleaseItemKey( pxQueue, pxQueue->u.xQueue.pcReadFrom );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_CONFLATING_QUEUES */
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeekDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
+{
+int8_t *pcReadFrom;
+
+	#if( configUSE_PRIORITY_QUEUES == 1 )
+	if( pxQueue->pxPriorityOrder != NULL )
+	{
+		prvCopyDataFromPriorityQueue( pxQueue, pvBuffer, pdFALSE );
+	}
+	else
+	#endif /* configUSE_PRIORITY_QUEUES */
+	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+	{
+		/* Copy the item that would be received next without moving the read
+		pointer. */
+		pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+		if( pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		{
+			pcReadFrom = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PRIORITY_QUEUES == 1 )
+
+	static void prvCopyDataToPriorityQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
+	{
+	QueuePriorityOrder_t * const pxOrder = pxQueue->pxPriorityOrder;
+	const UBaseType_t uxLevel = ( UBaseType_t ) ( ( UBaseType_t ) xPosition & ~( UBaseType_t ) queueSEND_BY_PRIORITY );
+	UBaseType_t uxSlot;
+
+		/* This function is called from a critical section, and only when the
+		queue is not full, so there is always a free slot. */
+		configASSERT( uxLevel < pxOrder->uxLevels );
+		uxSlot = pxOrder->uxFreeSlot;
+		configASSERT( uxSlot != queueNO_SLOT );
+		pxOrder->uxFreeSlot = pxOrder->puxNextSlot[ uxSlot ];
+
+		( void ) memcpy( ( void * ) &( pxQueue->pcHead[ uxSlot * pxQueue->uxItemSize ] ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+
+		/* Append the slot to its level so items of equal priority are received
+		in the order they were sent. */
+		pxOrder->puxNextSlot[ uxSlot ] = queueNO_SLOT;
+
+		if( pxOrder->puxLevelHead[ uxLevel ] == queueNO_SLOT )
+		{
+			pxOrder->puxLevelHead[ uxLevel ] = uxSlot;
+			pxOrder->ulLevelMap[ uxLevel >> 5 ] |= ( 1UL << ( uxLevel & 0x1fUL ) );
+			pxOrder->ulGroupMap |= ( 1UL << ( uxLevel >> 5 ) );
+		}
+		else
+		{
+			pxOrder->puxNextSlot[ pxOrder->puxLevelTail[ uxLevel ] ] = uxSlot;
+		}
+
+		pxOrder->puxLevelTail[ uxLevel ] = uxSlot;
+	}
+
+#endif /* configUSE_PRIORITY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PRIORITY_QUEUES == 1 )
+
+	static void prvCopyDataFromPriorityQueue( Queue_t * const pxQueue, void * const pvBuffer, const BaseType_t xRemove )
+	{
+	QueuePriorityOrder_t * const pxOrder = pxQueue->pxPriorityOrder;
+	UBaseType_t uxGroup, uxLevel, uxSlot;
+
+		/* This function is called from a critical section, and only when the
+		queue is not empty, so at least one level holds items. */
+		configASSERT( pxOrder->ulGroupMap != 0UL );
+		uxGroup = queueHIGHEST_SET_BIT( pxOrder->ulGroupMap );
+		uxLevel = ( uxGroup << 5 ) + queueHIGHEST_SET_BIT( pxOrder->ulLevelMap[ uxGroup ] );
+		uxSlot = pxOrder->puxLevelHead[ uxLevel ];
+
+		( void ) memcpy( ( void * ) pvBuffer, ( void * ) &( pxQueue->pcHead[ uxSlot * pxQueue->uxItemSize ] ), ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+
+		if( xRemove != pdFALSE )
+		{
+			pxOrder->puxLevelHead[ uxLevel ] = pxOrder->puxNextSlot[ uxSlot ];
+
+			if( pxOrder->puxLevelHead[ uxLevel ] == queueNO_SLOT )
+			{
+				pxOrder->ulLevelMap[ uxGroup ] &= ~( 1UL << ( uxLevel & 0x1fUL ) );
+
+				if( pxOrder->ulLevelMap[ uxGroup ] == 0UL )
+				{
+					pxOrder->ulGroupMap &= ~( 1UL << uxGroup );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Return the slot to the free list. */
+			pxOrder->puxNextSlot[ uxSlot ] = pxOrder->uxFreeSlot;
+			pxOrder->uxFreeSlot = uxSlot;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_PRIORITY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PRIORITY_QUEUES == 1 )
+
+	static void prvResetPriorityOrder( const Queue_t * const pxQueue )
+	{
+	QueuePriorityOrder_t * const pxOrder = pxQueue->pxPriorityOrder;
+	UBaseType_t ux;
+
+		pxOrder->ulGroupMap = 0UL;
+
+		for( ux = ( UBaseType_t ) 0U; ux < queuePRIORITY_GROUPS; ux++ )
+		{
+			pxOrder->ulLevelMap[ ux ] = 0UL;
+		}
+
+		for( ux = ( UBaseType_t ) 0U; ux < pxOrder->uxLevels; ux++ )
+		{
+			pxOrder->puxLevelHead[ ux ] = queueNO_SLOT;
+		}
+
+		/* Chain every slot into the free list. */
+		for( ux = ( UBaseType_t ) 1U; ux < pxQueue->uxLength; ux++ )
+		{
+			pxOrder->puxNextSlot[ ux - ( UBaseType_t ) 1U ] = ux;
+		}
+
+		pxOrder->puxNextSlot[ pxQueue->uxLength - ( UBaseType_t ) 1U ] = queueNO_SLOT;
+		pxOrder->uxFreeSlot = ( UBaseType_t ) 0U;
+	}
+
+#endif /* configUSE_PRIORITY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_CONFLATING_QUEUES == 1 )
+
+	static void prvCopyDataToConflatingQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
+	{
+	QueueKeyIndex_t * const pxKeyIndex = pxQueue->pxKeyIndex;
+	const UBaseType_t uxSlot = ( UBaseType_t ) ( pxQueue->pcWriteTo - pxQueue->pcHead ) / pxQueue->uxItemSize; /*lint !e946 !e947 Pointer subtraction within the same storage area. */
+	UBaseType_t uxKey;
+
+		/* Items that are not replacing a pending item always go to the back of
+		the queue, whether or not they have a key. */
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+		pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+		if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( xPosition & queueSEND_BY_KEY ) != 0 )
+		{
+			uxKey = ( UBaseType_t ) ( ( UBaseType_t ) xPosition & ~( UBaseType_t ) queueSEND_BY_KEY );
+			configASSERT( uxKey < pxKeyIndex->uxKeys );
+			pxKeyIndex->puxKeySlot[ uxKey ] = uxSlot;
+			pxKeyIndex->puxSlotKey[ uxSlot ] = uxKey;
+		}
+		else
+		{
+			pxKeyIndex->puxSlotKey[ uxSlot ] = queueNO_KEY;
+		}
+	}
+
+#endif /* configUSE_CONFLATING_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_CONFLATING_QUEUES == 1 )
+
+	static BaseType_t prvReplacePendingItem( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
+	{
+	QueueKeyIndex_t * const pxKeyIndex = pxQueue->pxKeyIndex;
+	UBaseType_t uxKey, uxSlot;
+	BaseType_t xReturn = pdFALSE;
+
+		if( ( pxKeyIndex != NULL ) && ( ( xPosition & queueSEND_BY_KEY ) != 0 ) )
+		{
+			uxKey = ( UBaseType_t ) ( ( UBaseType_t ) xPosition & ~( UBaseType_t ) queueSEND_BY_KEY );
+			configASSERT( uxKey < pxKeyIndex->uxKeys );
+			uxSlot = pxKeyIndex->puxKeySlot[ uxKey ];
+
+			if( uxSlot != queueNO_KEY_SLOT )
+			{
+				/* The pending item keeps its place in the queue, so an item
+				that is updated often is not starved by keys updated less
+				often. */
+				( void ) memcpy( ( void * ) &( pxQueue->pcHead[ uxSlot * pxQueue->uxItemSize ] ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
 	}
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_CONFLATING_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if( configUSE_CONFLATING_QUEUES == 1 )
 
-	void vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber )
+	static void prvReleaseItemKey( const Queue_t * const pxQueue, const int8_t * const pcItem )
 	{
-		( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
-	}
-
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
+	QueueKeyIndex_t * const pxKeyIndex = pxQueue->pxKeyIndex;
+	const UBaseType_t uxSlot = ( UBaseType_t ) ( pcItem - pxQueue->pcHead ) / pxQueue->uxItemSize; /*lint !e946 !e947 Pointer subtraction within the same storage area. */
+	const UBaseType_t uxKey = pxKeyIndex->puxSlotKey[ uxSlot ];
 
-	uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
-	{
-		return ( ( Queue_t * ) xQueue )->ucQueueType;
+		if( uxKey != queueNO_KEY )
+		{
+			/* A later item with the same key goes to the back of the queue
+			again. */
+			pxKeyIndex->puxKeySlot[ uxKey ] = queueNO_KEY_SLOT;
+			pxKeyIndex->puxSlotKey[ uxSlot ] = queueNO_KEY;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 	}
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_CONFLATING_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if( configUSE_MUTEXES == 1 )
+#if( configUSE_CONFLATING_QUEUES == 1 )
 
-	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+	static void prvResetKeyIndex( const Queue_t * const pxQueue )
 	{
-	UBaseType_t uxHighestPriorityOfWaitingTasks;
+	QueueKeyIndex_t * const pxKeyIndex = pxQueue->pxKeyIndex;
+	UBaseType_t ux;
 
-		/* If a task waiting for a mutex causes the mutex holder to inherit a
-		priority, but the waiting task times out, then the holder should
-		disinherit the priority - but only down to the highest priority of any
-		other tasks that are waiting for the same mutex.  For this purpose,
-		return the priority of the highest priority task that is waiting for the
-		mutex. */
-		if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+		for( ux = ( UBaseType_t ) 0U; ux < pxKeyIndex->uxKeys; ux++ )
 		{
-			uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+			pxKeyIndex->puxKeySlot[ ux ] = queueNO_KEY_SLOT;
 		}
-		else
+
+		for( ux = ( UBaseType_t ) 0U; ux < pxQueue->uxLength; ux++ )
 		{
-			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+			pxKeyIndex->puxSlotKey[ ux ] = queueNO_KEY;
 		}
-
-		return uxHighestPriorityOfWaitingTasks;
 	}
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_CONFLATING_QUEUES */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
-{
-BaseType_t xReturn = pdFALSE;
-UBaseType_t uxMessagesWaiting;
 
-	/* This function is called from a critical section. */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, const UBaseType_t uxItemCount )
+{
+const size_t xBytesToCopy = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+size_t xFirstBytes;
 
-	uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+	/* Copy as much as fits before the end of the storage area, then the rest
+	to the start of the storage area. */
+	xFirstBytes = configMIN( ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ), xBytesToCopy ); /*lint !e946 !e947 Pointer subtraction within the same storage area. */
+	( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xFirstBytes ); /*lint !e9087 Cast to void required by function signature. */
 
-	if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+	if( xFirstBytes < xBytesToCopy )
 	{
-		#if ( configUSE_MUTEXES == 1 )
-		{
-			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
-			{
-				/* The mutex is no longer being held. */
-				xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
-				pxQueue->u.xSemaphore.xMutexHolder = NULL;
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
-		}
-		#endif /* configUSE_MUTEXES */
+		( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) ( pcItems + xFirstBytes ), xBytesToCopy - xFirstBytes ); /*lint !e9087 Cast to void required by function signature. */
+		pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytesToCopy - xFirstBytes );
 	}
-	else if( xPosition == queueSEND_TO_BACK )
+	else
 	{
-		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
-		pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+		pxQueue->pcWriteTo += xBytesToCopy;
+
 		if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
 		{
 			pxQueue->pcWriteTo = pxQueue->pcHead;
@@ -2110,33 +3416,87 @@ UBaseType_t uxMessagesWaiting;
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
+
+	pxQueue->uxMessagesWaiting += uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, const UBaseType_t uxItemCount )
+{
+const size_t xBytesToCopy = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+size_t xFirstBytes;
+int8_t *pcReadFrom;
+
+	/* pcReadFrom points to the last item read, so the first item to copy
+	follows it. */
+	pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+
+	if( pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+	{
+		pcReadFrom = pxQueue->pcHead;
+	}
 	else
 	{
-		( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
-		pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
-		if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xFirstBytes = configMIN( ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom ), xBytesToCopy ); /*lint !e946 !e947 Pointer subtraction within the same storage area. */
+	( void ) memcpy( ( void * ) pcBuffer, ( void * ) pcReadFrom, xFirstBytes ); /*lint !e9087 Cast to void required by function signature. */
+
+	if( xFirstBytes < xBytesToCopy )
+	{
+		( void ) memcpy( ( void * ) ( pcBuffer + xFirstBytes ), ( void * ) pxQueue->pcHead, xBytesToCopy - xFirstBytes ); /*lint !e9087 Cast to void required by function signature. */
+		pcReadFrom = pxQueue->pcHead + ( xBytesToCopy - xFirstBytes );
+	}
+	else
+	{
+		pcReadFrom += xBytesToCopy;
+	}
+
+	/* Leave pcReadFrom pointing at the last item copied out. */
+	pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize;
+	pxQueue->uxMessagesWaiting -= uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue, const UBaseType_t uxItemsAdded )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+UBaseType_t uxItem, uxTasksToUnblock = uxItemsAdded;
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		if( pxQueue->pxQueueSetContainer != NULL )
 		{
-			pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+			/* The queue set holds one handle for each item in its members, so
+			it must be notified once per item.  Tasks wait on the set rather
+			than on its members. */
+			for( uxItem = 0; uxItem < uxItemsAdded; uxItem++ )
+			{
+				if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+				{
+					xHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			uxTasksToUnblock = 0;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+	}
+	#endif /* configUSE_QUEUE_SETS */
 
-		if( xPosition == queueOVERWRITE )
+	for( uxItem = 0; ( uxItem < uxTasksToUnblock ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ); uxItem++ )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
 		{
-			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
-			{
-				/* An item is not being added but overwritten, so subtract
-				one from the recorded number of items in the queue so when
-				one is added again below the number of recorded items remains
-				correct. */
-				--uxMessagesWaiting;
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+			xHigherPriorityTaskWoken = pdTRUE;
 		}
 		else
 		{
@@ -2144,27 +3504,28 @@ UBaseType_t uxMessagesWaiting;
 		}
 	}
 
-	pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
-
-	return xReturn;
+	return xHigherPriorityTaskWoken;
 }
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
+static BaseType_t prvUnblockSenders( Queue_t * const pxQueue, const UBaseType_t uxItemsRemoved )
 {
-	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+UBaseType_t uxItem;
+
+	for( uxItem = 0; ( uxItem < uxItemsRemoved ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ); uxItem++ )
 	{
-		pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
-		if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
 		{
-			pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+			xHigherPriorityTaskWoken = pdTRUE;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
-		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
 	}
+
+	return xHigherPriorityTaskWoken;
 }
 /*-----------------------------------------------------------*/
 
@@ -2732,6 +4093,203 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_STATS == 1 )
+
+	static void prvRecordWaitTime( Queue_t * const pxQueue, const uint32_t ulWaitStart )
+	{
+	const uint32_t ulWaitTime = configQUEUE_STATS_TIMESTAMP() - ulWaitStart;
+
+		/* Unsigned arithmetic gives the right answer even if the time stamp
+		has wrapped. */
+		pxQueue->xStats.ulTotalWaitTime += ulWaitTime;
+
+		if( ulWaitTime > pxQueue->xStats.ulMaxWaitTime )
+		{
+			pxQueue->xStats.ulMaxWaitTime = ulWaitTime;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+	void vQueueGetStats( QueueHandle_t xQueue, QueueStats_t *pxStats )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = pxQueue->xStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+	void vQueueResetStats( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			( void ) memset( ( void * ) &( pxQueue->xStats ), 0x00, sizeof( pxQueue->xStats ) );
+			pxQueue->xStats.uxMaxMessagesWaiting = pxQueue->uxMessagesWaiting;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+
+	static BaseType_t prvGetRegistryEntryStats( const UBaseType_t uxEntry, QueueRegistryStats_t * const pxStats )
+	{
+	BaseType_t xReturn = pdFALSE;
+	const Queue_t *pxQueue;
+
+		/* Read the entry in the same critical section as the statistics so
+		the handle cannot be unregistered half way through. */
+		taskENTER_CRITICAL();
+		{
+			pxQueue = xQueueRegistry[ uxEntry ].xHandle;
+
+			if( pxQueue != NULL )
+			{
+				pxStats->pcQueueName = xQueueRegistry[ uxEntry ].pcQueueName;
+				pxStats->xHandle = xQueueRegistry[ uxEntry ].xHandle;
+				pxStats->uxLength = pxQueue->uxLength;
+				pxStats->uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+				pxStats->xStats = pxQueue->xStats;
+
+				#if ( configUSE_TRACE_FACILITY == 1 )
+				{
+					pxStats->ucQueueType = pxQueue->ucQueueType;
+				}
+				#else
+				{
+					/* The type is not stored, so work out as much of it as
+					possible.  Recursive mutexes are reported as mutexes, and
+					queue sets as queues. */
+					if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+					{
+						pxStats->ucQueueType = queueQUEUE_TYPE_MUTEX;
+					}
+					else if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+					{
+						pxStats->ucQueueType = ( pxQueue->uxLength == ( UBaseType_t ) 1 ) ? queueQUEUE_TYPE_BINARY_SEMAPHORE : queueQUEUE_TYPE_COUNTING_SEMAPHORE;
+					}
+					else
+					{
+						pxStats->ucQueueType = queueQUEUE_TYPE_BASE;
+					}
+				}
+				#endif /* configUSE_TRACE_FACILITY */
+
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+
+	UBaseType_t uxQueueGetRegistryStats( QueueRegistryStats_t *pxStats, UBaseType_t uxMaxEntries )
+	{
+	UBaseType_t ux, uxCount = 0;
+
+		configASSERT( ( pxStats != NULL ) || ( uxMaxEntries == ( UBaseType_t ) 0 ) );
+
+		for( ux = ( UBaseType_t ) 0U; ( ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE ) && ( uxCount < uxMaxEntries ); ux++ )
+		{
+			if( prvGetRegistryEntryStats( ux, &( pxStats[ uxCount ] ) ) != pdFALSE )
+			{
+				uxCount++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return uxCount;
+	}
+
+#endif /* ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+
+	void vQueueWriteStats( QueueStatsWriteFunction_t pxWriteLine )
+	{
+	QueueRegistryStats_t xEntry;
+	UBaseType_t ux;
+	char cLine[ queueSTATS_LINE_LENGTH ]; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+		configASSERT( pxWriteLine );
+
+		( void ) snprintf( cLine, sizeof( cLine ), "QS S %lu", ( unsigned long ) configQUEUE_STATS_TIMESTAMP() );
+		pxWriteLine( cLine );
+
+		/* Take one entry at a time so only one line of text is needed, and so
+		the write function, which may block, is called outside of the critical
+		section. */
+		for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+		{
+			if( prvGetRegistryEntryStats( ux, &xEntry ) != pdFALSE )
+			{
+				( void ) snprintf( cLine, sizeof( cLine ), "QS Q %lx %u %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu %s",
+								   ( unsigned long ) ( size_t ) xEntry.xHandle,
+								   ( unsigned int ) xEntry.ucQueueType,
+								   ( unsigned long ) xEntry.uxLength,
+								   ( unsigned long ) xEntry.uxMessagesWaiting,
+								   ( unsigned long ) xEntry.xStats.uxMaxMessagesWaiting,
+								   ( unsigned long ) xEntry.xStats.ulSends,
+								   ( unsigned long ) xEntry.xStats.ulReceives,
+								   ( unsigned long ) xEntry.xStats.ulSendsFailed,
+								   ( unsigned long ) xEntry.xStats.ulReceivesFailed,
+								   ( unsigned long ) xEntry.xStats.ulSendBlocks,
+								   ( unsigned long ) xEntry.xStats.ulReceiveBlocks,
+								   ( unsigned long ) xEntry.xStats.ulTotalWaitTime,
+								   ( unsigned long ) xEntry.xStats.ulMaxWaitTime,
+								   ( unsigned long ) xEntry.xStats.ulPriorityInheritances,
+								   xEntry.pcQueueName );
+				pxWriteLine( cLine );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		pxWriteLine( "QS E" );
+	}
+
+#endif /* ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TIMERS == 1 )
 
 	void vQueueWaitForMessageRestricted( QueueHandle_t xQueue, TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely )
@@ -2897,6 +4455,7 @@ Queue_t * const pxQueue = xQueue;
 
 			/* The data copied is the handle of the queue that contains data. */
 			xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+			queueSTATS_SENT( pxQueueSetContainer, 1 );
 
 			if( cTxLock == queueUNLOCKED )
 			{
@@ -2943,3 +4502,16 @@ Queue_t * const pxQueue = xQueue;
 
 
 
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_READY_SETS == 1 )
+
+	ReadySetMember_t *pxQueueGetReadySetMember( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		return &( pxQueue->xReadySetMember );
+	}
+
+#endif /* configUSE_READY_SETS */
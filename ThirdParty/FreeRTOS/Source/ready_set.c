@@ -0,0 +1,637 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "ready_set.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to include ready set functionality.  This #if is closed at the very bottom of
+this file.  If you want to include ready sets then ensure configUSE_READY_SETS
+is set to 1 in FreeRTOSConfig.h. */
+#if( configUSE_READY_SETS == 1 )
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to use ready sets
+#endif
+
+/* Bits used in the ucFlags member of a ReadySetMember_t. */
+#define readysetFLAGS_IN_READY_LIST		( ( uint8_t ) 1 ) /* Set while the member is linked into its set's ready list. */
+#define readysetFLAGS_EDGE_TRIGGERED	( ( uint8_t ) 2 ) /* Set if the member was added as eReadySetEdge. */
+#define readysetFLAGS_IS_STREAM_BUFFER	( ( uint8_t ) 4 ) /* Set if the member is a stream or message buffer rather than a queue. */
+
+/* Bits used in the ucFlags member of a ready set. */
+#define readysetFLAGS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 1 )
+
+/* Structure that holds the state of a ready set.  The ready list is a singly
+linked FIFO threaded through the members themselves, so marking a member ready
+never allocates memory and never copies anything. */
+typedef struct ReadySetDef_t /*lint !e9058 Style convention uses tag. */
+{
+	ReadySetMember_t *pxReadyHead;				/* The member that became ready first. */
+	ReadySetMember_t *pxReadyTail;				/* The member that became ready last. */
+	volatile TaskHandle_t xTaskWaiting;			/* Holds the handle of the task blocked in uxReadySetWait(), or NULL. */
+	UBaseType_t uxReadyCount;					/* The number of members in the ready list. */
+	UBaseType_t uxNumberOfMembers;				/* The number of members in the set, used to catch sets deleted while still in use. */
+	uint8_t ucFlags;
+} ReadySet_t;
+
+/*
+ * Appends a member to the tail of its set's ready list if it is not already in
+ * the list.  Must be called from a critical section.
+ */
+static void prvMarkReady( ReadySet_t * const pxReadySet,
+						  ReadySetMember_t * const pxMember ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes a member from anywhere in its set's ready list.  Must be called from
+ * a critical section.
+ */
+static void prvUnlinkReady( ReadySet_t * const pxReadySet,
+							ReadySetMember_t * const pxMember ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the queue or stream buffer pxMember is contained in holds
+ * data.
+ */
+static BaseType_t prvMemberHoldsData( const ReadySetMember_t * const pxMember ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves up to uxMaxEvents members that still hold data from the ready list into
+ * pxEvents, dropping members that have since been emptied.  Level triggered
+ * members are put back at the tail of the ready list so they are reported again
+ * while they hold data.  Must be called from a critical section.
+ */
+static UBaseType_t prvCollectReadyMembers( ReadySet_t * const pxReadySet,
+										   ReadySetEvent_t * const pxEvents,
+										   UBaseType_t uxMaxEvents ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both the queue and stream buffer versions of the add and remove
+ * functions.
+ */
+static BaseType_t prvAddMember( ReadySet_t * const pxReadySet,
+								ReadySetMember_t * const pxMember,
+								eReadySetTrigger_t eTrigger,
+								void *pvTag,
+								uint8_t ucTypeFlag ) PRIVILEGED_FUNCTION;
+static BaseType_t prvRemoveMember( ReadySet_t * const pxReadySet,
+								   ReadySetMember_t * const pxMember ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	ReadySetHandle_t xReadySetCreate( void )
+	{
+	ReadySet_t *pxReadySet;
+
+		pxReadySet = ( ReadySet_t * ) pvPortMalloc( sizeof( ReadySet_t ) ); /*lint !e9087 !e9079 see comment above. */
+
+		if( pxReadySet != NULL )
+		{
+			( void ) memset( ( void * ) pxReadySet, 0x00, sizeof( ReadySet_t ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxReadySet;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	ReadySetHandle_t xReadySetCreateStatic( StaticReadySet_t *pxReadySetBuffer )
+	{
+	ReadySet_t *pxReadySet;
+
+		configASSERT( pxReadySetBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticReadySet_t equals the size of the real ready
+			set structure. */
+			volatile size_t xSize = sizeof( StaticReadySet_t );
+			configASSERT( xSize == sizeof( ReadySet_t ) );
+		} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		/* The user has provided a statically allocated ready set - use it. */
+		pxReadySet = ( ReadySet_t * ) pxReadySetBuffer; /*lint !e740 !e9087 ReadySet_t and StaticReadySet_t are deliberately aliased for data hiding purposes and guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+		if( pxReadySet != NULL )
+		{
+			( void ) memset( ( void * ) pxReadySet, 0x00, sizeof( ReadySet_t ) );
+			pxReadySet->ucFlags = readysetFLAGS_IS_STATICALLY_ALLOCATED;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxReadySet;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vReadySetDelete( ReadySetHandle_t xReadySet )
+{
+ReadySet_t * const pxReadySet = xReadySet;
+
+	configASSERT( pxReadySet );
+
+	/* Members point back at the set, so all of them must have been removed. */
+	configASSERT( pxReadySet->uxNumberOfMembers == ( UBaseType_t ) 0 );
+	configASSERT( pxReadySet->xTaskWaiting == NULL );
+
+	if( ( pxReadySet->ucFlags & readysetFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			vPortFree( pxReadySet );
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucFlags must be corrupt.
+			Force an assert. */
+			configASSERT( xReadySet == ( ReadySetHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* The structure was not allocated dynamically and cannot be freed -
+		just scrub it so future use will assert. */
+		( void ) memset( pxReadySet, 0x00, sizeof( ReadySet_t ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xReadySetAddQueue( ReadySetHandle_t xReadySet,
+							  QueueHandle_t xQueueOrSemaphore,
+							  eReadySetTrigger_t eTrigger,
+							  void *pvTag )
+{
+	configASSERT( xReadySet );
+	configASSERT( xQueueOrSemaphore );
+
+	return prvAddMember( xReadySet, pxQueueGetReadySetMember( xQueueOrSemaphore ), eTrigger, pvTag, ( uint8_t ) 0 );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xReadySetAddStreamBuffer( ReadySetHandle_t xReadySet,
+									 StreamBufferHandle_t xStreamBuffer,
+									 eReadySetTrigger_t eTrigger,
+									 void *pvTag )
+{
+	configASSERT( xReadySet );
+	configASSERT( xStreamBuffer );
+
+	return prvAddMember( xReadySet, pxStreamBufferGetReadySetMember( xStreamBuffer ), eTrigger, pvTag, readysetFLAGS_IS_STREAM_BUFFER );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xReadySetRemoveQueue( ReadySetHandle_t xReadySet,
+								 QueueHandle_t xQueueOrSemaphore )
+{
+	configASSERT( xReadySet );
+	configASSERT( xQueueOrSemaphore );
+
+	return prvRemoveMember( xReadySet, pxQueueGetReadySetMember( xQueueOrSemaphore ) );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xReadySetRemoveStreamBuffer( ReadySetHandle_t xReadySet,
+										StreamBufferHandle_t xStreamBuffer )
+{
+	configASSERT( xReadySet );
+	configASSERT( xStreamBuffer );
+
+	return prvRemoveMember( xReadySet, pxStreamBufferGetReadySetMember( xStreamBuffer ) );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxReadySetWait( ReadySetHandle_t xReadySet,
+							ReadySetEvent_t * const pxEvents,
+							UBaseType_t uxMaxEvents,
+							TickType_t xTicksToWait )
+{
+ReadySet_t * const pxReadySet = xReadySet;
+UBaseType_t uxCount;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxReadySet );
+	configASSERT( pxEvents );
+	configASSERT( uxMaxEvents > ( UBaseType_t ) 0 );
+
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			uxCount = prvCollectReadyMembers( pxReadySet, pxEvents, uxMaxEvents );
+
+			if( ( uxCount == ( UBaseType_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+			{
+				/* Nothing is ready so prepare to block.  The notification state
+				is cleared inside the critical section, so a member that becomes
+				ready after this point leaves a notification pending and the
+				wait below returns immediately. */
+				configASSERT( pxReadySet->xTaskWaiting == NULL );
+				( void ) xTaskNotifyStateClear( NULL );
+				pxReadySet->xTaskWaiting = xTaskGetCurrentTaskHandle();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( uxCount > ( UBaseType_t ) 0 ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+		else
+		{
+			traceBLOCKING_ON_READY_SET_WAIT( xReadySet );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+			pxReadySet->xTaskWaiting = NULL;
+
+			/* Look at the ready list once more even if the block time expired,
+			then give up. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				xTicksToWait = ( TickType_t ) 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+void vReadySetSignal( ReadySetMember_t * const pxMember )
+{
+ReadySet_t *pxReadySet;
+
+	taskENTER_CRITICAL();
+	{
+		/* The member may have been removed from its set since the caller
+		looked, so look again inside the critical section. */
+		pxReadySet = pxMember->pxReadySet;
+
+		if( pxReadySet != NULL )
+		{
+			prvMarkReady( pxReadySet, pxMember );
+
+			if( pxReadySet->xTaskWaiting != NULL )
+			{
+				( void ) xTaskNotify( pxReadySet->xTaskWaiting, ( uint32_t ) 0, eNoAction );
+				pxReadySet->xTaskWaiting = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vReadySetSignalFromISR( ReadySetMember_t * const pxMember, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+ReadySet_t *pxReadySet;
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pxReadySet = pxMember->pxReadySet;
+
+		if( pxReadySet != NULL )
+		{
+			prvMarkReady( pxReadySet, pxMember );
+
+			if( pxReadySet->xTaskWaiting != NULL )
+			{
+				( void ) xTaskNotifyFromISR( pxReadySet->xTaskWaiting, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+				pxReadySet->xTaskWaiting = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMarkReady( ReadySet_t * const pxReadySet,
+						  ReadySetMember_t * const pxMember )
+{
+	if( ( pxMember->ucFlags & readysetFLAGS_IN_READY_LIST ) == ( uint8_t ) 0 )
+	{
+		pxMember->pxNextReady = NULL;
+
+		if( pxReadySet->pxReadyTail == NULL )
+		{
+			pxReadySet->pxReadyHead = pxMember;
+		}
+		else
+		{
+			pxReadySet->pxReadyTail->pxNextReady = pxMember;
+		}
+
+		pxReadySet->pxReadyTail = pxMember;
+		pxMember->ucFlags |= readysetFLAGS_IN_READY_LIST;
+		( pxReadySet->uxReadyCount )++;
+	}
+	else
+	{
+		/* Already in the ready list - this is what stops a busy member from
+		costing the waiting task anything more than one event. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnlinkReady( ReadySet_t * const pxReadySet,
+							ReadySetMember_t * const pxMember )
+{
+ReadySetMember_t *pxPrevious = NULL, *pxIterator;
+
+	if( ( pxMember->ucFlags & readysetFLAGS_IN_READY_LIST ) != ( uint8_t ) 0 )
+	{
+		for( pxIterator = pxReadySet->pxReadyHead; pxIterator != pxMember; pxIterator = pxIterator->pxNextReady )
+		{
+			configASSERT( pxIterator );
+			pxPrevious = pxIterator;
+		}
+
+		if( pxPrevious == NULL )
+		{
+			pxReadySet->pxReadyHead = pxMember->pxNextReady;
+		}
+		else
+		{
+			pxPrevious->pxNextReady = pxMember->pxNextReady;
+		}
+
+		if( pxReadySet->pxReadyTail == pxMember )
+		{
+			pxReadySet->pxReadyTail = pxPrevious;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxMember->pxNextReady = NULL;
+		pxMember->ucFlags &= ( uint8_t ) ~readysetFLAGS_IN_READY_LIST;
+		( pxReadySet->uxReadyCount )--;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMemberHoldsData( const ReadySetMember_t * const pxMember )
+{
+BaseType_t xReturn;
+
+	if( ( pxMember->ucFlags & readysetFLAGS_IS_STREAM_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xReturn = ( xStreamBufferIsEmpty( ( StreamBufferHandle_t ) pxMember->pvMember ) == pdFALSE ) ? pdTRUE : pdFALSE;
+	}
+	else
+	{
+		xReturn = ( uxQueueMessagesWaitingFromISR( ( QueueHandle_t ) pxMember->pvMember ) > ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCollectReadyMembers( ReadySet_t * const pxReadySet,
+										   ReadySetEvent_t * const pxEvents,
+										   UBaseType_t uxMaxEvents )
+{
+UBaseType_t uxCount = 0, uxToExamine;
+ReadySetMember_t *pxMember;
+
+	/* Only the members that were in the list on entry are examined, so level
+	triggered members put back at the tail are not reported twice. */
+	uxToExamine = pxReadySet->uxReadyCount;
+
+	while( ( uxToExamine > ( UBaseType_t ) 0 ) && ( uxCount < uxMaxEvents ) )
+	{
+		uxToExamine--;
+
+		/* Pop the member at the head of the ready list. */
+		pxMember = pxReadySet->pxReadyHead;
+		pxReadySet->pxReadyHead = pxMember->pxNextReady;
+
+		if( pxReadySet->pxReadyHead == NULL )
+		{
+			pxReadySet->pxReadyTail = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxMember->pxNextReady = NULL;
+		pxMember->ucFlags &= ( uint8_t ) ~readysetFLAGS_IN_READY_LIST;
+		( pxReadySet->uxReadyCount )--;
+
+		/* The member may have been emptied by a receive since it was marked
+		ready, in which case it is dropped until it is next written to. */
+		if( prvMemberHoldsData( pxMember ) != pdFALSE )
+		{
+			pxEvents[ uxCount ].pvMember = pxMember->pvMember;
+			pxEvents[ uxCount ].pvTag = pxMember->pvTag;
+			uxCount++;
+
+			if( ( pxMember->ucFlags & readysetFLAGS_EDGE_TRIGGERED ) == ( uint8_t ) 0 )
+			{
+				prvMarkReady( pxReadySet, pxMember );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAddMember( ReadySet_t * const pxReadySet,
+								ReadySetMember_t * const pxMember,
+								eReadySetTrigger_t eTrigger,
+								void *pvTag,
+								uint8_t ucTypeFlag )
+{
+BaseType_t xReturn;
+
+	taskENTER_CRITICAL();
+	{
+		if( pxMember->pxReadySet != NULL )
+		{
+			/* Cannot add a member to more than one ready set. */
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			pxMember->pvTag = pvTag;
+			pxMember->pxNextReady = NULL;
+			pxMember->ucFlags = ucTypeFlag;
+
+			if( eTrigger == eReadySetEdge )
+			{
+				pxMember->ucFlags |= readysetFLAGS_EDGE_TRIGGERED;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxMember->pxReadySet = pxReadySet;
+			( pxReadySet->uxNumberOfMembers )++;
+
+			/* Data written before the member was added would otherwise not be
+			reported until the member is written to again. */
+			if( prvMemberHoldsData( pxMember ) != pdFALSE )
+			{
+				prvMarkReady( pxReadySet, pxMember );
+
+				if( pxReadySet->xTaskWaiting != NULL )
+				{
+					( void ) xTaskNotify( pxReadySet->xTaskWaiting, ( uint32_t ) 0, eNoAction );
+					pxReadySet->xTaskWaiting = NULL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRemoveMember( ReadySet_t * const pxReadySet,
+								   ReadySetMember_t * const pxMember )
+{
+BaseType_t xReturn;
+
+	taskENTER_CRITICAL();
+	{
+		if( pxMember->pxReadySet != pxReadySet )
+		{
+			/* The member is not in this set. */
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			prvUnlinkReady( pxReadySet, pxMember );
+			pxMember->pxReadySet = NULL;
+			pxMember->ucFlags = ( uint8_t ) 0;
+			( pxReadySet->uxNumberOfMembers )--;
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include ready set functionality.  If you want to include ready sets then
+ensure configUSE_READY_SETS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_READY_SETS == 1 */
@@ -0,0 +1,185 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "slab.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to use slab caches.  This #if is closed at the very bottom of this file. */
+#if( configUSE_KERNEL_OBJECT_SLABS == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use slab caches
+#endif
+
+/* The caches that have been used, most recently used first. */
+PRIVILEGED_DATA static SlabCache_t *pxSlabCaches = NULL;
+
+/*-----------------------------------------------------------*/
+
+void *pvSlabAllocate( SlabCache_t *pxCache )
+{
+void *pvReturn = NULL;
+
+	/* Free objects are linked through their first word, so each object must
+	be large enough to hold a pointer. */
+	configASSERT( pxCache->xObjectSize >= sizeof( void * ) );
+
+	taskENTER_CRITICAL();
+	{
+		if( pxCache->pvFreeList != NULL )
+		{
+			/* Reuse the most recently freed object. */
+			pvReturn = pxCache->pvFreeList;
+			pxCache->pvFreeList = *( ( void ** ) pvReturn );
+		}
+		else if( pxCache->pucNextUnused < pxCache->pucEnd )
+		{
+			/* Use an object that has never been allocated. */
+			pvReturn = ( void * ) pxCache->pucNextUnused;
+			pxCache->pucNextUnused += pxCache->xObjectSize;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pvReturn != NULL )
+		{
+			( pxCache->uxObjectsInUse )++;
+
+			if( pxCache->uxObjectsInUse > pxCache->uxMaximumObjectsInUse )
+			{
+				pxCache->uxMaximumObjectsInUse = pxCache->uxObjectsInUse;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			( pxCache->xNumberOfFallbackAllocations )++;
+		}
+
+		if( pxCache->xRegistered == pdFALSE )
+		{
+			pxCache->pxNextCache = pxSlabCaches;
+			pxSlabCaches = pxCache;
+			pxCache->xRegistered = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( pvReturn == NULL )
+	{
+		/* The cache is full. */
+		pvReturn = pvPortMalloc( pxCache->xObjectSize );
+	}
+	else
+	{
+		traceMALLOC( pvReturn, pxCache->xObjectSize );
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vSlabFree( SlabCache_t *pxCache, void *pv )
+{
+uint8_t * const puc = ( uint8_t * ) pv;
+
+	if( ( puc >= pxCache->pucStart ) && ( puc < pxCache->pucEnd ) )
+	{
+		/* Check the object is the start of an object in the cache. */
+		configASSERT( ( ( size_t ) ( puc - pxCache->pucStart ) % pxCache->xObjectSize ) == ( size_t ) 0 );
+
+		traceFREE( pv, pxCache->xObjectSize );
+
+		taskENTER_CRITICAL();
+		{
+			*( ( void ** ) pv ) = pxCache->pvFreeList;
+			pxCache->pvFreeList = pv;
+			( pxCache->uxObjectsInUse )--;
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		/* The object was allocated from the heap because the cache was
+		full. */
+		vPortFree( pv );
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxSlabGetStats( SlabStats_t *pxSlabStatsArray, const UBaseType_t uxArraySize )
+{
+SlabCache_t const *pxCache;
+UBaseType_t uxCount = 0U;
+
+	taskENTER_CRITICAL();
+	{
+		for( pxCache = pxSlabCaches; ( pxCache != NULL ) && ( uxCount < uxArraySize ); pxCache = pxCache->pxNextCache )
+		{
+			pxSlabStatsArray[ uxCount ].pcName = pxCache->pcName;
+			pxSlabStatsArray[ uxCount ].xObjectSize = pxCache->xObjectSize;
+			pxSlabStatsArray[ uxCount ].uxObjectCount = ( UBaseType_t ) ( ( size_t ) ( pxCache->pucEnd - pxCache->pucStart ) / pxCache->xObjectSize );
+			pxSlabStatsArray[ uxCount ].uxObjectsInUse = pxCache->uxObjectsInUse;
+			pxSlabStatsArray[ uxCount ].uxMaximumObjectsInUse = pxCache->uxMaximumObjectsInUse;
+			pxSlabStatsArray[ uxCount ].xNumberOfFallbackAllocations = pxCache->xNumberOfFallbackAllocations;
+			uxCount++;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return uxCount;
+}
+
+/* This entire source file will be skipped if the application is not configured
+to use slab caches.  This #if is closed at the very bottom of this file. */
+#endif /* configUSE_KERNEL_OBJECT_SLABS == 1 */
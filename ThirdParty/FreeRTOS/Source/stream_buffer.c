@@ -39,6 +39,10 @@ task.h is included from an application file. */
 #include "task.h"
 #include "stream_buffer.h"
 
+#if( configUSE_READY_SETS == 1 )
+	#include "ready_set.h"
+#endif
+
 #if( configUSE_TASK_NOTIFICATIONS != 1 )
 	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
 #endif
@@ -152,6 +156,10 @@ typedef struct StreamBufferDef_t /*lint !e9058 Style convention uses tag. */
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxStreamBufferNumber;		/* Used for tracing purposes. */
 	#endif
+
+	#if ( configUSE_READY_SETS == 1 )
+		ReadySetMember_t xReadySetMember;		/* Links the stream buffer into the ready list of the ready set it belongs to. */
+	#endif
 } StreamBuffer_t;
 
 /*
@@ -202,6 +210,34 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer,
 									  size_t xMaxCount,
 									  size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
 
+/*
+ * Return the length of the largest contiguous region that can be written in
+ * place, and set *ppvData to its start.  For a message buffer the region starts
+ * after the space needed for the message length.
+ */
+static size_t prvGetWritableRegion( StreamBuffer_t * const pxStreamBuffer, void **ppvData ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the length of the data that can be read in place, and set *ppvData to
+ * its start.  For a stream buffer that is the data before the end of the
+ * storage area.  For a message buffer it is the length of the next message,
+ * and *ppvData is NULL if the message wraps around the end of the storage
+ * area.
+ */
+static size_t prvGetReadableRegion( StreamBuffer_t * const pxStreamBuffer, void **ppvData ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add xDataLengthBytes bytes that have already been written in place at the
+ * region returned by prvGetWritableRegion() to the buffer.
+ */
+static size_t prvCommitWrittenBytes( StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove xDataLengthBytes bytes that have been read in place, or for a message
+ * buffer the next message, from the buffer.
+ */
+static size_t prvConsumeReadBytes( StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -364,6 +400,14 @@ StreamBuffer_t * pxStreamBuffer = xStreamBuffer;
 
 	traceSTREAM_BUFFER_DELETE( xStreamBuffer );
 
+	#if( configUSE_READY_SETS == 1 )
+	{
+		/* The buffer must be removed from its ready set before it is
+		deleted. */
+		configASSERT( pxStreamBuffer->xReadySetMember.pxReadySet == NULL );
+	}
+	#endif
+
 	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
 	{
 		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
@@ -398,6 +442,10 @@ BaseType_t xReturn = pdFAIL;
 	UBaseType_t uxStreamBufferNumber;
 #endif
 
+#if( configUSE_READY_SETS == 1 )
+	ReadySetMember_t xReadySetMember;
+#endif
+
 	configASSERT( pxStreamBuffer );
 
 	#if( configUSE_TRACE_FACILITY == 1 )
@@ -415,6 +463,15 @@ BaseType_t xReturn = pdFAIL;
 		{
 			if( pxStreamBuffer->xTaskWaitingToSend == NULL )
 			{
+				#if( configUSE_READY_SETS == 1 )
+				{
+					/* Resetting the buffer does not remove it from its ready
+					set.  If the buffer is in the set's ready list it is dropped
+					from the list when the set finds it empty. */
+					xReadySetMember = pxStreamBuffer->xReadySetMember;
+				}
+				#endif
+
 				prvInitialiseNewStreamBuffer( pxStreamBuffer,
 											  pxStreamBuffer->pucBuffer,
 											  pxStreamBuffer->xLength,
@@ -422,6 +479,12 @@ BaseType_t xReturn = pdFAIL;
 											  pxStreamBuffer->ucFlags );
 				xReturn = pdPASS;
 
+				#if( configUSE_READY_SETS == 1 )
+				{
+					pxStreamBuffer->xReadySetMember = xReadySetMember;
+				}
+				#endif
+
 				#if( configUSE_TRACE_FACILITY == 1 )
 				{
 					pxStreamBuffer->uxStreamBufferNumber = uxStreamBufferNumber;
@@ -596,6 +659,12 @@ TimeOut_t xTimeOut;
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		#if( configUSE_READY_SETS == 1 )
+		{
+			readysetSIGNAL( &( pxStreamBuffer->xReadySetMember ) );
+		}
+		#endif
 	}
 	else
 	{
@@ -646,6 +715,12 @@ size_t xRequiredSpace = xDataLengthBytes;
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		#if( configUSE_READY_SETS == 1 )
+		{
+			readysetSIGNAL_FROM_ISR( &( pxStreamBuffer->xReadySetMember ), pxHigherPriorityTaskWoken );
+		}
+		#endif
 	}
 	else
 	{
@@ -1085,6 +1160,484 @@ UBaseType_t uxSavedInterruptStatus;
 }
 /*-----------------------------------------------------------*/
 
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+								 void **ppvData,
+								 TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xSpace, xRequiredSpace = ( size_t ) 1;
+TimeOut_t xTimeOut;
+
+	configASSERT( ppvData );
+	configASSERT( pxStreamBuffer );
+
+	/* At least one byte of data must fit, after the message length if this is
+	a message buffer. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			/* Wait until there is space to write to, as in
+			xStreamBufferSend(). */
+			taskENTER_CRITICAL();
+			{
+				xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+				if( xSpace < xRequiredSpace )
+				{
+					/* Clear notification state as going to wait for space. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one writer. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					taskEXIT_CRITICAL();
+					break;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return prvGetWritableRegion( pxStreamBuffer, ppvData );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+										void **ppvData )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+	configASSERT( ppvData );
+	configASSERT( pxStreamBuffer );
+
+	return prvGetWritableRegion( pxStreamBuffer, ppvData );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+								size_t xDataLengthBytes )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvCommitWrittenBytes( pxStreamBuffer, xDataLengthBytes );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configUSE_READY_SETS == 1 )
+		{
+			readysetSIGNAL( &( pxStreamBuffer->xReadySetMember ) );
+		}
+		#endif
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+									   size_t xDataLengthBytes,
+									   BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvCommitWrittenBytes( pxStreamBuffer, xDataLengthBytes );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configUSE_READY_SETS == 1 )
+		{
+			readysetSIGNAL_FROM_ISR( &( pxStreamBuffer->xReadySetMember ), pxHigherPriorityTaskWoken );
+		}
+		#endif
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceivePeek( StreamBufferHandle_t xStreamBuffer,
+								 void **ppvData,
+								 TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xBytesAvailable, xBytesToStoreMessageLength;
+
+	configASSERT( ppvData );
+	configASSERT( pxStreamBuffer );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+	else
+	{
+		xBytesToStoreMessageLength = 0;
+	}
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		/* Wait for data as in xStreamBufferReceive().  Checking if there is
+		data and clearing the notification state must be performed
+		atomically. */
+		taskENTER_CRITICAL();
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+			if( xBytesAvailable <= xBytesToStoreMessageLength )
+			{
+				/* Clear notification state as going to wait for data. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Should only be one reader. */
+				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBytesAvailable <= xBytesToStoreMessageLength )
+		{
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return prvGetReadableRegion( pxStreamBuffer, ppvData );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceivePeekFromISR( StreamBufferHandle_t xStreamBuffer,
+										void **ppvData )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+	configASSERT( ppvData );
+	configASSERT( pxStreamBuffer );
+
+	return prvGetReadableRegion( pxStreamBuffer, ppvData );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveConsume( StreamBufferHandle_t xStreamBuffer,
+									size_t xDataLengthBytes )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvConsumeReadBytes( pxStreamBuffer, xDataLengthBytes );
+
+	/* Was a task waiting for space in the buffer? */
+	if( xReturn > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+		sbRECEIVE_COMPLETED( pxStreamBuffer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+										   size_t xDataLengthBytes,
+										   BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvConsumeReadBytes( pxStreamBuffer, xDataLengthBytes );
+
+	/* Was a task waiting for space in the buffer? */
+	if( xReturn > ( size_t ) 0 )
+	{
+		sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvGetWritableRegion( StreamBuffer_t * const pxStreamBuffer, void **ppvData )
+{
+size_t xSpace, xStart, xBytesToStoreMessageLength, xReturn;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+	else
+	{
+		xBytesToStoreMessageLength = 0;
+	}
+
+	/* Only the writer moves the head, so the space can only grow after it is
+	read here. */
+	xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+	if( xSpace > xBytesToStoreMessageLength )
+	{
+		/* The message length is written at the head when the message is
+		committed, and may wrap.  The data itself must not wrap, so the region
+		ends at the end of the storage area. */
+		xStart = pxStreamBuffer->xHead + xBytesToStoreMessageLength;
+
+		if( xStart >= pxStreamBuffer->xLength )
+		{
+			xStart -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		*ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ xStart ] );
+		xReturn = configMIN( pxStreamBuffer->xLength - xStart, xSpace - xBytesToStoreMessageLength );
+	}
+	else
+	{
+		*ppvData = NULL;
+		xReturn = 0;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvGetReadableRegion( StreamBuffer_t * const pxStreamBuffer, void **ppvData )
+{
+size_t xBytesAvailable, xStart, xReturn;
+
+	xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+	*ppvData = NULL;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xReturn = xStreamBufferNextMessageLengthBytes( pxStreamBuffer );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			xStart = pxStreamBuffer->xTail + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+			if( xStart >= pxStreamBuffer->xLength )
+			{
+				xStart -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* A message written by xMessageBufferSend() can wrap around the
+			end of the storage area, in which case it cannot be read in place
+			and *ppvData is left NULL. */
+			if( ( xStart + xReturn ) <= pxStreamBuffer->xLength )
+			{
+				*ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ xStart ] );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else if( xBytesAvailable > ( size_t ) 0 )
+	{
+		/* Return the data before the end of the storage area.  Any data that
+		has wrapped is returned by the next call. */
+		*ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xTail ] );
+		xReturn = configMIN( pxStreamBuffer->xLength - pxStreamBuffer->xTail, xBytesAvailable );
+	}
+	else
+	{
+		xReturn = 0;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCommitWrittenBytes( StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes )
+{
+size_t xNextHead;
+void *pvRegion;
+
+	/* The data must fit in the region returned by the reserve call. */
+	configASSERT( xDataLengthBytes <= prvGetWritableRegion( pxStreamBuffer, &pvRegion ) );
+	( void ) pvRegion;
+
+	if( xDataLengthBytes > ( size_t ) 0 )
+	{
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* Write the length in front of the message, moving the head to the
+			start of the data. */
+			( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* The data is already in place, so just move the head past it. */
+		xNextHead = pxStreamBuffer->xHead + xDataLengthBytes;
+
+		if( xNextHead >= pxStreamBuffer->xLength )
+		{
+			xNextHead -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xHead = xNextHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvConsumeReadBytes( StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes )
+{
+size_t xCount, xNextTail;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		/* A message is always removed whole. */
+		configASSERT( xDataLengthBytes == xStreamBufferNextMessageLengthBytes( pxStreamBuffer ) );
+		xDataLengthBytes = xStreamBufferNextMessageLengthBytes( pxStreamBuffer );
+
+		if( xDataLengthBytes > ( size_t ) 0 )
+		{
+			xCount = xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			xCount = 0;
+		}
+	}
+	else
+	{
+		configASSERT( xDataLengthBytes <= prvBytesInBuffer( pxStreamBuffer ) );
+		xDataLengthBytes = configMIN( xDataLengthBytes, prvBytesInBuffer( pxStreamBuffer ) );
+		xCount = xDataLengthBytes;
+	}
+
+	/* The data has already been read in place, so just move the tail past
+	it. */
+	xNextTail = pxStreamBuffer->xTail + xCount;
+
+	if( xNextTail >= pxStreamBuffer->xLength )
+	{
+		xNextTail -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxStreamBuffer->xTail = xNextTail;
+
+	return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
 {
 size_t xNextHead, xFirstLength;
@@ -1230,6 +1783,13 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	pxStreamBuffer->xLength = xBufferSizeBytes;
 	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
 	pxStreamBuffer->ucFlags = ucFlags;
+
+	#if( configUSE_READY_SETS == 1 )
+	{
+		/* The other members were zeroed by the memset() above. */
+		pxStreamBuffer->xReadySetMember.pvMember = ( void * ) pxStreamBuffer;
+	}
+	#endif
 }
 
 #if ( configUSE_TRACE_FACILITY == 1 )
@@ -1261,3 +1821,14 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_READY_SETS == 1 )
+
+	ReadySetMember_t *pxStreamBufferGetReadySetMember( StreamBufferHandle_t xStreamBuffer )
+	{
+		configASSERT( xStreamBuffer );
+		return &( xStreamBuffer->xReadySetMember );
+	}
+
+#endif /* configUSE_READY_SETS */
+/*-----------------------------------------------------------*/
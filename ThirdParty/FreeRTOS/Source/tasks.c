@@ -40,6 +40,10 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "stack_macros.h"
 
+#if ( configUSE_KERNEL_OBJECT_SLABS == 1 )
+	#include "slab.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
 for the header files above, but not in this file, in order to generate the
@@ -112,7 +116,143 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/* Tasks at configEDF_TASK_PRIORITY are not time sliced round robin.  Their
+	ready list is kept in deadline order, so the task at its head, which has the
+	earliest absolute deadline, is selected instead. */
+	#define taskSELECT_FROM_READY_LIST( uxTopPriority )														\
+	{																									\
+		if( ( uxTopPriority ) == ( UBaseType_t ) configEDF_TASK_PRIORITY )								\
+		{																								\
+			pxCurrentTCB = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ) );	\
+		}																								\
+		else																							\
+		{																								\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxTopPriority ) ] ) );	\
+		}																								\
+	}
+
+	#define taskINSERT_INTO_READY_LIST( pxTCB )																\
+	{																									\
+		if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY )							\
+		{																								\
+			prvInsertInDeadlineOrder( ( pxTCB ) );														\
+		}																								\
+		else																							\
+		{																								\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) );	\
+		}																								\
+	}
+
+	/* A readied EDF task preempts the running EDF task if it was inserted
+	ahead of it, which means its deadline is earlier. */
+	#define taskDEADLINE_PREEMPTS_CURRENT( pxTCB )	( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) &&						\
+													  ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) &&					\
+													  ( ( pxTCB ) != pxCurrentTCB ) &&																\
+													  ( listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ) ) == ( pxTCB ) ) )
+
+	/* Deadlines are absolute tick counts so may wrap.  xA is before xB if the
+	tick count has to advance less than half its range to get from xA to xB. */
+	#define taskDEADLINE_IS_BEFORE( xA, xB )	( ( TickType_t ) ( ( xA ) - ( xB ) ) > ( portMAX_DELAY >> 1 ) )
+
+#else
+
+	#define taskSELECT_FROM_READY_LIST( uxTopPriority )	listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxTopPriority ) ] ) )
+	#define taskINSERT_INTO_READY_LIST( pxTCB )			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+	#define taskDEADLINE_PREEMPTS_CURRENT( pxTCB )		( pdFALSE )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
+/* Decide whether a task of priority uxPriority that has just been readied
+should preempt the running task.  If configUSE_PREEMPTION_THRESHOLD is 1 and the
+running task has a preemption threshold above its priority then only tasks with
+a priority above the threshold preempt it, and tasks of equal priority do not
+time slice with it. */
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	#define taskPREEMPTION_THRESHOLD_ACTIVE()						( pxCurrentTCB->uxPreemptionThreshold > pxCurrentTCB->uxPriority )
+	#define taskPRIORITY_PREEMPTS_CURRENT( uxReadyPriority )				( taskPREEMPTION_THRESHOLD_ACTIVE() ? ( ( uxReadyPriority ) > pxCurrentTCB->uxPreemptionThreshold ) : ( ( uxReadyPriority ) > pxCurrentTCB->uxPriority ) )
+	#define taskPRIORITY_PREEMPTS_OR_SHARES_CURRENT( uxReadyPriority )	( taskPREEMPTION_THRESHOLD_ACTIVE() ? ( ( uxReadyPriority ) > pxCurrentTCB->uxPreemptionThreshold ) : ( ( uxReadyPriority ) >= pxCurrentTCB->uxPriority ) )
+
+#else
+
+	#define taskPREEMPTION_THRESHOLD_ACTIVE()						( pdFALSE )
+	#define taskPRIORITY_PREEMPTS_CURRENT( uxReadyPriority )				( ( uxReadyPriority ) > pxCurrentTCB->uxPriority )
+	#define taskPRIORITY_PREEMPTS_OR_SHARES_CURRENT( uxReadyPriority )	( ( uxReadyPriority ) >= pxCurrentTCB->uxPriority )
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+
+/* Decide whether the task pxTCB, which has just been placed in a ready list,
+should preempt the running task, by priority or, for EDF tasks, by deadline. */
+#define taskREADIED_TASK_PREEMPTS_CURRENT( pxTCB )	( taskPRIORITY_PREEMPTS_CURRENT( ( pxTCB )->uxPriority ) || taskDEADLINE_PREEMPTS_CURRENT( pxTCB ) )
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TWO_LEVEL_TASK_SELECTION == 1 )
+
+	/* If configUSE_TWO_LEVEL_TASK_SELECTION is 1 then the ready priorities are
+	held in a two level bitmap.  Bit n of ulReadyPriorityMap[ g ] is set when
+	pxReadyTasksLists[ ( g * 32 ) + n ] is not empty, and bit g of
+	ulReadyGroupMap is set when ulReadyPriorityMap[ g ] is not zero.  The
+	highest ready priority is then found with two bit scans however many
+	priorities there are, allowing up to 1024 priorities. */
+	#if( configMAX_PRIORITIES > 1024 )
+		#error configMAX_PRIORITIES cannot exceed 1024 when configUSE_TWO_LEVEL_TASK_SELECTION is 1.
+	#endif
+
+	#define taskREADY_PRIORITY_GROUPS		( ( configMAX_PRIORITIES + 31 ) / 32 )
+
+	#define taskHIGHEST_SET_BIT( ulBitmap )	( ( UBaseType_t ) 31U - ( UBaseType_t ) portCOUNT_LEADING_ZEROS( ( ulBitmap ) ) )
+
+	#define taskRECORD_READY_PRIORITY( uxPriority )														\
+	{																									\
+		ulReadyPriorityMap[ ( uxPriority ) >> 5 ] |= ( 1UL << ( ( uxPriority ) & 0x1fUL ) );				\
+		ulReadyGroupMap |= ( 1UL << ( ( uxPriority ) >> 5 ) );											\
+	} /* taskRECORD_READY_PRIORITY */
+
+	/*-----------------------------------------------------------*/
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()															\
+	{																									\
+	UBaseType_t uxTopGroup, uxTopPriority;																\
+																										\
+		/* Find the highest group that contains ready tasks, then the highest						\
+		priority within that group. */																	\
+		uxTopGroup = taskHIGHEST_SET_BIT( ulReadyGroupMap );											\
+		uxTopPriority = ( uxTopGroup << 5 ) + taskHIGHEST_SET_BIT( ulReadyPriorityMap[ uxTopGroup ] );	\
+		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );			\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );													\
+		uxTopReadyPriority = uxTopPriority;																\
+	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
+
+	/*-----------------------------------------------------------*/
+
+	/* Clear the bit for uxPriority, and the group bit too if it was the last
+	ready priority in its group.  The second parameter is unused and only
+	present for compatibility with the port optimised version of the macro. */
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )										\
+	{																									\
+		ulReadyPriorityMap[ ( uxPriority ) >> 5 ] &= ~( 1UL << ( ( uxPriority ) & 0x1fUL ) );			\
+		if( ulReadyPriorityMap[ ( uxPriority ) >> 5 ] == 0UL )											\
+		{																								\
+			ulReadyGroupMap &= ~( 1UL << ( ( uxPriority ) >> 5 ) );										\
+		}																								\
+	}
+
+	/* Only reset the ready priority if the TCB being reset was the last one
+	referenced from its ready list. */
+	#define taskRESET_READY_PRIORITY( uxPriority )														\
+	{																									\
+		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 )	\
+		{																								\
+			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
+		}																								\
+	}
+
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
 	performed in a generic way that is not optimised to any particular
@@ -143,7 +283,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 																										\
 		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
 		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );													\
 		uxTopReadyPriority = uxTopPriority;																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -173,7 +313,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 		/* Find the highest priority list that contains ready tasks. */								\
 		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );												\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -213,12 +353,13 @@ count overflows. */
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or in deadline order at
+ * configEDF_TASK_PRIORITY if configUSE_EDF_SCHEDULING is 1.
  */
 #define prvAddTaskToReadyList( pxTCB )																\
 	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
 	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+	taskINSERT_INTO_READY_LIST( pxTCB );															\
 	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 /*-----------------------------------------------------------*/
 
@@ -244,6 +385,30 @@ to its original value when it is released. */
 	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
 #endif
 
+/* Sets the event list item value of pxTCB to match uxPriority after the
+priority of the task has changed.  An event list that carries a priority index
+must stay sorted for the index to remain valid, so if the task is waiting in
+such a list it is re-inserted at the position that matches its new priority. */
+#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+	#define taskSET_EVENT_LIST_ITEM_PRIORITY( pxTCB, uxPriority )												\
+	{																											\
+	List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( ( pxTCB )->xEventListItem ) );					\
+																												\
+		if( ( pxEventList != NULL ) && ( pxEventList->pxPriorityIndex != NULL ) )								\
+		{																										\
+			( void ) uxListRemove( &( ( pxTCB )->xEventListItem ) );											\
+			listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) ( uxPriority ) ); \
+			vListInsert( pxEventList, &( ( pxTCB )->xEventListItem ) );										\
+		}																										\
+		else																									\
+		{																										\
+			listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) ( uxPriority ) ); \
+		}																										\
+	}
+#else
+	#define taskSET_EVENT_LIST_ITEM_PRIORITY( pxTCB, uxPriority )	listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) ( uxPriority ) ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+#endif /* configUSE_PRIORITY_INDEXED_EVENT_LISTS */
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -308,8 +473,8 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments in FreeRTOS.h with the definition of
@@ -326,6 +491,28 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		int iTaskErrno;
 	#endif
 
+	#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+		UBaseType_t		uxPreemptionThreshold;	/*< Only tasks with a priority above this value can preempt the task while it is running.  Has no effect if not above uxPriority. */
+		struct tskTaskControlBlock *pxNextThresholdPreempted; /*< Links the tasks that were preempted while their threshold was active. */
+	#endif
+
+	#if( configUSE_TASK_BUDGETS == 1 )
+		TickType_t		xBudget;				/*< The number of ticks the task can execute for at its own priority in each budget period. */
+		TickType_t		xBudgetPeriod;			/*< The budget replenishment period, or 0 if the task has no budget. */
+		TickType_t		xBudgetRemaining;		/*< The budget left in the current period. */
+		TickType_t		xBudgetPeriodStart;		/*< The tick count at which the current budget period started. */
+		UBaseType_t		uxBudgetOverruns;		/*< The number of periods in which the task exhausted its budget. */
+		ListItem_t		xBudgetListItem;		/*< Used to reference the task from xBudgetExhaustedTaskList. */
+	#endif
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xEDFPeriod;				/*< The period set by vTaskSetPeriodicDeadline(). */
+		TickType_t		xEDFRelativeDeadline;	/*< The deadline relative to the start of each period, or 0 if the task is not an EDF task. */
+		TickType_t		xEDFReleaseTime;		/*< The tick count at which the current job was released. */
+		TickType_t		xEDFAbsoluteDeadline;	/*< The tick count by which the current job should complete. */
+		UBaseType_t		uxEDFDeadlineMisses;	/*< The number of jobs that completed after their deadline. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -378,6 +565,28 @@ PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
 
+#if ( configUSE_TWO_LEVEL_TASK_SELECTION == 1 )
+
+	/* See the definition of taskSELECT_HIGHEST_PRIORITY_TASK(). */
+	PRIVILEGED_DATA static volatile uint32_t ulReadyGroupMap = 0UL;
+	PRIVILEGED_DATA static volatile uint32_t ulReadyPriorityMap[ taskREADY_PRIORITY_GROUPS ] = { 0UL };
+
+#endif
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	PRIVILEGED_DATA static List_t xBudgetExhaustedTaskList;				/*< Tasks that have exhausted their budget and are waiting for it to be replenished. */
+
+#endif
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	/* Tasks that were preempted while their preemption threshold was active,
+	most recently preempted (and so highest threshold) first. */
+	PRIVILEGED_DATA static TCB_t * pxThresholdPreemptedTCB = NULL;
+
+#endif
+
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
 lists the xStateListItem can be referenced from, if the scheduler is suspended.
@@ -397,6 +606,24 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+/* Task control blocks are taken from a slab cache, if one is configured, so
+creating and deleting tasks does not fragment the heap.  Stacks are always
+allocated from the heap. */
+#if ( configUSE_KERNEL_OBJECT_SLABS == 1 )
+
+	PRIVILEGED_DATA static TCB_t xTCBSlabObjects[ configSLAB_TASK_COUNT ];
+	PRIVILEGED_DATA static SlabCache_t xTCBSlab = slabCACHE_INITIALISER( xTCBSlabObjects, "TCB" );
+
+	#define taskALLOCATE_TCB()		( ( TCB_t * ) pvSlabAllocate( &xTCBSlab ) )
+	#define taskFREE_TCB( pxTCB )	vSlabFree( &xTCBSlab, ( pxTCB ) )
+
+#else
+
+	#define taskALLOCATE_TCB()		( ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ) )
+	#define taskFREE_TCB( pxTCB )	vPortFree( pxTCB )
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -574,6 +801,46 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
+/*
+ * Inserts pxTCB into the ready list at configEDF_TASK_PRIORITY after every
+ * task with the same or an earlier absolute deadline, so the list stays in
+ * deadline order and tasks with equal deadlines run in the order they became
+ * ready.  A task that is not an EDF task only reaches that priority by
+ * inheriting it, and is inserted ahead of the EDF tasks so it releases the
+ * mutex they wait for.
+ */
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvInsertInDeadlineOrder( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called by vTaskSwitchContext() after the highest priority ready task has been
+ * selected.  Resumes a preempted task instead of the selected task if the
+ * selected task's priority does not exceed the preempted task's threshold.
+ */
+#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	static void prvApplyPreemptionThreshold( TCB_t *pxPreviousTCB ) PRIVILEGED_FUNCTION;
+	static void prvRemoveThresholdPreemptedTask( TCB_t const *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from xTaskIncrementTick().  Charges the tick to the running task's
+ * budget, dropping the task to configTASK_BUDGET_BACKGROUND_PRIORITY if the
+ * budget is exhausted, and restores the priority of tasks whose budget has been
+ * replenished.  Returns pdTRUE if a context switch is required.
+ */
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static BaseType_t prvUpdateTaskBudgets( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+	static void prvReplenishTaskBudget( TCB_t *pxTCB, const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+	static void prvSetTaskBudgetPriority( TCB_t *pxTCB, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -693,7 +960,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends
 			on the implementation of the port malloc function and whether or
 			not static allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = taskALLOCATE_TCB();
 
 			if( pxNewTCB != NULL )
 			{
@@ -748,19 +1015,19 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends on
 			the implementation of the port malloc function and whether or not static
 			allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = taskALLOCATE_TCB();
 
 			if( pxNewTCB != NULL )
 			{
 				/* Allocate space for the stack used by the task being created.
 				The base of the stack memory stored in the TCB so the task can
 				be deleted later if required. */
-				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 				if( pxNewTCB->pxStack == NULL )
 				{
 					/* Could not allocate the stack.  Delete the allocated TCB. */
-					vPortFree( pxNewTCB );
+					taskFREE_TCB( pxNewTCB );
 					pxNewTCB = NULL;
 				}
 			}
@@ -770,12 +1037,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 		StackType_t *pxStack;
 
 			/* Allocate space for the stack used by the task being created. */
-			pxStack = pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+			pxStack = pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
 
 			if( pxStack != NULL )
 			{
 				/* Allocate space for the TCB. */
-				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+				pxNewTCB = taskALLOCATE_TCB(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
 				if( pxNewTCB != NULL )
 				{
@@ -786,7 +1053,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 				{
 					/* The stack cannot be used as the TCB was not created.  Free
 					it again. */
-					vPortFree( pxStack );
+					vPortFreeStack( pxStack );
 				}
 			}
 			else
@@ -989,8 +1256,8 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		( void ) memset( ( void * ) &( pxNewTCB->ulNotifiedValue[ 0 ] ), 0x00, sizeof( pxNewTCB->ulNotifiedValue ) );
+		( void ) memset( ( void * ) &( pxNewTCB->ucNotifyState[ 0 ] ), taskNOT_WAITING_NOTIFICATION, sizeof( pxNewTCB->ucNotifyState ) );
 	}
 	#endif
 
@@ -1009,6 +1276,35 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+	{
+		pxNewTCB->uxPreemptionThreshold = tskIDLE_PRIORITY;
+		pxNewTCB->pxNextThresholdPreempted = NULL;
+	}
+	#endif
+
+	#if( configUSE_TASK_BUDGETS == 1 )
+	{
+		pxNewTCB->xBudget = ( TickType_t ) 0U;
+		pxNewTCB->xBudgetPeriod = ( TickType_t ) 0U;
+		pxNewTCB->xBudgetRemaining = ( TickType_t ) 0U;
+		pxNewTCB->xBudgetPeriodStart = ( TickType_t ) 0U;
+		pxNewTCB->uxBudgetOverruns = ( UBaseType_t ) 0U;
+		vListInitialiseItem( &( pxNewTCB->xBudgetListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxNewTCB->xBudgetListItem ), pxNewTCB );
+	}
+	#endif
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		pxNewTCB->xEDFPeriod = ( TickType_t ) 0U;
+		pxNewTCB->xEDFRelativeDeadline = ( TickType_t ) 0U;
+		pxNewTCB->xEDFReleaseTime = ( TickType_t ) 0U;
+		pxNewTCB->xEDFAbsoluteDeadline = ( TickType_t ) 0U;
+		pxNewTCB->uxEDFDeadlineMisses = ( UBaseType_t ) 0U;
+	}
+	#endif
+
 	/* Initialize the TCB stack to look as if the task was already running,
 	but had been interrupted by the scheduler.  The return address is set
 	to the start of the task function. Once the stack has been initialised
@@ -1141,7 +1437,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	{
 		/* If the created task is of a higher priority than the current task
 		then it should run now. */
-		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		if( taskREADIED_TASK_PREEMPTS_CURRENT( pxNewTCB ) )
 		{
 			taskYIELD_IF_USING_PREEMPTION();
 		}
@@ -1189,6 +1485,25 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+			{
+				prvRemoveThresholdPreemptedTask( pxTCB );
+			}
+			#endif
+
+			#if( configUSE_TASK_BUDGETS == 1 )
+			{
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -1423,17 +1738,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					{
 						#if( configUSE_TASK_NOTIFICATIONS == 1 )
 						{
+						BaseType_t x;
+
 							/* The task does not appear on the event list item of
 							and of the RTOS objects, but could still be in the
-							blocked state if it is waiting on its notification
-							rather than waiting on an object. */
-							if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
-							{
-								eReturn = eBlocked;
-							}
-							else
+							blocked state if it is waiting on one of its
+							notifications rather than waiting on an object. */
+							eReturn = eSuspended;
+
+							for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 							{
-								eReturn = eSuspended;
+								if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+								{
+									eReturn = eBlocked;
+									break;
+								}
 							}
 						}
 						#else
@@ -1584,7 +1903,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 						/* The priority of a task other than the currently
 						running task is being raised.  Is the priority being
 						raised above that of the running task? */
-						if( uxNewPriority >= pxCurrentTCB->uxPriority )
+						if( taskPRIORITY_PREEMPTS_OR_SHARES_CURRENT( uxNewPriority ) )
 						{
 							xYieldRequired = pdTRUE;
 						}
@@ -1645,7 +1964,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				being used for anything else. */
 				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
 				{
-					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					taskSET_EVENT_LIST_ITEM_PRIORITY( pxTCB, uxNewPriority );
 				}
 				else
 				{
@@ -1693,10 +2012,278 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				( void ) uxPriorityUsedOnEntry;
 			}
 		}
-		taskEXIT_CRITICAL();
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* INCLUDE_vTaskPrioritySet */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	void vTaskPreemptionThresholdSet( TaskHandle_t xTask, UBaseType_t uxNewThreshold )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xYieldRequired = pdFALSE;
+
+		configASSERT( ( uxNewThreshold < configMAX_PRIORITIES ) );
+
+		/* Ensure the new threshold is valid. */
+		if( uxNewThreshold >= ( UBaseType_t ) configMAX_PRIORITIES )
+		{
+			uxNewThreshold = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* Lowering the threshold of the running task may allow a task
+			that was previously held off to run now.  Yielding is harmless if
+			there is no such task. */
+			if( ( pxTCB == pxCurrentTCB ) && ( uxNewThreshold < pxTCB->uxPreemptionThreshold ) )
+			{
+				xYieldRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->uxPreemptionThreshold = uxNewThreshold;
+
+			if( xYieldRequired != pdFALSE )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskPreemptionThresholdGet( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxPreemptionThreshold;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	void vTaskSetBudget( TaskHandle_t xTask, const TickType_t xBudget, const TickType_t xPeriod )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( xBudget <= xPeriod );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* The idle task must always be able to run at its own priority. */
+			configASSERT( pxTCB != xIdleTaskHandle );
+
+			/* Start a new period with a full budget.  This also restores the
+			task's priority if it was waiting for its old budget to be
+			replenished. */
+			pxTCB->xBudget = xBudget;
+			pxTCB->xBudgetPeriod = xPeriod;
+			prvReplenishTaskBudget( pxTCB, xTickCount );
+
+			/* A task that was restored may now be the highest priority ready
+			task.  Yielding is harmless if it is not. */
+			taskYIELD_IF_USING_PREEMPTION();
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskGetBudgetOverrunCount( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxBudgetOverruns;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskSetPeriodicDeadline( TaskHandle_t xTask, const TickType_t xPeriod, const TickType_t xRelativeDeadline )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( xPeriod > ( TickType_t ) 0U );
+		configASSERT( xRelativeDeadline > ( TickType_t ) 0U );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* Only tasks at the EDF priority are ordered by deadline. */
+			configASSERT( pxTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY );
+
+			/* The first job is released now. */
+			pxTCB->xEDFPeriod = xPeriod;
+			pxTCB->xEDFRelativeDeadline = xRelativeDeadline;
+			pxTCB->xEDFReleaseTime = xTickCount;
+			pxTCB->xEDFAbsoluteDeadline = xTickCount + xRelativeDeadline;
+			pxTCB->uxEDFDeadlineMisses = ( UBaseType_t ) 0U;
+
+			/* A ready task moves to its place in deadline order. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+			{
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvInsertInDeadlineOrder( pxTCB );
+
+				if( listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ) ) != pxCurrentTCB )
+				{
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskWaitForNextPeriod( void )
+	{
+		configASSERT( pxCurrentTCB->xEDFRelativeDeadline != ( TickType_t ) 0U );
+
+		taskENTER_CRITICAL();
+		{
+			/* The job that has just completed missed its deadline if the
+			deadline is already in the past. */
+			if( taskDEADLINE_IS_BEFORE( pxCurrentTCB->xEDFAbsoluteDeadline, xTickCount ) )
+			{
+				( pxCurrentTCB->uxEDFDeadlineMisses )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The deadline of the next job must be in place before the task
+			is readied at the start of the next period, as that is when it is
+			compared against the other EDF tasks. */
+			pxCurrentTCB->xEDFAbsoluteDeadline = pxCurrentTCB->xEDFReleaseTime + pxCurrentTCB->xEDFPeriod + pxCurrentTCB->xEDFRelativeDeadline;
+
+			/* If the job overran into the next period the task does not block
+			below, so it is moved to its place for the new deadline now. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE )
+			{
+				( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+				prvInsertInDeadlineOrder( pxCurrentTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Block until the next release.  This also advances xEDFReleaseTime,
+		and returns immediately, after yielding, if the job overran into the
+		next period. */
+		vTaskDelayUntil( &( pxCurrentTCB->xEDFReleaseTime ), pxCurrentTCB->xEDFPeriod );
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskGetDeadlineMissCount( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxEDFDeadlineMisses;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvInsertInDeadlineOrder( TCB_t *pxTCB )
+	{
+	List_t * const pxList = &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] );
+	ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+	ListItem_t const * const pxEndMarker = listGET_END_MARKER( pxList );
+	ListItem_t *pxIterator;
+	TCB_t *pxNextTCB;
+
+		/* Deadlines wrap with the tick count, so the position is found with
+		taskDEADLINE_IS_BEFORE() rather than by vListInsert() comparing item
+		values.  The walk stops at the first task that the new task must run
+		before. */
+		for( pxIterator = ( ListItem_t * ) pxEndMarker; pxIterator->pxNext != pxEndMarker; pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		{
+			pxNextTCB = listGET_LIST_ITEM_OWNER( pxIterator->pxNext ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+			if( pxTCB->xEDFRelativeDeadline == ( TickType_t ) 0U )
+			{
+				if( pxNextTCB->xEDFRelativeDeadline != ( TickType_t ) 0U )
+				{
+					break;
+				}
+			}
+			else if( ( pxNextTCB->xEDFRelativeDeadline != ( TickType_t ) 0U ) && ( taskDEADLINE_IS_BEFORE( pxTCB->xEDFAbsoluteDeadline, pxNextTCB->xEDFAbsoluteDeadline ) ) )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* Link the item in after pxIterator, as vListInsert() does. */
+		pxNewListItem->pxNext = pxIterator->pxNext;
+		pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+		pxNewListItem->pxPrevious = pxIterator;
+		pxIterator->pxNext = pxNewListItem;
+		pxNewListItem->pxContainer = pxList;
+
+		( pxList->uxNumberOfItems )++;
 	}
 
-#endif /* INCLUDE_vTaskPrioritySet */
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_vTaskSuspend == 1 )
@@ -1738,11 +2325,16 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			BaseType_t x;
+
+				for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but
+						is now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
@@ -1871,7 +2463,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					prvAddTaskToReadyList( pxTCB );
 
 					/* A higher priority task may have just been resumed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskPRIORITY_PREEMPTS_OR_SHARES_CURRENT( pxTCB->uxPriority ) )
 					{
 						/* This yield may not cause the task just resumed to run,
 						but will leave the lists in the correct state for the
@@ -1939,7 +2531,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskPRIORITY_PREEMPTS_OR_SHARES_CURRENT( pxTCB->uxPriority ) )
 					{
 						xYieldRequired = pdTRUE;
 					}
@@ -2139,7 +2731,16 @@ void vTaskSuspendAll( void )
 		configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
 		task that are in the Ready state, even though the idle task is
 		running. */
-		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+		#if( configUSE_TWO_LEVEL_TASK_SELECTION == 1 )
+		{
+			/* Any bit other than the idle priority bit in the first group, or
+			any other group, denotes a ready task above the idle priority. */
+			if( ( ulReadyGroupMap > 1UL ) || ( ulReadyPriorityMap[ 0 ] > 1UL ) )
+			{
+				uxHigherPriorityReadyTasks = pdTRUE;
+			}
+		}
+		#elif( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 		{
 			if( uxTopReadyPriority > tskIDLE_PRIORITY )
 			{
@@ -2224,7 +2825,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 					/* If the moved task has a priority higher than the current
 					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskPRIORITY_PREEMPTS_OR_SHARES_CURRENT( pxTCB->uxPriority ) )
 					{
 						xYieldPending = pdTRUE;
 					}
@@ -2678,7 +3279,7 @@ BaseType_t xYieldRequired = pdFALSE;
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskREADIED_TASK_PREEMPTS_CURRENT( pxTCB ) )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2801,7 +3402,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 						only be performed if the unblocked task has a
 						priority that is equal to or higher than the
 						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						if( taskPRIORITY_PREEMPTS_OR_SHARES_CURRENT( pxTCB->uxPriority ) )
 						{
 							xSwitchRequired = pdTRUE;
 						}
@@ -2815,12 +3416,29 @@ BaseType_t xSwitchRequired = pdFALSE;
 			}
 		}
 
+		#if ( configUSE_TASK_BUDGETS == 1 )
+		{
+			if( prvUpdateTaskBudgets( xConstTickCount ) != pdFALSE )
+			{
+				#if ( configUSE_PREEMPTION == 1 )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				#endif
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_BUDGETS */
+
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
 		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) && ( taskPREEMPTION_THRESHOLD_ACTIVE() == pdFALSE ) )
 			{
 				xSwitchRequired = pdTRUE;
 			}
@@ -2996,6 +3614,10 @@ void vTaskSwitchContext( void )
 	}
 	else
 	{
+		#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+			TCB_t * const pxPreviousTCB = pxCurrentTCB;
+		#endif
+
 		xYieldPending = pdFALSE;
 		traceTASK_SWITCHED_OUT();
 
@@ -3039,6 +3661,13 @@ void vTaskSwitchContext( void )
 		/* Select a new task to run using either the generic C or port
 		optimised asm code. */
 		taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+		#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+		{
+			prvApplyPreemptionThreshold( pxPreviousTCB );
+		}
+		#endif
+
 		traceTASK_SWITCHED_IN();
 
 		/* After the new task is switched in, update the global errno. */
@@ -3071,7 +3700,9 @@ void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksT
 	/* Place the event list item of the TCB in the appropriate event list.
 	This is placed in the list in priority order so the highest priority task
 	is the first to be woken by the event.  The queue that contains the event
-	list is locked, preventing simultaneous access from interrupts. */
+	list is locked, preventing simultaneous access from interrupts.  If
+	configUSE_PRIORITY_INDEXED_EVENT_LISTS is 1 then queue event lists carry a
+	priority index and the insert does not walk the list. */
 	vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
 	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
@@ -3117,8 +3748,19 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xIte
 		/* Place the event list item of the TCB in the appropriate event list.
 		In this case it is assume that this is the only task that is going to
 		be waiting on this event list, so the faster vListInsertEnd() function
-		can be used in place of vListInsert. */
-		vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+		can be used in place of vListInsert - unless the list carries a priority
+		index, in which case vListInsert() is just as fast and keeps the index
+		valid. */
+		#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+		if( pxEventList->pxPriorityIndex != NULL )
+		{
+			vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+		}
+		else
+		#endif /* configUSE_PRIORITY_INDEXED_EVENT_LISTS */
+		{
+			vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+		}
 
 		/* If the task should block indefinitely then set the block time to a
 		value that will be recognised as an indefinite delay inside the
@@ -3183,7 +3825,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskREADIED_TASK_PREEMPTS_CURRENT( pxUnblockedTCB ) )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3240,7 +3882,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskREADIED_TASK_PREEMPTS_CURRENT( pxUnblockedTCB ) )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3251,6 +3893,62 @@ TCB_t *pxUnblockedTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+	BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+	{
+	TCB_t *pxUnblockedTCB;
+	BaseType_t xReturn;
+
+		/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It is used by
+		event groups that are set directly from interrupts, whose event lists
+		are only ever accessed from within critical sections. */
+
+		/* Store the new item value in the event list. */
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		configASSERT( pxUnblockedTCB );
+		( void ) uxListRemove( pxEventListItem );
+
+		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		{
+			( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+			prvAddTaskToReadyList( pxUnblockedTCB );
+
+			#if( configUSE_TICKLESS_IDLE != 0 )
+			{
+				/* See the comment in xTaskRemoveFromEventList(). */
+				prvResetNextTaskUnblockTime();
+			}
+			#endif
+		}
+		else
+		{
+			/* The delayed and ready lists cannot be accessed, so hold this task
+			pending until the scheduler is resumed. */
+			vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+		}
+
+		if( taskREADIED_TASK_PREEMPTS_CURRENT( pxUnblockedTCB ) )
+		{
+			/* Mark that a yield is pending in case the user is not using the
+			"xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS
+			function. */
+			xReturn = pdTRUE;
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3629,6 +4327,12 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
+	#if ( configUSE_TASK_BUDGETS == 1 )
+	{
+		vListInitialise( &xBudgetExhaustedTaskList );
+	}
+	#endif /* configUSE_TASK_BUDGETS */
+
 	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
 	using list2. */
 	pxDelayedTaskList = &xDelayedTaskList1;
@@ -3905,8 +4609,8 @@ static void prvCheckTasksWaitingTermination( void )
 		{
 			/* The task can only have been allocated dynamically - free both
 			the stack and TCB. */
-			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
+			vPortFreeStack( pxTCB->pxStack );
+			taskFREE_TCB( pxTCB );
 		}
 		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
 		{
@@ -3917,14 +4621,14 @@ static void prvCheckTasksWaitingTermination( void )
 			{
 				/* Both the stack and TCB were allocated dynamically, so both
 				must be freed. */
-				vPortFree( pxTCB->pxStack );
-				vPortFree( pxTCB );
+				vPortFreeStack( pxTCB->pxStack );
+				taskFREE_TCB( pxTCB );
 			}
 			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
 			{
 				/* Only the stack was statically allocated, so the TCB is the
 				only memory that must be freed. */
-				vPortFree( pxTCB );
+				taskFREE_TCB( pxTCB );
 			}
 			else
 			{
@@ -3940,6 +4644,280 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+
+#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	static void prvApplyPreemptionThreshold( TCB_t *pxPreviousTCB )
+	{
+	TCB_t *pxPreemptedTCB;
+
+		/* A task that is switched out while still ready has been preempted.  It
+		keeps running if the selected task does not exceed its threshold,
+		otherwise it is remembered so it is resumed ahead of tasks below its
+		threshold once the preempting task stops running. */
+		if( ( pxPreviousTCB != pxCurrentTCB ) &&
+			( pxPreviousTCB->uxPreemptionThreshold > pxPreviousTCB->uxPriority ) &&
+			( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+		{
+			if( pxPreviousTCB->uxPreemptionThreshold >= pxCurrentTCB->uxPriority )
+			{
+				pxCurrentTCB = pxPreviousTCB;
+			}
+			else
+			{
+				prvRemoveThresholdPreemptedTask( pxPreviousTCB );
+				pxPreviousTCB->pxNextThresholdPreempted = pxThresholdPreemptedTCB;
+				pxThresholdPreemptedTCB = pxPreviousTCB;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Discard tasks that have blocked or been suspended since they were
+		preempted - they are no longer shielded. */
+		while( pxThresholdPreemptedTCB != NULL )
+		{
+			pxPreemptedTCB = pxThresholdPreemptedTCB;
+
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreemptedTCB->uxPriority ] ), &( pxPreemptedTCB->xStateListItem ) ) != pdFALSE )
+			{
+				break;
+			}
+			else
+			{
+				pxThresholdPreemptedTCB = pxPreemptedTCB->pxNextThresholdPreempted;
+			}
+		}
+
+		/* The most recently preempted task has the highest threshold, so only
+		it needs to be compared against the selected task. */
+		pxPreemptedTCB = pxThresholdPreemptedTCB;
+
+		if( ( pxPreemptedTCB != NULL ) && ( pxPreemptedTCB->uxPreemptionThreshold >= pxCurrentTCB->uxPriority ) )
+		{
+			pxCurrentTCB = pxPreemptedTCB;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* The task that is about to run is no longer preempted. */
+		prvRemoveThresholdPreemptedTask( pxCurrentTCB );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRemoveThresholdPreemptedTask( TCB_t const *pxTCB )
+	{
+	TCB_t **ppxLink = &pxThresholdPreemptedTCB;
+
+		/* The list is never longer than the number of distinct thresholds in
+		use. */
+		while( *ppxLink != NULL )
+		{
+			if( *ppxLink == pxTCB )
+			{
+				*ppxLink = pxTCB->pxNextThresholdPreempted;
+				break;
+			}
+			else
+			{
+				ppxLink = &( ( *ppxLink )->pxNextThresholdPreempted );
+			}
+		}
+	}
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static BaseType_t prvUpdateTaskBudgets( const TickType_t xConstTickCount )
+	{
+	TCB_t *pxTCB;
+	ListItem_t *pxItem, *pxNextItem;
+	ListItem_t const *pxEndMarker = listGET_END_MARKER( &xBudgetExhaustedTaskList );
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		/* Restore the tasks whose budget period has ended.  Only tasks that
+		have exhausted their budget are in the list, so it is normally short. */
+		pxItem = listGET_HEAD_ENTRY( &xBudgetExhaustedTaskList );
+
+		while( pxItem != pxEndMarker )
+		{
+			pxNextItem = listGET_NEXT( pxItem );
+			pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+			if( ( TickType_t ) ( xConstTickCount - pxTCB->xBudgetPeriodStart ) >= pxTCB->xBudgetPeriod )
+			{
+				prvReplenishTaskBudget( pxTCB, xConstTickCount );
+
+				if( taskREADIED_TASK_PREEMPTS_CURRENT( pxTCB ) )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxItem = pxNextItem;
+		}
+
+		/* Charge the tick to the running task. */
+		pxTCB = pxCurrentTCB;
+
+		if( pxTCB->xBudgetPeriod != ( TickType_t ) 0U )
+		{
+			if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) == NULL )
+			{
+				/* Tasks that have not exhausted their budget are not in
+				xBudgetExhaustedTaskList, so start a new period here if the
+				last one has ended. */
+				if( ( TickType_t ) ( xConstTickCount - pxTCB->xBudgetPeriodStart ) >= pxTCB->xBudgetPeriod )
+				{
+					prvReplenishTaskBudget( pxTCB, xConstTickCount );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pxTCB->xBudgetRemaining > ( TickType_t ) 0U )
+			{
+				( pxTCB->xBudgetRemaining )--;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* A task that holds a mutex is not dropped until it gives the
+			mutex back, as doing so would delay any higher priority task that
+			is waiting for the mutex. */
+			if( ( pxTCB->xBudgetRemaining == ( TickType_t ) 0U ) &&
+				( pxTCB->uxPriority > ( UBaseType_t ) configTASK_BUDGET_BACKGROUND_PRIORITY ) &&
+				( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0U ) )
+			{
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) == NULL )
+				{
+					( pxTCB->uxBudgetOverruns )++;
+					vListInsertEnd( &xBudgetExhaustedTaskList, &( pxTCB->xBudgetListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				traceTASK_PRIORITY_SET( pxTCB, configTASK_BUDGET_BACKGROUND_PRIORITY );
+				prvSetTaskBudgetPriority( pxTCB, ( UBaseType_t ) configTASK_BUDGET_BACKGROUND_PRIORITY );
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xSwitchRequired;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReplenishTaskBudget( TCB_t *pxTCB, const TickType_t xConstTickCount )
+	{
+		if( pxTCB->xBudgetPeriod != ( TickType_t ) 0U )
+		{
+			/* Keep the periods aligned to the first, even if a whole period
+			passed without the budget being looked at. */
+			pxTCB->xBudgetPeriodStart += ( ( TickType_t ) ( xConstTickCount - pxTCB->xBudgetPeriodStart ) / pxTCB->xBudgetPeriod ) * pxTCB->xBudgetPeriod;
+		}
+		else
+		{
+			pxTCB->xBudgetPeriodStart = xConstTickCount;
+		}
+
+		pxTCB->xBudgetRemaining = pxTCB->xBudget;
+
+		if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) != NULL )
+		{
+			( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+
+			/* Return the task to its base priority, unless it has since
+			inherited a higher one. */
+			if( pxTCB->uxPriority < pxTCB->uxBasePriority )
+			{
+				traceTASK_PRIORITY_SET( pxTCB, pxTCB->uxBasePriority );
+				prvSetTaskBudgetPriority( pxTCB, pxTCB->uxBasePriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSetTaskBudgetPriority( TCB_t *pxTCB, UBaseType_t uxNewPriority )
+	{
+	const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+		/* Unlike vTaskPrioritySet() the base priority is left unchanged, so
+		the task returns to it when its budget is replenished. */
+		pxTCB->uxPriority = uxNewPriority;
+
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			taskSET_EVENT_LIST_ITEM_PRIORITY( pxTCB, uxNewPriority );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* There is one ready list per priority, so a ready task must be moved
+		to the list for its new priority. */
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+		{
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvAddTaskToReadyList( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
 static void prvResetNextTaskUnblockTime( void )
 {
 TCB_t *pxTCB;
@@ -4031,7 +5009,7 @@ TCB_t *pxTCB;
 				not being used for anything else. */
 				if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
 				{
-					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					taskSET_EVENT_LIST_ITEM_PRIORITY( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
 				}
 				else
 				{
@@ -4231,7 +5209,7 @@ TCB_t *pxTCB;
 					being used for anything else. */
 					if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
 					{
-						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+						taskSET_EVENT_LIST_ITEM_PRIORITY( pxTCB, uxPriorityToUse );
 					}
 					else
 					{
@@ -4632,17 +5610,19 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4670,17 +5650,17 @@ TickType_t uxReturn;
 		taskENTER_CRITICAL();
 		{
 			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4688,7 +5668,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4700,22 +5680,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4748,14 +5730,14 @@ TickType_t uxReturn;
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 			}
 
 			/* If ucNotifyValue is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4764,11 +5746,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4780,44 +5762,45 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4835,7 +5818,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 
 					break;
 			}
@@ -4868,7 +5851,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskREADIED_TASK_PREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4894,7 +5877,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4902,6 +5885,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4927,30 +5911,30 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4968,7 +5952,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 					break;
 			}
 
@@ -4993,7 +5977,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskREADIED_TASK_PREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5023,13 +6007,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -5053,12 +6038,12 @@ TickType_t uxReturn;
 
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
@@ -5081,7 +6066,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskREADIED_TASK_PREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5109,20 +6094,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
@@ -5140,11 +6127,13 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyValueClear( TaskHandle_t xTask, uint32_t ulBitsToClear )
+	uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear )
 	{
 	TCB_t *pxTCB;
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
@@ -5153,8 +6142,8 @@ TickType_t uxReturn;
 		{
 			/* Return the notification as it was before the bits were cleared,
 			then clear the bit mask. */
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
-			pxTCB->ulNotifiedValue &= ~ulBitsToClear;
+			ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
+			pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
 		}
 		taskEXIT_CRITICAL();
 
@@ -38,6 +38,17 @@ task.h is included from an application file. */
 #include "queue.h"
 #include "timers.h"
 
+#if ( configUSE_KERNEL_OBJECT_SLABS == 1 )
+	#include "slab.h"
+#endif
+
+#if ( configUSE_TIMER_STATS == 1 )
+	/* snprintf() is used by vTimerWriteStats(), and memset() by
+	vTimerResetStats(). */
+	#include <stdio.h>
+	#include <string.h>
+#endif
+
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
 	#error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
 #endif
@@ -69,6 +80,67 @@ defining trmTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h. */
 #define tmrSTATUS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 0x02 )
 #define tmrSTATUS_IS_AUTORELOAD				( ( uint8_t ) 0x04 )
 
+/* Bit definitions used in the ucPendingCommand member of a timer structure
+when configUSE_TIMER_PENDING_COMMANDS is 1.  A non-zero value means the timer
+is in the list of timers with a pending command. */
+#define tmrPENDING_START					( ( uint8_t ) 0x01 )
+#define tmrPENDING_STOP						( ( uint8_t ) 0x02 )
+#define tmrPENDING_PERIOD					( ( uint8_t ) 0x04 )
+#define tmrPENDING_DELETE					( ( uint8_t ) 0x08 )
+
+/* The message sent on the timer queue to tell the timer service task that
+timer commands are pending.  It is negative, like the pended function calls, so
+it cannot be mistaken for a timer command. */
+#define tmrCOMMAND_PROCESS_PENDING			( ( BaseType_t ) -3 )
+
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	/* The geometry of the timing wheel.  Each level has tmrWHEEL_SLOTS slots,
+	indexed by the next tmrWHEEL_SLOT_BITS bits of the tick count, and there are
+	enough levels to cover every bit of the tick count. */
+	#define tmrWHEEL_SLOT_BITS		( ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS )
+	#define tmrWHEEL_SLOTS			( 1U << configTIMER_WHEEL_SLOT_BITS )
+	#define tmrWHEEL_SLOT_MASK		( ( uint32_t ) tmrWHEEL_SLOTS - 1UL )
+	#define tmrWHEEL_TICK_BITS		( ( UBaseType_t ) sizeof( TickType_t ) * ( UBaseType_t ) 8U )
+	#define tmrWHEEL_LEVELS			( ( tmrWHEEL_TICK_BITS + tmrWHEEL_SLOT_BITS - 1U ) / tmrWHEEL_SLOT_BITS )
+
+	/* Isolating the lowest set bit allows it to be found as the highest. */
+	#define tmrLOWEST_SET_BIT( ulBitmap )	tmrHIGHEST_SET_BIT( ( ulBitmap ) & ( ~( ulBitmap ) + 1UL ) )
+
+#endif /* configUSE_TIMER_WHEEL */
+
+#if ( configUSE_TIMER_WHEEL == 1 ) || ( configUSE_TIMER_STATS == 1 )
+	#define tmrHIGHEST_SET_BIT( ulBitmap )	( ( UBaseType_t ) 31U - ( UBaseType_t ) portCOUNT_LEADING_ZEROS( ( ulBitmap ) ) )
+#endif
+
+#if ( configUSE_TIMER_STATS == 1 )
+
+	/* The length of each line written by vTimerWriteStats().  Longer timer
+	names are truncated. */
+	#define tmrSTATS_LINE_LENGTH	( 32 + ( configTIMER_STATS_BUCKETS * 11 ) )
+
+	/* The histogram bucket that counts ulValue. */
+	#define tmrSTATS_BUCKET( ulValue )	( ( ( ulValue ) == 0UL ) ? ( UBaseType_t ) 0U : ( ( tmrHIGHEST_SET_BIT( ( ulValue ) ) < ( UBaseType_t ) ( configTIMER_STATS_BUCKETS - 1 ) ) ? ( tmrHIGHEST_SET_BIT( ( ulValue ) ) + ( UBaseType_t ) 1U ) : ( UBaseType_t ) ( configTIMER_STATS_BUCKETS - 1 ) ) )
+
+#endif /* configUSE_TIMER_STATS */
+
+/* The time at which a timer should have expired, before its slack moved its
+expiry time on. */
+#if ( configUSE_TIMER_SLACK == 1 )
+	#define tmrNOMINAL_EXPIRY_TIME( pxTimer, xExpiryTime )	( ( TickType_t ) ( ( xExpiryTime ) - ( pxTimer )->xExpiryDelay ) )
+#else
+	#define tmrNOMINAL_EXPIRY_TIME( pxTimer, xExpiryTime )	( xExpiryTime )
+#endif
+
+/* The time at which a timer that should expire at xNextExpiryTime will expire,
+once its slack has been applied.  Every path that puts a timer in the active
+timers must use it, so the timers that share a slack also share expiry times. */
+#if ( configUSE_TIMER_SLACK == 1 )
+	#define tmrAPPLY_SLACK( pxTimer, xNextExpiryTime )		prvApplyTimerSlack( ( pxTimer ), ( xNextExpiryTime ) )
+#else
+	#define tmrAPPLY_SLACK( pxTimer, xNextExpiryTime )		( xNextExpiryTime )
+#endif
+
 /* The definition of the timers themselves. */
 typedef struct tmrTimerControl /* The old naming convention is used to prevent breaking kernel aware debuggers. */
 {
@@ -81,6 +153,19 @@ typedef struct tmrTimerControl /* The old naming convention is used to prevent b
 		UBaseType_t			uxTimerNumber;		/*<< An ID assigned by trace tools such as FreeRTOS+Trace */
 	#endif
 	uint8_t 				ucStatus;			/*<< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
+	#if( configUSE_TIMER_PENDING_COMMANDS == 1 )
+		struct tmrTimerControl	*pxNextPending;	/*<< The next timer in the list of timers with a pending command. */
+		TickType_t			xPendingCommandTime;/*<< The time from which a pending start is measured. */
+		TickType_t			xPendingPeriod;		/*<< The period set by a pending period change. */
+		uint8_t				ucPendingCommand;	/*<< tmrPENDING_ bits that record the commands not yet processed by the timer service task. */
+	#endif
+	#if( configUSE_TIMER_SLACK == 1 )
+		TickType_t			xSlackInTicks;		/*<< How late the timer may expire.  One less than a power of two. */
+		TickType_t			xExpiryDelay;		/*<< How much later than its period the timer will expire this time, because of its slack. */
+	#endif
+	#if( configUSE_TIMER_STATS == 1 )
+		TimerStats_t		xStats;				/*<< How late the callback has run, and how long it has taken. */
+	#endif
 } xTIMER;
 
 /* The old xTIMER name is maintained above then typedefed to the new Timer_t
@@ -137,10 +222,57 @@ PRIVILEGED_DATA static List_t xActiveTimerList2;
 PRIVILEGED_DATA static List_t *pxCurrentTimerList;
 PRIVILEGED_DATA static List_t *pxOverflowTimerList;
 
+/* If configUSE_TIMER_WHEEL is 1 then active timers that expire before the tick
+count next overflows are held in a hierarchical timing wheel rather than in
+*pxCurrentTimerList, so starting, stopping and expiring a timer does not depend
+on the number of active timers.  A timer is held at the level given by the most
+significant group of tmrWHEEL_SLOT_BITS bits in which its expiry time differs
+from xTimerWheelTime, in the slot given by those bits of its expiry time, so it
+is always in a slot ahead of xTimerWheelTime.  When xTimerWheelTime reaches the
+start of a slot the timers in the slot move down the wheel, until they reach
+the slot at level 0 that holds the timers that expire at xTimerWheelTime.
+Timers that expire after the tick count overflows are held in
+*pxOverflowTimerList, which is not sorted, and move to the wheel when the tick
+count overflows.  Only the timer service task is allowed to access the wheel. */
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	PRIVILEGED_DATA static List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+	PRIVILEGED_DATA static uint32_t ulTimerWheelSlotsInUse[ tmrWHEEL_LEVELS ];	/* Bit n is set if slot n of the level might hold timers. */
+	PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+
+#endif
+
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
 PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 
+/* Timers that have a command the timer service task has not yet processed, in
+the order the commands were given, when configUSE_TIMER_PENDING_COMMANDS is 1.
+Accessed from within critical sections. */
+#if ( configUSE_TIMER_PENDING_COMMANDS == 1 )
+
+	PRIVILEGED_DATA static Timer_t * volatile pxPendingTimersHead = NULL;
+	PRIVILEGED_DATA static Timer_t * volatile pxPendingTimersTail = NULL;
+
+#endif
+
+/* Timers are taken from a slab cache, if one is configured, so creating and
+deleting them does not fragment the heap. */
+#if ( configUSE_KERNEL_OBJECT_SLABS == 1 )
+
+	PRIVILEGED_DATA static Timer_t xTimerSlabObjects[ configSLAB_TIMER_COUNT ];
+	PRIVILEGED_DATA static SlabCache_t xTimerSlab = slabCACHE_INITIALISER( xTimerSlabObjects, "Timer" );
+
+	#define tmrALLOCATE_TIMER()			( ( Timer_t * ) pvSlabAllocate( &xTimerSlab ) )
+	#define tmrFREE_TIMER( pxTimer )	vSlabFree( &xTimerSlab, ( pxTimer ) )
+
+#else
+
+	#define tmrALLOCATE_TIMER()			( ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) ) )
+	#define tmrFREE_TIMER( pxTimer )	vPortFree( pxTimer )
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -174,18 +306,98 @@ static portTASK_FUNCTION_PROTO( prvTimerTask, pvParameters ) PRIVILEGED_FUNCTION
  */
 static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Called by the timer service task to apply a single command to a timer.
+ */
+static void prvProcessTimerCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xMessageValue ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_PENDING_COMMANDS == 1 )
+
+	/*
+	 * Record a command in the timer itself, rather than send it on the timer
+	 * queue.  A later command replaces an earlier one that has not yet been
+	 * processed.  Must be called from within a critical section.  Returns
+	 * pdTRUE if the list of timers with a pending command was empty, in which
+	 * case the timer service task must be told about the command by
+	 * prvNotifyPendingCommands().
+	 */
+	static BaseType_t prvPendTimerCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Post the message that tells the timer service task commands are pending.
+	 * Does not block - if the timer queue is full the timer service task will
+	 * run anyway.
+	 */
+	static void prvNotifyPendingCommands( const BaseType_t xFromISR, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the timer service task to process the commands recorded by
+	 * prvPendTimerCommand().
+	 */
+	static void prvProcessPendingCommands( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_PENDING_COMMANDS */
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
  * depending on if the expire time causes a timer counter overflow.
  */
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_TIMER_SLACK == 1 )
+
+	/*
+	 * Move xNextExpiryTime on to the next multiple of the timer's slack plus
+	 * one, record how far it was moved in the timer, and return the result.
+	 */
+	static TickType_t prvApplyTimerSlack( Timer_t * const pxTimer, const TickType_t xNextExpiryTime ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_SLACK */
+
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
  * auto-reload timer, then call its callback.
  */
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
+/*
+ * Remove pxTimer, which expired at xExpireTime, from its list, reload it if it
+ * is an auto-reload timer, then call its callback.
+ */
+static void prvExpireTimer( Timer_t * const pxTimer, const TickType_t xExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Call the callback of pxTimer, which expired at xExpireTime, recording how
+ * late and how long the call was if configUSE_TIMER_STATS is 1.
+ */
+static void prvCallTimerCallback( Timer_t * const pxTimer, const TickType_t xExpireTime ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/*
+	 * Place an active timer in the timing wheel, using the expiry time held in
+	 * its list item, which must not be before xTimerWheelTime.
+	 */
+	static void prvInsertTimerInWheel( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the time at which the timing wheel next needs attention - either
+	 * the time at which the next timer expires, or the time at which timers
+	 * must move down the wheel - and set *pxWheelWasEmpty to pdFALSE.  If the
+	 * wheel holds no timers return 0 and set *pxWheelWasEmpty to pdTRUE.
+	 */
+	static TickType_t prvGetNextWheelTime( BaseType_t * const pxWheelWasEmpty ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move xTimerWheelTime on to xTime, which must be a time returned by
+	 * prvGetNextWheelTime(), moving the timers in the slots that start at xTime
+	 * down the wheel.  Returns the slot that holds the timers that expire at
+	 * xTime.
+	 */
+	static List_t *prvAdvanceTimerWheel( const TickType_t xTime ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
+
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
  * current timer list does not still reference some timers.
@@ -287,7 +499,7 @@ BaseType_t xReturn = pdFAIL;
 	{
 	Timer_t *pxNewTimer;
 
-		pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
+		pxNewTimer = tmrALLOCATE_TIMER(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
 
 		if( pxNewTimer != NULL )
 		{
@@ -369,6 +581,25 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 		pxNewTimer->pvTimerID = pvTimerID;
 		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
 		vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+		#if( configUSE_TIMER_PENDING_COMMANDS == 1 )
+		{
+			pxNewTimer->pxNextPending = NULL;
+			pxNewTimer->xPendingCommandTime = ( TickType_t ) 0U;
+			pxNewTimer->xPendingPeriod = xTimerPeriodInTicks;
+			pxNewTimer->ucPendingCommand = 0U;
+		}
+		#endif
+		#if( configUSE_TIMER_SLACK == 1 )
+		{
+			pxNewTimer->xSlackInTicks = ( TickType_t ) 0U;
+			pxNewTimer->xExpiryDelay = ( TickType_t ) 0U;
+		}
+		#endif
+		#if( configUSE_TIMER_STATS == 1 )
+		{
+			( void ) memset( ( void * ) &( pxNewTimer->xStats ), 0x00, sizeof( pxNewTimer->xStats ) );
+		}
+		#endif
 		if( uxAutoReload != pdFALSE )
 		{
 			pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
@@ -381,46 +612,302 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait )
 {
 BaseType_t xReturn = pdFAIL;
-DaemonTaskMessage_t xMessage;
 
 	configASSERT( xTimer );
 
-	/* Send a message to the timer service task to perform a particular action
-	on a particular timer definition. */
-	if( xTimerQueue != NULL )
+	#if( configUSE_TIMER_PENDING_COMMANDS == 1 )
 	{
-		/* Send a command to the timer service task to start the xTimer timer. */
-		xMessage.xMessageID = xCommandID;
-		xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
-		xMessage.u.xTimerParameters.pxTimer = xTimer;
+	BaseType_t xNotify;
+	UBaseType_t uxSavedInterruptStatus;
+
+		/* Record the command in the timer, so it cannot fail for want of
+		space in the timer queue and xTicksToWait is not needed. */
+		( void ) xTicksToWait;
 
-		if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+		if( xTimerQueue != NULL )
 		{
-			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+			if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
 			{
-				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+				taskENTER_CRITICAL();
+				{
+					xNotify = prvPendTimerCommand( xTimer, xCommandID, xOptionalValue );
+				}
+				taskEXIT_CRITICAL();
+
+				/* The timer service task processes pending commands each time
+				it runs, so does not need to tell itself about its own.  Before
+				the scheduler starts both handles can be NULL, so a NULL timer
+				task handle always sends the message. */
+				if( ( xNotify != pdFALSE ) && ( ( xTimerTaskHandle == NULL ) || ( xTaskGetCurrentTaskHandle() != xTimerTaskHandle ) ) )
+				{
+					prvNotifyPendingCommands( pdFALSE, NULL );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
-				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+				uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+				{
+					xNotify = prvPendTimerCommand( xTimer, xCommandID, xOptionalValue );
+				}
+				portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+				if( xNotify != pdFALSE )
+				{
+					prvNotifyPendingCommands( pdTRUE, pxHigherPriorityTaskWoken );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
+
+			xReturn = pdPASS;
+			traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
 		}
 		else
 		{
-			xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+			mtCOVERAGE_TEST_MARKER();
 		}
-
-		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
 	}
-	else
+	#else
 	{
-		mtCOVERAGE_TEST_MARKER();
+	DaemonTaskMessage_t xMessage;
+
+		/* Send a message to the timer service task to perform a particular
+		action on a particular timer definition. */
+		if( xTimerQueue != NULL )
+		{
+			/* Send a command to the timer service task to start the xTimer timer. */
+			xMessage.xMessageID = xCommandID;
+			xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+			xMessage.u.xTimerParameters.pxTimer = xTimer;
+
+			if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+			{
+				if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+				}
+				else
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+				}
+			}
+			else
+			{
+				xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+			}
+
+			traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 	}
+	#endif /* configUSE_TIMER_PENDING_COMMANDS */
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+UBaseType_t uxTimerGenericCommandMultiple( TimerHandle_t const * const pxTimers, const UBaseType_t uxTimerCount, const BaseType_t xCommandID, const TickType_t xOptionalValue, const TickType_t xTicksToWait )
+{
+UBaseType_t uxIndex, uxSent = 0;
+
+	configASSERT( pxTimers );
+
+	/* Only the task level commands can be sent to more than one timer. */
+	configASSERT( ( xCommandID > tmrCOMMAND_START_DONT_TRACE ) && ( xCommandID < tmrFIRST_FROM_ISR_COMMAND ) );
+
+	#if( configUSE_TIMER_PENDING_COMMANDS == 1 )
+	{
+	BaseType_t xNotify = pdFALSE;
+
+		( void ) xTicksToWait;
+
+		if( xTimerQueue != NULL )
+		{
+			/* One short critical section per timer, so the time interrupts
+			are masked does not grow with the number of timers, but only one
+			message to the timer service task however many timers there are. */
+			for( uxIndex = 0; uxIndex < uxTimerCount; uxIndex++ )
+			{
+				configASSERT( pxTimers[ uxIndex ] );
+
+				taskENTER_CRITICAL();
+				{
+					if( prvPendTimerCommand( pxTimers[ uxIndex ], xCommandID, xOptionalValue ) != pdFALSE )
+					{
+						xNotify = pdTRUE;
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				traceTIMER_COMMAND_SEND( pxTimers[ uxIndex ], xCommandID, xOptionalValue, pdPASS );
+			}
+
+			uxSent = uxTimerCount;
+
+			if( ( xNotify != pdFALSE ) && ( ( xTimerTaskHandle == NULL ) || ( xTaskGetCurrentTaskHandle() != xTimerTaskHandle ) ) )
+			{
+				prvNotifyPendingCommands( pdFALSE, NULL );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		for( uxIndex = 0; uxIndex < uxTimerCount; uxIndex++ )
+		{
+			if( xTimerGenericCommand( pxTimers[ uxIndex ], xCommandID, xOptionalValue, NULL, xTicksToWait ) != pdFAIL )
+			{
+				uxSent++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	#endif /* configUSE_TIMER_PENDING_COMMANDS */
+
+	return uxSent;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_PENDING_COMMANDS == 1 )
+
+	static BaseType_t prvPendTimerCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue )
+	{
+	BaseType_t xListWasEmpty = pdFALSE;
+	uint8_t ucCommand = pxTimer->ucPendingCommand;
+
+		switch( xCommandID )
+		{
+			case tmrCOMMAND_START_DONT_TRACE :
+				/* The timer service task restarting an auto-reload timer.  Any
+				command from the application was given after the timer expired,
+				so takes precedence. */
+				if( ucCommand == 0U )
+				{
+					ucCommand = tmrPENDING_START;
+					pxTimer->xPendingCommandTime = xOptionalValue;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				break;
+
+			case tmrCOMMAND_START :
+			case tmrCOMMAND_START_FROM_ISR :
+			case tmrCOMMAND_RESET :
+			case tmrCOMMAND_RESET_FROM_ISR :
+				ucCommand &= ( uint8_t ) ~tmrPENDING_STOP;
+				ucCommand |= tmrPENDING_START;
+				pxTimer->xPendingCommandTime = xOptionalValue;
+				break;
+
+			case tmrCOMMAND_STOP :
+			case tmrCOMMAND_STOP_FROM_ISR :
+				/* A pending period change is kept, as it would have been had
+				both commands been processed. */
+				ucCommand &= ( uint8_t ) ~tmrPENDING_START;
+				ucCommand |= tmrPENDING_STOP;
+				break;
+
+			case tmrCOMMAND_CHANGE_PERIOD :
+			case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
+				/* Changing the period also starts the timer, measured from the
+				time the period was changed. */
+				configASSERT( ( xOptionalValue > 0 ) );
+				ucCommand &= ( uint8_t ) ~tmrPENDING_STOP;
+				ucCommand |= ( uint8_t ) ( tmrPENDING_START | tmrPENDING_PERIOD );
+				pxTimer->xPendingPeriod = xOptionalValue;
+				if( xCommandID == tmrCOMMAND_CHANGE_PERIOD )
+				{
+					pxTimer->xPendingCommandTime = xTaskGetTickCount();
+				}
+				else
+				{
+					pxTimer->xPendingCommandTime = xTaskGetTickCountFromISR();
+				}
+				break;
+
+			case tmrCOMMAND_DELETE :
+				ucCommand = tmrPENDING_DELETE;
+				break;
+
+			default :
+				/* Don't expect to get here. */
+				break;
+		}
+
+		if( ( pxTimer->ucPendingCommand == 0U ) && ( ucCommand != 0U ) )
+		{
+			/* Add the timer to the end of the list, so commands for different
+			timers are processed in the order they were given. */
+			pxTimer->pxNextPending = NULL;
+			if( pxPendingTimersTail == NULL )
+			{
+				pxPendingTimersHead = pxTimer;
+				xListWasEmpty = pdTRUE;
+			}
+			else
+			{
+				pxPendingTimersTail->pxNextPending = pxTimer;
+			}
+			pxPendingTimersTail = pxTimer;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxTimer->ucPendingCommand = ucCommand;
+
+		return xListWasEmpty;
+	}
+
+#endif /* configUSE_TIMER_PENDING_COMMANDS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_PENDING_COMMANDS == 1 )
+
+	static void prvNotifyPendingCommands( const BaseType_t xFromISR, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	DaemonTaskMessage_t xMessage;
+
+		/* Only the message ID is used.  If the queue is full the message is
+		not needed, as the timer service task will not block while the queue
+		holds messages. */
+		xMessage.xMessageID = tmrCOMMAND_PROCESS_PENDING;
+
+		if( xFromISR == pdFALSE )
+		{
+			( void ) xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+		}
+		else
+		{
+			( void ) xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+		}
+	}
+
+#endif /* configUSE_TIMER_PENDING_COMMANDS */
+/*-----------------------------------------------------------*/
+
 TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
 {
 	/* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
@@ -484,6 +971,130 @@ UBaseType_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_SLACK == 1 )
+
+	void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlackInTicks )
+	{
+	Timer_t * pxTimer = xTimer;
+	TickType_t xSlack = ( TickType_t ) 0U;
+
+		configASSERT( xTimer );
+
+		/* Round down to one less than a power of two, so the slack plus one can
+		be used to align expiry times. */
+		while( ( xSlack < xSlackInTicks ) && ( ( ( xSlack << 1 ) | ( TickType_t ) 1U ) <= xSlackInTicks ) )
+		{
+			xSlack = ( xSlack << 1 ) | ( TickType_t ) 1U;
+		}
+
+		pxTimer->xSlackInTicks = xSlack;
+	}
+
+#endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_SLACK == 1 )
+
+	TickType_t xTimerGetSlack( TimerHandle_t xTimer )
+	{
+	Timer_t * pxTimer = xTimer;
+
+		configASSERT( xTimer );
+		return pxTimer->xSlackInTicks;
+	}
+
+#endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_STATS == 1 )
+
+	void vTimerGetStats( TimerHandle_t xTimer, TimerStats_t *pxStats )
+	{
+	Timer_t * const pxTimer = xTimer;
+
+		configASSERT( xTimer );
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = pxTimer->xStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_STATS == 1 )
+
+	void vTimerResetStats( TimerHandle_t xTimer )
+	{
+	Timer_t * const pxTimer = xTimer;
+
+		configASSERT( xTimer );
+
+		taskENTER_CRITICAL();
+		{
+			( void ) memset( ( void * ) &( pxTimer->xStats ), 0x00, sizeof( pxTimer->xStats ) );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_STATS == 1 )
+
+	void vTimerWriteStats( TimerHandle_t const * const pxTimers, const UBaseType_t uxTimerCount, TimerStatsWriteFunction_t pxWriteLine )
+	{
+	TimerStats_t xStats;
+	UBaseType_t uxTimer, uxBucket;
+	size_t xLength;
+	char cLine[ tmrSTATS_LINE_LENGTH ]; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+		configASSERT( ( pxTimers != NULL ) || ( uxTimerCount == ( UBaseType_t ) 0 ) );
+		configASSERT( pxWriteLine );
+
+		( void ) snprintf( cLine, sizeof( cLine ), "TS S %lu", ( unsigned long ) configTIMER_STATS_TIMESTAMP() );
+		pxWriteLine( cLine );
+
+		/* Take one timer at a time so only one line of text is needed, and so
+		the write function, which may block, is called outside of the critical
+		section. */
+		for( uxTimer = ( UBaseType_t ) 0U; uxTimer < uxTimerCount; uxTimer++ )
+		{
+			vTimerGetStats( pxTimers[ uxTimer ], &xStats );
+
+			( void ) snprintf( cLine, sizeof( cLine ), "TS T %lx %lu %lu %lu %lu %s",
+							   ( unsigned long ) ( size_t ) pxTimers[ uxTimer ],
+							   ( unsigned long ) xStats.ulCallbacks,
+							   ( unsigned long ) xStats.ulMaxLateness,
+							   ( unsigned long ) xStats.ulMaxRunTime,
+							   ( unsigned long ) xStats.ulTotalRunTime,
+							   ( pxTimers[ uxTimer ]->pcTimerName != NULL ) ? pxTimers[ uxTimer ]->pcTimerName : "" );
+			pxWriteLine( cLine );
+
+			xLength = ( size_t ) snprintf( cLine, sizeof( cLine ), "TS L %lx", ( unsigned long ) ( size_t ) pxTimers[ uxTimer ] );
+			for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) configTIMER_STATS_BUCKETS; uxBucket++ )
+			{
+				xLength += ( size_t ) snprintf( &( cLine[ xLength ] ), sizeof( cLine ) - xLength, " %lu", ( unsigned long ) xStats.ulLateness[ uxBucket ] );
+			}
+			pxWriteLine( cLine );
+
+			xLength = ( size_t ) snprintf( cLine, sizeof( cLine ), "TS R %lx", ( unsigned long ) ( size_t ) pxTimers[ uxTimer ] );
+			for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) configTIMER_STATS_BUCKETS; uxBucket++ )
+			{
+				xLength += ( size_t ) snprintf( &( cLine[ xLength ] ), sizeof( cLine ) - xLength, " %lu", ( unsigned long ) xStats.ulRunTime[ uxBucket ] );
+			}
+			pxWriteLine( cLine );
+		}
+
+		pxWriteLine( "TS E" );
+	}
+
+#endif /* configUSE_TIMER_STATS */
+/*-----------------------------------------------------------*/
+
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer )
 {
 Timer_t * pxTimer =  xTimer;
@@ -505,12 +1116,34 @@ Timer_t *pxTimer = xTimer;
 /*-----------------------------------------------------------*/
 
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+{
+	#if( configUSE_TIMER_WHEEL == 1 )
+	{
+	List_t * const pxExpiredTimers = prvAdvanceTimerWheel( xNextExpireTime );
+
+		/* xNextExpireTime may only be the time at which timers move down the
+		wheel, in which case no timers expire. */
+		while( listLIST_IS_EMPTY( pxExpiredTimers ) == pdFALSE )
+		{
+			prvExpireTimer( ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxExpiredTimers ), xNextExpireTime, xTimeNow ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		}
+	}
+	#else
+	{
+		/* A check has already been performed to ensure the list is not
+		empty. */
+		prvExpireTimer( ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ), xNextExpireTime, xTimeNow ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+	}
+	#endif /* configUSE_TIMER_WHEEL */
+}
+/*-----------------------------------------------------------*/
+
+static void prvExpireTimer( Timer_t * const pxTimer, const TickType_t xExpireTime, const TickType_t xTimeNow )
 {
 BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+const TickType_t xNominalExpireTime = tmrNOMINAL_EXPIRY_TIME( pxTimer, xExpireTime );
 
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
+	/* Remove the timer from the list of active timers. */
 	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
 	traceTIMER_EXPIRED( pxTimer );
 
@@ -520,12 +1153,14 @@ Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTi
 	{
 		/* The timer is inserted into a list using a time relative to anything
 		other than the current time.  It will therefore be inserted into the
-		correct list relative to the time this task thinks it is now. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+		correct list relative to the time this task thinks it is now.  The
+		period is measured from when the timer should have expired, so slack
+		does not make the timer drift. */
+		if( prvInsertTimerInActiveList( pxTimer, ( xNominalExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNominalExpireTime ) != pdFALSE )
 		{
 			/* The timer expired before it was added to the active timer
 			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNominalExpireTime, NULL, tmrNO_DELAY );
 			configASSERT( xResult );
 			( void ) xResult;
 		}
@@ -541,11 +1176,62 @@ Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTi
 	}
 
 	/* Call the timer callback. */
-	pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+	prvCallTimerCallback( pxTimer, xExpireTime );
 }
 /*-----------------------------------------------------------*/
 
-static portTASK_FUNCTION( prvTimerTask, pvParameters )
+static void prvCallTimerCallback( Timer_t * const pxTimer, const TickType_t xExpireTime )
+{
+	#if( configUSE_TIMER_STATS == 1 )
+	{
+	uint32_t ulLateness, ulRunTime, ulStartTime;
+
+		/* Measured immediately before the call, so the time taken by the
+		callbacks of other timers that expired at the same time is included. */
+		ulLateness = ( uint32_t ) ( xTaskGetTickCount() - xExpireTime );
+		ulStartTime = configTIMER_STATS_TIMESTAMP();
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+		ulRunTime = configTIMER_STATS_TIMESTAMP() - ulStartTime;
+
+		/* Only this task updates the statistics, but the critical section
+		stops vTimerGetStats() copying them half way through an update. */
+		taskENTER_CRITICAL();
+		{
+			( pxTimer->xStats.ulCallbacks )++;
+			( pxTimer->xStats.ulLateness[ tmrSTATS_BUCKET( ulLateness ) ] )++;
+			( pxTimer->xStats.ulRunTime[ tmrSTATS_BUCKET( ulRunTime ) ] )++;
+			pxTimer->xStats.ulTotalRunTime += ulRunTime;
+
+			if( ulLateness > pxTimer->xStats.ulMaxLateness )
+			{
+				pxTimer->xStats.ulMaxLateness = ulLateness;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ulRunTime > pxTimer->xStats.ulMaxRunTime )
+			{
+				pxTimer->xStats.ulMaxRunTime = ulRunTime;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	#else
+	{
+		( void ) xExpireTime;
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+	}
+	#endif /* configUSE_TIMER_STATS */
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvTimerTask, pvParameters )
 {
 TickType_t xNextExpireTime;
 BaseType_t xListWasEmpty;
@@ -565,6 +1251,14 @@ BaseType_t xListWasEmpty;
 	}
 	#endif /* configUSE_DAEMON_TASK_STARTUP_HOOK */
 
+	#if( configUSE_TIMER_PENDING_COMMANDS == 1 )
+	{
+		/* Timers can be started before the scheduler, and by the startup
+		hook.  Apply their commands before the first expiry time is read. */
+		prvProcessPendingCommands();
+	}
+	#endif
+
 	for( ;; )
 	{
 		/* Query the timers list to see if it contains any timers, and if so,
@@ -652,16 +1346,24 @@ TickType_t xNextExpireTime;
 	this task to unblock when the tick count overflows, at which point the
 	timer lists will be switched and the next expiry time can be
 	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-	if( *pxListWasEmpty == pdFALSE )
+	#if( configUSE_TIMER_WHEEL == 1 )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		xNextExpireTime = prvGetNextWheelTime( pxListWasEmpty );
 	}
-	else
+	#else
 	{
-		/* Ensure the task unblocks when the tick count rolls over. */
-		xNextExpireTime = ( TickType_t ) 0U;
+		*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+		if( *pxListWasEmpty == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		}
+		else
+		{
+			/* Ensure the task unblocks when the tick count rolls over. */
+			xNextExpireTime = ( TickType_t ) 0U;
+		}
 	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xNextExpireTime;
 }
@@ -693,15 +1395,16 @@ PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Va
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
 {
 BaseType_t xProcessTimerNow = pdFALSE;
+const TickType_t xExpiryTime = tmrAPPLY_SLACK( pxTimer, xNextExpiryTime );
 
-	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xExpiryTime );
 	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
-	if( xNextExpiryTime <= xTimeNow )
+	if( xExpiryTime <= xTimeNow )
 	{
 		/* Has the expiry time elapsed between the command to start/reset a
 		timer was issued, and the time the command was processed? */
-		if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= ( ( TickType_t ) ( xExpiryTime - xCommandTime ) ) ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		{
 			/* The time between a command being issued and the command being
 			processed actually exceeds the timers period.  */
@@ -709,12 +1412,22 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				/* The overflow list does not need to be sorted as its timers
+				are moved to the wheel when the tick count overflows. */
+				vListInsertEnd( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#else
+			{
+				vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 		}
 	}
 	else
 	{
-		if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+		if( ( xTimeNow < xCommandTime ) && ( xExpiryTime >= xCommandTime ) )
 		{
 			/* If, since the command was issued, the tick count has overflowed
 			but the expiry time has not, then the timer must have already passed
@@ -723,7 +1436,15 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				prvInsertTimerInWheel( pxTimer );
+			}
+			#else
+			{
+				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 		}
 	}
 
@@ -731,20 +1452,175 @@ BaseType_t xProcessTimerNow = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_SLACK == 1 )
+
+	static TickType_t prvApplyTimerSlack( Timer_t * const pxTimer, const TickType_t xNextExpiryTime )
+	{
+	TickType_t xExpiryTime;
+
+		/* The slack plus one is a power of two, so timers with similar expiry
+		times and the same slack share one. */
+		xExpiryTime = ( xNextExpiryTime + pxTimer->xSlackInTicks ) & ~( pxTimer->xSlackInTicks );
+		pxTimer->xExpiryDelay = xExpiryTime - xNextExpiryTime;
+
+		return xExpiryTime;
+	}
+
+#endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	static void prvInsertTimerInWheel( Timer_t * const pxTimer )
+	{
+	const uint32_t ulExpiryTime = ( uint32_t ) listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+	const uint32_t ulDifferentBits = ulExpiryTime ^ ( uint32_t ) xTimerWheelTime;
+	UBaseType_t uxLevel, uxSlot;
+
+		if( ulDifferentBits == 0UL )
+		{
+			/* The timer expires now, so goes in the slot at level 0 that holds
+			the timers that expire at xTimerWheelTime. */
+			uxLevel = ( UBaseType_t ) 0U;
+		}
+		else
+		{
+			uxLevel = tmrHIGHEST_SET_BIT( ulDifferentBits ) / tmrWHEEL_SLOT_BITS;
+		}
+
+		uxSlot = ( UBaseType_t ) ( ( ulExpiryTime >> ( uxLevel * tmrWHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK );
+
+		vListInsertEnd( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+		ulTimerWheelSlotsInUse[ uxLevel ] |= ( uint32_t ) 1UL << uxSlot;
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	static TickType_t prvGetNextWheelTime( BaseType_t * const pxWheelWasEmpty )
+	{
+	const uint32_t ulWheelTime = ( uint32_t ) xTimerWheelTime;
+	uint32_t ulSlotsAhead, ulNextTime = 0UL;
+	UBaseType_t uxLevel, uxShift, uxFirstSlot, uxSlot;
+	BaseType_t xFound = pdFALSE;
+
+		/* Every timer at a level expires after every timer at the levels below
+		it, so the first slot ahead of xTimerWheelTime at the lowest level that
+		has one holds the next timers to expire or to move down the wheel.  At
+		level 0 the slot of xTimerWheelTime itself counts as ahead, as it holds
+		the timers that expire at xTimerWheelTime. */
+		for( uxLevel = 0; ( uxLevel < tmrWHEEL_LEVELS ) && ( xFound == pdFALSE ); uxLevel++ )
+		{
+			uxShift = uxLevel * tmrWHEEL_SLOT_BITS;
+			uxFirstSlot = ( UBaseType_t ) ( ( ulWheelTime >> uxShift ) & tmrWHEEL_SLOT_MASK );
+			if( uxLevel != ( UBaseType_t ) 0U )
+			{
+				uxFirstSlot++;
+			}
+
+			if( uxFirstSlot < ( UBaseType_t ) tmrWHEEL_SLOTS )
+			{
+				ulSlotsAhead = ulTimerWheelSlotsInUse[ uxLevel ] >> uxFirstSlot;
+			}
+			else
+			{
+				ulSlotsAhead = 0UL;
+			}
+
+			while( ( ulSlotsAhead != 0UL ) && ( xFound == pdFALSE ) )
+			{
+				uxSlot = uxFirstSlot + tmrLOWEST_SET_BIT( ulSlotsAhead );
+
+				if( listLIST_IS_EMPTY( &( xTimerWheel[ uxLevel ][ uxSlot ] ) ) != pdFALSE )
+				{
+					/* Slots are not marked as empty when a timer is stopped,
+					so do it now. */
+					ulTimerWheelSlotsInUse[ uxLevel ] &= ~( ( uint32_t ) 1UL << uxSlot );
+					ulSlotsAhead &= ulSlotsAhead - 1UL;
+				}
+				else
+				{
+					/* The start of the slot.  The bits above this level are
+					those of xTimerWheelTime. */
+					if( ( uxShift + tmrWHEEL_SLOT_BITS ) < ( UBaseType_t ) 32U )
+					{
+						ulNextTime = ulWheelTime & ~( ( ( uint32_t ) 1UL << ( uxShift + tmrWHEEL_SLOT_BITS ) ) - 1UL );
+					}
+					ulNextTime |= ( uint32_t ) uxSlot << uxShift;
+					xFound = pdTRUE;
+				}
+			}
+		}
+
+		/* If the wheel is empty the task unblocks when the tick count rolls
+		over, as per the list case. */
+		*pxWheelWasEmpty = ( xFound == pdFALSE ) ? pdTRUE : pdFALSE;
+
+		return ( TickType_t ) ulNextTime;
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	static List_t *prvAdvanceTimerWheel( const TickType_t xTime )
+	{
+	List_t *pxSlot;
+	Timer_t *pxTimer;
+	UBaseType_t uxLevel, uxShift, uxSlot;
+
+		xTimerWheelTime = xTime;
+
+		/* Move the timers in the slots that start at xTime down the wheel,
+		highest level first.  Their expiry times now only differ from
+		xTimerWheelTime in lower bits, so they go to lower levels, or to the
+		slot that holds the timers that expire at xTime. */
+		for( uxLevel = tmrWHEEL_LEVELS - ( UBaseType_t ) 1U; uxLevel > ( UBaseType_t ) 0U; uxLevel-- )
+		{
+			uxShift = uxLevel * tmrWHEEL_SLOT_BITS;
+
+			if( ( ( uint32_t ) xTime & ( ( ( uint32_t ) 1UL << uxShift ) - 1UL ) ) == 0UL )
+			{
+				uxSlot = ( UBaseType_t ) ( ( ( uint32_t ) xTime >> uxShift ) & tmrWHEEL_SLOT_MASK );
+				pxSlot = &( xTimerWheel[ uxLevel ][ uxSlot ] );
+
+				while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+				{
+					pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+					( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+					prvInsertTimerInWheel( pxTimer );
+				}
+
+				ulTimerWheelSlotsInUse[ uxLevel ] &= ~( ( uint32_t ) 1UL << uxSlot );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return &( xTimerWheel[ 0 ][ ( uint32_t ) xTime & tmrWHEEL_SLOT_MASK ] );
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+
 static void	prvProcessReceivedCommands( void )
 {
 DaemonTaskMessage_t xMessage;
-Timer_t *pxTimer;
-BaseType_t xTimerListsWereSwitched, xResult;
-TickType_t xTimeNow;
 
 	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
 	{
 		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
 		{
 			/* Negative commands are pended function calls rather than timer
-			commands. */
-			if( xMessage.xMessageID < ( BaseType_t ) 0 )
+			commands, other than the message that says timer commands are
+			pending, which are processed below. */
+			if( ( xMessage.xMessageID < ( BaseType_t ) 0 ) && ( xMessage.xMessageID != tmrCOMMAND_PROCESS_PENDING ) )
 			{
 				const CallbackParameters_t * const pxCallback = &( xMessage.u.xCallbackParameters );
 
@@ -768,173 +1644,336 @@ TickType_t xTimeNow;
 		{
 			/* The messages uses the xTimerParameters member to work on a
 			software timer. */
-			pxTimer = xMessage.u.xTimerParameters.pxTimer;
+			prvProcessTimerCommand( xMessage.u.xTimerParameters.pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+		}
+	}
 
-			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+	#if( configUSE_TIMER_PENDING_COMMANDS == 1 )
+	{
+		prvProcessPendingCommands();
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessTimerCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xMessageValue )
+{
+BaseType_t xTimerListsWereSwitched, xResult;
+TickType_t xTimeNow;
+
+	if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+	{
+		/* The timer is in a list, remove it. */
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xMessageValue );
+
+	/* In this case the xTimerListsWereSwitched parameter is not used, but
+	it must be present in the function call.  prvSampleTimeNow() must be
+	called after the message is received from xTimerQueue so there is no
+	possibility of a higher priority task adding a message to the message
+	queue with a time that is ahead of the timer daemon task (because it
+	pre-empted the timer daemon task after the xTimeNow value was set). */
+	xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+
+	switch( xCommandID )
+	{
+		case tmrCOMMAND_START :
+		case tmrCOMMAND_START_FROM_ISR :
+		case tmrCOMMAND_RESET :
+		case tmrCOMMAND_RESET_FROM_ISR :
+		case tmrCOMMAND_START_DONT_TRACE :
+			/* Start or restart a timer. */
+			pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+			if( prvInsertTimerInActiveList( pxTimer,  xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessageValue ) != pdFALSE )
 			{
-				/* The timer is in a list, remove it. */
-				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				/* The timer expired before it was added to the active
+				timer list.  Process it now. */
+				prvCallTimerCallback( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) );
+				traceTIMER_EXPIRED( pxTimer );
+
+				if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+				{
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
+			break;
+
+		case tmrCOMMAND_STOP :
+		case tmrCOMMAND_STOP_FROM_ISR :
+			/* The timer has already been removed from the active list. */
+			pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+			break;
+
+		case tmrCOMMAND_CHANGE_PERIOD :
+		case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
+			pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+			pxTimer->xTimerPeriodInTicks = xMessageValue;
+			configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+			/* The new period does not really have a reference, and can
+			be longer or shorter than the old one.  The command time is
+			therefore set to the current time, and as the period cannot
+			be zero the next expiry time can only be in the future,
+			meaning (unlike for the xTimerStart() case above) there is
+			no fail case that needs to be handled here. */
+			( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+			break;
+
+		case tmrCOMMAND_DELETE :
+			#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				/* The timer has already been removed from the active list,
+				just free up the memory if the memory was dynamically
+				allocated. */
+				if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+				{
+					tmrFREE_TIMER( pxTimer );
+				}
+				else
+				{
+					pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+				}
+			}
+			#else
+			{
+				/* If dynamic allocation is not enabled, the memory
+				could not have been dynamically allocated. So there is
+				no need to free the memory - just mark the timer as
+				"not active". */
+				pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+			break;
 
-			traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+		default	:
+			/* Don't expect to get here. */
+			break;
+	}
+}
+/*-----------------------------------------------------------*/
 
-			/* In this case the xTimerListsWereSwitched parameter is not used, but
-			it must be present in the function call.  prvSampleTimeNow() must be
-			called after the message is received from xTimerQueue so there is no
-			possibility of a higher priority task adding a message to the message
-			queue with a time that is ahead of the timer daemon task (because it
-			pre-empted the timer daemon task after the xTimeNow value was set). */
-			xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+#if( configUSE_TIMER_PENDING_COMMANDS == 1 )
+
+	static void prvProcessPendingCommands( void )
+	{
+	Timer_t *pxTimer;
+	uint8_t ucCommand = 0U;
+	TickType_t xCommandTime = ( TickType_t ) 0U, xNewPeriod = ( TickType_t ) 0U;
 
-			switch( xMessage.xMessageID )
+		do
+		{
+			/* Take the first timer from the list, with its pending commands,
+			so the commands given while this one is processed are recorded
+			afresh. */
+			taskENTER_CRITICAL();
 			{
-				case tmrCOMMAND_START :
-				case tmrCOMMAND_START_FROM_ISR :
-				case tmrCOMMAND_RESET :
-				case tmrCOMMAND_RESET_FROM_ISR :
-				case tmrCOMMAND_START_DONT_TRACE :
-					/* Start or restart a timer. */
-					pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-					if( prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
+				pxTimer = pxPendingTimersHead;
+
+				if( pxTimer != NULL )
+				{
+					pxPendingTimersHead = pxTimer->pxNextPending;
+					if( pxPendingTimersHead == NULL )
 					{
-						/* The timer expired before it was added to the active
-						timer list.  Process it now. */
-						pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-						traceTIMER_EXPIRED( pxTimer );
-
-						if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-						{
-							xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-							configASSERT( xResult );
-							( void ) xResult;
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
+						pxPendingTimersTail = NULL;
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
-					break;
 
-				case tmrCOMMAND_STOP :
-				case tmrCOMMAND_STOP_FROM_ISR :
-					/* The timer has already been removed from the active list. */
-					pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
-					break;
-
-				case tmrCOMMAND_CHANGE_PERIOD :
-				case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
-					pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-					pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-					configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-					/* The new period does not really have a reference, and can
-					be longer or shorter than the old one.  The command time is
-					therefore set to the current time, and as the period cannot
-					be zero the next expiry time can only be in the future,
-					meaning (unlike for the xTimerStart() case above) there is
-					no fail case that needs to be handled here. */
-					( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-					break;
-
-				case tmrCOMMAND_DELETE :
-					#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-					{
-						/* The timer has already been removed from the active list,
-						just free up the memory if the memory was dynamically
-						allocated. */
-						if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
-						{
-							vPortFree( pxTimer );
-						}
-						else
-						{
-							pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
-						}
-					}
-					#else
-					{
-						/* If dynamic allocation is not enabled, the memory
-						could not have been dynamically allocated. So there is
-						no need to free the memory - just mark the timer as
-						"not active". */
-						pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
-					}
-					#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-					break;
+					ucCommand = pxTimer->ucPendingCommand;
+					xCommandTime = pxTimer->xPendingCommandTime;
+					xNewPeriod = pxTimer->xPendingPeriod;
+					pxTimer->pxNextPending = NULL;
+					pxTimer->ucPendingCommand = 0U;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( pxTimer != NULL )
+			{
+				if( ( ucCommand & tmrPENDING_PERIOD ) != 0U )
+				{
+					pxTimer->xTimerPeriodInTicks = xNewPeriod;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-				default	:
-					/* Don't expect to get here. */
-					break;
+				/* Only the last of the commands recorded for the timer
+				matters. */
+				if( ( ucCommand & tmrPENDING_DELETE ) != 0U )
+				{
+					prvProcessTimerCommand( pxTimer, tmrCOMMAND_DELETE, ( TickType_t ) 0U );
+				}
+				else if( ( ucCommand & tmrPENDING_STOP ) != 0U )
+				{
+					prvProcessTimerCommand( pxTimer, tmrCOMMAND_STOP, ( TickType_t ) 0U );
+				}
+				else if( ( ucCommand & tmrPENDING_START ) != 0U )
+				{
+					prvProcessTimerCommand( pxTimer, tmrCOMMAND_START, xCommandTime );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
-		}
+		} while( pxTimer != NULL );
 	}
-}
+
+#endif /* configUSE_TIMER_PENDING_COMMANDS */
 /*-----------------------------------------------------------*/
 
 static void prvSwitchTimerLists( void )
 {
 TickType_t xNextExpireTime, xReloadTime;
-List_t *pxTemp;
 Timer_t *pxTimer;
 BaseType_t xResult;
 
-	/* The tick count has overflowed.  The timer lists must be switched.
-	If there are any timers still referenced from the current timer list
-	then they must have expired and should be processed before the lists
-	are switched. */
-	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+	#if( configUSE_TIMER_WHEEL == 1 )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+	BaseType_t xWheelWasEmpty;
+	List_t *pxExpiredTimers;
+	TickType_t xNominalExpireTime;
+
+		/* The tick count has overflowed, so any timers still in the wheel
+		have expired and must be processed, in expiry order, before the timers
+		in the overflow list are moved to the wheel. */
+		xNextExpireTime = prvGetNextWheelTime( &xWheelWasEmpty );
+		while( xWheelWasEmpty == pdFALSE )
+		{
+			pxExpiredTimers = prvAdvanceTimerWheel( xNextExpireTime );
 
-		/* Remove the timer from the list. */
-		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-		traceTIMER_EXPIRED( pxTimer );
+			while( listLIST_IS_EMPTY( pxExpiredTimers ) == pdFALSE )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxExpiredTimers ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				traceTIMER_EXPIRED( pxTimer );
 
-		/* Execute its callback, then send a command to restart the timer if
-		it is an auto-reload timer.  It cannot be restarted here as the lists
-		have not yet been switched. */
-		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+				/* Execute its callback, then restart the timer if it is an
+				auto-reload timer, as per the list case below. */
+				prvCallTimerCallback( pxTimer, xNextExpireTime );
 
-		if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+				if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+				{
+					/* A reload time, once its slack is applied, that is not
+					beyond the overflow must be processed in this loop too. */
+					xNominalExpireTime = tmrNOMINAL_EXPIRY_TIME( pxTimer, xNextExpireTime );
+					xReloadTime = tmrAPPLY_SLACK( pxTimer, ( xNominalExpireTime + pxTimer->xTimerPeriodInTicks ) );
+					if( xReloadTime > xNominalExpireTime )
+					{
+						listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
+						prvInsertTimerInWheel( pxTimer );
+					}
+					else
+					{
+						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNominalExpireTime, NULL, tmrNO_DELAY );
+						configASSERT( xResult );
+						( void ) xResult;
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			xNextExpireTime = prvGetNextWheelTime( &xWheelWasEmpty );
+		}
+
+		xTimerWheelTime = ( TickType_t ) 0U;
+
+		while( listLIST_IS_EMPTY( pxOverflowTimerList ) == pdFALSE )
 		{
-			/* Calculate the reload value, and if the reload value results in
-			the timer going into the same timer list then it has already expired
-			and the timer should be re-inserted into the current list so it is
-			processed again within this loop.  Otherwise a command should be sent
-			to restart the timer to ensure it is only inserted into a list after
-			the lists have been swapped. */
-			xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
-			if( xReloadTime > xNextExpireTime )
+			pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxOverflowTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+			prvInsertTimerInWheel( pxTimer );
+		}
+	}
+	#else
+	{
+	List_t *pxTemp;
+
+		/* The tick count has overflowed.  The timer lists must be switched.
+		If there are any timers still referenced from the current timer list
+		then they must have expired and should be processed before the lists
+		are switched. */
+		while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+
+			/* Remove the timer from the list. */
+			pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+			traceTIMER_EXPIRED( pxTimer );
+
+			#if( configUSE_TIMER_SLACK == 1 )
 			{
-				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
-				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				/* Reload from when the timer should have expired. */
+				xNextExpireTime = tmrNOMINAL_EXPIRY_TIME( pxTimer, xNextExpireTime );
+			}
+			#endif
+
+			/* Execute its callback, then send a command to restart the timer if
+			it is an auto-reload timer.  It cannot be restarted here as the lists
+			have not yet been switched. */
+			prvCallTimerCallback( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) );
+
+			if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+			{
+				/* Calculate the reload value, and if the reload value results in
+				the timer going into the same timer list then it has already expired
+				and the timer should be re-inserted into the current list so it is
+				processed again within this loop.  Otherwise a command should be sent
+				to restart the timer to ensure it is only inserted into a list after
+				the lists have been swapped. */
+				xReloadTime = tmrAPPLY_SLACK( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ) );
+				if( xReloadTime > xNextExpireTime )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
+					listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+					vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				}
+				else
+				{
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
 			}
 			else
 			{
-				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-				configASSERT( xResult );
-				( void ) xResult;
+				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
-	}
 
-	pxTemp = pxCurrentTimerList;
-	pxCurrentTimerList = pxOverflowTimerList;
-	pxOverflowTimerList = pxTemp;
+		pxTemp = pxCurrentTimerList;
+		pxCurrentTimerList = pxOverflowTimerList;
+		pxOverflowTimerList = pxTemp;
+	}
+	#endif /* configUSE_TIMER_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
@@ -952,6 +1991,20 @@ static void prvCheckForValidListAndQueue( void )
 			pxCurrentTimerList = &xActiveTimerList1;
 			pxOverflowTimerList = &xActiveTimerList2;
 
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+			UBaseType_t uxLevel, uxSlot;
+
+				for( uxLevel = 0; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+				{
+					for( uxSlot = 0; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+					{
+						vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+					}
+				}
+			}
+			#endif /* configUSE_TIMER_WHEEL */
+
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
 				/* The timer queue is allocated statically in case
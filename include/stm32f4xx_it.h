@@ -34,6 +34,7 @@ void DebugMon_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
 void RTC_Alarm_IRQHandler(void);
+void TIM5_IRQHandler(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,352 @@
+/**
+ * @file hrtimer.c
+ * @brief High-resolution one-shot timer service - deadline heap and compare logic
+ *
+ * Pending timers are held in a binary min-heap of pointers ordered by
+ * deadline, and each timer records its position in the heap so it can be
+ * stopped without a search.  Starting or stopping a timer is O(log n), and the
+ * compare register only needs reprogramming when the earliest deadline
+ * changes.
+ *
+ * Deadlines are absolute counter values.  They are ordered by their signed
+ * difference, which stays correct when the counter wraps as long as every
+ * pending deadline is within HRTIMER_MAX_DELAY_TICKS of the counter.
+ *
+ * The heap is shared by tasks and the compare interrupt, and timers may be
+ * started or stopped from other interrupts, so it is updated with interrupts
+ * up to configMAX_SYSCALL_INTERRUPT_PRIORITY masked.  On Cortex-M that mask
+ * can be raised from both tasks and interrupts.
+ */
+
+#include "hrtimer.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#define HRTIMER_LOCK()          taskENTER_CRITICAL_FROM_ISR()
+#define HRTIMER_UNLOCK(saved)   taskEXIT_CRITICAL_FROM_ISR(saved)
+
+// True if timer a is due before timer b.
+#define HRTIMER_BEFORE(a, b)    ((int32_t)((a)->deadline - (b)->deadline) < 0)
+
+static HRTimer_t *heap[HRTIMER_MAX_TIMERS];
+static uint32_t heapCount;
+static volatile uint32_t deferFailures;
+
+/**
+ * @brief Move the timer at index towards the root until its parent is due first
+ */
+static void HRTimer_SiftUp(uint32_t index)
+{
+    HRTimer_t *timer = heap[index];
+
+    while (index > 0U)
+    {
+        uint32_t parent = (index - 1U) / 2U;
+
+        if (!HRTIMER_BEFORE(timer, heap[parent]))
+        {
+            break;
+        }
+
+        heap[index] = heap[parent];
+        heap[index]->index = (uint8_t)index;
+        index = parent;
+    }
+
+    heap[index] = timer;
+    timer->index = (uint8_t)index;
+}
+
+/**
+ * @brief Move the timer at index towards the leaves until it is due first
+ */
+static void HRTimer_SiftDown(uint32_t index)
+{
+    HRTimer_t *timer = heap[index];
+
+    for (;;)
+    {
+        uint32_t child = (2U * index) + 1U;
+
+        if (child >= heapCount)
+        {
+            break;
+        }
+
+        // Follow the child that is due first.
+        if (((child + 1U) < heapCount) && HRTIMER_BEFORE(heap[child + 1U], heap[child]))
+        {
+            child++;
+        }
+
+        if (!HRTIMER_BEFORE(heap[child], timer))
+        {
+            break;
+        }
+
+        heap[index] = heap[child];
+        heap[index]->index = (uint8_t)index;
+        index = child;
+    }
+
+    heap[index] = timer;
+    timer->index = (uint8_t)index;
+}
+
+/**
+ * @brief Remove the timer at index from the heap
+ */
+static void HRTimer_RemoveAt(uint32_t index)
+{
+    HRTimer_t *last;
+
+    heap[index]->index = HRTIMER_NOT_PENDING;
+    heapCount--;
+
+    if (index < heapCount)
+    {
+        // Fill the gap with the last timer, which may belong above or below it.
+        last = heap[heapCount];
+        heap[index] = last;
+        HRTimer_SiftUp(index);
+        HRTimer_SiftDown(last->index);
+    }
+}
+
+/**
+ * @brief Program the compare register for the earliest deadline
+ * @note Called with the heap locked, whenever the root of the heap changes.
+ */
+static void HRTimer_Program(void)
+{
+    uint32_t deadline;
+
+    if (heapCount == 0U)
+    {
+        HRTimer_HwDisarm();
+        return;
+    }
+
+    deadline = heap[0]->deadline;
+    HRTimer_HwSetCompare(deadline);
+
+    // The compare only matches when the counter equals the deadline, so a
+    // deadline that has passed, or that the counter may have reached before
+    // the write, would not interrupt until the counter wraps.
+    if ((int32_t)(deadline - HRTimer_HwCounter()) < (int32_t)HRTIMER_MIN_LEAD_TICKS)
+    {
+        HRTimer_HwTrigger();
+    }
+}
+
+#if (configUSE_TIMERS == 1) && (INCLUDE_xTimerPendFunctionCall == 1)
+/**
+ * @brief Run the callback of a timer in the timer service task
+ */
+static void HRTimer_RunDeferred(void *parameter, uint32_t unused)
+{
+    HRTimer_t *timer = (HRTimer_t *)parameter;
+
+    (void)unused;
+    timer->callback(timer, timer->context);
+}
+#endif
+
+/**
+ * @brief Initialize the timer service and start the hardware counter
+ */
+void HRTimer_Init(void)
+{
+    heapCount = 0U;
+    deferFailures = 0U;
+    HRTimer_HwInit();
+}
+
+/**
+ * @brief Initialize a timer, which is not pending until it is started
+ * @param timer: The timer, which must stay valid while it is pending
+ * @param callback: Called when the timer expires
+ * @param context: Passed to the callback
+ * @param mode: Whether the callback runs in the compare interrupt or in the
+ *        FreeRTOS timer service task
+ */
+void HRTimer_Create(HRTimer_t *timer, HRTimer_Callback_t callback, void *context, HRTimer_CallMode_t mode)
+{
+    configASSERT(timer != NULL);
+    configASSERT(callback != NULL);
+
+    timer->deadline = 0U;
+    timer->callback = callback;
+    timer->context = context;
+    timer->mode = (uint8_t)mode;
+    timer->index = HRTIMER_NOT_PENDING;
+}
+
+/**
+ * @brief Start a timer to expire delay counter ticks from now
+ * @note May be called from tasks, from interrupts at or below
+ *       configMAX_SYSCALL_INTERRUPT_PRIORITY, and from callbacks.  A pending
+ *       timer is restarted.
+ * @param delay: Ticks of HRTIMER_COUNTER_HZ, at most HRTIMER_MAX_DELAY_TICKS
+ * @retval false if HRTIMER_MAX_TIMERS timers are already pending
+ */
+bool HRTimer_Start(HRTimer_t *timer, uint32_t delay)
+{
+    configASSERT(delay <= HRTIMER_MAX_DELAY_TICKS);
+
+    return HRTimer_StartAt(timer, HRTimer_HwCounter() + delay);
+}
+
+/**
+ * @brief Start a timer to expire when the counter reaches deadline
+ * @note A deadline that has already passed expires immediately.  Restarting a
+ *       timer from its callback with HRTimer_GetDeadline() plus a period gives
+ *       a sequence of expiries that does not drift.
+ * @param deadline: Counter value at which the timer expires
+ * @retval false if HRTIMER_MAX_TIMERS timers are already pending
+ */
+bool HRTimer_StartAt(HRTimer_t *timer, uint32_t deadline)
+{
+    UBaseType_t saved;
+    bool started = true;
+    bool wasFirst;
+
+    configASSERT(timer != NULL);
+
+    saved = HRTIMER_LOCK();
+    {
+        wasFirst = (timer->index == 0U);
+
+        if (timer->index != HRTIMER_NOT_PENDING)
+        {
+            HRTimer_RemoveAt(timer->index);
+        }
+
+        if (heapCount < HRTIMER_MAX_TIMERS)
+        {
+            timer->deadline = deadline;
+            heap[heapCount] = timer;
+            heapCount++;
+            HRTimer_SiftUp(heapCount - 1U);
+        }
+        else
+        {
+            started = false;
+        }
+
+        if (wasFirst || (timer->index == 0U))
+        {
+            HRTimer_Program();
+        }
+    }
+    HRTIMER_UNLOCK(saved);
+
+    return started;
+}
+
+/**
+ * @brief Stop a timer
+ * @note A callback that has been passed to the timer service task still runs.
+ * @retval true if the timer was pending
+ */
+bool HRTimer_Stop(HRTimer_t *timer)
+{
+    UBaseType_t saved;
+    bool wasPending;
+
+    configASSERT(timer != NULL);
+
+    saved = HRTIMER_LOCK();
+    {
+        wasPending = (timer->index != HRTIMER_NOT_PENDING);
+
+        if (wasPending)
+        {
+            bool wasFirst = (timer->index == 0U);
+
+            HRTimer_RemoveAt(timer->index);
+
+            if (wasFirst)
+            {
+                HRTimer_Program();
+            }
+        }
+    }
+    HRTIMER_UNLOCK(saved);
+
+    return wasPending;
+}
+
+/**
+ * @brief Check if a timer has been started and has not yet expired
+ */
+bool HRTimer_IsPending(const HRTimer_t *timer)
+{
+    return timer->index != HRTIMER_NOT_PENDING;
+}
+
+/**
+ * @brief Get the counter value at which a timer expires, or last expired
+ */
+uint32_t HRTimer_GetDeadline(const HRTimer_t *timer)
+{
+    return timer->deadline;
+}
+
+/**
+ * @brief Read the counter
+ */
+uint32_t HRTimer_Now(void)
+{
+    return HRTimer_HwCounter();
+}
+
+/**
+ * @brief Get the number of task callbacks dropped because the timer command
+ *        queue was full
+ * @note Raise configTIMER_QUEUE_LENGTH if this is not zero.
+ */
+uint32_t HRTimer_GetDeferFailures(void)
+{
+    return deferFailures;
+}
+
+/**
+ * @brief Expire every timer whose deadline has passed, then program the
+ *        compare register for the next
+ * @note Called by the compare interrupt handler after it clears the flag.
+ */
+void HRTimer_IRQHandler(void)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    UBaseType_t saved;
+    HRTimer_t *timer;
+
+    saved = HRTIMER_LOCK();
+
+    while ((heapCount > 0U) && ((int32_t)(heap[0]->deadline - HRTimer_HwCounter()) <= 0))
+    {
+        timer = heap[0];
+        HRTimer_RemoveAt(0U);
+
+        if (timer->mode == (uint8_t)HRTIMER_CALL_FROM_ISR)
+        {
+            // Unlocked, so the callback can restart the timer.
+            HRTIMER_UNLOCK(saved);
+            timer->callback(timer, timer->context);
+            saved = HRTIMER_LOCK();
+        }
+#if (configUSE_TIMERS == 1) && (INCLUDE_xTimerPendFunctionCall == 1)
+        else if (xTimerPendFunctionCallFromISR(HRTimer_RunDeferred, timer, 0U, &higherPriorityTaskWoken) != pdPASS)
+        {
+            deferFailures++;
+        }
+#endif
+    }
+
+    HRTimer_Program();
+    HRTIMER_UNLOCK(saved);
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
@@ -0,0 +1,105 @@
+/**
+ * @file hrtimer.h
+ * @brief High-resolution one-shot timer service on a 32-bit hardware timer
+ *
+ * FreeRTOS software timers expire on tick boundaries (1 ms with
+ * configTICK_RATE_HZ = 1000) and run in the timer service task.  This service
+ * runs one-shot timers from a free running 32-bit hardware counter instead:
+ * pending timers are kept in a binary min-heap ordered by deadline, and the
+ * counter's compare register is programmed for the earliest one, so there is
+ * one interrupt per expiry and none while nothing is pending.
+ *
+ * Each timer's callback runs either in the compare interrupt, or in the
+ * FreeRTOS timer service task via xTimerPendFunctionCallFromISR().  The second
+ * is only available when configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall
+ * are both 1.
+ *
+ * The heap and compare logic in hrtimer.c only use the counter through the
+ * HRTimer_Hw functions below, which hrtimer_tim.c implements with TIM5.
+ */
+
+#ifndef HRTIMER_H
+#define HRTIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+
+// Counter frequency.  At 1 MHz times are in microseconds and the counter
+// wraps every 71 minutes.
+#ifndef HRTIMER_COUNTER_HZ
+#define HRTIMER_COUNTER_HZ 1000000UL
+#endif
+
+// Most timers that can be pending at once.
+#ifndef HRTIMER_MAX_TIMERS
+#define HRTIMER_MAX_TIMERS 16
+#endif
+
+// A deadline this close to the counter when the compare register is written
+// may be passed before the write takes effect, so the interrupt is raised by
+// software instead.
+#ifndef HRTIMER_MIN_LEAD_TICKS
+#define HRTIMER_MIN_LEAD_TICKS 2
+#endif
+
+// Deadlines are compared by the signed difference to the counter, so must be
+// less than half the counter range ahead.
+#define HRTIMER_MAX_DELAY_TICKS 0x7FFFFFFFUL
+
+#define HRTIMER_US_TO_TICKS(us) ((uint32_t)(((uint64_t)(us) * HRTIMER_COUNTER_HZ) / 1000000ULL))
+
+typedef struct HRTimer HRTimer_t;
+
+typedef void (*HRTimer_Callback_t)(HRTimer_t *timer, void *context);
+
+typedef enum
+{
+    HRTIMER_CALL_FROM_ISR,  // Called in the compare interrupt.  Keep it short, use only FromISR APIs.
+#if (configUSE_TIMERS == 1) && (INCLUDE_xTimerPendFunctionCall == 1)
+    HRTIMER_CALL_FROM_TASK  // Called in the FreeRTOS timer service task.
+#endif
+} HRTimer_CallMode_t;
+
+// A timer.  The memory is provided by the caller, and must stay valid while
+// the timer is pending.  The fields are private to hrtimer.c.
+struct HRTimer
+{
+    uint32_t deadline;
+    HRTimer_Callback_t callback;
+    void *context;
+    uint8_t mode;
+    uint8_t index;  // Position in the heap, or HRTIMER_NOT_PENDING.
+};
+
+#define HRTIMER_NOT_PENDING 0xFFU
+
+// Heap positions are stored in the uint8_t index field.
+#if HRTIMER_MAX_TIMERS >= HRTIMER_NOT_PENDING
+#error HRTIMER_MAX_TIMERS must be less than HRTIMER_NOT_PENDING
+#endif
+
+// Function prototypes
+void HRTimer_Init(void);
+void HRTimer_Create(HRTimer_t *timer, HRTimer_Callback_t callback, void *context, HRTimer_CallMode_t mode);
+bool HRTimer_Start(HRTimer_t *timer, uint32_t delay);
+bool HRTimer_StartAt(HRTimer_t *timer, uint32_t deadline);
+bool HRTimer_Stop(HRTimer_t *timer);
+bool HRTimer_IsPending(const HRTimer_t *timer);
+uint32_t HRTimer_GetDeadline(const HRTimer_t *timer);
+uint32_t HRTimer_Now(void);
+uint32_t HRTimer_GetDeferFailures(void);
+void HRTimer_IRQHandler(void);
+
+// Hardware layer, implemented in hrtimer_tim.c.  HRTimer_HwSetCompare()
+// programs the compare register and enables its interrupt,
+// HRTimer_HwDisarm() disables the interrupt, and HRTimer_HwTrigger() raises
+// it now.  The interrupt handler must clear the interrupt flag, then call
+// HRTimer_IRQHandler().
+void HRTimer_HwInit(void);
+uint32_t HRTimer_HwCounter(void);
+void HRTimer_HwSetCompare(uint32_t compare);
+void HRTimer_HwDisarm(void);
+void HRTimer_HwTrigger(void);
+
+#endif /* HRTIMER_H */
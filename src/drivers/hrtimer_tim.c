@@ -0,0 +1,120 @@
+/**
+ * @file hrtimer_tim.c
+ * @brief High-resolution timer service - TIM5 hardware layer
+ *
+ * TIM5 is a 32-bit timer on APB1, separate from the TIM6 HAL time base in
+ * stm32f4xx_hal_timebase_tim.c.  It free runs at HRTIMER_COUNTER_HZ over the
+ * full 32-bit range, and capture/compare channel 1, in timing mode with no
+ * output, raises the interrupt at each deadline.
+ */
+
+#include "hrtimer.h"
+#include "main.h"
+#include "FreeRTOS.h"
+
+// The compare interrupt calls FreeRTOS FromISR functions, so must not be
+// above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY (numerically lower).
+#ifndef HRTIMER_IRQ_PRIORITY
+#define HRTIMER_IRQ_PRIORITY configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+#endif
+
+TIM_HandleTypeDef htim5;
+
+/**
+ * @brief Configure TIM5 as a free running counter with a compare interrupt
+ */
+void HRTimer_HwInit(void)
+{
+    RCC_ClkInitTypeDef clkconfig;
+    TIM_OC_InitTypeDef sConfigOC = {0};
+    uint32_t pFLatency;
+    uint32_t timclock;
+
+    __HAL_RCC_TIM5_CLK_ENABLE();
+
+    // APB1 timers run at twice PCLK1 when the APB1 prescaler is not 1.
+    HAL_RCC_GetClockConfig(&clkconfig, &pFLatency);
+    timclock = HAL_RCC_GetPCLK1Freq();
+    if (clkconfig.APB1CLKDivider != RCC_HCLK_DIV1)
+    {
+        timclock *= 2U;
+    }
+
+    htim5.Instance = TIM5;
+    htim5.Init.Prescaler = (timclock / HRTIMER_COUNTER_HZ) - 1U;
+    htim5.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim5.Init.Period = 0xFFFFFFFFU;
+    htim5.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim5.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_OC_Init(&htim5) != HAL_OK)
+    {
+        Error_Handler();
+    }
+
+    // Compare preload stays disabled so each new deadline takes effect at once.
+    sConfigOC.OCMode = TIM_OCMODE_TIMING;
+    sConfigOC.Pulse = 0U;
+    sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
+    sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+    if (HAL_TIM_OC_ConfigChannel(&htim5, &sConfigOC, TIM_CHANNEL_1) != HAL_OK)
+    {
+        Error_Handler();
+    }
+
+    HAL_NVIC_SetPriority(TIM5_IRQn, HRTIMER_IRQ_PRIORITY, 0U);
+    HAL_NVIC_EnableIRQ(TIM5_IRQn);
+
+    // Start counting with the compare interrupt disabled until a timer is
+    // started.
+    __HAL_TIM_DISABLE_IT(&htim5, TIM_IT_CC1);
+    __HAL_TIM_ENABLE(&htim5);
+}
+
+/**
+ * @brief Read the TIM5 counter
+ */
+uint32_t HRTimer_HwCounter(void)
+{
+    return TIM5->CNT;
+}
+
+/**
+ * @brief Set the deadline of the compare interrupt and enable it
+ */
+void HRTimer_HwSetCompare(uint32_t compare)
+{
+    // Clear any match of the previous deadline first, so it does not raise
+    // the interrupt early.
+    __HAL_TIM_CLEAR_FLAG(&htim5, TIM_FLAG_CC1);
+    TIM5->CCR1 = compare;
+    __HAL_TIM_ENABLE_IT(&htim5, TIM_IT_CC1);
+}
+
+/**
+ * @brief Disable the compare interrupt
+ */
+void HRTimer_HwDisarm(void)
+{
+    __HAL_TIM_DISABLE_IT(&htim5, TIM_IT_CC1);
+}
+
+/**
+ * @brief Raise the compare interrupt now
+ */
+void HRTimer_HwTrigger(void)
+{
+    TIM5->EGR = TIM_EGR_CC1G;
+}
+
+/**
+ * @brief This function handles TIM5 global interrupt
+ */
+void TIM5_IRQHandler(void)
+{
+    if ((__HAL_TIM_GET_FLAG(&htim5, TIM_FLAG_CC1) != RESET) &&
+        (__HAL_TIM_GET_IT_SOURCE(&htim5, TIM_IT_CC1) != RESET))
+    {
+        __HAL_TIM_CLEAR_FLAG(&htim5, TIM_FLAG_CC1);
+        HRTimer_IRQHandler();
+    }
+}
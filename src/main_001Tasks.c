@@ -51,6 +51,15 @@
 
 #define DWT_CTRL    (*(volatile uint32_t*)0xE0001000)
 
+#if( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
+// 64 KB core-coupled RAM, zero wait state but not reachable by DMA.  The part
+// after the linker script's .ccmram section, which ends at _eccmram as in the
+// STM32CubeMX scripts for the F429, is left for task stacks.
+#define CCMRAM_BASE 0x10000000UL
+#define CCMRAM_SIZE (64 * 1024)
+extern uint8_t _eccmram[];
+#endif
+
 // Global variables for LCD display
 uint16_t task1_y_pos = 50;
 uint16_t task2_y_pos = 80;
@@ -122,6 +131,19 @@ int main(void)
   //Enable the CYCCNT counter.
   DWT_CTRL |= ( 1 << 0);
 
+#if( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
+  // Put task stacks in CCM RAM; the configTOTAL_HEAP_SIZE general region
+  // heap_regions creates in SRAM stays free for TCBs, queues and DMA buffers
+  {
+    static HeapRegion_t ccm_region;
+
+    ccm_region.pucStartAddress = _eccmram;
+    ccm_region.xSizeInBytes = (CCMRAM_BASE + CCMRAM_SIZE) - (uint32_t)_eccmram;
+    configASSERT(((uint32_t)_eccmram >= CCMRAM_BASE) && ((uint32_t)_eccmram < (CCMRAM_BASE + CCMRAM_SIZE)));
+    vPortAddHeapRegion(&ccm_region, eHeapPlacementFast);
+  }
+#endif
+
   // Create tasks with DIFFERENT priorities to prevent LCD interference
   // Higher priority task will complete LCD updates without interruption
   status = xTaskCreate(task1_handler, "Task-1", 200, "Hello world from Task-1", 3, &task1_handle);
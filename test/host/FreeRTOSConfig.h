@@ -0,0 +1,86 @@
+/*
+ * FreeRTOS configuration for the host tests.  It follows the target's
+ * configuration, with a larger heap, an idle hook to advance the virtual tick,
+ * and an assert that reports where it failed.  Every option the kernel changes
+ * add can be overridden with -D in the Makefile.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#define configUSE_PREEMPTION					1
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION		0
+#endif
+#define configSUPPORT_DYNAMIC_ALLOCATION		1
+#define configUSE_IDLE_HOOK						1
+#define configUSE_TICK_HOOK						0
+#define configCPU_CLOCK_HZ						( ( unsigned long ) 168000000 )
+#define configTICK_RATE_HZ						( ( TickType_t ) 1000 )
+#ifndef configMAX_PRIORITIES
+	#define configMAX_PRIORITIES				( 7 )
+#endif
+#define configMINIMAL_STACK_SIZE				( ( unsigned short ) 128 )
+#ifndef configTOTAL_HEAP_SIZE
+	#define configTOTAL_HEAP_SIZE				( ( size_t ) ( 4 * 1024 * 1024 ) )
+#endif
+#define configMAX_TASK_NAME_LEN					( 10 )
+#define configUSE_TRACE_FACILITY				1
+#define configUSE_16_BIT_TICKS					0
+#define configUSE_MUTEXES						1
+#ifndef configQUEUE_REGISTRY_SIZE
+	#define configQUEUE_REGISTRY_SIZE			8
+#endif
+#define configUSE_RECURSIVE_MUTEXES				1
+#define configUSE_MALLOC_FAILED_HOOK			0
+#define configUSE_APPLICATION_TASK_TAG			0
+#define configUSE_COUNTING_SEMAPHORES			1
+#define configUSE_QUEUE_SETS					1
+#define configUSE_TASK_NOTIFICATIONS			1
+#define configUSE_CO_ROUTINES					0
+#define configMAX_CO_ROUTINE_PRIORITIES			( 2 )
+
+#define configUSE_TIMERS						1
+#ifndef configTIMER_TASK_PRIORITY
+	#define configTIMER_TASK_PRIORITY			( 2 )
+#endif
+#ifndef configTIMER_QUEUE_LENGTH
+	#define configTIMER_QUEUE_LENGTH			10
+#endif
+#define configTIMER_TASK_STACK_DEPTH			( configMINIMAL_STACK_SIZE * 2 )
+
+#define INCLUDE_vTaskPrioritySet				1
+#define INCLUDE_uxTaskPriorityGet				1
+#define INCLUDE_vTaskDelete						1
+#define INCLUDE_vTaskCleanUpResources			1
+#define INCLUDE_vTaskSuspend					1
+#define INCLUDE_vTaskDelayUntil					1
+#define INCLUDE_vTaskDelay						1
+#define INCLUDE_xQueueGetMutexHolder			1
+#define INCLUDE_xTaskGetSchedulerState			1
+#ifndef INCLUDE_xTimerPendFunctionCall
+	#define INCLUDE_xTimerPendFunctionCall		1
+#endif
+#define INCLUDE_xTaskGetCurrentTaskHandle		1
+#define INCLUDE_uxTaskGetStackHighWaterMark		1
+#define INCLUDE_xTaskGetIdleTaskHandle			0
+#define INCLUDE_eTaskGetState					1
+#define INCLUDE_xSemaphoreGetMutexHolder		1
+
+/* Timer callbacks are timed in microseconds of the host's clock, as the
+virtual tick does not advance while a callback runs. */
+extern uint32_t ulPortHostMicroseconds( void );
+#ifndef configTIMER_STATS_TIMESTAMP
+	#define configTIMER_STATS_TIMESTAMP()		ulPortHostMicroseconds()
+#endif
+
+/* Like the target's assert, this uses taskDISABLE_INTERRUPTS(), so a kernel
+file that asserts without including task.h fails to build.  A test of what
+the kernel does when asserts are compiled out defines it to only evaluate
+its argument. */
+extern void vAssertCalled( const char *pcFile, int iLine );
+#ifndef configASSERT
+	#define configASSERT( x ) if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); vAssertCalled( __FILE__, __LINE__ ); }
+#endif
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,124 @@
+/*
+ * Cooperative host port used by the tests in this directory.
+ *
+ * Each task runs on its own ucontext stack and tasks only switch when the
+ * kernel yields, so a test is deterministic.  The tick is virtual: it is only
+ * incremented by the idle hook, so time passes when, and only when, every task
+ * is blocked.  A test can model a task that runs for some ticks by calling
+ * vPortRunForTicks().
+ */
+
+#include <ucontext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define portHOST_STACK_SIZE		( 256 * 1024 )
+
+typedef struct HostContext
+{
+	ucontext_t xContext;
+} HostContext_t;
+
+extern void * volatile pxCurrentTCB;
+static ucontext_t xSchedulerCaller;
+
+static void prvTaskEntry( uintptr_t uxCode, uintptr_t uxParameters )
+{
+	( ( TaskFunction_t ) uxCode )( ( void * ) uxParameters );
+	fprintf( stderr, "a task returned from its implementing function\n" );
+	abort();
+}
+
+/* The context is stored on the kernel's stack for the task, where the first
+member of the TCB, pxTopOfStack, points to it. */
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+HostContext_t *pxHost = malloc( sizeof( HostContext_t ) );
+
+	if( pxHost == NULL )
+	{
+		abort();
+	}
+
+	( void ) getcontext( &( pxHost->xContext ) );
+	pxHost->xContext.uc_stack.ss_size = portHOST_STACK_SIZE;
+	pxHost->xContext.uc_stack.ss_sp = malloc( portHOST_STACK_SIZE );
+	pxHost->xContext.uc_link = NULL;
+	makecontext( &( pxHost->xContext ), ( void ( * )( void ) ) prvTaskEntry, 2, ( uintptr_t ) pxCode, ( uintptr_t ) pvParameters );
+
+	/* Two pointers down keeps the slot aligned to portBYTE_ALIGNMENT. */
+	pxTopOfStack -= ( 2 * sizeof( HostContext_t * ) ) / sizeof( StackType_t );
+	*( HostContext_t ** ) pxTopOfStack = pxHost;
+	return pxTopOfStack;
+}
+
+/* Counts the switches between tasks, for benchmarks. */
+volatile unsigned long ulPortContextSwitches;
+
+static HostContext_t *prvContextOf( void *pvTCB )
+{
+	return **( HostContext_t *** ) pvTCB;
+}
+
+void vPortYield( void )
+{
+void *pvPreviousTCB = pxCurrentTCB;
+
+	vTaskSwitchContext();
+
+	if( pxCurrentTCB != pvPreviousTCB )
+	{
+		ulPortContextSwitches++;
+		( void ) swapcontext( &( prvContextOf( pvPreviousTCB )->xContext ), &( prvContextOf( pxCurrentTCB )->xContext ) );
+	}
+}
+
+BaseType_t xPortStartScheduler( void )
+{
+	( void ) swapcontext( &xSchedulerCaller, &( prvContextOf( pxCurrentTCB )->xContext ) );
+	return pdFALSE;
+}
+
+void vPortEndScheduler( void )
+{
+	( void ) swapcontext( &( prvContextOf( pxCurrentTCB )->xContext ), &xSchedulerCaller );
+}
+
+void vPortRunForTicks( TickType_t xTicks )
+{
+	while( xTicks > ( TickType_t ) 0 )
+	{
+		if( xTaskIncrementTick() != pdFALSE )
+		{
+			vPortYield();
+		}
+
+		xTicks--;
+	}
+}
+
+void vApplicationIdleHook( void )
+{
+	( void ) xTaskIncrementTick();
+	vPortYield();
+}
+
+uint32_t ulPortHostMicroseconds( void )
+{
+struct timespec xNow;
+
+	( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( uint32_t ) ( ( ( uint64_t ) xNow.tv_sec * 1000000ULL ) + ( ( uint64_t ) xNow.tv_nsec / 1000ULL ) );
+}
+
+/* Weak, so a test of what trips an assert can define its own that returns to
+the test instead. */
+__attribute__( ( weak ) ) void vAssertCalled( const char *pcFile, int iLine )
+{
+	fprintf( stderr, "assertion failed at %s:%d\n", pcFile, iLine );
+	abort();
+}
@@ -0,0 +1,57 @@
+/*
+ * Port definitions for the cooperative host port used by the tests in this
+ * directory.  Tasks run on ucontext stacks in a single Linux thread, so there
+ * is nothing to mask: critical sections are empty and a "yield" is a direct
+ * context switch.  Time is virtual - see port.c.
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uint32_t
+#define portBASE_TYPE	long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY				( TickType_t ) 0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC		1
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portPOINTER_SIZE_TYPE		uintptr_t
+
+extern void vPortYield( void );
+#define portYIELD()					vPortYield()
+#define portEND_SWITCHING_ISR( x )	if( ( x ) != pdFALSE ) portYIELD()
+#define portYIELD_FROM_ISR( x )		portEND_SWITCHING_ISR( x )
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()		0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )	( void ) ( x )
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+#define portINLINE					__inline
+#define portFORCE_INLINE			inline __attribute__( ( always_inline ) )
+#define portMEMORY_BARRIER()		__asm volatile( "" ::: "memory" )
+
+/* portCOUNT_LEADING_ZEROS() is deliberately not defined, so the tests cover
+the kernel's portable fallback. */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	0
+
+#endif /* PORTMACRO_H */
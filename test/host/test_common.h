@@ -0,0 +1,43 @@
+/*
+ * Helpers shared by the host tests.  A test counts failed checks in
+ * ulTestFailures and returns TEST_RESULT() from main(), so make check fails
+ * if any check failed.
+ */
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static unsigned long ulTestFailures;
+
+#define TEST_CHECK( x )																\
+	do																				\
+	{																				\
+		if( !( x ) )																\
+		{																			\
+			printf( "FAIL %s:%d: %s\n", __FILE__, __LINE__, #x );					\
+			ulTestFailures++;														\
+		}																			\
+	} while( 0 )
+
+#define TEST_RESULT()	( ( ulTestFailures == 0UL ) ? ( printf( "PASS\n" ), 0 ) : ( printf( "%lu checks failed\n", ulTestFailures ), 1 ) )
+
+/* Wall clock time, for benchmarks. */
+static inline uint64_t ullTestNanoseconds( void )
+{
+struct timespec xNow;
+
+	( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+
+/* In port.c.  Increments the tick as if the calling task ran for xTicks. */
+extern void vPortRunForTicks( TickType_t xTicks );
+
+/* In port.c.  The number of switches between tasks so far. */
+extern volatile unsigned long ulPortContextSwitches;
+
+#endif /* TEST_COMMON_H */
@@ -0,0 +1,293 @@
+/*
+ * Conflating queues, and a display task that cannot keep up with the updates
+ * of the regions it draws.
+ *
+ * An item sent with the key of a pending item must replace that item where it
+ * is, without changing the number of items, even when the queue is full.
+ * Once the pending item has been received, the next item with its key must go
+ * to the back of the queue.  A peek must not release the key.  Items sent
+ * without a key must never be replaced, and xQueueReset() must forget every
+ * key.
+ *
+ * Then a producer posts 64 updates each tick to 16 regions for 400 ticks, and
+ * a display task above it receives four updates each tick.  The printed
+ * figures give the updates the display received, how many of them had already
+ * been superseded, and the tick the display showed the last update of every
+ * region, with a FIFO queue the producer blocks on and with a conflating queue.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "test_common.h"
+
+#define testLENGTH				4
+#define testKEYS				8
+#define testNO_KEY				0xffU
+#define testREGIONS				16
+#define testUPDATES_PER_TICK	64
+#define testPRODUCER_TICKS		400
+#define testDRAWS_PER_TICK		4
+
+typedef struct TestItem
+{
+	uint8_t ucKey;
+	uint32_t ulValue;
+} TestItem_t;
+
+static QueueHandle_t xQueue;
+static volatile uint32_t ulLatest[ testREGIONS ], ulShown[ testREGIONS ];
+static volatile unsigned long ulDeliveries, ulStale;
+static volatile BaseType_t xProducerDone, xDisplayDone;
+
+static BaseType_t prvSend( uint8_t ucKey, uint32_t ulValue )
+{
+TestItem_t xItem;
+
+	xItem.ucKey = ucKey;
+	xItem.ulValue = ulValue;
+
+	if( ucKey == testNO_KEY )
+	{
+		return xQueueSend( xQueue, &xItem, 0 );
+	}
+
+	return xQueueSendWithKey( xQueue, &xItem, ucKey, 0 );
+}
+
+static BaseType_t prvReceived( uint8_t ucKey, uint32_t ulValue )
+{
+TestItem_t xItem;
+
+	return ( xQueueReceive( xQueue, &xItem, 0 ) == pdPASS ) && ( xItem.ucKey == ucKey ) && ( xItem.ulValue == ulValue );
+}
+
+static void prvCheckConflation( void )
+{
+TestItem_t xItem;
+
+	xQueue = xQueueCreateConflating( testLENGTH, sizeof( TestItem_t ), testKEYS );
+	TEST_CHECK( xQueue != NULL );
+
+	/* Replaced where it is. */
+	TEST_CHECK( prvSend( 1, 10 ) == pdPASS );
+	TEST_CHECK( prvSend( 2, 20 ) == pdPASS );
+	TEST_CHECK( prvSend( 1, 11 ) == pdPASS );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == 2 );
+
+	/* A peek does not release the key. */
+	TEST_CHECK( ( xQueuePeek( xQueue, &xItem, 0 ) == pdPASS ) && ( xItem.ulValue == 11 ) );
+	TEST_CHECK( prvSend( 1, 12 ) == pdPASS );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == 2 );
+
+	/* Once received, the key goes to the back. */
+	TEST_CHECK( prvReceived( 1, 12 ) );
+	TEST_CHECK( prvSend( 1, 13 ) == pdPASS );
+	TEST_CHECK( prvSend( 2, 21 ) == pdPASS );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == 2 );
+	TEST_CHECK( prvReceived( 2, 21 ) );
+	TEST_CHECK( prvReceived( 1, 13 ) );
+
+	/* Items without a key are never replaced, and do not replace. */
+	TEST_CHECK( prvSend( testNO_KEY, 30 ) == pdPASS );
+	TEST_CHECK( prvSend( 3, 40 ) == pdPASS );
+	TEST_CHECK( prvSend( testNO_KEY, 31 ) == pdPASS );
+	TEST_CHECK( prvSend( 3, 41 ) == pdPASS );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == 3 );
+
+	/* A full queue still takes a pending key, but nothing else. */
+	TEST_CHECK( prvSend( 4, 50 ) == pdPASS );
+	TEST_CHECK( prvSend( 4, 51 ) == pdPASS );
+	TEST_CHECK( prvSend( 3, 42 ) == pdPASS );
+	TEST_CHECK( prvSend( 5, 60 ) == errQUEUE_FULL );
+	TEST_CHECK( prvSend( testNO_KEY, 32 ) == errQUEUE_FULL );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == testLENGTH );
+
+	TEST_CHECK( prvReceived( testNO_KEY, 30 ) );
+	TEST_CHECK( prvReceived( 3, 42 ) );
+	TEST_CHECK( prvReceived( testNO_KEY, 31 ) );
+	TEST_CHECK( prvReceived( 4, 51 ) );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == 0 );
+
+	/* The items above wrapped the storage, so these are in the last slot and
+	the first. */
+	TEST_CHECK( prvSend( 6, 70 ) == pdPASS );
+	TEST_CHECK( prvSend( 7, 80 ) == pdPASS );
+	TEST_CHECK( prvSend( 6, 71 ) == pdPASS );
+	TEST_CHECK( prvSend( 7, 81 ) == pdPASS );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == 2 );
+
+	/* A reset forgets the keys, so they are not replaced in the emptied
+	queue. */
+	( void ) xQueueReset( xQueue );
+	TEST_CHECK( prvSend( 6, 72 ) == pdPASS );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == 1 );
+	TEST_CHECK( prvSend( 7, 82 ) == pdPASS );
+	TEST_CHECK( prvSend( 6, 73 ) == pdPASS );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == 2 );
+	TEST_CHECK( prvReceived( 6, 73 ) );
+	TEST_CHECK( prvReceived( 7, 82 ) );
+
+	vQueueDelete( xQueue );
+}
+
+/* Posts updates to the regions in turn, blocking if the queue has no room. */
+static void prvProducerTask( void *pvParameters )
+{
+const BaseType_t xConflating = ( BaseType_t ) pvParameters;
+TestItem_t xItem;
+TickType_t xWakeTime = xTaskGetTickCount();
+UBaseType_t uxTick, uxUpdate;
+
+	for( uxTick = 0; uxTick < testPRODUCER_TICKS; uxTick++ )
+	{
+		for( uxUpdate = 0; uxUpdate < testUPDATES_PER_TICK; uxUpdate++ )
+		{
+			xItem.ucKey = ( uint8_t ) ( uxUpdate % testREGIONS );
+			xItem.ulValue = ulLatest[ xItem.ucKey ] + 1;
+			ulLatest[ xItem.ucKey ] = xItem.ulValue;
+
+			if( xConflating != pdFALSE )
+			{
+				TEST_CHECK( xQueueSendWithKey( xQueue, &xItem, xItem.ucKey, portMAX_DELAY ) == pdPASS );
+			}
+			else
+			{
+				TEST_CHECK( xQueueSend( xQueue, &xItem, portMAX_DELAY ) == pdPASS );
+			}
+		}
+
+		vTaskDelayUntil( &xWakeTime, 1 );
+	}
+
+	xProducerDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+
+/* Draws as many updates as it has time for each tick. */
+static void prvDisplayTask( void *pvParameters )
+{
+TestItem_t xItem;
+TickType_t xWakeTime = xTaskGetTickCount();
+UBaseType_t uxDraw;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		for( uxDraw = 0; uxDraw < testDRAWS_PER_TICK; uxDraw++ )
+		{
+			if( xQueueReceive( xQueue, &xItem, 0 ) != pdPASS )
+			{
+				break;
+			}
+
+			ulDeliveries++;
+			ulStale += ( xItem.ulValue != ulLatest[ xItem.ucKey ] );
+			ulShown[ xItem.ucKey ] = xItem.ulValue;
+		}
+
+		if( ( xProducerDone != pdFALSE ) && ( uxQueueMessagesWaiting( xQueue ) == 0 ) )
+		{
+			break;
+		}
+
+		vTaskDelayUntil( &xWakeTime, 1 );
+	}
+
+	xDisplayDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+
+static void prvBenchmark( BaseType_t xConflating )
+{
+TickType_t xStart, xTicks;
+UBaseType_t ux;
+BaseType_t xAllShown = pdTRUE;
+
+	if( xConflating != pdFALSE )
+	{
+		xQueue = xQueueCreateConflating( testREGIONS, sizeof( TestItem_t ), testREGIONS );
+	}
+	else
+	{
+		xQueue = xQueueCreate( testREGIONS, sizeof( TestItem_t ) );
+	}
+
+	TEST_CHECK( xQueue != NULL );
+
+	for( ux = 0; ux < testREGIONS; ux++ )
+	{
+		ulLatest[ ux ] = 0;
+		ulShown[ ux ] = 0;
+	}
+
+	ulDeliveries = 0;
+	ulStale = 0;
+	xProducerDone = pdFALSE;
+	xDisplayDone = pdFALSE;
+	xStart = xTaskGetTickCount();
+
+	TEST_CHECK( xTaskCreate( prvProducerTask, "producer", configMINIMAL_STACK_SIZE, ( void * ) xConflating, 2, NULL ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvDisplayTask, "display", configMINIMAL_STACK_SIZE, NULL, 3, NULL ) == pdPASS );
+
+	while( xDisplayDone == pdFALSE )
+	{
+		vTaskDelay( 1 );
+	}
+
+	xTicks = xTaskGetTickCount() - xStart;
+
+	for( ux = 0; ux < testREGIONS; ux++ )
+	{
+		if( ulShown[ ux ] != ulLatest[ ux ] )
+		{
+			xAllShown = pdFALSE;
+		}
+	}
+
+	printf( "%s queue, %d regions: %lu updates drawn, %lu of them stale, all drawn after %lu ticks\n",
+			( xConflating != pdFALSE ) ? "conflating" : "FIFO      ", testREGIONS, ulDeliveries, ulStale, ( unsigned long ) xTicks );
+
+	TEST_CHECK( xAllShown != pdFALSE );
+
+	if( xConflating != pdFALSE )
+	{
+		/* At most one update per region is ever waiting, and it is the
+		latest. */
+		TEST_CHECK( ulStale == 0UL );
+		TEST_CHECK( ulDeliveries <= ( ( ( testPRODUCER_TICKS + 1UL ) * testDRAWS_PER_TICK ) + testREGIONS ) );
+		TEST_CHECK( xTicks <= ( testPRODUCER_TICKS + ( testREGIONS / testDRAWS_PER_TICK ) + 2UL ) );
+	}
+	else
+	{
+		TEST_CHECK( ulDeliveries == ( ( unsigned long ) testPRODUCER_TICKS * testUPDATES_PER_TICK ) );
+		/* The first updates are drawn in the tick the display starts. */
+		TEST_CHECK( xTicks >= ( ( ( ( unsigned long ) testPRODUCER_TICKS * testUPDATES_PER_TICK ) / testDRAWS_PER_TICK ) - 1UL ) );
+	}
+
+	/* Let the idle task free the tasks. */
+	vTaskDelay( 1 );
+	vQueueDelete( xQueue );
+}
+
+static void prvControlTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	prvCheckConflation();
+
+	prvBenchmark( pdFALSE );
+	prvBenchmark( pdTRUE );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,39 @@
+/*
+ * The portable portCOUNT_LEADING_ZEROS() from FreeRTOS.h, which the host port
+ * uses because it does not define its own, against the compiler's builtin.
+ */
+
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+
+#include "test_common.h"
+
+int main( void )
+{
+uint32_t ulBit, ulValue;
+unsigned long ulIndex;
+
+	TEST_CHECK( portCOUNT_LEADING_ZEROS( 0UL ) == 32U );
+
+	for( ulBit = 0; ulBit < 32UL; ulBit++ )
+	{
+		ulValue = 1UL << ulBit;
+		TEST_CHECK( portCOUNT_LEADING_ZEROS( ulValue ) == ( uint8_t ) __builtin_clz( ulValue ) );
+		TEST_CHECK( portCOUNT_LEADING_ZEROS( ulValue | ( ulValue - 1UL ) ) == ( uint8_t ) __builtin_clz( ulValue ) );
+	}
+
+	srand( 1 );
+	for( ulIndex = 0; ulIndex < 1000000UL; ulIndex++ )
+	{
+		ulValue = ( ( uint32_t ) rand() << 16 ) ^ ( uint32_t ) rand();
+		ulValue >>= ( uint32_t ) rand() % 32U;
+
+		if( ulValue != 0UL )
+		{
+			TEST_CHECK( portCOUNT_LEADING_ZEROS( ulValue ) == ( uint8_t ) __builtin_clz( ulValue ) );
+		}
+	}
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,101 @@
+/*
+ * An EDF task that becomes ready with an earlier deadline than the running EDF
+ * task preempts it straight away, whether it is readied by a task, an
+ * interrupt or the tick, and one with a later deadline does not.  Built with
+ * configUSE_TIME_SLICING set to 0, so no tick interrupt forces a switch.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "test_common.h"
+
+static SemaphoreHandle_t xEarlySemaphore, xLateSemaphore;
+static volatile UBaseType_t uxEarlyRuns, uxLateRuns;
+static volatile TickType_t xEarlyWokeAt;
+
+/* Deadline 100 ticks after each release. */
+static void prvEarlyTask( void *pvParameters )
+{
+	( void ) pvParameters;
+	vTaskSetPeriodicDeadline( NULL, 1000, 100 );
+
+	for( ;; )
+	{
+		( void ) xSemaphoreTake( xEarlySemaphore, portMAX_DELAY );
+		uxEarlyRuns++;
+
+		if( uxEarlyRuns == 3U )
+		{
+			vTaskDelay( 5 );
+			xEarlyWokeAt = xTaskGetTickCount();
+		}
+	}
+}
+
+/* Deadline 990 ticks after each release. */
+static void prvLateTask( void *pvParameters )
+{
+	( void ) pvParameters;
+	vTaskSetPeriodicDeadline( NULL, 1000, 990 );
+
+	for( ;; )
+	{
+		( void ) xSemaphoreTake( xLateSemaphore, portMAX_DELAY );
+		uxLateRuns++;
+	}
+}
+
+/* Deadline 900 ticks after each release. */
+static void prvRunningTask( void *pvParameters )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+TickType_t xStart;
+
+	( void ) pvParameters;
+	vTaskSetPeriodicDeadline( NULL, 1000, 900 );
+
+	/* Later deadline, so no preemption. */
+	xSemaphoreGive( xLateSemaphore );
+	TEST_CHECK( uxLateRuns == 0U );
+
+	/* Earlier deadline, readied by a task. */
+	xSemaphoreGive( xEarlySemaphore );
+	TEST_CHECK( uxEarlyRuns == 1U );
+
+	/* Earlier deadline, readied by an interrupt. */
+	TEST_CHECK( xSemaphoreGiveFromISR( xEarlySemaphore, &xHigherPriorityTaskWoken ) == pdPASS );
+	TEST_CHECK( xHigherPriorityTaskWoken == pdTRUE );
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+	TEST_CHECK( uxEarlyRuns == 2U );
+
+	/* Earlier deadline, readied by the tick 5 ticks into a 10 tick run. */
+	xSemaphoreGive( xEarlySemaphore );
+	TEST_CHECK( uxEarlyRuns == 3U );
+	xStart = xTaskGetTickCount();
+	vPortRunForTicks( 10 );
+	TEST_CHECK( xEarlyWokeAt == ( xStart + 5U ) );
+
+	/* The later deadline task runs once this task blocks. */
+	TEST_CHECK( uxLateRuns == 0U );
+	vTaskDelay( 1 );
+	TEST_CHECK( uxLateRuns == 1U );
+
+	TEST_CHECK( uxTaskGetDeadlineMissCount( NULL ) == 0U );
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	xEarlySemaphore = xSemaphoreCreateBinary();
+	xLateSemaphore = xSemaphoreCreateBinary();
+
+	TEST_CHECK( xTaskCreate( prvEarlyTask, "early", configMINIMAL_STACK_SIZE, NULL, configEDF_TASK_PRIORITY, NULL ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvLateTask, "late", configMINIMAL_STACK_SIZE, NULL, configEDF_TASK_PRIORITY, NULL ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvRunningTask, "running", configMINIMAL_STACK_SIZE, NULL, configEDF_TASK_PRIORITY, NULL ) == pdPASS );
+
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,113 @@
+/*
+ * Two periodic tasks, using 2 of every 5 ticks and 4 of every 7 ticks, run
+ * for 3500 ticks.  The utilisation is 97%, which earliest deadline first
+ * scheduling meets but rate monotonic priorities do not.  Built with
+ * configUSE_EDF_SCHEDULING set to 1, where no deadline may be missed, and set
+ * to 0, where the shorter period task has the higher priority and the other
+ * task must miss deadlines.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "test_common.h"
+
+#define testRUN_TICKS	( ( TickType_t ) 3500 )
+
+typedef struct PeriodicTask
+{
+	TickType_t xExecutionTime;
+	TickType_t xPeriod;
+	UBaseType_t uxMisses;
+	TaskHandle_t xHandle;
+} PeriodicTask_t;
+
+static PeriodicTask_t xTasks[ 2 ] =
+{
+	{ 2, 5, 0, NULL },
+	{ 4, 7, 0, NULL }
+};
+
+static UBaseType_t prvMisses( PeriodicTask_t *pxTask )
+{
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		return uxTaskGetDeadlineMissCount( pxTask->xHandle );
+	}
+	#else
+	{
+		return pxTask->uxMisses;
+	}
+	#endif
+}
+
+static void prvPeriodicTask( void *pvParameters )
+{
+PeriodicTask_t *pxTask = ( PeriodicTask_t * ) pvParameters;
+TickType_t xRelease = xTaskGetTickCount();
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		( void ) xRelease;
+		vTaskSetPeriodicDeadline( NULL, pxTask->xPeriod, pxTask->xPeriod );
+	}
+	#endif
+
+	for( ;; )
+	{
+		vPortRunForTicks( pxTask->xExecutionTime );
+
+		#if( configUSE_EDF_SCHEDULING == 1 )
+		{
+			vTaskWaitForNextPeriod();
+		}
+		#else
+		{
+			if( xTaskGetTickCount() > ( xRelease + pxTask->xPeriod ) )
+			{
+				pxTask->uxMisses++;
+			}
+
+			vTaskDelayUntil( &xRelease, pxTask->xPeriod );
+		}
+		#endif
+
+		if( xTaskGetTickCount() > testRUN_TICKS )
+		{
+			vTaskEndScheduler();
+		}
+	}
+}
+
+int main( void )
+{
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		TEST_CHECK( xTaskCreate( prvPeriodicTask, "a", configMINIMAL_STACK_SIZE, &( xTasks[ 0 ] ), configEDF_TASK_PRIORITY, &( xTasks[ 0 ].xHandle ) ) == pdPASS );
+		TEST_CHECK( xTaskCreate( prvPeriodicTask, "b", configMINIMAL_STACK_SIZE, &( xTasks[ 1 ] ), configEDF_TASK_PRIORITY, &( xTasks[ 1 ].xHandle ) ) == pdPASS );
+	}
+	#else
+	{
+		TEST_CHECK( xTaskCreate( prvPeriodicTask, "a", configMINIMAL_STACK_SIZE, &( xTasks[ 0 ] ), 4, &( xTasks[ 0 ].xHandle ) ) == pdPASS );
+		TEST_CHECK( xTaskCreate( prvPeriodicTask, "b", configMINIMAL_STACK_SIZE, &( xTasks[ 1 ] ), 3, &( xTasks[ 1 ].xHandle ) ) == pdPASS );
+	}
+	#endif
+
+	vTaskStartScheduler();
+
+	printf( "%s: deadline misses %lu and %lu\n", ( configUSE_EDF_SCHEDULING == 1 ) ? "EDF" : "RM",
+			( unsigned long ) prvMisses( &( xTasks[ 0 ] ) ), ( unsigned long ) prvMisses( &( xTasks[ 1 ] ) ) );
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		TEST_CHECK( prvMisses( &( xTasks[ 0 ] ) ) == 0U );
+		TEST_CHECK( prvMisses( &( xTasks[ 1 ] ) ) == 0U );
+	}
+	#else
+	{
+		TEST_CHECK( prvMisses( &( xTasks[ 1 ] ) ) > 0U );
+	}
+	#endif
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,148 @@
+/*
+ * Event groups set and cleared from interrupts without the timer daemon task.
+ *
+ * A direct event group, created by xEventGroupCreateDirect() with room for two
+ * waiting tasks, must turn away a third waiter as if its block time expired,
+ * wake a waiter from xEventGroupSetBitsFromISR() only once all its bits are
+ * set, and report through pxHigherPriorityTaskWoken when the scheduler is
+ * suspended.  The printed latencies compare the time from
+ * xEventGroupSetBitsFromISR() to the waiting task running for a direct group
+ * and for an ordinary group, whose bits are set by the daemon task.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+#include "test_common.h"
+
+#define testLATENCY_SAMPLES		20000UL
+
+static EventGroupHandle_t xDirectGroup, xDeferredGroup;
+static volatile UBaseType_t uxWoken;
+static uint64_t ullWokenAt;
+
+static void prvWaiterTask( void *pvParameters )
+{
+EventGroupHandle_t xGroup = ( EventGroupHandle_t ) pvParameters;
+EventBits_t uxBits;
+
+	for( ;; )
+	{
+		uxBits = xEventGroupWaitBits( xGroup, 0x01, pdTRUE, pdFALSE, portMAX_DELAY );
+		ullWokenAt = ullTestNanoseconds();
+
+		if( ( uxBits & 0x01 ) != 0 )
+		{
+			uxWoken++;
+		}
+	}
+}
+
+static void prvWaitAllTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	TEST_CHECK( ( xEventGroupWaitBits( xDirectGroup, 0x06, pdTRUE, pdTRUE, portMAX_DELAY ) & 0x06 ) == 0x06 );
+	uxWoken += 10;
+	vTaskDelete( NULL );
+}
+
+static uint64_t prvMeasureLatency( EventGroupHandle_t xGroup )
+{
+uint64_t ullTotal = 0, ullStart;
+UBaseType_t uxBefore;
+BaseType_t xHigherPriorityTaskWoken;
+unsigned long ul;
+
+	for( ul = 0; ul < testLATENCY_SAMPLES; ul++ )
+	{
+		uxBefore = uxWoken;
+		xHigherPriorityTaskWoken = pdFALSE;
+		ullStart = ullTestNanoseconds();
+		TEST_CHECK( xEventGroupSetBitsFromISR( xGroup, 0x01, &xHigherPriorityTaskWoken ) == pdPASS );
+		portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+
+		while( uxWoken == uxBefore )
+		{
+			taskYIELD();
+		}
+
+		ullTotal += ullWokenAt - ullStart;
+	}
+
+	return ullTotal / testLATENCY_SAMPLES;
+}
+
+static void prvControlTask( void *pvParameters )
+{
+BaseType_t xHigherPriorityTaskWoken;
+TickType_t xStart;
+uint64_t ullDirect, ullDeferred;
+
+	( void ) pvParameters;
+
+	/* The second of the two waiters the group allows. */
+	TEST_CHECK( xTaskCreate( prvWaitAllTask, "all", configMINIMAL_STACK_SIZE, NULL, 3, NULL ) == pdPASS );
+	vTaskDelay( 1 );
+
+	/* A third waiter returns at once, as if its block time had expired. */
+	xStart = xTaskGetTickCount();
+	TEST_CHECK( xEventGroupWaitBits( xDirectGroup, 0x08, pdFALSE, pdFALSE, 100 ) == 0 );
+	TEST_CHECK( xTaskGetTickCount() == xStart );
+
+	/* Only once all the bits it waits for are set is a task woken. */
+	xHigherPriorityTaskWoken = pdFALSE;
+	TEST_CHECK( xEventGroupSetBitsFromISR( xDirectGroup, 0x02, &xHigherPriorityTaskWoken ) == pdPASS );
+	TEST_CHECK( xHigherPriorityTaskWoken == pdFALSE );
+	TEST_CHECK( uxWoken == 0 );
+	TEST_CHECK( xEventGroupGetBits( xDirectGroup ) == 0x02 );
+
+	TEST_CHECK( xEventGroupSetBitsFromISR( xDirectGroup, 0x04, &xHigherPriorityTaskWoken ) == pdPASS );
+	TEST_CHECK( xHigherPriorityTaskWoken == pdTRUE );
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+	TEST_CHECK( uxWoken == 10 );
+	TEST_CHECK( xEventGroupGetBits( xDirectGroup ) == 0 );
+
+	/* An interrupt while the scheduler is suspended readies the waiter, which
+	runs when the scheduler is resumed. */
+	vTaskSuspendAll();
+	{
+		xHigherPriorityTaskWoken = pdFALSE;
+		TEST_CHECK( xEventGroupSetBitsFromISR( xDirectGroup, 0x01, &xHigherPriorityTaskWoken ) == pdPASS );
+		TEST_CHECK( xHigherPriorityTaskWoken == pdTRUE );
+		TEST_CHECK( uxWoken == 10 );
+	}
+	( void ) xTaskResumeAll();
+	TEST_CHECK( uxWoken == 11 );
+
+	/* Clearing from an interrupt takes effect at once. */
+	TEST_CHECK( xEventGroupSetBitsFromISR( xDirectGroup, 0x10, &xHigherPriorityTaskWoken ) == pdPASS );
+	TEST_CHECK( xEventGroupClearBitsFromISR( xDirectGroup, 0x10 ) == pdPASS );
+	TEST_CHECK( xEventGroupGetBits( xDirectGroup ) == 0 );
+
+	/* Task level calls still wake the waiter of a direct group. */
+	( void ) xEventGroupSetBits( xDirectGroup, 0x01 );
+	TEST_CHECK( uxWoken == 12 );
+
+	ullDirect = prvMeasureLatency( xDirectGroup );
+	ullDeferred = prvMeasureLatency( xDeferredGroup );
+	printf( "interrupt to waiting task: direct group %llu ns, through the daemon task %llu ns\n",
+			( unsigned long long ) ullDirect, ( unsigned long long ) ullDeferred );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	xDirectGroup = xEventGroupCreateDirect( 2 );
+	xDeferredGroup = xEventGroupCreate();
+	TEST_CHECK( ( xDirectGroup != NULL ) && ( xDeferredGroup != NULL ) );
+
+	TEST_CHECK( xTaskCreate( prvWaiterTask, "direct", configMINIMAL_STACK_SIZE, xDirectGroup, 4, NULL ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvWaiterTask, "deferred", configMINIMAL_STACK_SIZE, xDeferredGroup, 4, NULL ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
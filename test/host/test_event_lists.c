@@ -0,0 +1,98 @@
+/*
+ * Wake order of a queue's waiting tasks, and the cost of waking them.
+ *
+ * 256 tasks of random priority block on an empty queue, and with indexed
+ * event lists one task has its priority raised while it waits.  Sending 256
+ * items must then wake the tasks highest priority first, and in the order they
+ * blocked within a priority.
+ * Built with configUSE_PRIORITY_INDEXED_EVENT_LISTS set to 1 and to 0, so the
+ * printed time per send compares the indexed event lists with the sorted lists.
+ */
+
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "test_common.h"
+
+#define testWAITERS		256
+
+static QueueHandle_t xQueue;
+static TaskHandle_t xWaiters[ testWAITERS ];
+static UBaseType_t uxPriority[ testWAITERS ];
+static UBaseType_t uxBlockOrder[ testWAITERS ];
+static UBaseType_t uxWakeOrder[ testWAITERS ];
+static UBaseType_t uxBlocked, uxWoken;
+
+static void prvWaiterTask( void *pvParameters )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+uint32_t ulItem;
+
+	uxBlockOrder[ uxIndex ] = uxBlocked++;
+	TEST_CHECK( xQueueReceive( xQueue, &ulItem, portMAX_DELAY ) == pdPASS );
+	uxWakeOrder[ uxWoken++ ] = uxIndex;
+	vTaskSuspend( NULL );
+}
+
+static void prvSenderTask( void *pvParameters )
+{
+uint32_t ulItem = 0;
+uint64_t ullStart, ullEnd;
+UBaseType_t uxIndex, uxA, uxB;
+
+	( void ) pvParameters;
+
+	#if( configUSE_PRIORITY_INDEXED_EVENT_LISTS == 1 )
+	{
+		/* Moves a waiting task within the event list.  The sorted lists leave
+		a waiting task where it is when its priority changes. */
+		vTaskPrioritySet( xWaiters[ 5 ], configMAX_PRIORITIES - 1 );
+		uxPriority[ 5 ] = configMAX_PRIORITIES - 1;
+	}
+	#endif
+
+	ullStart = ullTestNanoseconds();
+	for( uxIndex = 0; uxIndex < testWAITERS; uxIndex++ )
+	{
+		TEST_CHECK( xQueueSend( xQueue, &ulItem, 0 ) == pdPASS );
+	}
+	ullEnd = ullTestNanoseconds();
+
+	TEST_CHECK( uxWoken == testWAITERS );
+
+	for( uxIndex = 1; uxIndex < uxWoken; uxIndex++ )
+	{
+		uxA = uxWakeOrder[ uxIndex - 1 ];
+		uxB = uxWakeOrder[ uxIndex ];
+		TEST_CHECK( ( uxPriority[ uxA ] > uxPriority[ uxB ] ) ||
+					( ( uxPriority[ uxA ] == uxPriority[ uxB ] ) && ( uxBlockOrder[ uxA ] < uxBlockOrder[ uxB ] ) ) );
+	}
+
+	printf( "indexed event lists %d: %llu ns per send\n", configUSE_PRIORITY_INDEXED_EVENT_LISTS,
+			( unsigned long long ) ( ( ullEnd - ullStart ) / testWAITERS ) );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+UBaseType_t uxIndex;
+
+	srand( 1 );
+	xQueue = xQueueCreate( testWAITERS, sizeof( uint32_t ) );
+
+	for( uxIndex = 0; uxIndex < testWAITERS; uxIndex++ )
+	{
+		uxPriority[ uxIndex ] = 2 + ( UBaseType_t ) ( rand() % ( configMAX_PRIORITIES - 2 ) );
+		TEST_CHECK( xTaskCreate( prvWaiterTask, "wait", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) uxIndex, uxPriority[ uxIndex ], &( xWaiters[ uxIndex ] ) ) == pdPASS );
+	}
+
+	TEST_CHECK( xTaskCreate( prvSenderTask, "send", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
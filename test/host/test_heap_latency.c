@@ -0,0 +1,306 @@
+/*
+ * Replays an allocation trace against the heap it is linked with, and reports
+ * the mean, 99.99th percentile and worst case time of pvPortMalloc() and
+ * vPortFree() and how fragmented the free space is once the trace ends.  The
+ * worst case includes the host preempting the test, so the percentile is the
+ * better measure of the heap itself.  Built with heap_4.c and
+ * with heap_tlsf.c, so the two can be compared on the same trace.
+ *
+ * Without arguments the trace is generated: 400000 operations on 1000 slots,
+ * each allocating a block of 1 to 120 bytes, or one in eight times up to 4000
+ * bytes, if the slot is empty and freeing it otherwise.  With an argument the
+ * "HT M" and "HT F" lines of a trace captured with vHeapTraceWriteRecords() are
+ * replayed from that file instead.  The sizes in a captured trace include the
+ * heap's block header, so each replayed block is a little larger than the
+ * original.
+ *
+ * Every block is filled and checked before it is freed, and the free space
+ * must return to its initial size once every block is freed.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "test_common.h"
+
+#define testSLOTS				1000U
+#define testOPERATIONS			400000UL
+#define testREPLAY_SLOTS		65536U
+#define testHISTOGRAM_NS		10U		/* Width of a latency histogram bucket. */
+#define testHISTOGRAM_BUCKETS	10000U
+
+typedef struct Block
+{
+	unsigned long ulKey;		/* The slot, or the address in a captured trace.  0 if unused. */
+	uint8_t *pucData;
+	size_t xSize;
+} Block_t;
+
+static Block_t xBlocks[ testREPLAY_SLOTS ];
+static uint64_t ullTotalTime, ullWorstMalloc, ullWorstFree;
+static unsigned long ulMallocHistogram[ testHISTOGRAM_BUCKETS ], ulFreeHistogram[ testHISTOGRAM_BUCKETS ];
+static unsigned long ulOperations, ulFailures;
+static uint32_t ulSeed = 1;
+
+/* Not rand(), so the generated trace is the same on every C library. */
+static uint32_t prvRandom( void )
+{
+	ulSeed = ( ulSeed * 1103515245UL ) + 12345UL;
+	return ( ulSeed >> 16 ) & 0x7fffUL;
+}
+
+static void prvRecordTime( uint64_t ullTime, uint64_t *pullWorst, unsigned long *pulHistogram )
+{
+uint64_t ullBucket = ullTime / testHISTOGRAM_NS;
+
+	ullTotalTime += ullTime;
+	ulOperations++;
+
+	if( ullTime > *pullWorst )
+	{
+		*pullWorst = ullTime;
+	}
+
+	if( ullBucket >= testHISTOGRAM_BUCKETS )
+	{
+		ullBucket = testHISTOGRAM_BUCKETS - 1U;
+	}
+
+	pulHistogram[ ullBucket ]++;
+}
+
+static uint64_t prvPercentile( const unsigned long *pulHistogram, unsigned long ulPerTenThousand )
+{
+unsigned long ulCount = 0, ulSeen = 0, ulBucket;
+
+	for( ulBucket = 0; ulBucket < testHISTOGRAM_BUCKETS; ulBucket++ )
+	{
+		ulCount += pulHistogram[ ulBucket ];
+	}
+
+	for( ulBucket = 0; ulBucket < testHISTOGRAM_BUCKETS; ulBucket++ )
+	{
+		ulSeen += pulHistogram[ ulBucket ];
+
+		if( ( ulSeen * 10000UL ) >= ( ulCount * ulPerTenThousand ) )
+		{
+			break;
+		}
+	}
+
+	return ( uint64_t ) ( ulBucket + 1UL ) * testHISTOGRAM_NS;
+}
+
+static Block_t *prvFindBlock( unsigned long ulKey, BaseType_t xCreate )
+{
+size_t xIndex = ( size_t ) ( ( ulKey * 2654435761UL ) % testREPLAY_SLOTS );
+
+	while( xBlocks[ xIndex ].ulKey != ulKey )
+	{
+		if( xBlocks[ xIndex ].ulKey == 0UL )
+		{
+			if( xCreate == pdFALSE )
+			{
+				return NULL;
+			}
+
+			xBlocks[ xIndex ].ulKey = ulKey;
+			break;
+		}
+
+		xIndex = ( xIndex + 1U ) % testREPLAY_SLOTS;
+	}
+
+	return &( xBlocks[ xIndex ] );
+}
+
+static void prvAllocate( Block_t *pxBlock, size_t xSize )
+{
+uint64_t ullStart, ullTime;
+size_t x;
+
+	ullStart = ullTestNanoseconds();
+	pxBlock->pucData = pvPortMalloc( xSize );
+	ullTime = ullTestNanoseconds() - ullStart;
+	prvRecordTime( ullTime, &ullWorstMalloc, ulMallocHistogram );
+
+	if( pxBlock->pucData == NULL )
+	{
+		ulFailures++;
+		pxBlock->ulKey = 0UL;
+		return;
+	}
+
+	TEST_CHECK( ( ( uintptr_t ) pxBlock->pucData & portBYTE_ALIGNMENT_MASK ) == 0U );
+	pxBlock->xSize = xSize;
+
+	for( x = 0; x < xSize; x++ )
+	{
+		pxBlock->pucData[ x ] = ( uint8_t ) ( pxBlock->ulKey + x );
+	}
+}
+
+static void prvFree( Block_t *pxBlock )
+{
+uint64_t ullStart, ullTime;
+size_t x;
+BaseType_t xIntact = pdTRUE;
+
+	for( x = 0; x < pxBlock->xSize; x++ )
+	{
+		if( pxBlock->pucData[ x ] != ( uint8_t ) ( pxBlock->ulKey + x ) )
+		{
+			xIntact = pdFALSE;
+		}
+	}
+
+	TEST_CHECK( xIntact == pdTRUE );
+
+	ullStart = ullTestNanoseconds();
+	vPortFree( pxBlock->pucData );
+	ullTime = ullTestNanoseconds() - ullStart;
+	prvRecordTime( ullTime, &ullWorstFree, ulFreeHistogram );
+
+	pxBlock->pucData = NULL;
+	pxBlock->xSize = 0;
+}
+
+static void prvReplayGenerated( void )
+{
+unsigned long ulOperation;
+Block_t *pxBlock;
+size_t xSize;
+
+	for( ulOperation = 0; ulOperation < testOPERATIONS; ulOperation++ )
+	{
+		pxBlock = prvFindBlock( 1UL + ( prvRandom() % testSLOTS ), pdTRUE );
+
+		if( pxBlock->pucData != NULL )
+		{
+			prvFree( pxBlock );
+		}
+		else
+		{
+			if( ( prvRandom() % 8U ) == 0U )
+			{
+				xSize = 1U + ( prvRandom() % 4000U );
+			}
+			else
+			{
+				xSize = 1U + ( prvRandom() % 120U );
+			}
+
+			prvAllocate( pxBlock, xSize );
+		}
+	}
+}
+
+static void prvReplayCaptured( const char *pcFile )
+{
+FILE *pxFile = fopen( pcFile, "r" );
+char cLine[ 256 ], cEvent;
+unsigned long ulTime, ulAddress, ulSize;
+Block_t *pxBlock;
+
+	TEST_CHECK( pxFile != NULL );
+
+	if( pxFile == NULL )
+	{
+		return;
+	}
+
+	while( fgets( cLine, sizeof( cLine ), pxFile ) != NULL )
+	{
+		if( ( sscanf( cLine, "HT %c %lu %lx %lu", &cEvent, &ulTime, &ulAddress, &ulSize ) != 4 ) || ( ulAddress == 0UL ) )
+		{
+			continue;
+		}
+
+		if( cEvent == 'M' )
+		{
+			pxBlock = prvFindBlock( ulAddress, pdTRUE );
+
+			if( pxBlock->pucData == NULL )
+			{
+				prvAllocate( pxBlock, ( size_t ) ulSize );
+			}
+		}
+		else if( cEvent == 'F' )
+		{
+			pxBlock = prvFindBlock( ulAddress, pdFALSE );
+
+			/* Blocks allocated before the capture started are not known. */
+			if( ( pxBlock != NULL ) && ( pxBlock->pucData != NULL ) )
+			{
+				prvFree( pxBlock );
+			}
+		}
+	}
+
+	( void ) fclose( pxFile );
+}
+
+int main( int argc, char **argv )
+{
+HeapStats_t xStats;
+size_t xInitialFreeBytes, x;
+void *pvBlock;
+
+	/* The first allocation initialises the heap.  Touching all of it then
+	keeps page faults out of the measured times. */
+	pvBlock = pvPortMalloc( 8 );
+	vPortFree( pvBlock );
+	xInitialFreeBytes = xPortGetFreeHeapSize();
+	for( x = 0; x < testSLOTS; x++ )
+	{
+		xBlocks[ x ].pucData = pvPortMalloc( 1024 );
+
+		if( xBlocks[ x ].pucData != NULL )
+		{
+			memset( xBlocks[ x ].pucData, 0, 1024 );
+		}
+	}
+
+	for( x = 0; x < testSLOTS; x++ )
+	{
+		vPortFree( xBlocks[ x ].pucData );
+		xBlocks[ x ].pucData = NULL;
+	}
+
+	if( argc > 1 )
+	{
+		prvReplayCaptured( argv[ 1 ] );
+	}
+	else
+	{
+		prvReplayGenerated();
+	}
+
+	vPortGetHeapStats( &xStats );
+	printf( "%s: %lu operations, %lu failed, mean %llu ns\n", HEAP_NAME, ulOperations, ulFailures,
+			( unsigned long long ) ( ( ulOperations > 0UL ) ? ( ullTotalTime / ulOperations ) : 0U ) );
+	printf( "%s: malloc 99.99%% %llu ns, worst %llu ns; free 99.99%% %llu ns, worst %llu ns\n", HEAP_NAME,
+			( unsigned long long ) prvPercentile( ulMallocHistogram, 9999UL ), ( unsigned long long ) ullWorstMalloc,
+			( unsigned long long ) prvPercentile( ulFreeHistogram, 9999UL ), ( unsigned long long ) ullWorstFree );
+	printf( "%s: %lu bytes free in %lu blocks, largest %lu bytes, fragmentation %lu%%\n",
+			HEAP_NAME, ( unsigned long ) xStats.xAvailableHeapSpaceInBytes, ( unsigned long ) xStats.xNumberOfFreeBlocks,
+			( unsigned long ) xStats.xSizeOfLargestFreeBlockInBytes,
+			( unsigned long ) ( 100U - ( ( 100U * xStats.xSizeOfLargestFreeBlockInBytes ) / ( xStats.xAvailableHeapSpaceInBytes + 1U ) ) ) );
+
+	for( x = 0; x < testREPLAY_SLOTS; x++ )
+	{
+		if( xBlocks[ x ].pucData != NULL )
+		{
+			prvFree( &( xBlocks[ x ] ) );
+		}
+	}
+
+	vPortGetHeapStats( &xStats );
+	TEST_CHECK( xStats.xAvailableHeapSpaceInBytes == xInitialFreeBytes );
+	TEST_CHECK( xStats.xNumberOfFreeBlocks == 1U );
+
+	return TEST_RESULT();
+}
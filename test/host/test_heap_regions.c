@@ -0,0 +1,106 @@
+/*
+ * heap_regions.c with malloc()'d memory standing in for the target's SRAM, CCM
+ * RAM, SDRAM and DMA RAM.  Built as the target's configuration builds it: with
+ * configHEAP_DEFAULT_REGION set to 0, so the application's regions are the
+ * whole heap, and configSTACK_ALLOCATION_FROM_SEPARATE_HEAP set to 1, so task
+ * stacks are allocated from the fast region.
+ */
+
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "test_common.h"
+
+#define testGENERAL_SIZE	( 16U * 1024U )
+#define testFAST_SIZE		( 64U * 1024U )
+#define testBULK_SIZE		( 1024U * 1024U )
+#define testDMA_SIZE		( 8U * 1024U )
+
+static uint8_t *pucGeneral, *pucFast, *pucBulk, *pucDMA;
+
+static BaseType_t prvIsIn( const void *pv, const uint8_t *pucRegion, size_t xSize )
+{
+	return ( ( ( const uint8_t * ) pv >= pucRegion ) && ( ( const uint8_t * ) pv < ( pucRegion + xSize ) ) ) ? pdTRUE : pdFALSE;
+}
+
+static void prvTask( void *pvParameters )
+{
+TaskStatus_t xStatus;
+
+	( void ) pvParameters;
+
+	vTaskGetInfo( NULL, &xStatus, pdFALSE, eRunning );
+	TEST_CHECK( prvIsIn( xStatus.pxStackBase, pucFast, testFAST_SIZE ) == pdTRUE );
+
+	/* The TCB is not a stack, so it comes from the general region. */
+	TEST_CHECK( prvIsIn( xTaskGetCurrentTaskHandle(), pucGeneral, testGENERAL_SIZE ) == pdTRUE );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+HeapRegion_t xGeneral, xFast, xBulk, xDMA;
+HeapStats_t xStats;
+size_t xFreeBefore, xDMAFree;
+void *pvBulk, *pvDMA, *pvDMAOverflow, *pvLarge;
+
+	pucGeneral = malloc( testGENERAL_SIZE );
+	pucFast = malloc( testFAST_SIZE );
+	pucBulk = malloc( testBULK_SIZE );
+	pucDMA = malloc( testDMA_SIZE );
+
+	xGeneral.pucStartAddress = pucGeneral;
+	xGeneral.xSizeInBytes = testGENERAL_SIZE;
+	xFast.pucStartAddress = pucFast;
+	xFast.xSizeInBytes = testFAST_SIZE;
+	xBulk.pucStartAddress = pucBulk;
+	xBulk.xSizeInBytes = testBULK_SIZE;
+	xDMA.pucStartAddress = pucDMA;
+	xDMA.xSizeInBytes = testDMA_SIZE;
+
+	vPortAddHeapRegion( &xGeneral, eHeapPlacementGeneral );
+	vPortAddHeapRegion( &xFast, eHeapPlacementFast );
+	vPortAddHeapRegion( &xBulk, eHeapPlacementBulk );
+	vPortAddHeapRegion( &xDMA, eHeapPlacementDMA );
+
+	/* There is no default region, so the free space is exactly what the four
+	regions provide, less a block header at the end of each. */
+	xFreeBefore = xPortGetFreeHeapSize();
+	TEST_CHECK( xFreeBefore <= ( testGENERAL_SIZE + testFAST_SIZE + testBULK_SIZE + testDMA_SIZE ) );
+	TEST_CHECK( xFreeBefore >= ( testGENERAL_SIZE + testFAST_SIZE + testBULK_SIZE + testDMA_SIZE - ( 4U * 32U ) ) );
+
+	/* Placement hints, and the fall back to the general region. */
+	pvBulk = pvPortMallocPlaced( 100000, eHeapPlacementBulk );
+	TEST_CHECK( prvIsIn( pvBulk, pucBulk, testBULK_SIZE ) == pdTRUE );
+
+	pvDMA = pvPortMallocPlaced( 6000, eHeapPlacementDMA );
+	TEST_CHECK( prvIsIn( pvDMA, pucDMA, testDMA_SIZE ) == pdTRUE );
+
+	pvDMAOverflow = pvPortMallocPlaced( 6000, eHeapPlacementDMA );
+	TEST_CHECK( prvIsIn( pvDMAOverflow, pucGeneral, testGENERAL_SIZE ) == pdTRUE );
+
+	/* Too large for the general region, so it falls back to the bulk region. */
+	pvLarge = pvPortMalloc( testGENERAL_SIZE + 1000U );
+	TEST_CHECK( prvIsIn( pvLarge, pucBulk, testBULK_SIZE ) == pdTRUE );
+
+	xDMAFree = xPortGetFreeHeapSizePlaced( eHeapPlacementDMA );
+	vPortFree( pvDMA );
+	TEST_CHECK( xPortGetFreeHeapSizePlaced( eHeapPlacementDMA ) > xDMAFree );
+
+	vPortFree( pvBulk );
+	vPortFree( pvDMAOverflow );
+	vPortFree( pvLarge );
+	TEST_CHECK( xPortGetFreeHeapSize() == xFreeBefore );
+
+	/* Task stacks come from the fast region. */
+	TEST_CHECK( xTaskCreate( prvTask, "task", 1000, NULL, 2, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	vPortGetHeapStats( &xStats );
+	TEST_CHECK( xStats.xNumberOfFreeBlocks >= 4U );
+
+	return TEST_RESULT();
+}
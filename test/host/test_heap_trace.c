@@ -0,0 +1,273 @@
+/*
+ * The heap trace ring, its free block snapshots, and the tools/heap_trace.py
+ * report.
+ *
+ * More blocks are allocated than the ring holds.  uxHeapTraceRead() must then
+ * return the newest records, oldest first, with the block, its size, the task
+ * and one call site, and the overwritten records must be counted as lost.
+ * Then, with the ring full again, every other block is freed so the heap has a
+ * free block between each pair of used ones, and the trace and a snapshot are
+ * written to a log.  The "HT L" line must give the records lost since the last
+ * read, and the "HT S", "HT R" and "HT B" lines must match what
+ * vPortGetHeapStats() says about the free blocks, each of which must hold a
+ * freed block.  The log is then passed through tools/heap_trace.py, whose
+ * counts and fragmentation map row must agree.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_trace.h"
+
+#include "test_common.h"
+
+#define testLOG_FILE		"build/heap_trace.log"
+#define testEXTRA_RECORDS	5
+#define testBLOCKS			( configHEAP_TRACE_RECORDS + testEXTRA_RECORDS )
+#define testSMALL_BLOCKS	20
+#define testFREED_BLOCKS	( ( testBLOCKS + 1 ) / 2 )
+
+static void *pvBlocks[ testBLOCKS ], *pvSmallBlocks[ testSMALL_BLOCKS ];
+static FILE *pxLog;
+
+static void prvWriteLine( const char *pcLine )
+{
+	fprintf( pxLog, "%s\n", pcLine );
+}
+
+static void prvDiscardLine( const char *pcLine )
+{
+	( void ) pcLine;
+}
+
+/* The ring only holds the newest records once it has wrapped. */
+static void prvCheckRing( void )
+{
+HeapTraceRecord_t xRecords[ configHEAP_TRACE_RECORDS + 1 ];
+UBaseType_t uxRead, ux;
+
+	for( ux = 0; ux < testBLOCKS; ux++ )
+	{
+		pvBlocks[ ux ] = pvPortMalloc( 24 + ( 8 * ux ) );
+		TEST_CHECK( pvBlocks[ ux ] != NULL );
+	}
+
+	uxRead = uxHeapTraceRead( xRecords, configHEAP_TRACE_RECORDS + 1 );
+	TEST_CHECK( uxRead == configHEAP_TRACE_RECORDS );
+
+	for( ux = 0; ux < uxRead; ux++ )
+	{
+		TEST_CHECK( xRecords[ ux ].ucEvent == heapTRACE_MALLOC );
+		TEST_CHECK( xRecords[ ux ].pvAddress == pvBlocks[ ux + testEXTRA_RECORDS ] );
+		TEST_CHECK( xRecords[ ux ].xSize >= ( 24 + ( 8 * ( ux + testEXTRA_RECORDS ) ) ) );
+		TEST_CHECK( xRecords[ ux ].xTask == xTaskGetCurrentTaskHandle() );
+		TEST_CHECK( xRecords[ ux ].pvCaller == xRecords[ 0 ].pvCaller );
+
+		if( ux > 0 )
+		{
+			TEST_CHECK( xRecords[ ux ].xSize == ( xRecords[ ux - 1 ].xSize + 8 ) );
+		}
+	}
+
+	TEST_CHECK( xRecords[ 0 ].pvCaller != NULL );
+	TEST_CHECK( uxHeapTraceRead( xRecords, 1 ) == 0 );
+
+	/* Reading the count clears it. */
+	TEST_CHECK( uxHeapTraceGetLostRecordCount() == testEXTRA_RECORDS );
+	TEST_CHECK( uxHeapTraceGetLostRecordCount() == 0 );
+}
+
+/* Checks the lines written to the log against the heap. */
+static void prvCheckLog( void )
+{
+HeapStats_t xStats;
+char cLine[ 128 ];
+unsigned long ulTime, ulAddress, ulSize, ulCaller, ulTask, ulFreeBytes, ulFreeBlocks = 0;
+unsigned long ulLost = 0, ulMallocs = 0, ulFrees = 0, ulRegions = 0, ulBlocks = 0, ulBlockBytes = 0, ulLargest = 0;
+UBaseType_t uxHeld = 0, ux;
+char cEvent;
+
+	vPortGetHeapStats( &xStats );
+
+	pxLog = fopen( testLOG_FILE, "r" );
+	TEST_CHECK( pxLog != NULL );
+
+	if( pxLog == NULL )
+	{
+		return;
+	}
+
+	while( fgets( cLine, sizeof( cLine ), pxLog ) != NULL )
+	{
+		if( sscanf( cLine, "HT %c %lu %lx %lu %lx %lx", &cEvent, &ulTime, &ulAddress, &ulSize, &ulCaller, &ulTask ) == 6 )
+		{
+			TEST_CHECK( ulTask == ( unsigned long ) ( size_t ) xTaskGetCurrentTaskHandle() );
+
+			if( cEvent == 'M' )
+			{
+				ulMallocs++;
+			}
+			else
+			{
+				ulFrees++;
+			}
+		}
+		else if( sscanf( cLine, "HT L %lu", &ulLost ) == 1 )
+		{
+		}
+		else if( sscanf( cLine, "HT S %lu %lu %lu", &ulTime, &ulFreeBytes, &ulFreeBlocks ) == 3 )
+		{
+			TEST_CHECK( ulFreeBytes == xStats.xAvailableHeapSpaceInBytes );
+			TEST_CHECK( ulFreeBlocks == xStats.xNumberOfFreeBlocks );
+		}
+		else if( sscanf( cLine, "HT R %lx %lu", &ulAddress, &ulSize ) == 2 )
+		{
+			ulRegions++;
+			TEST_CHECK( ulSize <= configTOTAL_HEAP_SIZE );
+		}
+		else if( sscanf( cLine, "HT B %lx %lu", &ulAddress, &ulSize ) == 2 )
+		{
+			ulBlocks++;
+			ulBlockBytes += ulSize;
+
+			if( ulSize > ulLargest )
+			{
+				ulLargest = ulSize;
+			}
+
+			/* Every free block but the one at the end of the heap holds one
+			of the freed blocks. */
+			for( ux = 0; ux < testBLOCKS; ux += 2 )
+			{
+				if( ( ( size_t ) pvBlocks[ ux ] > ulAddress ) && ( ( size_t ) pvBlocks[ ux ] < ( ulAddress + ulSize ) ) )
+				{
+					uxHeld++;
+				}
+			}
+		}
+	}
+
+	( void ) fclose( pxLog );
+
+	/* The ring holds the newest small block allocations and every free. */
+	TEST_CHECK( ulLost == ( testSMALL_BLOCKS + testFREED_BLOCKS - configHEAP_TRACE_RECORDS ) );
+	TEST_CHECK( ulMallocs == ( configHEAP_TRACE_RECORDS - testFREED_BLOCKS ) );
+	TEST_CHECK( ulFrees == testFREED_BLOCKS );
+
+	TEST_CHECK( ulRegions == 1UL );
+	TEST_CHECK( ulFreeBlocks == ( testFREED_BLOCKS + 1UL ) );
+	TEST_CHECK( ulBlocks == ulFreeBlocks );
+	TEST_CHECK( ulBlockBytes == ulFreeBytes );
+	TEST_CHECK( ulLargest == xStats.xSizeOfLargestFreeBlockInBytes );
+	TEST_CHECK( uxHeld == testFREED_BLOCKS );
+}
+
+/* Runs tools/heap_trace.py on the log and checks its counts and the row of its
+fragmentation map. */
+static void prvCheckReport( void )
+{
+HeapStats_t xStats;
+FILE *pxReport;
+char cLine[ 256 ];
+unsigned long ulRecords = 0, ulLost = 0, ulUnmatched = 0, ulHeld = 0, ulTime, ulFree = 0, ulLargest = 0, ulBlocks = 0;
+BaseType_t xInMap = pdFALSE, xMapRow = pdFALSE;
+
+	vPortGetHeapStats( &xStats );
+
+	pxReport = popen( "python3 ../../tools/heap_trace.py " testLOG_FILE, "r" );
+	TEST_CHECK( pxReport != NULL );
+
+	if( pxReport == NULL )
+	{
+		return;
+	}
+
+	while( fgets( cLine, sizeof( cLine ), pxReport ) != NULL )
+	{
+		fputs( cLine, stdout );
+
+		/* sscanf() stores the leading number of any row, so the summary
+		lines are found by their text first. */
+		if( strstr( cLine, " records, " ) != NULL )
+		{
+			TEST_CHECK( sscanf( cLine, "%lu records, %lu lost, %lu frees", &ulRecords, &ulLost, &ulUnmatched ) == 3 );
+		}
+		else if( strstr( cLine, " bytes) still allocated" ) != NULL )
+		{
+			TEST_CHECK( sscanf( cLine, "%lu blocks (", &ulHeld ) == 1 );
+		}
+		else if( strncmp( cLine, "Fragmentation map", 17 ) == 0 )
+		{
+			xInMap = pdTRUE;
+		}
+		else if( ( xInMap != pdFALSE ) && ( xMapRow == pdFALSE ) &&
+				 ( sscanf( cLine, "%lu %lu %lu %lu", &ulTime, &ulFree, &ulLargest, &ulBlocks ) == 4 ) )
+		{
+			xMapRow = pdTRUE;
+		}
+	}
+
+	TEST_CHECK( pclose( pxReport ) == 0 );
+
+	/* The frees are of blocks whose allocations were read out of the ring
+	before the log was written. */
+	TEST_CHECK( ulRecords == configHEAP_TRACE_RECORDS );
+	TEST_CHECK( ulLost == ( testSMALL_BLOCKS + testFREED_BLOCKS - configHEAP_TRACE_RECORDS ) );
+	TEST_CHECK( ulUnmatched == testFREED_BLOCKS );
+	TEST_CHECK( ulHeld == ( configHEAP_TRACE_RECORDS - testFREED_BLOCKS ) );
+	TEST_CHECK( xMapRow != pdFALSE );
+	TEST_CHECK( ulFree == xStats.xAvailableHeapSpaceInBytes );
+	TEST_CHECK( ulLargest == xStats.xSizeOfLargestFreeBlockInBytes );
+	TEST_CHECK( ulBlocks == xStats.xNumberOfFreeBlocks );
+}
+
+static void prvControlTask( void *pvParameters )
+{
+UBaseType_t ux;
+
+	( void ) pvParameters;
+
+	/* The records of the tasks created before the scheduler started, and of
+	the timer task's queue. */
+	vHeapTraceWriteRecords( prvDiscardLine );
+
+	prvCheckRing();
+
+	/* The small blocks come from after the others, so freeing every other
+	block leaves a free block between each pair of used ones. */
+	for( ux = 0; ux < testSMALL_BLOCKS; ux++ )
+	{
+		pvSmallBlocks[ ux ] = pvPortMalloc( 8 );
+		TEST_CHECK( pvSmallBlocks[ ux ] != NULL );
+	}
+
+	for( ux = 0; ux < testBLOCKS; ux += 2 )
+	{
+		vPortFree( pvBlocks[ ux ] );
+	}
+
+	pxLog = fopen( testLOG_FILE, "w" );
+	TEST_CHECK( pxLog != NULL );
+
+	if( pxLog != NULL )
+	{
+		fprintf( pxLog, "other output is ignored\n" );
+		vHeapTraceWriteRecords( prvWriteLine );
+		vHeapTraceWriteSnapshot( prvWriteLine );
+		( void ) fclose( pxLog );
+
+		prvCheckLog();
+		prvCheckReport();
+	}
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,329 @@
+/*
+ * The high-resolution timer service in src/drivers/hrtimer.c, on a simulated
+ * counter.
+ *
+ * The hardware layer below is a 32-bit counter that moves on while the
+ * service runs, and a compare that, like TIM5's, only raises the interrupt
+ * when the counter equals the compare value exactly.  14 timers are started,
+ * restarted and stopped at random, with some deadlines too close to be
+ * reached by the compare, while the counter wraps.  Periodic timers restart
+ * themselves from their callbacks with HRTimer_StartAt(), and their deadlines
+ * must not drift.  Every timer must expire once per start that was not stopped,
+ * never before its deadline, and the heap must refuse a timer once
+ * HRTIMER_MAX_TIMERS are pending.
+ *
+ * Built with task callbacks, which run in the timer service task, and without
+ * INCLUDE_xTimerPendFunctionCall, where only interrupt callbacks exist.
+ */
+
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "hrtimer.h"
+
+#include "test_common.h"
+
+#define testTIMERS		14
+#define testSTEPS		2000000L
+#define testSTART		0xFFFF0000UL
+
+#if (configUSE_TIMERS == 1) && (INCLUDE_xTimerPendFunctionCall == 1)
+	#define testTASK_CALLBACKS	1
+#else
+	#define testTASK_CALLBACKS	0
+#endif
+
+/* The simulated counter and compare. */
+static uint32_t ulCounter, ulCompare;
+static BaseType_t xArmed, xFlag, xInInterrupt;
+static unsigned long ulInterrupts, ulTriggers;
+
+static HRTimer_t xTimers[ testTIMERS ];
+static HRTimer_CallMode_t xModes[ testTIMERS ];
+static BaseType_t xPeriodic[ testTIMERS ];
+static uint32_t ulPeriods[ testTIMERS ], ulNextDeadline[ testTIMERS ];
+static unsigned long ulStarted[ testTIMERS ], ulStopped[ testTIMERS ], ulFired[ testTIMERS ];
+static unsigned long ulEarly, ulDrifted, ulWrongContext, ulStillPending, ulMaxLateness;
+
+static void prvStep( void )
+{
+	ulCounter++;
+
+	if( ulCounter == ulCompare )
+	{
+		xFlag = pdTRUE;
+	}
+}
+
+/* The counter moves on by up to 3 while the service reads it. */
+uint32_t HRTimer_HwCounter( void )
+{
+int iSteps = rand() % 4;
+
+	while( iSteps-- > 0 )
+	{
+		prvStep();
+	}
+
+	return ulCounter;
+}
+
+void HRTimer_HwInit( void )
+{
+	xArmed = pdFALSE;
+	xFlag = pdFALSE;
+}
+
+void HRTimer_HwSetCompare( uint32_t ulValue )
+{
+	xFlag = pdFALSE;
+	ulCompare = ulValue;
+	xArmed = pdTRUE;
+}
+
+void HRTimer_HwDisarm( void )
+{
+	xArmed = pdFALSE;
+}
+
+void HRTimer_HwTrigger( void )
+{
+	xFlag = pdTRUE;
+	ulTriggers++;
+}
+
+/* Runs the compare interrupt if it is enabled and pending. */
+static void prvService( void )
+{
+	if( ( xArmed != pdFALSE ) && ( xFlag != pdFALSE ) && ( xInInterrupt == pdFALSE ) )
+	{
+		xFlag = pdFALSE;
+		ulInterrupts++;
+		xInInterrupt = pdTRUE;
+		HRTimer_IRQHandler();
+		xInInterrupt = pdFALSE;
+	}
+}
+
+static void prvCallback( HRTimer_t *pxTimer, void *pvContext )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvContext;
+int32_t lLateness = ( int32_t ) ( ulCounter - HRTimer_GetDeadline( pxTimer ) );
+
+	ulFired[ uxIndex ]++;
+
+	if( xModes[ uxIndex ] == HRTIMER_CALL_FROM_ISR )
+	{
+		if( xInInterrupt == pdFALSE )
+		{
+			ulWrongContext++;
+		}
+
+		if( HRTimer_IsPending( pxTimer ) )
+		{
+			ulStillPending++;
+		}
+
+		if( lLateness < 0 )
+		{
+			ulEarly++;
+		}
+		else if( ( unsigned long ) lLateness > ulMaxLateness )
+		{
+			ulMaxLateness = ( unsigned long ) lLateness;
+		}
+
+		if( xPeriodic[ uxIndex ] != pdFALSE )
+		{
+			if( HRTimer_GetDeadline( pxTimer ) != ulNextDeadline[ uxIndex ] )
+			{
+				ulDrifted++;
+			}
+
+			/* Restarting from the callback, from the deadline rather than
+			the counter. */
+			ulNextDeadline[ uxIndex ] = HRTimer_GetDeadline( pxTimer ) + ulPeriods[ uxIndex ];
+			TEST_CHECK( HRTimer_StartAt( pxTimer, ulNextDeadline[ uxIndex ] ) );
+			ulStarted[ uxIndex ]++;
+		}
+	}
+	else
+	{
+		/* A task callback may run after the timer was started again, and
+		then the deadline is the new one.  The host port switches to the timer
+		service task within the simulated interrupt, so the task that runs the
+		callback is checked rather than xInInterrupt. */
+		if( xTaskGetCurrentTaskHandle() != xTimerGetTimerDaemonTaskHandle() )
+		{
+			ulWrongContext++;
+		}
+
+		if( ( !HRTimer_IsPending( pxTimer ) ) && ( lLateness < 0 ) )
+		{
+			ulEarly++;
+		}
+	}
+}
+
+static void prvStart( UBaseType_t uxIndex, uint32_t ulDelay )
+{
+	if( !HRTimer_IsPending( &( xTimers[ uxIndex ] ) ) )
+	{
+		ulStarted[ uxIndex ]++;
+	}
+
+	TEST_CHECK( HRTimer_Start( &( xTimers[ uxIndex ] ), ulDelay ) );
+	TEST_CHECK( HRTimer_IsPending( &( xTimers[ uxIndex ] ) ) );
+	ulNextDeadline[ uxIndex ] = HRTimer_GetDeadline( &( xTimers[ uxIndex ] ) );
+}
+
+static void prvCheckCapacity( void )
+{
+static HRTimer_t xExtra[ HRTIMER_MAX_TIMERS + 1 ];
+UBaseType_t uxIndex, uxStarted = 0;
+
+	for( uxIndex = 0; uxIndex <= HRTIMER_MAX_TIMERS; uxIndex++ )
+	{
+		HRTimer_Create( &( xExtra[ uxIndex ] ), prvCallback, NULL, HRTIMER_CALL_FROM_ISR );
+
+		if( HRTimer_Start( &( xExtra[ uxIndex ] ), 1000 + uxIndex ) )
+		{
+			uxStarted++;
+		}
+	}
+
+	TEST_CHECK( uxStarted == HRTIMER_MAX_TIMERS );
+	TEST_CHECK( !HRTimer_IsPending( &( xExtra[ HRTIMER_MAX_TIMERS ] ) ) );
+	TEST_CHECK( ( xArmed != pdFALSE ) && ( ulCompare == HRTimer_GetDeadline( &( xExtra[ 0 ] ) ) ) );
+
+	/* The compare follows the earliest deadline as timers are stopped. */
+	TEST_CHECK( HRTimer_Stop( &( xExtra[ 0 ] ) ) );
+	TEST_CHECK( ulCompare == HRTimer_GetDeadline( &( xExtra[ 1 ] ) ) );
+
+	for( uxIndex = 1; uxIndex < HRTIMER_MAX_TIMERS; uxIndex++ )
+	{
+		TEST_CHECK( HRTimer_Stop( &( xExtra[ uxIndex ] ) ) );
+	}
+
+	TEST_CHECK( xArmed == pdFALSE );
+}
+
+static void prvControlTask( void *pvParameters )
+{
+UBaseType_t uxIndex;
+unsigned long ulTotal = 0;
+long lStep;
+
+	( void ) pvParameters;
+
+	HRTimer_Init();
+	ulCounter = testSTART;
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		xModes[ uxIndex ] = HRTIMER_CALL_FROM_ISR;
+
+		#if( testTASK_CALLBACKS == 1 )
+		{
+			if( ( uxIndex % 3 ) == 2 )
+			{
+				xModes[ uxIndex ] = HRTIMER_CALL_FROM_TASK;
+			}
+		}
+		#endif
+
+		xPeriodic[ uxIndex ] = ( ( uxIndex % 3 ) == 0 ) ? pdTRUE : pdFALSE;
+		ulPeriods[ uxIndex ] = 5 + ( rand() % 300 );
+		HRTimer_Create( &( xTimers[ uxIndex ] ), prvCallback, ( void * ) ( uintptr_t ) uxIndex, xModes[ uxIndex ] );
+		TEST_CHECK( !HRTimer_IsPending( &( xTimers[ uxIndex ] ) ) );
+	}
+
+	for( lStep = 0; lStep < testSTEPS; lStep++ )
+	{
+		uxIndex = rand() % testTIMERS;
+
+		switch( rand() % 64 )
+		{
+			case 0:
+				prvStart( uxIndex, rand() % 2000 );
+				break;
+
+			case 1:
+				if( HRTimer_Stop( &( xTimers[ uxIndex ] ) ) )
+				{
+					ulStopped[ uxIndex ]++;
+				}
+
+				TEST_CHECK( !HRTimer_IsPending( &( xTimers[ uxIndex ] ) ) );
+				break;
+
+			case 2:
+				/* Too close for the compare to be written in time. */
+				prvStart( uxIndex, rand() % HRTIMER_MIN_LEAD_TICKS );
+				break;
+
+			default:
+				break;
+		}
+
+		prvStep();
+		prvService();
+
+		/* Lets the timer service task run the task callbacks. */
+		if( ( lStep & 63 ) == 0 )
+		{
+			taskYIELD();
+		}
+	}
+
+	/* Stop the periodic timers, and let every other timer expire. */
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		if( ( xPeriodic[ uxIndex ] != pdFALSE ) && HRTimer_Stop( &( xTimers[ uxIndex ] ) ) )
+		{
+			ulStopped[ uxIndex ]++;
+		}
+	}
+
+	for( lStep = 0; lStep < 5000; lStep++ )
+	{
+		prvStep();
+		prvService();
+		taskYIELD();
+	}
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		TEST_CHECK( !HRTimer_IsPending( &( xTimers[ uxIndex ] ) ) );
+		TEST_CHECK( ulFired[ uxIndex ] == ( ulStarted[ uxIndex ] - ulStopped[ uxIndex ] ) );
+		ulTotal += ulFired[ uxIndex ];
+	}
+
+	printf( "task callbacks %d: %lu expiries, %lu interrupts, %lu raised by software, at most %lu ticks late\n",
+			testTASK_CALLBACKS, ulTotal, ulInterrupts, ulTriggers, ulMaxLateness );
+
+	/* The counter wrapped, and the compare alone would have missed some. */
+	TEST_CHECK( ulCounter < testSTART );
+	TEST_CHECK( ulTriggers > 0UL );
+	TEST_CHECK( ulEarly == 0UL );
+	TEST_CHECK( ulDrifted == 0UL );
+	TEST_CHECK( ulWrongContext == 0UL );
+	TEST_CHECK( ulStillPending == 0UL );
+	TEST_CHECK( HRTimer_GetDeferFailures() == 0UL );
+
+	prvCheckCapacity();
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	srand( 1 );
+
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,310 @@
+/*
+ * Log buffers written by many producers at once.
+ *
+ * First, before the scheduler starts, three host threads write records of
+ * random length into one log buffer as fast as they can while the main thread
+ * reads them without blocking.  The threads really do run concurrently, so
+ * this exercises the compare-and-swap claim and the publish order.  Every
+ * record carries its producer and sequence number, and must be read exactly
+ * once, in each producer's order, with its contents intact.
+ *
+ * Then three tasks, one of them using xLogBufferSendFromISR(), write to a
+ * small buffer read by a task that blocks for each record.
+ *
+ * Last, the cost of passing one record through a log buffer is compared with
+ * the cost of passing it through a message buffer guarded by a mutex, which is
+ * what a stream buffer needs to be shared by more than one writer.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "message_buffer.h"
+#include "log_buffer.h"
+
+#include "test_common.h"
+
+#define testTHREADS				3U
+#define testRECORDS_PER_THREAD	50000U
+#define testTASKS				3U
+#define testRECORDS_PER_TASK	3000U
+#define testBENCHMARK_RECORDS	1000000UL
+#define testBENCHMARK_LENGTH	24U
+
+static LogBufferHandle_t xLogBuffer;
+static volatile BaseType_t xStart;
+
+/* Each record starts with the producer's number and the record's sequence
+number, and the rest is filled from the sequence number. */
+static size_t prvFillRecord( uint8_t *pucRecord, uint32_t ulProducer, uint32_t ulSequence, size_t xLength )
+{
+size_t x;
+
+	memcpy( pucRecord, &ulProducer, sizeof( ulProducer ) );
+	memcpy( pucRecord + 4, &ulSequence, sizeof( ulSequence ) );
+
+	for( x = 8; x < xLength; x++ )
+	{
+		pucRecord[ x ] = ( uint8_t ) ( ulSequence + x );
+	}
+
+	return xLength;
+}
+
+static BaseType_t prvCheckRecord( const uint8_t *pucRecord, size_t xLength, uint32_t *pulNextSequence, UBaseType_t uxProducers )
+{
+uint32_t ulProducer, ulSequence;
+size_t x;
+
+	if( xLength < 8U )
+	{
+		return pdFALSE;
+	}
+
+	memcpy( &ulProducer, pucRecord, sizeof( ulProducer ) );
+	memcpy( &ulSequence, pucRecord + 4, sizeof( ulSequence ) );
+
+	if( ( ulProducer >= uxProducers ) || ( ulSequence != pulNextSequence[ ulProducer ] ) )
+	{
+		return pdFALSE;
+	}
+
+	for( x = 8; x < xLength; x++ )
+	{
+		if( pucRecord[ x ] != ( uint8_t ) ( ulSequence + x ) )
+		{
+			return pdFALSE;
+		}
+	}
+
+	pulNextSequence[ ulProducer ]++;
+	return pdTRUE;
+}
+
+static void *prvProducerThread( void *pvParameters )
+{
+uint32_t ulProducer = ( uint32_t ) ( uintptr_t ) pvParameters;
+uint32_t ulSequence = 0, ulSeed = ulProducer;
+uint8_t ucRecord[ 64 ];
+size_t xLength;
+
+	while( xStart == pdFALSE )
+	{
+		sched_yield();
+	}
+
+	while( ulSequence < testRECORDS_PER_THREAD )
+	{
+		ulSeed = ( ulSeed * 1103515245UL ) + 12345UL;
+		xLength = prvFillRecord( ucRecord, ulProducer, ulSequence, 8U + ( ( ulSeed >> 16 ) % 40U ) );
+
+		/* A full buffer drops the record, so try again. */
+		if( xLogBufferSend( xLogBuffer, ucRecord, xLength ) == xLength )
+		{
+			ulSequence++;
+		}
+		else
+		{
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+static void prvThreadStress( void )
+{
+pthread_t xThreads[ testTHREADS ];
+uint32_t ulNext[ testTHREADS ] = { 0 };
+uint8_t ucRecord[ 64 ];
+unsigned long ulReceived = 0, ulBad = 0;
+size_t xLength;
+uint32_t x;
+
+	xLogBuffer = xLogBufferCreate( 1024 );
+	TEST_CHECK( xLogBuffer != NULL );
+
+	for( x = 0; x < testTHREADS; x++ )
+	{
+		TEST_CHECK( pthread_create( &( xThreads[ x ] ), NULL, prvProducerThread, ( void * ) ( uintptr_t ) x ) == 0 );
+	}
+
+	xStart = pdTRUE;
+
+	while( ulReceived < ( unsigned long ) ( testTHREADS * testRECORDS_PER_THREAD ) )
+	{
+		xLength = xLogBufferReceive( xLogBuffer, ucRecord, sizeof( ucRecord ), 0 );
+
+		if( xLength == 0U )
+		{
+			sched_yield();
+			continue;
+		}
+
+		if( prvCheckRecord( ucRecord, xLength, ulNext, testTHREADS ) == pdFALSE )
+		{
+			ulBad++;
+		}
+
+		ulReceived++;
+	}
+
+	for( x = 0; x < testTHREADS; x++ )
+	{
+		( void ) pthread_join( xThreads[ x ], NULL );
+	}
+
+	printf( "threads: %lu records, %lu bad, %lu dropped and resent\n", ulReceived, ulBad,
+			( unsigned long ) uxLogBufferGetDroppedCount( xLogBuffer ) );
+	TEST_CHECK( ulBad == 0UL );
+	TEST_CHECK( xLogBufferNextLengthBytes( xLogBuffer ) == 0U );
+
+	/* A receive buffer that is too small leaves the record where it is. */
+	TEST_CHECK( xLogBufferSend( xLogBuffer, "hello world", 11 ) == 11U );
+	TEST_CHECK( xLogBufferReceive( xLogBuffer, ucRecord, 4, 0 ) == 0U );
+	TEST_CHECK( xLogBufferNextLengthBytes( xLogBuffer ) == 11U );
+	TEST_CHECK( xLogBufferReceive( xLogBuffer, ucRecord, sizeof( ucRecord ), 0 ) == 11U );
+
+	/* A record that can never fit is dropped. */
+	{
+	static uint8_t ucLarge[ 1024 ];
+
+		TEST_CHECK( xLogBufferSend( xLogBuffer, ucLarge, 1017 ) == 0U );
+		TEST_CHECK( xLogBufferSend( xLogBuffer, ucLarge, 500 ) == 500U );
+		TEST_CHECK( xLogBufferReceive( xLogBuffer, ucLarge, sizeof( ucLarge ), 0 ) == 500U );
+	}
+
+	vLogBufferDelete( xLogBuffer );
+}
+
+static void prvProducerTask( void *pvParameters )
+{
+uint32_t ulProducer = ( uint32_t ) ( uintptr_t ) pvParameters;
+uint32_t ulSequence = 0;
+uint8_t ucRecord[ 32 ];
+size_t xLength, xSent;
+BaseType_t xHigherPriorityTaskWoken;
+
+	while( ulSequence < testRECORDS_PER_TASK )
+	{
+		xLength = prvFillRecord( ucRecord, ulProducer, ulSequence, 8U + ( ulSequence % 20U ) );
+
+		/* The last producer stands in for an interrupt. */
+		if( ulProducer == ( testTASKS - 1U ) )
+		{
+			xHigherPriorityTaskWoken = pdFALSE;
+			xSent = xLogBufferSendFromISR( xLogBuffer, ucRecord, xLength, &xHigherPriorityTaskWoken );
+			portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+		}
+		else
+		{
+			xSent = xLogBufferSend( xLogBuffer, ucRecord, xLength );
+		}
+
+		if( xSent == xLength )
+		{
+			ulSequence++;
+		}
+
+		taskYIELD();
+	}
+
+	vTaskSuspend( NULL );
+}
+
+static void prvBenchmark( void )
+{
+LogBufferHandle_t xBenchmarkLog;
+MessageBufferHandle_t xMessageBuffer;
+SemaphoreHandle_t xMutex;
+uint8_t ucRecord[ 64 ] = { 0 };
+uint64_t ullStart, ullLogTime, ullMutexTime;
+unsigned long ul;
+
+	xBenchmarkLog = xLogBufferCreate( 4096 );
+	xMessageBuffer = xMessageBufferCreate( 4096 );
+	xMutex = xSemaphoreCreateMutex();
+	TEST_CHECK( ( xBenchmarkLog != NULL ) && ( xMessageBuffer != NULL ) && ( xMutex != NULL ) );
+
+	ullStart = ullTestNanoseconds();
+	for( ul = 0; ul < testBENCHMARK_RECORDS; ul++ )
+	{
+		( void ) xLogBufferSend( xBenchmarkLog, ucRecord, testBENCHMARK_LENGTH );
+		( void ) xLogBufferReceive( xBenchmarkLog, ucRecord, sizeof( ucRecord ), 0 );
+	}
+	ullLogTime = ullTestNanoseconds() - ullStart;
+
+	ullStart = ullTestNanoseconds();
+	for( ul = 0; ul < testBENCHMARK_RECORDS; ul++ )
+	{
+		( void ) xSemaphoreTake( xMutex, portMAX_DELAY );
+		( void ) xMessageBufferSend( xMessageBuffer, ucRecord, testBENCHMARK_LENGTH, 0 );
+		( void ) xSemaphoreGive( xMutex );
+		( void ) xMessageBufferReceive( xMessageBuffer, ucRecord, sizeof( ucRecord ), 0 );
+	}
+	ullMutexTime = ullTestNanoseconds() - ullStart;
+
+	printf( "log buffer %llu ns per record, mutex and message buffer %llu ns per record\n",
+			( unsigned long long ) ( ullLogTime / testBENCHMARK_RECORDS ),
+			( unsigned long long ) ( ullMutexTime / testBENCHMARK_RECORDS ) );
+}
+
+static void prvConsumerTask( void *pvParameters )
+{
+uint32_t ulNext[ testTASKS ] = { 0 }, ulSequence;
+uint8_t ucRecord[ 64 ];
+unsigned long ulReceived = 0, ulBad = 0;
+size_t xLength;
+
+	( void ) pvParameters;
+
+	while( ulReceived < ( unsigned long ) ( testTASKS * testRECORDS_PER_TASK ) )
+	{
+		xLength = xLogBufferReceive( xLogBuffer, ucRecord, sizeof( ucRecord ), portMAX_DELAY );
+
+		if( xLength == 0U )
+		{
+			continue;
+		}
+
+		/* The producers choose the length from the sequence number. */
+		memcpy( &ulSequence, ucRecord + 4, sizeof( ulSequence ) );
+
+		if( ( xLength != ( 8U + ( ulSequence % 20U ) ) ) || ( prvCheckRecord( ucRecord, xLength, ulNext, testTASKS ) == pdFALSE ) )
+		{
+			ulBad++;
+		}
+
+		ulReceived++;
+	}
+
+	printf( "tasks: %lu records, %lu bad\n", ulReceived, ulBad );
+	TEST_CHECK( ulBad == 0UL );
+
+	prvBenchmark();
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+uint32_t x;
+
+	prvThreadStress();
+
+	xLogBuffer = xLogBufferCreate( 256 );
+	TEST_CHECK( xLogBuffer != NULL );
+
+	for( x = 0; x < testTASKS; x++ )
+	{
+		TEST_CHECK( xTaskCreate( prvProducerTask, "prod", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) x, 1, NULL ) == pdPASS );
+	}
+
+	TEST_CHECK( xTaskCreate( prvConsumerTask, "cons", configMINIMAL_STACK_SIZE, NULL, 2, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
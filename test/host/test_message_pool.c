@@ -0,0 +1,271 @@
+/*
+ * Message pools, the ownership checks made when configASSERT() is defined, and
+ * the cost of passing messages by reference against copying them through a
+ * queue.
+ *
+ * The pool hands out its messages in order, refuses an allocation once they
+ * are all in use, and unblocks a task waiting to allocate when one is
+ * released.  A message released twice, sent by a task that does not own it, or
+ * released after it has been sent must trip the assert in prvChangeOwner(),
+ * which this test catches in its own vAssertCalled(), and leave the pool and
+ * the queue as they were.
+ *
+ * Then 64 and 512 byte messages are filled in, sent, received, read and freed
+ * in one task, through a pool and through a queue that holds the messages
+ * themselves.  memcpy() is wrapped by the linker, so the printed figures
+ * include the bytes each copies per message as well as the time per message.
+ */
+
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "message_pool.h"
+
+#include "test_common.h"
+
+#define testMESSAGES		4
+#define testMESSAGE_SIZE	64
+#define testBENCHMARK_HOPS	1000000UL
+#define testQUEUE_LENGTH	8
+
+static MessagePoolHandle_t xPool;
+static QueueHandle_t xQueue;
+static void * volatile pvStolenMessage;
+static volatile BaseType_t xAllocatorDone;
+
+/* Every memcpy() call in the kernel and the test comes here, as they are built
+with -fno-builtin-memcpy and linked with --wrap=memcpy. */
+static volatile unsigned long ulMemcpyBytes;
+void *__real_memcpy( void *pvDest, const void *pvSource, size_t xLength );
+void *__wrap_memcpy( void *pvDest, const void *pvSource, size_t xLength );
+
+void *__wrap_memcpy( void *pvDest, const void *pvSource, size_t xLength )
+{
+	ulMemcpyBytes += xLength;
+	return __real_memcpy( pvDest, pvSource, xLength );
+}
+
+/* An assert made while testASSERTS() runs its statement returns to the test
+instead of aborting. */
+static jmp_buf xAssertJump;
+static volatile BaseType_t xAssertExpected;
+static const char * volatile pcAssertFile;
+
+void vAssertCalled( const char *pcFile, int iLine )
+{
+	if( xAssertExpected != pdFALSE )
+	{
+		xAssertExpected = pdFALSE;
+		pcAssertFile = pcFile;
+		longjmp( xAssertJump, 1 );
+	}
+
+	fprintf( stderr, "assertion failed at %s:%d\n", pcFile, iLine );
+	abort();
+}
+
+#define testASSERTS( xStatement )																	\
+	do																								\
+	{																								\
+		pcAssertFile = NULL;																		\
+		xAssertExpected = pdTRUE;																	\
+		if( setjmp( xAssertJump ) == 0 )															\
+		{																							\
+			xStatement;																				\
+			xAssertExpected = pdFALSE;																\
+		}																							\
+		TEST_CHECK( ( pcAssertFile != NULL ) && ( strstr( pcAssertFile, "message_pool.c" ) != NULL ) );	\
+	} while( 0 )
+
+/* Runs above the control task, so blocks as soon as it is created. */
+static void prvAllocatorTask( void *pvParameters )
+{
+void *pvMessage;
+
+	( void ) pvParameters;
+
+	pvMessage = pvMessagePoolAllocate( xPool, portMAX_DELAY );
+	TEST_CHECK( pvMessage != NULL );
+	vMessagePoolRelease( xPool, pvMessage );
+	xAllocatorDone = pdTRUE;
+
+	vTaskDelete( NULL );
+}
+
+/* Tries to send a message the control task owns. */
+static void prvThiefTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	testASSERTS( ( void ) xMessagePoolSend( xPool, xQueue, pvStolenMessage, 0 ) );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == 0 );
+
+	vTaskDelete( NULL );
+}
+
+static void prvCheckPool( void )
+{
+uint8_t *pucMessages[ testMESSAGES ];
+void *pvMessage;
+UBaseType_t ux;
+
+	xPool = xMessagePoolCreate( testMESSAGES, testMESSAGE_SIZE );
+	xQueue = xQueueCreate( testMESSAGES, sizeof( void * ) );
+	TEST_CHECK( ( xPool != NULL ) && ( xQueue != NULL ) );
+	TEST_CHECK( uxMessagePoolGetFreeCount( xPool ) == testMESSAGES );
+
+	for( ux = 0; ux < testMESSAGES; ux++ )
+	{
+		pucMessages[ ux ] = pvMessagePoolAllocate( xPool, 0 );
+		TEST_CHECK( pucMessages[ ux ] != NULL );
+
+		if( ux > 0 )
+		{
+			TEST_CHECK( pucMessages[ ux ] == ( pucMessages[ ux - 1 ] + testMESSAGE_SIZE ) );
+		}
+	}
+
+	TEST_CHECK( pvMessagePoolAllocate( xPool, 0 ) == NULL );
+
+	/* A release unblocks a task waiting for a message. */
+	TEST_CHECK( xTaskCreate( prvAllocatorTask, "allocator", configMINIMAL_STACK_SIZE, NULL, 2, NULL ) == pdPASS );
+	TEST_CHECK( xAllocatorDone == pdFALSE );
+	vMessagePoolRelease( xPool, pucMessages[ 0 ] );
+	TEST_CHECK( xAllocatorDone != pdFALSE );
+	TEST_CHECK( uxMessagePoolGetFreeCount( xPool ) == 1 );
+
+	/* Released twice. */
+	testASSERTS( vMessagePoolRelease( xPool, pucMessages[ 0 ] ) );
+	TEST_CHECK( uxMessagePoolGetFreeCount( xPool ) == 1 );
+
+	/* Sent by a task that does not own it. */
+	pvStolenMessage = pucMessages[ 1 ];
+	TEST_CHECK( xTaskCreate( prvThiefTask, "thief", configMINIMAL_STACK_SIZE, NULL, 2, NULL ) == pdPASS );
+
+	/* The owner can still send it, but not release it once sent. */
+	memset( pucMessages[ 1 ], 0x5a, testMESSAGE_SIZE );
+	TEST_CHECK( xMessagePoolSend( xPool, xQueue, pucMessages[ 1 ], 0 ) == pdPASS );
+	testASSERTS( vMessagePoolRelease( xPool, pucMessages[ 1 ] ) );
+	TEST_CHECK( uxMessagePoolGetFreeCount( xPool ) == 1 );
+
+	pvMessage = pvMessagePoolReceive( xPool, xQueue, 0 );
+	TEST_CHECK( pvMessage == pucMessages[ 1 ] );
+	TEST_CHECK( pucMessages[ 1 ][ testMESSAGE_SIZE - 1 ] == 0x5a );
+	vMessagePoolRelease( xPool, pvMessage );
+
+	for( ux = 2; ux < testMESSAGES; ux++ )
+	{
+		vMessagePoolRelease( xPool, pucMessages[ ux ] );
+	}
+
+	TEST_CHECK( uxMessagePoolGetFreeCount( xPool ) == testMESSAGES );
+	vMessagePoolDelete( xPool );
+	vQueueDelete( xQueue );
+}
+
+/* Each message is filled in by the sender and every word of it is read by
+the receiver. */
+static void prvBenchmark( size_t xMessageSize, BaseType_t xByReference )
+{
+uint32_t ulMessage[ 512 / sizeof( uint32_t ) ], *pulMessage;
+const size_t xWords = xMessageSize / sizeof( uint32_t );
+unsigned long ulHop, ulErrors = 0, ulCopied;
+uint64_t ullStart, ullTime;
+size_t x;
+
+	if( xByReference != pdFALSE )
+	{
+		xPool = xMessagePoolCreate( testQUEUE_LENGTH, xMessageSize );
+		xQueue = xQueueCreate( testQUEUE_LENGTH, sizeof( void * ) );
+	}
+	else
+	{
+		xQueue = xQueueCreate( testQUEUE_LENGTH, xMessageSize );
+	}
+
+	TEST_CHECK( xQueue != NULL );
+	ulMemcpyBytes = 0;
+	ullStart = ullTestNanoseconds();
+
+	for( ulHop = 0; ulHop < testBENCHMARK_HOPS; ulHop++ )
+	{
+		if( xByReference != pdFALSE )
+		{
+			pulMessage = pvMessagePoolAllocate( xPool, 0 );
+			for( x = 0; x < xWords; x++ )
+			{
+				pulMessage[ x ] = ( uint32_t ) ( ulHop + x );
+			}
+			( void ) xMessagePoolSend( xPool, xQueue, pulMessage, 0 );
+
+			pulMessage = pvMessagePoolReceive( xPool, xQueue, 0 );
+			for( x = 0; x < xWords; x++ )
+			{
+				ulErrors += ( pulMessage[ x ] != ( uint32_t ) ( ulHop + x ) );
+			}
+			vMessagePoolRelease( xPool, pulMessage );
+		}
+		else
+		{
+			for( x = 0; x < xWords; x++ )
+			{
+				ulMessage[ x ] = ( uint32_t ) ( ulHop + x );
+			}
+			( void ) xQueueSend( xQueue, ulMessage, 0 );
+
+			( void ) xQueueReceive( xQueue, ulMessage, 0 );
+			for( x = 0; x < xWords; x++ )
+			{
+				ulErrors += ( ulMessage[ x ] != ( uint32_t ) ( ulHop + x ) );
+			}
+		}
+	}
+
+	ullTime = ullTestNanoseconds() - ullStart;
+	ulCopied = ulMemcpyBytes / testBENCHMARK_HOPS;
+
+	printf( "%3lu byte messages %s: %lu bytes copied by memcpy() and %llu ns per message\n",
+			( unsigned long ) xMessageSize, ( xByReference != pdFALSE ) ? "through a pool" : "by value     ",
+			ulCopied, ( unsigned long long ) ( ullTime / testBENCHMARK_HOPS ) );
+
+	TEST_CHECK( ulErrors == 0UL );
+
+	/* Only the pointer is copied in and out, or the whole message. */
+	if( xByReference != pdFALSE )
+	{
+		TEST_CHECK( ulCopied == ( 2UL * sizeof( void * ) ) );
+		vMessagePoolDelete( xPool );
+	}
+	else
+	{
+		TEST_CHECK( ulCopied == ( 2UL * xMessageSize ) );
+	}
+
+	vQueueDelete( xQueue );
+}
+
+static void prvControlTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	prvCheckPool();
+
+	prvBenchmark( 64, pdFALSE );
+	prvBenchmark( 64, pdTRUE );
+	prvBenchmark( 512, pdFALSE );
+	prvBenchmark( 512, pdTRUE );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
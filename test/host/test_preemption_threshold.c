@@ -0,0 +1,189 @@
+/*
+ * Preemption thresholds.
+ *
+ * A task at priority 1 with a threshold of 3 gives notifications to tasks at
+ * priorities 2, 3 and 4.  Only the task above the threshold may preempt it,
+ * and once that task blocks the thresholded task carries on ahead of the
+ * others, which run when it blocks.  A threshold at the task's own priority
+ * has no effect.
+ *
+ * Then a display task at priority 1 renders a frame for 7 ticks each time a
+ * sensor task at the timer task's priority, which wakes every 5 ticks, asks
+ * for one on every second wake.  The printed figures are the context switches
+ * per simulated second, how late the sensor task runs after its wake time and
+ * how long a frame takes from request to completion.  Built with and without
+ * configUSE_PREEMPTION_THRESHOLD, with the display task's threshold at the
+ * sensor task's priority when it is used.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "test_common.h"
+
+#define testSENSOR_PERIOD		5
+#define testRENDER_TICKS		7
+#define testWAKES				2000
+
+static TaskHandle_t xDisplayTask;
+static volatile TickType_t xFrameRequested;
+static unsigned long ulFrames, ulTotalFrameTime, ulMaxFrameTime;
+
+#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+static volatile UBaseType_t uxRuns[ 3 ];
+
+static void prvWokenTask( void *pvParameters )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		uxRuns[ uxIndex ]++;
+	}
+}
+
+/* Called by the control task, which runs at priority 1. */
+static void prvCheckThreshold( void )
+{
+TaskHandle_t xWoken[ 3 ];
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < 3; uxIndex++ )
+	{
+		TEST_CHECK( xTaskCreate( prvWokenTask, "woken", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) uxIndex, 2 + uxIndex, &( xWoken[ uxIndex ] ) ) == pdPASS );
+	}
+
+	vTaskPreemptionThresholdSet( NULL, 3 );
+	TEST_CHECK( uxTaskPreemptionThresholdGet( NULL ) == 3 );
+
+	/* Below and at the threshold. */
+	xTaskNotifyGive( xWoken[ 0 ] );
+	xTaskNotifyGive( xWoken[ 1 ] );
+	TEST_CHECK( ( uxRuns[ 0 ] == 0 ) && ( uxRuns[ 1 ] == 0 ) );
+
+	/* Above the threshold, after which this task runs again ahead of the
+	tasks it held off, including while the tick passes. */
+	xTaskNotifyGive( xWoken[ 2 ] );
+	TEST_CHECK( uxRuns[ 2 ] == 1 );
+	TEST_CHECK( ( uxRuns[ 0 ] == 0 ) && ( uxRuns[ 1 ] == 0 ) );
+	vPortRunForTicks( 3 );
+	TEST_CHECK( ( uxRuns[ 0 ] == 0 ) && ( uxRuns[ 1 ] == 0 ) );
+
+	vTaskDelay( 1 );
+	TEST_CHECK( ( uxRuns[ 0 ] == 1 ) && ( uxRuns[ 1 ] == 1 ) );
+
+	/* A threshold at the task's own priority has no effect. */
+	vTaskPreemptionThresholdSet( NULL, 1 );
+	xTaskNotifyGive( xWoken[ 0 ] );
+	TEST_CHECK( uxRuns[ 0 ] == 2 );
+
+	for( uxIndex = 0; uxIndex < 3; uxIndex++ )
+	{
+		vTaskDelete( xWoken[ uxIndex ] );
+	}
+}
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+
+static void prvDisplayTask( void *pvParameters )
+{
+TickType_t xFrameTime;
+
+	( void ) pvParameters;
+
+	#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+	{
+		vTaskPreemptionThresholdSet( NULL, configTIMER_TASK_PRIORITY );
+	}
+	#endif
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		vPortRunForTicks( testRENDER_TICKS );
+
+		xFrameTime = xTaskGetTickCount() - xFrameRequested;
+		ulFrames++;
+		ulTotalFrameTime += xFrameTime;
+
+		if( xFrameTime > ulMaxFrameTime )
+		{
+			ulMaxFrameTime = xFrameTime;
+		}
+	}
+}
+
+static void prvSensorTask( void *pvParameters )
+{
+TickType_t xWakeTime = xTaskGetTickCount(), xLateness, xStart = xWakeTime;
+unsigned long ulWake, ulTotalLateness = 0, ulMaxLateness = 0, ulSwitches = ulPortContextSwitches;
+
+	( void ) pvParameters;
+
+	for( ulWake = 0; ulWake < testWAKES; ulWake++ )
+	{
+		vTaskDelayUntil( &xWakeTime, testSENSOR_PERIOD );
+
+		xLateness = xTaskGetTickCount() - xWakeTime;
+		ulTotalLateness += xLateness;
+
+		if( xLateness > ulMaxLateness )
+		{
+			ulMaxLateness = xLateness;
+		}
+
+		if( ( ulWake & 1UL ) == 0UL )
+		{
+			xFrameRequested = xTaskGetTickCount();
+			xTaskNotifyGive( xDisplayTask );
+		}
+	}
+
+	ulSwitches = ulPortContextSwitches - ulSwitches;
+
+	printf( "preemption threshold %d: %lu switches per second, sensor %lu.%02lu ticks late on average and at most %lu, frames take %lu.%02lu ticks on average and at most %lu\n",
+			configUSE_PREEMPTION_THRESHOLD,
+			( ulSwitches * configTICK_RATE_HZ ) / ( unsigned long ) ( xTaskGetTickCount() - xStart ),
+			ulTotalLateness / testWAKES, ( ( ulTotalLateness * 100UL ) / testWAKES ) % 100UL, ulMaxLateness,
+			ulTotalFrameTime / ulFrames, ( ( ulTotalFrameTime * 100UL ) / ulFrames ) % 100UL, ulMaxFrameTime );
+
+	/* Without a threshold the sensor task always preempts the display task,
+	and with one it waits at most for the rest of a frame. */
+	#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+	{
+		TEST_CHECK( ulMaxLateness > 0UL );
+		TEST_CHECK( ulMaxLateness < testRENDER_TICKS );
+	}
+	#else
+	{
+		TEST_CHECK( ulMaxLateness == 0UL );
+	}
+	#endif
+
+	vTaskEndScheduler();
+}
+
+static void prvControlTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	#if( configUSE_PREEMPTION_THRESHOLD == 1 )
+	{
+		prvCheckThreshold();
+	}
+	#endif
+
+	TEST_CHECK( xTaskCreate( prvDisplayTask, "display", configMINIMAL_STACK_SIZE, NULL, 1, &xDisplayTask ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvSensorTask, "sensor", configMINIMAL_STACK_SIZE, NULL, configTIMER_TASK_PRIORITY, NULL ) == pdPASS );
+	vTaskDelete( NULL );
+}
+
+int main( void )
+{
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,265 @@
+/*
+ * Priority ordered queues, and the wait of an urgent item behind a saturated
+ * queue.
+ *
+ * Items of one level must be received in the order they were sent, and an
+ * item of a higher level before all of them, including when it was sent by a
+ * task that blocked because the queue was full of level 0 items.  A peek must
+ * return the item the next receive returns and leave it queued.  Levels above
+ * 31 are in later words of ulLevelMap, so are only found through ulGroupMap.
+ * After xQueueReset() every slot must be free again, whatever order the
+ * earlier receives left the free list in.
+ *
+ * Then a 64 item queue is kept at a depth of 63 level 0 items.  The printed
+ * figures give the number of items received ahead of an alarm sent at a higher
+ * level, and the time of a send and receive, against a FIFO queue.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "test_common.h"
+
+#define testLENGTH				8
+#define testLEVELS				256
+#define testBENCHMARK_LENGTH	64
+#define testBENCHMARK_HOPS		1000000UL
+#define testALARM_LEVEL			7
+#define testALARM				0xa1a2a3a4UL
+
+/* The level of an item is in its top byte, so the order it was received in
+can be checked. */
+#define testITEM( uxLevel, ulSequence )	( ( ( uint32_t ) ( uxLevel ) << 24 ) | ( uint32_t ) ( ulSequence ) )
+
+static QueueHandle_t xQueue;
+static volatile BaseType_t xSenderDone;
+
+/* Runs above the control task, so blocks on the full queue as soon as it is
+created. */
+static void prvUrgentSenderTask( void *pvParameters )
+{
+const uint32_t ulItem = testITEM( testALARM_LEVEL, 0 );
+
+	( void ) pvParameters;
+
+	TEST_CHECK( xQueueSendWithPriority( xQueue, &ulItem, testALARM_LEVEL, portMAX_DELAY ) == pdPASS );
+	xSenderDone = pdTRUE;
+
+	vTaskDelete( NULL );
+}
+
+static void prvCheckOrder( void )
+{
+uint32_t ulItem;
+UBaseType_t ux;
+
+	xQueue = xQueueCreatePriority( testLENGTH, sizeof( uint32_t ), testLEVELS );
+	TEST_CHECK( xQueue != NULL );
+
+	/* FIFO within a level, and the levels highest first. */
+	for( ux = 0; ux < 3; ux++ )
+	{
+		ulItem = testITEM( 2, ux );
+		TEST_CHECK( xQueueSendWithPriority( xQueue, &ulItem, 2, 0 ) == pdPASS );
+		ulItem = testITEM( 0, ux );
+		TEST_CHECK( xQueueSend( xQueue, &ulItem, 0 ) == pdPASS );
+	}
+
+	ulItem = testITEM( 1, 0 );
+	TEST_CHECK( xQueueSendWithPriority( xQueue, &ulItem, 1, 0 ) == pdPASS );
+
+	/* A peek leaves the item where it is. */
+	TEST_CHECK( xQueuePeek( xQueue, &ulItem, 0 ) == pdPASS );
+	TEST_CHECK( ulItem == testITEM( 2, 0 ) );
+	TEST_CHECK( xQueuePeek( xQueue, &ulItem, 0 ) == pdPASS );
+	TEST_CHECK( ulItem == testITEM( 2, 0 ) );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == 7 );
+
+	for( ux = 0; ux < 3; ux++ )
+	{
+		TEST_CHECK( ( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS ) && ( ulItem == testITEM( 2, ux ) ) );
+	}
+
+	TEST_CHECK( ( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS ) && ( ulItem == testITEM( 1, 0 ) ) );
+
+	/* A level that has emptied is found again when it is next sent to. */
+	ulItem = testITEM( 2, 3 );
+	TEST_CHECK( xQueueSendWithPriority( xQueue, &ulItem, 2, 0 ) == pdPASS );
+	TEST_CHECK( ( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS ) && ( ulItem == testITEM( 2, 3 ) ) );
+
+	for( ux = 0; ux < 3; ux++ )
+	{
+		TEST_CHECK( ( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS ) && ( ulItem == testITEM( 0, ux ) ) );
+	}
+
+	TEST_CHECK( xQueueReceive( xQueue, &ulItem, 0 ) == errQUEUE_EMPTY );
+
+	/* Levels in four words of ulLevelMap, with three in the same word. */
+	{
+	static const UBaseType_t uxLevels[] = { 31, 200, 0, 33, 255, 63, 32 };
+	static const UBaseType_t uxOrder[] = { 255, 200, 63, 33, 32, 31, 0 };
+
+		for( ux = 0; ux < ( sizeof( uxLevels ) / sizeof( uxLevels[ 0 ] ) ); ux++ )
+		{
+			ulItem = testITEM( uxLevels[ ux ], ux );
+			TEST_CHECK( xQueueSendWithPriority( xQueue, &ulItem, uxLevels[ ux ], 0 ) == pdPASS );
+		}
+
+		for( ux = 0; ux < ( sizeof( uxOrder ) / sizeof( uxOrder[ 0 ] ) ); ux++ )
+		{
+			TEST_CHECK( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS );
+			TEST_CHECK( ( ulItem >> 24 ) == uxOrder[ ux ] );
+		}
+	}
+
+	/* Partly emptied, so the free list is no longer in slot order, then
+	reset.  Every slot must be usable again. */
+	for( ux = 0; ux < testLENGTH; ux++ )
+	{
+		ulItem = testITEM( ux % 3, ux );
+		TEST_CHECK( xQueueSendWithPriority( xQueue, &ulItem, ux % 3, 0 ) == pdPASS );
+	}
+
+	for( ux = 0; ux < 3; ux++ )
+	{
+		TEST_CHECK( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS );
+	}
+
+	( void ) xQueueReset( xQueue );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == 0 );
+	TEST_CHECK( xQueuePeek( xQueue, &ulItem, 0 ) == errQUEUE_EMPTY );
+
+	for( ux = 0; ux < testLENGTH; ux++ )
+	{
+		ulItem = testITEM( 0, ux );
+		TEST_CHECK( xQueueSend( xQueue, &ulItem, 0 ) == pdPASS );
+	}
+
+	TEST_CHECK( xQueueSendWithPriority( xQueue, &ulItem, 1, 0 ) == errQUEUE_FULL );
+
+	for( ux = 0; ux < testLENGTH; ux++ )
+	{
+		TEST_CHECK( ( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS ) && ( ulItem == testITEM( 0, ux ) ) );
+	}
+
+	/* A queue full of level 0 items, and a task blocked sending a more urgent
+	one.  Once a slot is freed its item is received next. */
+	for( ux = 0; ux < testLENGTH; ux++ )
+	{
+		ulItem = testITEM( 0, ux );
+		TEST_CHECK( xQueueSend( xQueue, &ulItem, 0 ) == pdPASS );
+	}
+
+	TEST_CHECK( xTaskCreate( prvUrgentSenderTask, "urgent", configMINIMAL_STACK_SIZE, NULL, 2, NULL ) == pdPASS );
+	TEST_CHECK( xSenderDone == pdFALSE );
+
+	TEST_CHECK( ( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS ) && ( ulItem == testITEM( 0, 0 ) ) );
+	TEST_CHECK( xSenderDone != pdFALSE );
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == testLENGTH );
+	TEST_CHECK( ( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS ) && ( ulItem == testITEM( testALARM_LEVEL, 0 ) ) );
+
+	for( ux = 1; ux < testLENGTH; ux++ )
+	{
+		TEST_CHECK( ( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS ) && ( ulItem == testITEM( 0, ux ) ) );
+	}
+
+	vQueueDelete( xQueue );
+}
+
+/* Keeps the queue at one below its length, then counts the items received
+before an alarm and times a send and receive at that depth. */
+static void prvBenchmark( BaseType_t xPriorityOrder )
+{
+uint32_t ulItem = 0;
+unsigned long ulHop, ulAhead = 0, ulErrors = 0;
+uint64_t ullStart, ullTime;
+UBaseType_t ux;
+
+	if( xPriorityOrder != pdFALSE )
+	{
+		xQueue = xQueueCreatePriority( testBENCHMARK_LENGTH, sizeof( uint32_t ), testALARM_LEVEL + 1 );
+	}
+	else
+	{
+		xQueue = xQueueCreate( testBENCHMARK_LENGTH, sizeof( uint32_t ) );
+	}
+
+	TEST_CHECK( xQueue != NULL );
+
+	for( ux = 0; ux < ( testBENCHMARK_LENGTH - 1 ); ux++ )
+	{
+		ulItem = ( uint32_t ) ux;
+		( void ) xQueueSend( xQueue, &ulItem, 0 );
+	}
+
+	/* Each item received ahead of the alarm is sent again, so the depth is
+	the same once the alarm is out. */
+	ulItem = testALARM;
+
+	if( xPriorityOrder != pdFALSE )
+	{
+		( void ) xQueueSendWithPriority( xQueue, &ulItem, testALARM_LEVEL, 0 );
+	}
+	else
+	{
+		( void ) xQueueSend( xQueue, &ulItem, 0 );
+	}
+
+	for( ;; )
+	{
+		TEST_CHECK( xQueueReceive( xQueue, &ulItem, 0 ) == pdPASS );
+
+		if( ulItem == testALARM )
+		{
+			break;
+		}
+
+		ulAhead++;
+		( void ) xQueueSend( xQueue, &ulItem, 0 );
+	}
+
+	TEST_CHECK( uxQueueMessagesWaiting( xQueue ) == ( testBENCHMARK_LENGTH - 1 ) );
+
+	/* The items keep cycling through the queue in order. */
+	ullStart = ullTestNanoseconds();
+
+	for( ulHop = 0; ulHop < testBENCHMARK_HOPS; ulHop++ )
+	{
+		ulItem = ( uint32_t ) ( ulHop + ( testBENCHMARK_LENGTH - 1 ) );
+		( void ) xQueueSend( xQueue, &ulItem, 0 );
+		( void ) xQueueReceive( xQueue, &ulItem, 0 );
+		ulErrors += ( ulItem != ( uint32_t ) ulHop );
+	}
+
+	ullTime = ullTestNanoseconds() - ullStart;
+
+	printf( "%s queue, depth %d of %d: %lu items ahead of the alarm, %llu ns per send and receive\n",
+			( xPriorityOrder != pdFALSE ) ? "priority" : "FIFO    ", testBENCHMARK_LENGTH - 1, testBENCHMARK_LENGTH,
+			ulAhead, ( unsigned long long ) ( ullTime / testBENCHMARK_HOPS ) );
+
+	TEST_CHECK( ulErrors == 0UL );
+	TEST_CHECK( ulAhead == ( ( xPriorityOrder != pdFALSE ) ? 0UL : ( testBENCHMARK_LENGTH - 1UL ) ) );
+
+	vQueueDelete( xQueue );
+}
+
+static void prvControlTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	prvCheckOrder();
+
+	prvBenchmark( pdFALSE );
+	prvBenchmark( pdTRUE );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,194 @@
+/*
+ * xQueueSendMultiple() and xQueueReceiveMultiple().
+ *
+ * A sender mixes bursts of 1 to 20 items with single sends while a higher
+ * priority receiver takes 1 to 16 items at a time, so bursts are split by a
+ * full queue and wrap around its storage.  Every item must be received once
+ * and in order.  Partial sends, timeouts and wrapping are then checked on a
+ * small queue, and the printed throughput compares sending and receiving 32
+ * items one at a time with doing so in one call each.
+ *
+ * When built with configASSERT() compiled out, a count of 0 must return
+ * 0 at once rather than block.
+ */
+
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "test_common.h"
+
+#define testSTRESS_ITEMS		200000U
+#define testBENCHMARK_ITEMS		200000UL
+#define testBATCH				32
+
+static QueueHandle_t xQueue;
+static volatile uint32_t ulReceived;
+static unsigned long ulOutOfOrder;
+
+static void prvReceiverTask( void *pvParameters )
+{
+uint32_t ulBuffer[ 16 ], ulExpected = 0;
+BaseType_t xReceived, x;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xReceived = xQueueReceiveMultiple( xQueue, ulBuffer, 1 + ( rand() % 16 ), portMAX_DELAY );
+
+		for( x = 0; x < xReceived; x++ )
+		{
+			if( ulBuffer[ x ] != ulExpected )
+			{
+				ulOutOfOrder++;
+			}
+
+			ulExpected++;
+		}
+
+		ulReceived += ( uint32_t ) xReceived;
+	}
+}
+
+static void prvEdgeCases( void )
+{
+QueueHandle_t xSmallQueue = xQueueCreate( 5, sizeof( uint32_t ) );
+uint32_t ulIn[ 10 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }, ulOut[ 10 ], ulItem;
+TickType_t xStart;
+int i;
+
+	/* Only as many items as fit are sent once the block time expires. */
+	TEST_CHECK( xQueueSendMultiple( xSmallQueue, ulIn, 3, 0 ) == 3 );
+	xStart = xTaskGetTickCount();
+	TEST_CHECK( xQueueSendMultiple( xSmallQueue, &( ulIn[ 3 ] ), 7, 2 ) == 2 );
+	TEST_CHECK( ( xTaskGetTickCount() - xStart ) >= 2 );
+
+	TEST_CHECK( xQueueReceiveMultiple( xSmallQueue, ulOut, 10, 0 ) == 5 );
+	for( i = 0; i < 5; i++ )
+	{
+		TEST_CHECK( ulOut[ i ] == ( uint32_t ) i );
+	}
+
+	TEST_CHECK( xQueueReceiveMultiple( xSmallQueue, ulOut, 10, 3 ) == 0 );
+
+	/* Bursts that wrap around the end of the queue's storage. */
+	for( i = 0; i < 20; i++ )
+	{
+		TEST_CHECK( xQueueSendMultiple( xSmallQueue, ulIn, 3, 0 ) == 3 );
+		TEST_CHECK( xQueueReceiveMultiple( xSmallQueue, ulOut, 2, 0 ) == 2 );
+		TEST_CHECK( ( ulOut[ 0 ] == 0 ) && ( ulOut[ 1 ] == 1 ) );
+		TEST_CHECK( ( xQueueReceive( xSmallQueue, &ulItem, 0 ) == pdPASS ) && ( ulItem == 2 ) );
+	}
+
+	#ifdef testZERO_COUNTS
+	{
+		/* A count of 0 neither blocks nor moves any items, whether the queue
+		is empty, partly full or full. */
+		xStart = xTaskGetTickCount();
+		TEST_CHECK( xQueueReceiveMultiple( xSmallQueue, ulOut, 0, portMAX_DELAY ) == 0 );
+		TEST_CHECK( xQueueSendMultiple( xSmallQueue, ulIn, 0, portMAX_DELAY ) == 0 );
+		TEST_CHECK( xQueueSendMultiple( xSmallQueue, ulIn, 2, 0 ) == 2 );
+		TEST_CHECK( xQueueReceiveMultiple( xSmallQueue, ulOut, 0, portMAX_DELAY ) == 0 );
+		TEST_CHECK( xQueueSendMultiple( xSmallQueue, ulIn, 3, 0 ) == 3 );
+		TEST_CHECK( xQueueSendMultiple( xSmallQueue, ulIn, 0, portMAX_DELAY ) == 0 );
+		TEST_CHECK( uxQueueMessagesWaiting( xSmallQueue ) == 5 );
+		TEST_CHECK( xTaskGetTickCount() == xStart );
+	}
+	#endif
+
+	vQueueDelete( xSmallQueue );
+}
+
+static void prvBenchmark( void )
+{
+QueueHandle_t xBenchmarkQueue = xQueueCreate( 64, 16 );
+static uint8_t ucIn[ testBATCH ][ 16 ], ucOut[ testBATCH ][ 16 ];
+uint64_t ullStart, ullSingleTime, ullBatchTime;
+unsigned long ul;
+int i;
+
+	ullStart = ullTestNanoseconds();
+	for( ul = 0; ul < testBENCHMARK_ITEMS; ul += testBATCH )
+	{
+		for( i = 0; i < testBATCH; i++ )
+		{
+			( void ) xQueueSend( xBenchmarkQueue, ucIn[ i ], 0 );
+		}
+
+		for( i = 0; i < testBATCH; i++ )
+		{
+			( void ) xQueueReceive( xBenchmarkQueue, ucOut[ i ], 0 );
+		}
+	}
+	ullSingleTime = ullTestNanoseconds() - ullStart;
+
+	ullStart = ullTestNanoseconds();
+	for( ul = 0; ul < testBENCHMARK_ITEMS; ul += testBATCH )
+	{
+		( void ) xQueueSendMultiple( xBenchmarkQueue, ucIn, testBATCH, 0 );
+		( void ) xQueueReceiveMultiple( xBenchmarkQueue, ucOut, testBATCH, 0 );
+	}
+	ullBatchTime = ullTestNanoseconds() - ullStart;
+
+	printf( "%d items through a queue: %llu ns one at a time, %llu ns in one call each way\n", testBATCH,
+			( unsigned long long ) ( ( ullSingleTime * testBATCH ) / testBENCHMARK_ITEMS ),
+			( unsigned long long ) ( ( ullBatchTime * testBATCH ) / testBENCHMARK_ITEMS ) );
+
+	vQueueDelete( xBenchmarkQueue );
+}
+
+static void prvSenderTask( void *pvParameters )
+{
+uint32_t ulItems[ 20 ], ulSent = 0;
+int iCount, i;
+
+	( void ) pvParameters;
+
+	while( ulSent < testSTRESS_ITEMS )
+	{
+		iCount = 1 + ( rand() % 20 );
+
+		for( i = 0; i < iCount; i++ )
+		{
+			ulItems[ i ] = ulSent + ( uint32_t ) i;
+		}
+
+		if( ( rand() & 1 ) != 0 )
+		{
+			TEST_CHECK( xQueueSendMultiple( xQueue, ulItems, ( UBaseType_t ) iCount, portMAX_DELAY ) == iCount );
+			ulSent += ( uint32_t ) iCount;
+		}
+		else
+		{
+			TEST_CHECK( xQueueSend( xQueue, &( ulItems[ 0 ] ), portMAX_DELAY ) == pdPASS );
+			ulSent++;
+		}
+	}
+
+	while( ulReceived < ulSent )
+	{
+		vTaskDelay( 1 );
+	}
+
+	TEST_CHECK( ulOutOfOrder == 0UL );
+
+	prvEdgeCases();
+	prvBenchmark();
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	srand( 1 );
+	xQueue = xQueueCreate( 24, sizeof( uint32_t ) );
+	TEST_CHECK( xQueue != NULL );
+
+	TEST_CHECK( xTaskCreate( prvReceiverTask, "rx", configMINIMAL_STACK_SIZE, NULL, 2, NULL ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvSenderTask, "tx", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
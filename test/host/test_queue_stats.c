@@ -0,0 +1,228 @@
+/*
+ * Queue, semaphore and mutex statistics, and the tools/queue_stats.py report.
+ *
+ * A producer fills a queue faster than its consumer empties it, a task holds
+ * a mutex that a higher priority task then waits for, and a counting semaphore
+ * is taken when empty.  The statistics of each must count exactly what
+ * happened.  Two reports written by vQueueWriteStats() are then passed through
+ * tools/queue_stats.py, whose table must give the counts between the reports,
+ * rank the queue, which tasks waited on longest, first, and flag the queue as
+ * having been full and the mutex as having caused priority inheritance.
+ *
+ * The printed time is the cost of a send and receive that do not block.  The
+ * test is also built without configUSE_QUEUE_STATS, where only that time is
+ * measured, so the cost of keeping the statistics can be seen.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "test_common.h"
+
+#define testLOG_FILE			"build/queue_stats.log"
+#define testBENCHMARK_CALLS		2000000UL
+
+static QueueHandle_t xSensorQueue;
+static SemaphoreHandle_t xBusMutex, xEventSemaphore;
+
+static void prvProducerTask( void *pvParameters )
+{
+int i;
+
+	( void ) pvParameters;
+
+	for( i = 0; i < 20; i++ )
+	{
+		( void ) xQueueSend( xSensorQueue, &i, portMAX_DELAY );
+	}
+
+	vTaskDelete( NULL );
+}
+
+static void prvConsumerTask( void *pvParameters )
+{
+int i, iValue;
+
+	( void ) pvParameters;
+
+	vTaskDelay( 5 );
+
+	for( i = 0; i < 20; i++ )
+	{
+		( void ) xQueueReceive( xSensorQueue, &iValue, portMAX_DELAY );
+		vTaskDelay( 2 );
+	}
+
+	vTaskDelete( NULL );
+}
+
+static void prvHolderTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	( void ) xSemaphoreTake( xBusMutex, portMAX_DELAY );
+	vTaskDelay( 30 );
+	( void ) xSemaphoreGive( xBusMutex );
+	vTaskDelete( NULL );
+}
+
+#if( configUSE_QUEUE_STATS == 1 )
+
+static FILE *pxLog;
+
+static void prvWriteLine( const char *pcLine )
+{
+	fprintf( pxLog, "%s\n", pcLine );
+}
+
+/* Runs tools/queue_stats.py on the captured reports and checks the order and
+flags of the rows in its table. */
+static void prvCheckReport( void )
+{
+FILE *pxReport;
+char cLine[ 256 ], cFirstLine[ 256 ] = "", cFirstRow[ 256 ] = "", cMutexRow[ 256 ] = "";
+BaseType_t xInTable = pdFALSE;
+
+	pxReport = popen( "python3 ../../tools/queue_stats.py " testLOG_FILE, "r" );
+	TEST_CHECK( pxReport != NULL );
+
+	if( pxReport == NULL )
+	{
+		return;
+	}
+
+	while( fgets( cLine, sizeof( cLine ), pxReport ) != NULL )
+	{
+		fputs( cLine, stdout );
+
+		if( cFirstLine[ 0 ] == '\0' )
+		{
+			strcpy( cFirstLine, cLine );
+		}
+
+		if( strncmp( cLine, "name ", 5 ) == 0 )
+		{
+			xInTable = pdTRUE;
+		}
+		else if( ( xInTable != pdFALSE ) && ( cFirstRow[ 0 ] == '\0' ) )
+		{
+			strcpy( cFirstRow, cLine );
+		}
+
+		if( strncmp( cLine, "bus_mutex ", 10 ) == 0 )
+		{
+			strcpy( cMutexRow, cLine );
+		}
+	}
+
+	TEST_CHECK( pclose( pxReport ) == 0 );
+	TEST_CHECK( strncmp( cLine, "used is", 7 ) == 0 );
+	TEST_CHECK( strncmp( cFirstLine, "2 reports", 9 ) == 0 );
+	TEST_CHECK( strncmp( cFirstRow, "sensor_q ", 9 ) == 0 );
+	TEST_CHECK( strstr( cFirstRow, "full" ) != NULL );
+	TEST_CHECK( strstr( cMutexRow, "inherit" ) != NULL );
+}
+
+static void prvCheckStats( void )
+{
+QueueStats_t xStats;
+QueueRegistryStats_t xRegistry[ configQUEUE_REGISTRY_SIZE ];
+UBaseType_t uxEntries;
+
+	pxLog = fopen( testLOG_FILE, "w" );
+	TEST_CHECK( pxLog != NULL );
+	vQueueWriteStats( prvWriteLine );
+
+	/* The holder has the mutex, so the first take times out and the second
+	waits for it, and both raise the holder's priority. */
+	vTaskDelay( 2 );
+	TEST_CHECK( xSemaphoreTake( xBusMutex, pdMS_TO_TICKS( 10 ) ) == pdFALSE );
+	TEST_CHECK( xSemaphoreTake( xBusMutex, portMAX_DELAY ) == pdTRUE );
+	( void ) xSemaphoreGive( xBusMutex );
+
+	vQueueGetStats( xBusMutex, &xStats );
+	TEST_CHECK( xStats.ulPriorityInheritances == 2 );
+	TEST_CHECK( xStats.ulReceivesFailed == 1 );
+	TEST_CHECK( xStats.ulReceiveBlocks == 2 );
+	TEST_CHECK( xStats.ulMaxWaitTime >= 10 );
+
+	/* The producer blocks whenever the queue is full. */
+	vTaskDelay( 100 );
+	vQueueGetStats( xSensorQueue, &xStats );
+	TEST_CHECK( ( xStats.ulSends == 20 ) && ( xStats.ulReceives == 20 ) );
+	TEST_CHECK( xStats.uxMaxMessagesWaiting == 4 );
+	TEST_CHECK( xStats.ulSendBlocks > 0 );
+	TEST_CHECK( xStats.ulTotalWaitTime > 0 );
+
+	TEST_CHECK( xSemaphoreTake( xEventSemaphore, 0 ) == pdFALSE );
+	( void ) xSemaphoreGive( xEventSemaphore );
+	( void ) xSemaphoreGive( xEventSemaphore );
+
+	/* The three objects above and the timer command queue. */
+	uxEntries = uxQueueGetRegistryStats( xRegistry, configQUEUE_REGISTRY_SIZE );
+	TEST_CHECK( uxEntries == 4 );
+
+	vQueueWriteStats( prvWriteLine );
+	( void ) fclose( pxLog );
+	prvCheckReport();
+
+	/* A reset keeps the count the semaphore already has as its high water
+	mark. */
+	vQueueResetStats( xEventSemaphore );
+	vQueueGetStats( xEventSemaphore, &xStats );
+	TEST_CHECK( ( xStats.ulSends == 0 ) && ( xStats.uxMaxMessagesWaiting == 2 ) );
+}
+
+#endif /* configUSE_QUEUE_STATS */
+
+static void prvControlTask( void *pvParameters )
+{
+QueueHandle_t xBenchmarkQueue;
+uint64_t ullStart, ullTime;
+unsigned long ul;
+int iValue = 0;
+
+	( void ) pvParameters;
+
+	#if( configUSE_QUEUE_STATS == 1 )
+	{
+		prvCheckStats();
+	}
+	#endif
+
+	xBenchmarkQueue = xQueueCreate( 8, sizeof( int ) );
+	ullStart = ullTestNanoseconds();
+	for( ul = 0; ul < testBENCHMARK_CALLS; ul++ )
+	{
+		( void ) xQueueSend( xBenchmarkQueue, &iValue, 0 );
+		( void ) xQueueReceive( xBenchmarkQueue, &iValue, 0 );
+	}
+	ullTime = ullTestNanoseconds() - ullStart;
+
+	printf( "queue statistics %d: send and receive %llu ns\n", configUSE_QUEUE_STATS,
+			( unsigned long long ) ( ullTime / testBENCHMARK_CALLS ) );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	xSensorQueue = xQueueCreate( 4, sizeof( int ) );
+	xBusMutex = xSemaphoreCreateMutex();
+	xEventSemaphore = xSemaphoreCreateCounting( 5, 0 );
+	vQueueAddToRegistry( xSensorQueue, "sensor_q" );
+	vQueueAddToRegistry( xBusMutex, "bus_mutex" );
+	vQueueAddToRegistry( xEventSemaphore, "events" );
+
+	TEST_CHECK( xTaskCreate( prvProducerTask, "producer", configMINIMAL_STACK_SIZE, NULL, 2, NULL ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvConsumerTask, "consumer", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvHolderTask, "holder", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 3, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
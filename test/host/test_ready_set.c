@@ -0,0 +1,216 @@
+/*
+ * Ready sets holding queues, a semaphore and a stream buffer.
+ *
+ * Level members are reported for as long as they hold data and edge members
+ * once per transition from empty, members are reported in the order they
+ * became ready, a wait with no ready member times out, and members can be
+ * removed.
+ *
+ * The printed throughput compares a task reading 16 queues through a queue
+ * set, which selects one item at a time, with the same task reading them
+ * through a ready set, which reports every ready queue in one wait.  A producer
+ * of the same priority writes bursts of three items to six of the queues.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "ready_set.h"
+
+#include "test_common.h"
+
+#define testQUEUES			16
+#define testROUNDS			20000L
+#define testBURST			3
+#define testITEMS			( testROUNDS * 6L * testBURST )
+
+static QueueHandle_t xQueues[ testQUEUES ];
+static QueueSetHandle_t xQueueSet;
+static ReadySetHandle_t xThroughputSet;
+static volatile BaseType_t xPhase;
+
+static void prvProducerTask( void *pvParameters )
+{
+BaseType_t xThisPhase;
+long lRound;
+int iQueue, iItem;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		while( xPhase == 0 )
+		{
+			vTaskDelay( 1 );
+		}
+
+		xThisPhase = xPhase;
+
+		for( lRound = 0; lRound < testROUNDS; lRound++ )
+		{
+			for( iQueue = 0; iQueue < testQUEUES; iQueue += 3 )
+			{
+				for( iItem = 0; iItem < testBURST; iItem++ )
+				{
+					( void ) xQueueSend( xQueues[ iQueue ], &lRound, portMAX_DELAY );
+				}
+			}
+
+			taskYIELD();
+		}
+
+		while( xPhase == xThisPhase )
+		{
+			vTaskDelay( 1 );
+		}
+	}
+}
+
+static void prvFunctionalTests( void )
+{
+QueueHandle_t xLevelQueue, xEdgeQueue;
+SemaphoreHandle_t xSemaphore;
+StreamBufferHandle_t xStreamBuffer;
+ReadySetHandle_t xReadySet;
+ReadySetEvent_t xEvents[ 8 ];
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+TickType_t xStart;
+long lValue = 1;
+
+	xLevelQueue = xQueueCreate( 4, sizeof( long ) );
+	xEdgeQueue = xQueueCreate( 4, sizeof( long ) );
+	xSemaphore = xSemaphoreCreateBinary();
+	xStreamBuffer = xStreamBufferCreate( 32, 8 );
+	xReadySet = xReadySetCreate();
+	TEST_CHECK( xReadySet != NULL );
+
+	/* A member that already holds data is ready as soon as it is added. */
+	( void ) xQueueSend( xLevelQueue, &lValue, 0 );
+	TEST_CHECK( xReadySetAddQueue( xReadySet, xLevelQueue, eReadySetLevel, ( void * ) 1 ) == pdPASS );
+	TEST_CHECK( xReadySetAddQueue( xReadySet, xLevelQueue, eReadySetLevel, ( void * ) 1 ) == pdFAIL );
+	TEST_CHECK( xReadySetAddQueue( xReadySet, xEdgeQueue, eReadySetEdge, ( void * ) 2 ) == pdPASS );
+	TEST_CHECK( xReadySetAddQueue( xReadySet, xSemaphore, eReadySetLevel, ( void * ) 3 ) == pdPASS );
+	TEST_CHECK( xReadySetAddStreamBuffer( xReadySet, xStreamBuffer, eReadySetEdge, ( void * ) 4 ) == pdPASS );
+
+	TEST_CHECK( uxReadySetWait( xReadySet, xEvents, 8, 0 ) == 1 );
+	TEST_CHECK( ( xEvents[ 0 ].pvMember == xLevelQueue ) && ( xEvents[ 0 ].pvTag == ( void * ) 1 ) );
+
+	/* A level member is reported until it is drained. */
+	TEST_CHECK( uxReadySetWait( xReadySet, xEvents, 8, 0 ) == 1 );
+	( void ) xQueueReceive( xLevelQueue, &lValue, 0 );
+	TEST_CHECK( uxReadySetWait( xReadySet, xEvents, 8, 0 ) == 0 );
+
+	/* Members are reported in the order they became ready, and those that do
+	not fit in the array are reported by the next wait. */
+	( void ) xQueueSend( xEdgeQueue, &lValue, 0 );
+	( void ) xQueueSend( xEdgeQueue, &lValue, 0 );
+	( void ) xQueueSend( xEdgeQueue, &lValue, 0 );
+	( void ) xSemaphoreGiveFromISR( xSemaphore, &xHigherPriorityTaskWoken );
+	( void ) xStreamBufferSend( xStreamBuffer, "hi", 2, 0 );
+	( void ) xQueueSendFromISR( xLevelQueue, &lValue, &xHigherPriorityTaskWoken );
+
+	TEST_CHECK( uxReadySetWait( xReadySet, xEvents, 2, 0 ) == 2 );
+	TEST_CHECK( ( xEvents[ 0 ].pvMember == xEdgeQueue ) && ( xEvents[ 1 ].pvMember == xSemaphore ) );
+	TEST_CHECK( uxReadySetWait( xReadySet, xEvents, 8, 0 ) == 3 );
+	TEST_CHECK( ( xEvents[ 0 ].pvMember == xStreamBuffer ) && ( xEvents[ 1 ].pvMember == xLevelQueue ) && ( xEvents[ 2 ].pvMember == xSemaphore ) );
+
+	/* The edge members are not reported again until they empty and refill. */
+	TEST_CHECK( uxReadySetWait( xReadySet, xEvents, 8, 0 ) == 2 );
+	( void ) xStreamBufferReset( xStreamBuffer );
+
+	TEST_CHECK( xReadySetRemoveQueue( xReadySet, xLevelQueue ) == pdPASS );
+	TEST_CHECK( xReadySetRemoveQueue( xReadySet, xLevelQueue ) == pdFAIL );
+	TEST_CHECK( uxReadySetWait( xReadySet, xEvents, 8, 0 ) == 1 );
+	TEST_CHECK( xEvents[ 0 ].pvMember == xSemaphore );
+	( void ) xSemaphoreTake( xSemaphore, 0 );
+
+	xStart = xTaskGetTickCount();
+	TEST_CHECK( uxReadySetWait( xReadySet, xEvents, 8, 5 ) == 0 );
+	TEST_CHECK( ( xTaskGetTickCount() - xStart ) >= 5 );
+
+	( void ) xStreamBufferSend( xStreamBuffer, "x", 1, 0 );
+	TEST_CHECK( uxReadySetWait( xReadySet, xEvents, 8, 5 ) == 1 );
+	TEST_CHECK( xEvents[ 0 ].pvTag == ( void * ) 4 );
+
+	TEST_CHECK( xReadySetRemoveQueue( xReadySet, xEdgeQueue ) == pdPASS );
+	TEST_CHECK( xReadySetRemoveQueue( xReadySet, xSemaphore ) == pdPASS );
+	TEST_CHECK( xReadySetRemoveStreamBuffer( xReadySet, xStreamBuffer ) == pdPASS );
+	vReadySetDelete( xReadySet );
+}
+
+static void prvConsumerTask( void *pvParameters )
+{
+ReadySetEvent_t xEvents[ 8 ];
+QueueSetMemberHandle_t xMember;
+uint64_t ullStart, ullQueueSetTime, ullReadySetTime;
+long lReceived, lWaits = 0, lValue;
+UBaseType_t uxEvents, uxEvent;
+int iQueue;
+
+	( void ) pvParameters;
+
+	prvFunctionalTests();
+
+	ullStart = ullTestNanoseconds();
+	xPhase = 1;
+	for( lReceived = 0; lReceived < testITEMS; lReceived++ )
+	{
+		xMember = xQueueSelectFromSet( xQueueSet, portMAX_DELAY );
+		TEST_CHECK( xQueueReceive( xMember, &lValue, 0 ) == pdPASS );
+	}
+	ullQueueSetTime = ullTestNanoseconds() - ullStart;
+
+	for( iQueue = 0; iQueue < testQUEUES; iQueue++ )
+	{
+		TEST_CHECK( xQueueRemoveFromSet( xQueues[ iQueue ], xQueueSet ) == pdPASS );
+		TEST_CHECK( xReadySetAddQueue( xThroughputSet, xQueues[ iQueue ], eReadySetLevel, NULL ) == pdPASS );
+	}
+
+	ullStart = ullTestNanoseconds();
+	xPhase = 2;
+	lReceived = 0;
+	while( lReceived < testITEMS )
+	{
+		uxEvents = uxReadySetWait( xThroughputSet, xEvents, 8, portMAX_DELAY );
+		lWaits++;
+
+		for( uxEvent = 0; uxEvent < uxEvents; uxEvent++ )
+		{
+			while( xQueueReceive( xEvents[ uxEvent ].pvMember, &lValue, 0 ) == pdPASS )
+			{
+				lReceived++;
+			}
+		}
+	}
+	ullReadySetTime = ullTestNanoseconds() - ullStart;
+
+	TEST_CHECK( lReceived == testITEMS );
+	printf( "queue set %llu ns per item, ready set %llu ns per item with %ld waits for %ld items\n",
+			( unsigned long long ) ( ullQueueSetTime / testITEMS ), ( unsigned long long ) ( ullReadySetTime / testITEMS ),
+			lWaits, lReceived );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+int iQueue;
+
+	xQueueSet = xQueueCreateSet( testQUEUES * 4 );
+	xThroughputSet = xReadySetCreate();
+	TEST_CHECK( ( xQueueSet != NULL ) && ( xThroughputSet != NULL ) );
+
+	for( iQueue = 0; iQueue < testQUEUES; iQueue++ )
+	{
+		xQueues[ iQueue ] = xQueueCreate( 4, sizeof( long ) );
+		TEST_CHECK( xQueueAddToSet( xQueues[ iQueue ], xQueueSet ) == pdPASS );
+	}
+
+	TEST_CHECK( xTaskCreate( prvConsumerTask, "consumer", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvProducerTask, "producer", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,356 @@
+/*
+ * Slab caches for kernel objects, and how fragmented they leave the heap.
+ *
+ * An object freed to a full cache is the next one handed out, and objects
+ * created while the cache has room take nothing from the heap.  Once a cache is
+ * full further objects come from pvPortMalloc(), are counted as fallback
+ * allocations by uxSlabGetStats(), and go back to the heap when deleted.
+ *
+ * Then tasks, semaphores, timers and event groups are created and deleted at
+ * random, as many of each as the caches hold, among application buffers of 16
+ * to 415 bytes that are allocated and freed at random too.  The printed figures
+ * are the most free blocks heap_4.c had and the smallest its largest free block
+ * was while that ran.  Built with and without configUSE_KERNEL_OBJECT_SLABS so
+ * the two can be compared, and the free space must return to its initial size
+ * in both once everything is deleted.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "timers.h"
+#include "event_groups.h"
+
+#if( configUSE_KERNEL_OBJECT_SLABS == 1 )
+	#include "slab.h"
+#endif
+
+#include "test_common.h"
+
+#define testOPERATIONS		200000UL
+#define testSAMPLE_EVERY	64UL
+#define testBUFFERS			32
+
+/* The control, idle and timer tasks use three task control blocks. */
+#define testTASKS			( configSLAB_TASK_COUNT - 3 )
+#define testSEMAPHORES		configSLAB_SEMAPHORE_COUNT
+#define testTIMERS			configSLAB_TIMER_COUNT
+#define testEVENT_GROUPS	configSLAB_EVENT_GROUP_COUNT
+
+static TaskHandle_t xTasks[ testTASKS ];
+static SemaphoreHandle_t xSemaphores[ testSEMAPHORES ];
+static TimerHandle_t xTimers[ testTIMERS ];
+static EventGroupHandle_t xEventGroups[ testEVENT_GROUPS ];
+static void *pvBuffers[ testBUFFERS ];
+static uint32_t ulSeed = 1;
+
+/* Not rand(), so the sequence is the same on every C library. */
+static uint32_t prvRandom( void )
+{
+	ulSeed = ( ulSeed * 1103515245UL ) + 12345UL;
+	return ( ulSeed >> 16 ) & 0x7fffUL;
+}
+
+/* The churned tasks have the idle task's priority, so only run while the
+control task is blocked. */
+static void prvChurnTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+}
+
+#if( configUSE_KERNEL_OBJECT_SLABS == 1 )
+
+static SlabStats_t prvGetStats( const char *pcName )
+{
+SlabStats_t xStats[ 4 ], xFound;
+UBaseType_t uxCount, uxIndex;
+
+	memset( &xFound, 0, sizeof( xFound ) );
+	uxCount = uxSlabGetStats( xStats, 4 );
+
+	for( uxIndex = 0; uxIndex < uxCount; uxIndex++ )
+	{
+		if( strcmp( xStats[ uxIndex ].pcName, pcName ) == 0 )
+		{
+			xFound = xStats[ uxIndex ];
+		}
+	}
+
+	return xFound;
+}
+
+/* Reuse, and the fallback to the heap once the event group cache is full. */
+static void prvCheckCache( void )
+{
+EventGroupHandle_t xGroups[ configSLAB_EVENT_GROUP_COUNT + 2 ], xGroup;
+SlabStats_t xStats;
+size_t xFreeSpace = xPortGetFreeHeapSize();
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < configSLAB_EVENT_GROUP_COUNT; uxIndex++ )
+	{
+		xGroups[ uxIndex ] = xEventGroupCreate();
+		TEST_CHECK( xGroups[ uxIndex ] != NULL );
+	}
+
+	TEST_CHECK( xPortGetFreeHeapSize() == xFreeSpace );
+
+	/* The most recently freed object is handed out again. */
+	xGroup = xGroups[ 1 ];
+	vEventGroupDelete( xGroup );
+	xGroups[ 1 ] = xEventGroupCreate();
+	TEST_CHECK( xGroups[ 1 ] == xGroup );
+
+	for( ; uxIndex < ( configSLAB_EVENT_GROUP_COUNT + 2 ); uxIndex++ )
+	{
+		xGroups[ uxIndex ] = xEventGroupCreate();
+		TEST_CHECK( xGroups[ uxIndex ] != NULL );
+	}
+
+	TEST_CHECK( xPortGetFreeHeapSize() < xFreeSpace );
+
+	xStats = prvGetStats( "EventGroup" );
+	TEST_CHECK( xStats.xObjectSize >= sizeof( void * ) );
+	TEST_CHECK( xStats.uxObjectCount == configSLAB_EVENT_GROUP_COUNT );
+	TEST_CHECK( xStats.uxObjectsInUse == configSLAB_EVENT_GROUP_COUNT );
+	TEST_CHECK( xStats.uxMaximumObjectsInUse == configSLAB_EVENT_GROUP_COUNT );
+	TEST_CHECK( xStats.xNumberOfFallbackAllocations == 2U );
+
+	/* Objects from the heap and from the cache each go back where they came
+	from. */
+	for( uxIndex = 0; uxIndex < ( configSLAB_EVENT_GROUP_COUNT + 2 ); uxIndex++ )
+	{
+		vEventGroupDelete( xGroups[ uxIndex ] );
+	}
+
+	TEST_CHECK( xPortGetFreeHeapSize() == xFreeSpace );
+
+	xStats = prvGetStats( "EventGroup" );
+	TEST_CHECK( xStats.uxObjectsInUse == 0U );
+	TEST_CHECK( xStats.uxMaximumObjectsInUse == configSLAB_EVENT_GROUP_COUNT );
+	TEST_CHECK( xStats.xNumberOfFallbackAllocations == 2U );
+}
+
+#endif /* configUSE_KERNEL_OBJECT_SLABS */
+
+/* Creates the object in slot uxSlot of one of the pools if the slot is empty,
+and deletes it otherwise. */
+static void prvToggle( uint32_t ulPool, UBaseType_t uxSlot )
+{
+	switch( ulPool )
+	{
+		case 0:
+			uxSlot %= testTASKS;
+			if( xTasks[ uxSlot ] == NULL )
+			{
+				TEST_CHECK( xTaskCreate( prvChurnTask, "churn", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, &( xTasks[ uxSlot ] ) ) == pdPASS );
+			}
+			else
+			{
+				vTaskDelete( xTasks[ uxSlot ] );
+				xTasks[ uxSlot ] = NULL;
+			}
+			break;
+
+		case 1:
+			uxSlot %= testSEMAPHORES;
+			if( xSemaphores[ uxSlot ] == NULL )
+			{
+				if( ( uxSlot & 1U ) == 0U )
+				{
+					xSemaphores[ uxSlot ] = xSemaphoreCreateBinary();
+				}
+				else
+				{
+					xSemaphores[ uxSlot ] = xSemaphoreCreateMutex();
+				}
+
+				TEST_CHECK( xSemaphores[ uxSlot ] != NULL );
+			}
+			else
+			{
+				vSemaphoreDelete( xSemaphores[ uxSlot ] );
+				xSemaphores[ uxSlot ] = NULL;
+			}
+			break;
+
+		case 2:
+			/* The timer task has a higher priority, so has freed the timer
+			when xTimerDelete() returns. */
+			uxSlot %= testTIMERS;
+			if( xTimers[ uxSlot ] == NULL )
+			{
+				xTimers[ uxSlot ] = xTimerCreate( "churn", 1000, pdFALSE, NULL, prvTimerCallback );
+				TEST_CHECK( xTimers[ uxSlot ] != NULL );
+			}
+			else
+			{
+				TEST_CHECK( xTimerDelete( xTimers[ uxSlot ], portMAX_DELAY ) == pdPASS );
+				xTimers[ uxSlot ] = NULL;
+			}
+			break;
+
+		case 3:
+			uxSlot %= testEVENT_GROUPS;
+			if( xEventGroups[ uxSlot ] == NULL )
+			{
+				xEventGroups[ uxSlot ] = xEventGroupCreate();
+				TEST_CHECK( xEventGroups[ uxSlot ] != NULL );
+			}
+			else
+			{
+				vEventGroupDelete( xEventGroups[ uxSlot ] );
+				xEventGroups[ uxSlot ] = NULL;
+			}
+			break;
+
+		default:
+			uxSlot %= testBUFFERS;
+			if( pvBuffers[ uxSlot ] == NULL )
+			{
+				pvBuffers[ uxSlot ] = pvPortMalloc( 16U + ( prvRandom() % 400U ) );
+				TEST_CHECK( pvBuffers[ uxSlot ] != NULL );
+			}
+			else
+			{
+				vPortFree( pvBuffers[ uxSlot ] );
+				pvBuffers[ uxSlot ] = NULL;
+			}
+			break;
+	}
+}
+
+static BaseType_t prvSlotUsed( uint32_t ulPool, UBaseType_t uxSlot )
+{
+	switch( ulPool )
+	{
+		case 0:		return ( xTasks[ uxSlot ] != NULL );
+		case 1:		return ( xSemaphores[ uxSlot ] != NULL );
+		case 2:		return ( xTimers[ uxSlot ] != NULL );
+		case 3:		return ( xEventGroups[ uxSlot ] != NULL );
+		default:	return ( pvBuffers[ uxSlot ] != NULL );
+	}
+}
+
+static void prvControlTask( void *pvParameters )
+{
+HeapStats_t xHeapStats;
+size_t xFreeSpace, xMinLargestBlock = ( size_t ) -1;
+unsigned long ulOperation, ulMaxFreeBlocks = 0;
+static const UBaseType_t uxPoolSizes[] = { testTASKS, testSEMAPHORES, testTIMERS, testEVENT_GROUPS, testBUFFERS };
+uint32_t ulPool;
+UBaseType_t uxSlot;
+
+	( void ) pvParameters;
+
+	#if( configUSE_KERNEL_OBJECT_SLABS == 1 )
+	{
+		prvCheckCache();
+	}
+	#else
+	{
+		/* Without the caches every object comes from the heap. */
+		xFreeSpace = xPortGetFreeHeapSize();
+		xEventGroups[ 0 ] = xEventGroupCreate();
+		TEST_CHECK( xPortGetFreeHeapSize() < xFreeSpace );
+		vEventGroupDelete( xEventGroups[ 0 ] );
+		xEventGroups[ 0 ] = NULL;
+	}
+	#endif
+
+	xFreeSpace = xPortGetFreeHeapSize();
+
+	for( ulOperation = 0; ulOperation < testOPERATIONS; ulOperation++ )
+	{
+		/* Buffers are toggled as often as all the kernel objects together. */
+		ulPool = prvRandom() % 8U;
+		if( ulPool > 4U )
+		{
+			ulPool = 4U;
+		}
+
+		prvToggle( ulPool, ( UBaseType_t ) prvRandom() );
+
+		if( ( ulOperation % testSAMPLE_EVERY ) == 0UL )
+		{
+			vPortGetHeapStats( &xHeapStats );
+
+			if( xHeapStats.xNumberOfFreeBlocks > ulMaxFreeBlocks )
+			{
+				ulMaxFreeBlocks = xHeapStats.xNumberOfFreeBlocks;
+			}
+
+			if( xHeapStats.xSizeOfLargestFreeBlockInBytes < xMinLargestBlock )
+			{
+				xMinLargestBlock = xHeapStats.xSizeOfLargestFreeBlockInBytes;
+			}
+		}
+	}
+
+	printf( "kernel object slabs %d: at most %lu free blocks, largest free block at least %lu of %lu bytes\n",
+			configUSE_KERNEL_OBJECT_SLABS, ulMaxFreeBlocks, ( unsigned long ) xMinLargestBlock, ( unsigned long ) configTOTAL_HEAP_SIZE );
+
+	#if( configUSE_KERNEL_OBJECT_SLABS == 1 )
+	{
+		/* The pools fit in the caches, and tasks and timers have been created
+		and deleted often enough to fill them at some point. */
+		SlabStats_t xStats;
+
+		xStats = prvGetStats( "TCB" );
+		TEST_CHECK( xStats.uxMaximumObjectsInUse == configSLAB_TASK_COUNT );
+		TEST_CHECK( xStats.xNumberOfFallbackAllocations == 0U );
+		xStats = prvGetStats( "Semaphore" );
+		TEST_CHECK( xStats.uxMaximumObjectsInUse == configSLAB_SEMAPHORE_COUNT );
+		TEST_CHECK( xStats.xNumberOfFallbackAllocations == 0U );
+		xStats = prvGetStats( "Timer" );
+		TEST_CHECK( xStats.uxMaximumObjectsInUse == configSLAB_TIMER_COUNT );
+		TEST_CHECK( xStats.xNumberOfFallbackAllocations == 0U );
+		xStats = prvGetStats( "EventGroup" );
+		TEST_CHECK( xStats.xNumberOfFallbackAllocations == 2U );
+	}
+	#endif
+
+	for( ulPool = 0; ulPool < 5U; ulPool++ )
+	{
+		for( uxSlot = 0; uxSlot < uxPoolSizes[ ulPool ]; uxSlot++ )
+		{
+			if( prvSlotUsed( ulPool, uxSlot ) != pdFALSE )
+			{
+				prvToggle( ulPool, uxSlot );
+			}
+		}
+	}
+
+	TEST_CHECK( xPortGetFreeHeapSize() == xFreeSpace );
+
+	#if( configUSE_KERNEL_OBJECT_SLABS == 1 )
+	{
+		TEST_CHECK( prvGetStats( "TCB" ).uxObjectsInUse == 3U );
+		TEST_CHECK( prvGetStats( "Semaphore" ).uxObjectsInUse == 0U );
+		TEST_CHECK( prvGetStats( "Timer" ).uxObjectsInUse == 0U );
+		TEST_CHECK( prvGetStats( "EventGroup" ).uxObjectsInUse == 0U );
+	}
+	#endif
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
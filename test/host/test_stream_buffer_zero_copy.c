@@ -0,0 +1,321 @@
+/*
+ * Zero-copy reserve/commit and peek/consume on stream and message buffers,
+ * where the data meets the end of the storage area.
+ *
+ * A stream buffer's writable region must stop at the end of the storage area,
+ * and the next reserve must resume at its start, as must the readable region
+ * on the other side.  A message committed where its length word wraps around
+ * the end of the storage area, but its data does not, must be peeked in place
+ * after the wrapped length.  A message written by xMessageBufferSend() whose
+ * data wraps must be peeked with a NULL data pointer and still be read whole by
+ * xMessageBufferReceive().  Consuming data must unblock a task waiting in
+ * xStreamBufferSendReserve() for space.
+ *
+ * Then the same stream of bytes is passed through a stream buffer with
+ * xStreamBufferSend() and xStreamBufferReceive(), and in place.  memcpy() is
+ * wrapped by the linker, so the printed figures include the bytes each way
+ * copies as well as the time per kilobyte.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+
+#include "test_common.h"
+
+#define testLENGTH_BYTES	sizeof( configMESSAGE_BUFFER_LENGTH_TYPE )
+#define testSIZE			16
+#define testMESSAGE_SIZE	40
+#define testBENCHMARK_SIZE	256
+#define testCHUNK			48
+#define testBENCHMARK_BYTES	( 16UL * 1024UL * 1024UL )
+
+static StreamBufferHandle_t xWriterBuffer;
+static volatile BaseType_t xWriterDone;
+static volatile unsigned long ulMemcpyBytes;
+
+/* Every memcpy() call in the kernel and the test comes here, as they are built
+with -fno-builtin-memcpy and linked with --wrap=memcpy. */
+void *__real_memcpy( void *pvDest, const void *pvSource, size_t xLength );
+void *__wrap_memcpy( void *pvDest, const void *pvSource, size_t xLength );
+
+void *__wrap_memcpy( void *pvDest, const void *pvSource, size_t xLength )
+{
+	ulMemcpyBytes += xLength;
+	return __real_memcpy( pvDest, pvSource, xLength );
+}
+
+static void prvFill( uint8_t *pucData, size_t xLength, uint8_t ucFirst )
+{
+size_t x;
+
+	for( x = 0; x < xLength; x++ )
+	{
+		pucData[ x ] = ( uint8_t ) ( ucFirst + x );
+	}
+}
+
+static BaseType_t prvMatches( const uint8_t *pucData, size_t xLength, uint8_t ucFirst )
+{
+size_t x;
+
+	for( x = 0; x < xLength; x++ )
+	{
+		if( pucData[ x ] != ( uint8_t ) ( ucFirst + x ) )
+		{
+			return pdFALSE;
+		}
+	}
+
+	return pdTRUE;
+}
+
+/* The storage area holds testSIZE + 1 bytes. */
+static void prvCheckStreamWrap( void )
+{
+StreamBufferHandle_t xBuffer = xStreamBufferCreate( testSIZE, 1 );
+uint8_t *pucStorage, *pucData;
+void *pv;
+
+	TEST_CHECK( xBuffer != NULL );
+
+	TEST_CHECK( xStreamBufferSendReserve( xBuffer, &pv, 0 ) == testSIZE );
+	pucStorage = ( uint8_t * ) pv;
+	prvFill( pucStorage, 12, 0 );
+	TEST_CHECK( xStreamBufferSendCommit( xBuffer, 12 ) == 12 );
+
+	TEST_CHECK( xStreamBufferReceivePeek( xBuffer, &pv, 0 ) == 12 );
+	TEST_CHECK( pv == pucStorage );
+	TEST_CHECK( prvMatches( pv, 12, 0 ) );
+	TEST_CHECK( xStreamBufferReceiveConsume( xBuffer, 12 ) == 12 );
+
+	/* The whole buffer is free, but only 5 bytes are left before the end of
+	the storage area. */
+	TEST_CHECK( xStreamBufferSendReserve( xBuffer, &pv, 0 ) == 5 );
+	TEST_CHECK( pv == ( pucStorage + 12 ) );
+	prvFill( pv, 5, 100 );
+	TEST_CHECK( xStreamBufferSendCommit( xBuffer, 5 ) == 5 );
+
+	TEST_CHECK( xStreamBufferSendReserve( xBuffer, &pv, 0 ) == ( testSIZE - 5 ) );
+	TEST_CHECK( pv == pucStorage );
+	prvFill( pv, 3, 105 );
+	TEST_CHECK( xStreamBufferSendCommit( xBuffer, 3 ) == 3 );
+
+	/* The data is read in the same two pieces. */
+	TEST_CHECK( xStreamBufferBytesAvailable( xBuffer ) == 8 );
+	TEST_CHECK( xStreamBufferReceivePeek( xBuffer, &pv, 0 ) == 5 );
+	pucData = ( uint8_t * ) pv;
+	TEST_CHECK( pucData == ( pucStorage + 12 ) );
+	TEST_CHECK( prvMatches( pucData, 5, 100 ) );
+	TEST_CHECK( xStreamBufferReceiveConsume( xBuffer, 5 ) == 5 );
+
+	TEST_CHECK( xStreamBufferReceivePeek( xBuffer, &pv, 0 ) == 3 );
+	TEST_CHECK( pv == pucStorage );
+	TEST_CHECK( prvMatches( pv, 3, 105 ) );
+	TEST_CHECK( xStreamBufferReceiveConsume( xBuffer, 3 ) == 3 );
+
+	TEST_CHECK( xStreamBufferIsEmpty( xBuffer ) == pdTRUE );
+	TEST_CHECK( xStreamBufferReceivePeek( xBuffer, &pv, 0 ) == 0 );
+	TEST_CHECK( pv == NULL );
+
+	vStreamBufferDelete( xBuffer );
+}
+
+/* The storage area holds testMESSAGE_SIZE + 1 bytes. */
+static void prvCheckMessageWrap( void )
+{
+MessageBufferHandle_t xBuffer = xMessageBufferCreate( testMESSAGE_SIZE );
+const size_t xStorageLength = testMESSAGE_SIZE + 1;
+uint8_t *pucStorage, ucData[ testMESSAGE_SIZE ];
+size_t xFirst;
+void *pv;
+
+	TEST_CHECK( xBuffer != NULL );
+
+	/* Move the head to two bytes before the end of the storage area. */
+	xFirst = xStorageLength - 2 - testLENGTH_BYTES;
+	TEST_CHECK( xMessageBufferSendReserve( xBuffer, &pv, 0 ) == ( testMESSAGE_SIZE - testLENGTH_BYTES ) );
+	pucStorage = ( uint8_t * ) pv - testLENGTH_BYTES;
+	prvFill( pv, xFirst, 0 );
+	TEST_CHECK( xMessageBufferSendCommit( xBuffer, xFirst ) == xFirst );
+	TEST_CHECK( xMessageBufferReceivePeek( xBuffer, &pv, 0 ) == xFirst );
+	TEST_CHECK( prvMatches( pv, xFirst, 0 ) );
+	TEST_CHECK( xMessageBufferReceiveConsume( xBuffer, xFirst ) == xFirst );
+
+	/* The length wraps, and the data starts after it at the start of the
+	storage area. */
+	TEST_CHECK( xMessageBufferSendReserve( xBuffer, &pv, 0 ) == ( testMESSAGE_SIZE - testLENGTH_BYTES ) );
+	TEST_CHECK( pv == ( pucStorage + testLENGTH_BYTES - 2 ) );
+	prvFill( pv, 10, 50 );
+	TEST_CHECK( xMessageBufferSendCommit( xBuffer, 10 ) == 10 );
+
+	TEST_CHECK( xMessageBufferReceivePeek( xBuffer, &pv, 0 ) == 10 );
+	TEST_CHECK( pv == ( pucStorage + testLENGTH_BYTES - 2 ) );
+	TEST_CHECK( prvMatches( pv, 10, 50 ) );
+	TEST_CHECK( xMessageBufferReceiveConsume( xBuffer, 10 ) == 10 );
+	TEST_CHECK( xMessageBufferIsEmpty( xBuffer ) == pdTRUE );
+
+	/* A message sent by copying, with its data wrapping around the end of the
+	storage area, can only be received by copying. */
+	TEST_CHECK( xMessageBufferReset( xBuffer ) == pdPASS );
+	xFirst = 30 - testLENGTH_BYTES;
+	prvFill( ucData, xFirst, 0 );
+	TEST_CHECK( xMessageBufferSend( xBuffer, ucData, xFirst, 0 ) == xFirst );
+	TEST_CHECK( xMessageBufferReceive( xBuffer, ucData, sizeof( ucData ), 0 ) == xFirst );
+
+	prvFill( ucData, 20, 70 );
+	TEST_CHECK( xMessageBufferSend( xBuffer, ucData, 20, 0 ) == 20 );
+	pv = pucStorage;
+	TEST_CHECK( xMessageBufferReceivePeek( xBuffer, &pv, 0 ) == 20 );
+	TEST_CHECK( pv == NULL );
+
+	memset( ucData, 0, sizeof( ucData ) );
+	TEST_CHECK( xMessageBufferReceive( xBuffer, ucData, sizeof( ucData ), 0 ) == 20 );
+	TEST_CHECK( prvMatches( ucData, 20, 70 ) );
+	TEST_CHECK( xMessageBufferIsEmpty( xBuffer ) == pdTRUE );
+
+	vMessageBufferDelete( xBuffer );
+}
+
+/* Runs above the control task, so runs as soon as it is unblocked. */
+static void prvWriterTask( void *pvParameters )
+{
+void *pv;
+size_t xLength;
+
+	( void ) pvParameters;
+
+	xLength = xStreamBufferSendReserve( xWriterBuffer, &pv, portMAX_DELAY );
+	TEST_CHECK( ( xLength > 0 ) && ( pv != NULL ) );
+	prvFill( pv, 1, 200 );
+	( void ) xStreamBufferSendCommit( xWriterBuffer, 1 );
+	xWriterDone = pdTRUE;
+
+	vTaskDelete( NULL );
+}
+
+static void prvCheckConsumeUnblocksWriter( void )
+{
+uint8_t ucData[ testSIZE ];
+void *pv;
+
+	xWriterBuffer = xStreamBufferCreate( testSIZE, 1 );
+	TEST_CHECK( xWriterBuffer != NULL );
+	prvFill( ucData, testSIZE, 0 );
+	TEST_CHECK( xStreamBufferSend( xWriterBuffer, ucData, testSIZE, 0 ) == testSIZE );
+
+	TEST_CHECK( xTaskCreate( prvWriterTask, "writer", configMINIMAL_STACK_SIZE, NULL, 2, NULL ) == pdPASS );
+	TEST_CHECK( xWriterDone == pdFALSE );
+
+	TEST_CHECK( xStreamBufferReceivePeek( xWriterBuffer, &pv, 0 ) == testSIZE );
+	TEST_CHECK( xStreamBufferReceiveConsume( xWriterBuffer, 4 ) == 4 );
+	TEST_CHECK( xWriterDone != pdFALSE );
+	TEST_CHECK( xStreamBufferBytesAvailable( xWriterBuffer ) == ( testSIZE - 3 ) );
+
+	vStreamBufferDelete( xWriterBuffer );
+}
+
+/* Passes testBENCHMARK_BYTES bytes through a stream buffer testCHUNK bytes at a
+time, generating each byte where it is written and checking it where it is
+read. */
+static void prvBenchmark( BaseType_t xInPlace )
+{
+StreamBufferHandle_t xBuffer = xStreamBufferCreate( testBENCHMARK_SIZE, 1 );
+uint8_t ucChunk[ testCHUNK ];
+unsigned long ulWritten = 0, ulRead = 0, ulErrors = 0, ulCopied;
+size_t xLength, xChunkLeft, x;
+uint64_t ullStart;
+uint8_t *puc;
+void *pv;
+
+	TEST_CHECK( xBuffer != NULL );
+	ulMemcpyBytes = 0;
+	ullStart = ullTestNanoseconds();
+
+	while( ulRead < testBENCHMARK_BYTES )
+	{
+		if( xInPlace != pdFALSE )
+		{
+			for( xChunkLeft = testCHUNK; xChunkLeft > 0; xChunkLeft -= xLength )
+			{
+				xLength = configMIN( xStreamBufferSendReserve( xBuffer, &pv, 0 ), xChunkLeft );
+				for( puc = pv, x = 0; x < xLength; x++ )
+				{
+					puc[ x ] = ( uint8_t ) ulWritten++;
+				}
+				( void ) xStreamBufferSendCommit( xBuffer, xLength );
+			}
+
+			while( ( xLength = xStreamBufferReceivePeek( xBuffer, &pv, 0 ) ) > 0 )
+			{
+				for( puc = pv, x = 0; x < xLength; x++ )
+				{
+					ulErrors += ( puc[ x ] != ( uint8_t ) ulRead++ );
+				}
+				( void ) xStreamBufferReceiveConsume( xBuffer, xLength );
+			}
+		}
+		else
+		{
+			for( x = 0; x < testCHUNK; x++ )
+			{
+				ucChunk[ x ] = ( uint8_t ) ulWritten++;
+			}
+			( void ) xStreamBufferSend( xBuffer, ucChunk, testCHUNK, 0 );
+
+			while( ( xLength = xStreamBufferReceive( xBuffer, ucChunk, sizeof( ucChunk ), 0 ) ) > 0 )
+			{
+				for( x = 0; x < xLength; x++ )
+				{
+					ulErrors += ( ucChunk[ x ] != ( uint8_t ) ulRead++ );
+				}
+			}
+		}
+	}
+
+	ulCopied = ulMemcpyBytes;
+
+	printf( "%s: %lu bytes copied by memcpy() per byte passed, %llu ns per KB\n",
+			( xInPlace != pdFALSE ) ? "reserve/commit and peek/consume" : "send and receive",
+			ulCopied / ulRead, ( unsigned long long ) ( ( ( ullTestNanoseconds() - ullStart ) * 1024ULL ) / ulRead ) );
+
+	TEST_CHECK( ulErrors == 0UL );
+	TEST_CHECK( ulRead == ulWritten );
+
+	/* Each byte is copied in and out, or not at all. */
+	if( xInPlace != pdFALSE )
+	{
+		TEST_CHECK( ulCopied == 0UL );
+	}
+	else
+	{
+		TEST_CHECK( ulCopied == ( 2UL * ulRead ) );
+	}
+
+	vStreamBufferDelete( xBuffer );
+}
+
+static void prvControlTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	prvCheckStreamWrap();
+	prvCheckMessageWrap();
+	prvCheckConsumeUnblocksWriter();
+
+	prvBenchmark( pdFALSE );
+	prvBenchmark( pdTRUE );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
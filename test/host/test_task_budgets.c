@@ -0,0 +1,113 @@
+/*
+ * Task CPU budgets bound the interference a busy task causes to tasks of
+ * lower priority.
+ *
+ * A task at priority 3 with a budget of 20 ticks in every 100 and a task at
+ * priority 1 both run without ever blocking.  In every period the lower
+ * priority task must get at least the 80 ticks the budget leaves it.  The
+ * busy task must be at its own priority early in each period, at
+ * configTASK_BUDGET_BACKGROUND_PRIORITY once its budget is used, and back at
+ * its own priority when the next period starts, and each period it is dropped
+ * must be counted as an overrun.  Once the budget is removed the busy task
+ * keeps the processor.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "test_common.h"
+
+#define testPRIORITY		3
+#define testBUDGET			20
+#define testPERIOD			100
+#define testPERIODS			10
+
+static TaskHandle_t xBusyTask;
+static volatile unsigned long ulBusyTicks, ulLowTicks;
+
+/* Each loop runs for exactly one tick, which is counted before it passes. */
+static void prvBusyTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulBusyTicks++;
+		vPortRunForTicks( 1 );
+	}
+}
+
+static void prvLowTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulLowTicks++;
+		vPortRunForTicks( 1 );
+	}
+}
+
+/* Runs above both tasks, so only blocks to let time pass. */
+static void prvControlTask( void *pvParameters )
+{
+TickType_t xWakeTime;
+unsigned long ulLowAtStart, ulBusyAtStart, ulLowInPeriod, ulMinLowInPeriod = testPERIOD;
+UBaseType_t uxPeriod;
+
+	( void ) pvParameters;
+
+	TEST_CHECK( xTaskCreate( prvBusyTask, "busy", configMINIMAL_STACK_SIZE, NULL, testPRIORITY, &xBusyTask ) == pdPASS );
+	TEST_CHECK( xTaskCreate( prvLowTask, "low", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+
+	vTaskSetBudget( xBusyTask, testBUDGET, testPERIOD );
+	xWakeTime = xTaskGetTickCount();
+
+	for( uxPeriod = 0; uxPeriod < testPERIODS; uxPeriod++ )
+	{
+		ulLowAtStart = ulLowTicks;
+		ulBusyAtStart = ulBusyTicks;
+
+		/* Within the budget, so restored if it was dropped last period. */
+		vTaskDelayUntil( &xWakeTime, testBUDGET / 2 );
+		TEST_CHECK( uxTaskPriorityGet( xBusyTask ) == testPRIORITY );
+		TEST_CHECK( ulLowTicks == ulLowAtStart );
+
+		/* The budget is used up. */
+		vTaskDelayUntil( &xWakeTime, testBUDGET );
+		TEST_CHECK( uxTaskPriorityGet( xBusyTask ) == configTASK_BUDGET_BACKGROUND_PRIORITY );
+		TEST_CHECK( uxTaskGetBudgetOverrunCount( xBusyTask ) == ( uxPeriod + 1 ) );
+
+		vTaskDelayUntil( &xWakeTime, testPERIOD - ( testBUDGET / 2 ) - testBUDGET );
+		ulLowInPeriod = ulLowTicks - ulLowAtStart;
+		TEST_CHECK( ulLowInPeriod >= ( testPERIOD - testBUDGET ) );
+		TEST_CHECK( ( ulBusyTicks - ulBusyAtStart ) <= testBUDGET );
+
+		if( ulLowInPeriod < ulMinLowInPeriod )
+		{
+			ulMinLowInPeriod = ulLowInPeriod;
+		}
+	}
+
+	printf( "budget %d of %d ticks: the lower priority task got at least %lu ticks per period, %lu overruns\n",
+			testBUDGET, testPERIOD, ulMinLowInPeriod, ( unsigned long ) uxTaskGetBudgetOverrunCount( xBusyTask ) );
+
+	/* Without a budget the busy task is never dropped. */
+	vTaskSetBudget( xBusyTask, 0, 0 );
+	vTaskDelayUntil( &xWakeTime, testPERIOD );
+	ulLowAtStart = ulLowTicks;
+	vTaskDelayUntil( &xWakeTime, testPERIOD );
+	TEST_CHECK( uxTaskPriorityGet( xBusyTask ) == testPRIORITY );
+	TEST_CHECK( ulLowTicks == ulLowAtStart );
+	TEST_CHECK( uxTaskGetBudgetOverrunCount( xBusyTask ) == testPERIODS );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, testPRIORITY + 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,236 @@
+/*
+ * Indexed task notifications, and the cost of a wake against an event group.
+ *
+ * With three notification values per task, a task waiting on index 1 must not
+ * be woken by notifications sent to index 0 or 2, which must stay pending with
+ * their own values for xTaskGenericNotifyStateClear() and
+ * ulTaskGenericNotifyValueClear() to clear, one index at a time.  A task
+ * waiting on an index with no timeout is on the suspended list, but
+ * eTaskGetState() must still report it as blocked.  Stream buffers must still
+ * wake their reader through index 0, without using or losing a notification
+ * pending on another index.
+ *
+ * Then a task waiting on index 1 is woken repeatedly, and a task waiting on an
+ * event group bit.  The printed figures give the time of a wake, and of a
+ * signal that the same task consumes without blocking.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+
+#include "test_common.h"
+
+#define testWAIT_INDEX			1
+#define testOTHER_INDEX			2
+#define testBENCHMARK_WAKES		200000UL
+#define testBENCHMARK_SIGNALS	10000000UL
+
+static TaskHandle_t xWaiter, xReader;
+static EventGroupHandle_t xGroup;
+static StreamBufferHandle_t xStream;
+static volatile unsigned long ulWakes;
+static volatile uint32_t ulWakeValue;
+static volatile size_t xReceived;
+
+/* Runs above the control task, so is waiting on its index whenever the
+control task runs. */
+static void prvWaiterTask( void *pvParameters )
+{
+uint32_t ulValue;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		TEST_CHECK( xTaskNotifyWaitIndexed( testWAIT_INDEX, 0, 0xffffffffUL, &ulValue, portMAX_DELAY ) == pdPASS );
+		ulWakeValue = ulValue;
+		ulWakes++;
+	}
+}
+
+/* Blocks on the stream buffer, which waits on index 0. */
+static void prvReaderTask( void *pvParameters )
+{
+uint8_t ucData[ 8 ];
+
+	( void ) pvParameters;
+
+	xReceived = xStreamBufferReceive( xStream, ucData, sizeof( ucData ), portMAX_DELAY );
+	vTaskSuspend( NULL );
+}
+
+static void prvCheckIndices( void )
+{
+uint32_t ulPrevious;
+
+	TEST_CHECK( xTaskCreate( prvWaiterTask, "waiter", configMINIMAL_STACK_SIZE, NULL, 2, &xWaiter ) == pdPASS );
+	TEST_CHECK( eTaskGetState( xWaiter ) == eBlocked );
+
+	/* Other indices do not wake it. */
+	TEST_CHECK( xTaskNotifyIndexed( xWaiter, 0, 7, eSetValueWithOverwrite ) == pdPASS );
+	TEST_CHECK( xTaskNotifyIndexed( xWaiter, testOTHER_INDEX, 0x4, eSetBits ) == pdPASS );
+	TEST_CHECK( xTaskNotifyAndQueryIndexed( xWaiter, testOTHER_INDEX, 0x10, eSetBits, &ulPrevious ) == pdPASS );
+	TEST_CHECK( ulPrevious == 0x4 );
+	TEST_CHECK( ulWakes == 0 );
+	TEST_CHECK( eTaskGetState( xWaiter ) == eBlocked );
+
+	TEST_CHECK( xTaskNotifyIndexed( xWaiter, testWAIT_INDEX, 0x20, eSetBits ) == pdPASS );
+	TEST_CHECK( ( ulWakes == 1 ) && ( ulWakeValue == 0x20 ) );
+
+	/* The wait consumed index 1, and the others are still pending. */
+	TEST_CHECK( xTaskNotifyStateClearIndexed( xWaiter, testWAIT_INDEX ) == pdFALSE );
+	TEST_CHECK( xTaskNotifyStateClearIndexed( xWaiter, testOTHER_INDEX ) == pdTRUE );
+	TEST_CHECK( xTaskNotifyStateClearIndexed( xWaiter, testOTHER_INDEX ) == pdFALSE );
+	TEST_CHECK( xTaskNotifyStateClear( xWaiter ) == pdTRUE );
+
+	/* Clearing the state leaves the value, which is cleared bit by bit. */
+	TEST_CHECK( ulTaskNotifyValueClearIndexed( xWaiter, testOTHER_INDEX, 0x4 ) == 0x14 );
+	TEST_CHECK( ulTaskNotifyValueClearIndexed( xWaiter, testOTHER_INDEX, 0 ) == 0x10 );
+	TEST_CHECK( ulTaskNotifyValueClearIndexed( xWaiter, testWAIT_INDEX, 0 ) == 0 );
+	TEST_CHECK( ulTaskNotifyValueClear( xWaiter, 0xffffffffUL ) == 7 );
+	TEST_CHECK( ulTaskNotifyValueClear( xWaiter, 0 ) == 0 );
+	TEST_CHECK( ulTaskNotifyValueClearIndexed( xWaiter, testOTHER_INDEX, 0 ) == 0x10 );
+
+	/* The calling task's own values are separate. */
+	TEST_CHECK( ulTaskNotifyValueClearIndexed( NULL, testOTHER_INDEX, 0 ) == 0 );
+
+	/* Waiting with no timeout puts it on the suspended list. */
+	TEST_CHECK( eTaskGetState( xWaiter ) == eBlocked );
+	TEST_CHECK( ulWakes == 1 );
+	vTaskDelete( xWaiter );
+
+	/* A stream buffer wakes its reader through index 0 only. */
+	xStream = xStreamBufferCreate( 16, 1 );
+	TEST_CHECK( xStream != NULL );
+	TEST_CHECK( xTaskCreate( prvReaderTask, "reader", configMINIMAL_STACK_SIZE, NULL, 2, &xReader ) == pdPASS );
+	TEST_CHECK( eTaskGetState( xReader ) == eBlocked );
+
+	TEST_CHECK( xTaskNotifyIndexed( xReader, testWAIT_INDEX, 0x55, eSetValueWithOverwrite ) == pdPASS );
+	TEST_CHECK( eTaskGetState( xReader ) == eBlocked );
+	TEST_CHECK( xReceived == 0 );
+
+	TEST_CHECK( xStreamBufferSend( xStream, "abc", 3, 0 ) == 3 );
+	TEST_CHECK( xReceived == 3 );
+	TEST_CHECK( eTaskGetState( xReader ) == eSuspended );
+	TEST_CHECK( xTaskNotifyStateClearIndexed( xReader, testWAIT_INDEX ) == pdTRUE );
+	TEST_CHECK( ulTaskNotifyValueClearIndexed( xReader, testWAIT_INDEX, 0 ) == 0x55 );
+
+	vTaskDelete( xReader );
+	vStreamBufferDelete( xStream );
+}
+
+static void prvNotifiedTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTakeIndexed( testWAIT_INDEX, pdTRUE, portMAX_DELAY );
+		ulWakes++;
+	}
+}
+
+static void prvEventGroupTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xEventGroupWaitBits( xGroup, 0x1, pdTRUE, pdFALSE, portMAX_DELAY );
+		ulWakes++;
+	}
+}
+
+/* Each signal wakes the task above, which waits again before the control task
+sends the next. */
+static void prvBenchmark( BaseType_t xEventGroup )
+{
+TaskHandle_t xSelf = xTaskGetCurrentTaskHandle();
+uint64_t ullStart, ullWake, ullSignal;
+unsigned long ulSignal, ulSwitches, ulConsumed = 0;
+
+	ulWakes = 0;
+
+	if( xEventGroup != pdFALSE )
+	{
+		xGroup = xEventGroupCreate();
+		TEST_CHECK( xGroup != NULL );
+		TEST_CHECK( xTaskCreate( prvEventGroupTask, "group", configMINIMAL_STACK_SIZE, NULL, 2, &xWaiter ) == pdPASS );
+	}
+	else
+	{
+		TEST_CHECK( xTaskCreate( prvNotifiedTask, "notified", configMINIMAL_STACK_SIZE, NULL, 2, &xWaiter ) == pdPASS );
+	}
+
+	ulSwitches = ulPortContextSwitches;
+	ullStart = ullTestNanoseconds();
+
+	for( ulSignal = 0; ulSignal < testBENCHMARK_WAKES; ulSignal++ )
+	{
+		if( xEventGroup != pdFALSE )
+		{
+			( void ) xEventGroupSetBits( xGroup, 0x1 );
+		}
+		else
+		{
+			( void ) xTaskNotifyGiveIndexed( xWaiter, testWAIT_INDEX );
+		}
+	}
+
+	ullWake = ( ullTestNanoseconds() - ullStart ) / testBENCHMARK_WAKES;
+	ulSwitches = ulPortContextSwitches - ulSwitches;
+	TEST_CHECK( ulWakes == testBENCHMARK_WAKES );
+
+	/* Signalled and consumed by the same task. */
+	ullStart = ullTestNanoseconds();
+
+	for( ulSignal = 0; ulSignal < testBENCHMARK_SIGNALS; ulSignal++ )
+	{
+		if( xEventGroup != pdFALSE )
+		{
+			( void ) xEventGroupSetBits( xGroup, 0x2 );
+			ulConsumed += ( ( xEventGroupWaitBits( xGroup, 0x2, pdTRUE, pdFALSE, 0 ) & 0x2 ) != 0 );
+		}
+		else
+		{
+			( void ) xTaskNotifyGiveIndexed( xSelf, testOTHER_INDEX );
+			ulConsumed += ulTaskNotifyTakeIndexed( testOTHER_INDEX, pdTRUE, 0 );
+		}
+	}
+
+	ullSignal = ( ullTestNanoseconds() - ullStart ) / testBENCHMARK_SIGNALS;
+	TEST_CHECK( ulConsumed == testBENCHMARK_SIGNALS );
+
+	printf( "%s: %llu ns and %lu context switches per wake, %llu ns per signal consumed without blocking\n",
+			( xEventGroup != pdFALSE ) ? "event group " : "notification", ( unsigned long long ) ullWake,
+			ulSwitches / testBENCHMARK_WAKES, ( unsigned long long ) ullSignal );
+
+	vTaskDelete( xWaiter );
+
+	if( xEventGroup != pdFALSE )
+	{
+		vEventGroupDelete( xGroup );
+	}
+}
+
+static void prvControlTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	prvCheckIndices();
+
+	prvBenchmark( pdFALSE );
+	prvBenchmark( pdTRUE );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,112 @@
+/*
+ * The cost of software timers with 10, 1000 and 10000 of them running.
+ *
+ * For each count, auto-reload timers with periods of 1000 to 101000 ticks are
+ * started, 10000 random timers are reset while all are running, 20000 ticks
+ * pass, and all are stopped.  The printed times are per call, and for the
+ * ticks that pass, the time they took divided by the number of expiries.
+ * Built with configUSE_TIMER_WHEEL set to 1 and to 0, to compare the timing
+ * wheel with the sorted lists.
+ */
+
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "test_common.h"
+
+#define testRESETS		10000UL
+#define testTICKS		20000
+
+static volatile unsigned long ulExpiries;
+static uint64_t ullRandom = 88172645463325252ULL;
+
+static uint32_t prvRandom( void )
+{
+	ullRandom ^= ullRandom << 13;
+	ullRandom ^= ullRandom >> 7;
+	ullRandom ^= ullRandom << 17;
+	return ( uint32_t ) ullRandom;
+}
+
+static void prvCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+	ulExpiries++;
+}
+
+static void prvBenchmark( unsigned long ulTimers )
+{
+TimerHandle_t *pxTimers = malloc( ulTimers * sizeof( TimerHandle_t ) );
+uint64_t ullStart, ullStartTime, ullResetTime, ullTicksTime, ullStopTime;
+unsigned long ul;
+
+	TEST_CHECK( pxTimers != NULL );
+
+	for( ul = 0; ul < ulTimers; ul++ )
+	{
+		pxTimers[ ul ] = xTimerCreate( "timer", 1000 + ( prvRandom() % 100000 ), pdTRUE, NULL, prvCallback );
+		TEST_CHECK( pxTimers[ ul ] != NULL );
+	}
+
+	ullStart = ullTestNanoseconds();
+	for( ul = 0; ul < ulTimers; ul++ )
+	{
+		( void ) xTimerStart( pxTimers[ ul ], portMAX_DELAY );
+	}
+	ullStartTime = ullTestNanoseconds() - ullStart;
+
+	ullStart = ullTestNanoseconds();
+	for( ul = 0; ul < testRESETS; ul++ )
+	{
+		( void ) xTimerReset( pxTimers[ prvRandom() % ulTimers ], portMAX_DELAY );
+	}
+	ullResetTime = ullTestNanoseconds() - ullStart;
+
+	ulExpiries = 0;
+	ullStart = ullTestNanoseconds();
+	vTaskDelay( testTICKS );
+	ullTicksTime = ullTestNanoseconds() - ullStart;
+
+	ullStart = ullTestNanoseconds();
+	for( ul = 0; ul < ulTimers; ul++ )
+	{
+		( void ) xTimerStop( pxTimers[ ul ], portMAX_DELAY );
+	}
+	ullStopTime = ullTestNanoseconds() - ullStart;
+
+	printf( "timer wheel %d, %5lu timers: start %6llu ns, reset %6llu ns, stop %6llu ns, %d ticks with %lu expiries %6llu ns per expiry\n",
+			configUSE_TIMER_WHEEL, ulTimers,
+			( unsigned long long ) ( ullStartTime / ulTimers ), ( unsigned long long ) ( ullResetTime / testRESETS ),
+			( unsigned long long ) ( ullStopTime / ulTimers ), testTICKS, ulExpiries,
+			( unsigned long long ) ( ullTicksTime / ( ( ulExpiries > 0UL ) ? ulExpiries : 1UL ) ) );
+
+	for( ul = 0; ul < ulTimers; ul++ )
+	{
+		TEST_CHECK( xTimerDelete( pxTimers[ ul ], portMAX_DELAY ) == pdPASS );
+	}
+
+	vTaskDelay( 1 );
+	free( pxTimers );
+}
+
+static void prvControlTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	prvBenchmark( 10 );
+	prvBenchmark( 1000 );
+	prvBenchmark( 10000 );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
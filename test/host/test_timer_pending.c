@@ -0,0 +1,169 @@
+/*
+ * Timer commands recorded in the timers themselves rather than sent on the
+ * timer queue.
+ *
+ * Timers started before the scheduler, including one started before any task
+ * exists, when the current task and timer task handles are both NULL, must
+ * expire on time.  Then a later command must replace an earlier one that has
+ * not been processed, and commands sent to many timers at once must reach them
+ * all.  The printed times compare sending a command to each of 1000 timers in
+ * turn with sending one command to all of them.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "test_common.h"
+
+#define testTIMERS		1000
+#define testROUNDS		200
+
+static TimerHandle_t xTimers[ testTIMERS ];
+static volatile UBaseType_t uxFired[ testTIMERS ];
+static volatile TickType_t xFiredAt[ testTIMERS ];
+static volatile UBaseType_t uxReloads;
+
+static void prvOneShotCallback( TimerHandle_t xTimer )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvTimerGetTimerID( xTimer );
+
+	uxFired[ uxIndex ]++;
+	xFiredAt[ uxIndex ] = xTaskGetTickCount();
+}
+
+static void prvReloadCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+	uxReloads++;
+}
+
+static UBaseType_t prvCountFired( UBaseType_t uxTimes )
+{
+UBaseType_t uxIndex, uxCount = 0;
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		if( uxFired[ uxIndex ] == uxTimes )
+		{
+			uxCount++;
+		}
+	}
+
+	return uxCount;
+}
+
+static void prvClearFired( void )
+{
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		uxFired[ uxIndex ] = 0;
+	}
+}
+
+static void prvApplicationTask( void *pvParameters )
+{
+TimerHandle_t xReloadTimer;
+uint64_t ullStart, ullSingleTime, ullMultipleTime;
+UBaseType_t uxIndex, uxSent = 0, uxRound;
+
+	( void ) pvParameters;
+
+	/* The timers started in main() expire at the ticks they were started
+	for. */
+	vTaskDelay( 25 );
+	TEST_CHECK( ( uxFired[ 0 ] == 1 ) && ( xFiredAt[ 0 ] == 10 ) );
+	TEST_CHECK( ( uxFired[ 1 ] == 1 ) && ( xFiredAt[ 1 ] == 20 ) );
+	TEST_CHECK( ( uxFired[ 2 ] == 1 ) && ( xFiredAt[ 2 ] == 15 ) );
+	TEST_CHECK( uxFired[ 3 ] == 0 );
+	TEST_CHECK( xTimerIsTimerActive( xTimers[ 3 ] ) == pdFALSE );
+	prvClearFired();
+
+	/* Only the last of the commands given before the timer task runs takes
+	effect, with the period of any change of period among them. */
+	TEST_CHECK( xTimerStart( xTimers[ 0 ], 0 ) == pdPASS );
+	TEST_CHECK( xTimerStop( xTimers[ 0 ], 0 ) == pdPASS );
+	TEST_CHECK( xTimerChangePeriod( xTimers[ 1 ], 7, 0 ) == pdPASS );
+	TEST_CHECK( xTimerStop( xTimers[ 1 ], 0 ) == pdPASS );
+	TEST_CHECK( xTimerStop( xTimers[ 2 ], 0 ) == pdPASS );
+	TEST_CHECK( xTimerStart( xTimers[ 2 ], 0 ) == pdPASS );
+	vTaskDelay( 1 );
+	TEST_CHECK( xTimerIsTimerActive( xTimers[ 0 ] ) == pdFALSE );
+	TEST_CHECK( xTimerIsTimerActive( xTimers[ 1 ] ) == pdFALSE );
+	TEST_CHECK( xTimerGetPeriod( xTimers[ 1 ] ) == 7 );
+	TEST_CHECK( xTimerIsTimerActive( xTimers[ 2 ] ) != pdFALSE );
+	vTaskDelay( 20 );
+	TEST_CHECK( ( uxFired[ 0 ] == 0 ) && ( uxFired[ 1 ] == 0 ) && ( uxFired[ 2 ] == 1 ) );
+
+	xReloadTimer = xTimerCreate( "reload", 3, pdTRUE, NULL, prvReloadCallback );
+	TEST_CHECK( xTimerStart( xReloadTimer, 0 ) == pdPASS );
+	vTaskDelay( 31 );
+	TEST_CHECK( xTimerStop( xReloadTimer, 0 ) == pdPASS );
+	vTaskDelay( 1 );
+	TEST_CHECK( uxReloads == 10 );
+
+	/* A command to each timer in turn, then one command to all of them. */
+	ullStart = ullTestNanoseconds();
+	for( uxRound = 0; uxRound < testROUNDS; uxRound++ )
+	{
+		for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+		{
+			TEST_CHECK( xTimerStart( xTimers[ uxIndex ], 0 ) == pdPASS );
+		}
+
+		for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+		{
+			TEST_CHECK( xTimerStop( xTimers[ uxIndex ], 0 ) == pdPASS );
+		}
+	}
+	ullSingleTime = ullTestNanoseconds() - ullStart;
+	vTaskDelay( 1 );
+
+	ullStart = ullTestNanoseconds();
+	for( uxRound = 0; uxRound < testROUNDS; uxRound++ )
+	{
+		uxSent += xTimerStartMultiple( xTimers, testTIMERS, 0 );
+		uxSent += xTimerStopMultiple( xTimers, testTIMERS, 0 );
+	}
+	ullMultipleTime = ullTestNanoseconds() - ullStart;
+	vTaskDelay( 1 );
+
+	TEST_CHECK( uxSent == ( 2 * testROUNDS * testTIMERS ) );
+	printf( "%d timers: %llu ns per command sent to each, %llu ns per timer sent to all\n", testTIMERS,
+			( unsigned long long ) ( ullSingleTime / ( 2 * testROUNDS * testTIMERS ) ),
+			( unsigned long long ) ( ullMultipleTime / ( 2 * testROUNDS * testTIMERS ) ) );
+
+	prvClearFired();
+	TEST_CHECK( xTimerStartMultiple( xTimers, testTIMERS, portMAX_DELAY ) == testTIMERS );
+	TEST_CHECK( xTimerChangePeriodMultiple( xTimers, testTIMERS, 5, portMAX_DELAY ) == testTIMERS );
+	vTaskDelay( 7 );
+	TEST_CHECK( prvCountFired( 1 ) == testTIMERS );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		xTimers[ uxIndex ] = xTimerCreate( "timer", 100, pdFALSE, ( void * ) ( uintptr_t ) uxIndex, prvOneShotCallback );
+		TEST_CHECK( xTimers[ uxIndex ] != NULL );
+	}
+
+	/* No task exists yet. */
+	TEST_CHECK( xTimerChangePeriod( xTimers[ 0 ], 10, 0 ) == pdPASS );
+
+	TEST_CHECK( xTaskCreate( prvApplicationTask, "app", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+
+	TEST_CHECK( xTimerChangePeriod( xTimers[ 1 ], 20, 0 ) == pdPASS );
+	TEST_CHECK( xTimerChangePeriodMultiple( &( xTimers[ 2 ] ), 2, 15, 0 ) == 2 );
+	TEST_CHECK( xTimerStop( xTimers[ 3 ], 0 ) == pdPASS );
+
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,150 @@
+/*
+ * Timer slack, and how many times the timer task wakes in an hour.
+ *
+ * 40 auto-reload timers with periods of 950 to 1050 ticks run for a simulated
+ * hour at 1 kHz.  Every callback must run no earlier than the nominal expiry
+ * time of the timer, counted in whole periods from when it was started, and no
+ * later than its slack, so the expiry times never drift.  Each reload time
+ * must be aligned to the slack too.  The hour crosses the tick count overflow
+ * with the scheduler suspended, so timers expire before the overflow but are
+ * reloaded on the paths that run when the timer lists are switched.
+ *
+ * Built with slack, using the timing wheel and the lists, and without, so the
+ * printed wakeups per hour show what coalescing the timers saves.
+ */
+
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "test_common.h"
+
+#define testTIMERS						40
+#define testHOUR						pdMS_TO_TICKS( 3600000UL )
+#define testSUSPENDED_TICKS				2048
+#define testSUSPENDED_BEFORE_OVERFLOW	1536
+
+#if( configUSE_TIMER_SLACK == 1 )
+	#define testSLACK		63
+#else
+	#define testSLACK		0
+#endif
+
+static TimerHandle_t xTimers[ testTIMERS ];
+static TickType_t xStarted[ testTIMERS ], xPeriods[ testTIMERS ];
+static unsigned long ulExpiries[ testTIMERS ];
+static unsigned long ulWakeups, ulTooLate, ulTooEarly, ulUnaligned;
+static TickType_t xLastWakeup, xResumeTick, xMaxLateness;
+
+static void prvCallback( TimerHandle_t xTimer )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvTimerGetTimerID( xTimer );
+TickType_t xNow = xTaskGetTickCount(), xNominal, xLateness;
+
+	ulExpiries[ uxIndex ]++;
+	xNominal = xStarted[ uxIndex ] + ( ( TickType_t ) ulExpiries[ uxIndex ] * xPeriods[ uxIndex ] );
+	xLateness = xNow - xNominal;
+
+	/* Lateness wraps to a large value if the timer expired early.  Timers
+	that expired while the scheduler was suspended run late when it resumes. */
+	if( xLateness > ( TickType_t ) ( testSUSPENDED_TICKS + testSLACK ) )
+	{
+		ulTooEarly++;
+	}
+	else if( ( xLateness > testSLACK ) && ( xNow != xResumeTick ) )
+	{
+		ulTooLate++;
+	}
+	else if( ( xLateness > xMaxLateness ) && ( xNow != xResumeTick ) )
+	{
+		xMaxLateness = xLateness;
+	}
+
+	/* The timer has been reloaded already. */
+	if( ( xTimerGetExpiryTime( xTimer ) & testSLACK ) != 0 )
+	{
+		ulUnaligned++;
+	}
+
+	if( ( xNow != xLastWakeup ) || ( ulWakeups == 0UL ) )
+	{
+		ulWakeups++;
+		xLastWakeup = xNow;
+	}
+}
+
+static void prvControlTask( void *pvParameters )
+{
+TickType_t xHourStart, xHourEnd;
+unsigned long ulTotal = 0, ulExpected;
+UBaseType_t uxIndex;
+
+	( void ) pvParameters;
+
+	srand( 1 );
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		xPeriods[ uxIndex ] = 950 + ( rand() % 101 );
+		xTimers[ uxIndex ] = xTimerCreate( "timer", xPeriods[ uxIndex ], pdTRUE, ( void * ) ( uintptr_t ) uxIndex, prvCallback );
+		TEST_CHECK( xTimers[ uxIndex ] != NULL );
+
+		#if( configUSE_TIMER_SLACK == 1 )
+		{
+			vTimerSetSlack( xTimers[ uxIndex ], testSLACK );
+			TEST_CHECK( xTimerGetSlack( xTimers[ uxIndex ] ) == testSLACK );
+		}
+		#endif
+
+		vTaskDelay( rand() % 50 );
+		xStarted[ uxIndex ] = xTaskGetTickCount();
+		TEST_CHECK( xTimerStart( xTimers[ uxIndex ], portMAX_DELAY ) == pdPASS );
+	}
+
+	xHourStart = xTaskGetTickCount();
+	xHourEnd = xHourStart + testHOUR;
+	ulWakeups = 0;
+
+	/* Let the tick count overflow while the timer task cannot run.  Timers
+	that expired long enough before the overflow are reloaded before it, and
+	the others are restarted by commands sent to the timer task itself. */
+	vTaskDelay( ( TickType_t ) ( 0U - testSUSPENDED_BEFORE_OVERFLOW ) - xTaskGetTickCount() );
+	xResumeTick = xTaskGetTickCount() + testSUSPENDED_TICKS;
+	vTaskSuspendAll();
+	vPortRunForTicks( testSUSPENDED_TICKS );
+	( void ) xTaskResumeAll();
+	TEST_CHECK( xTaskGetTickCount() == xResumeTick );
+
+	vTaskDelay( xHourEnd - xTaskGetTickCount() );
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		ulExpected = ( unsigned long ) ( ( xHourEnd - xStarted[ uxIndex ] ) / xPeriods[ uxIndex ] );
+		TEST_CHECK( ( ulExpiries[ uxIndex ] <= ulExpected ) && ( ( ulExpiries[ uxIndex ] + 1UL ) >= ulExpected ) );
+		ulTotal += ulExpiries[ uxIndex ];
+	}
+
+	printf( "slack %d ticks, timer wheel %d: %lu expiries, %lu wakeups per simulated hour, at most %lu ticks late\n",
+			testSLACK, configUSE_TIMER_WHEEL, ulTotal, ulWakeups, ( unsigned long ) xMaxLateness );
+
+	TEST_CHECK( xTaskGetTickCount() < xHourStart );
+	TEST_CHECK( ulTooEarly == 0UL );
+	TEST_CHECK( ulTooLate == 0UL );
+	TEST_CHECK( ulUnaligned == 0UL );
+
+	/* With slack the timer task only wakes at multiples of the slack plus one,
+	and when the scheduler resumed. */
+	TEST_CHECK( ulWakeups <= ( ( testHOUR / ( testSLACK + 1 ) ) + 1UL ) );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
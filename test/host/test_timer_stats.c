@@ -0,0 +1,184 @@
+/*
+ * Timer callback lateness and run time statistics, and the
+ * tools/timer_stats.py report.
+ *
+ * A task with a higher priority than the timer task wakes at the same tick as
+ * an auto-reload timer expires, and holds the timer task off for a known
+ * number of virtual ticks before blocking again.  The timer's lateness
+ * histogram and maximum must count exactly those ticks, including at the
+ * expiry that crosses the tick count overflow.  Another timer's callback busy
+ * waits for 300 us of the host's clock, which must be recorded as its run
+ * time.  A report written by vTimerWriteStats() is then passed through
+ * tools/timer_stats.py, whose table must rank the slow callback first.
+ *
+ * Built with the timing wheel and with the sorted lists.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "test_common.h"
+
+#define testLOG_FILE		"build/timer_stats.log"
+#define testPERIOD			100
+#define testEXPIRIES		40
+#define testSLOW_RUN_TIME	300
+
+static TimerHandle_t xControlTimer, xSlowTimer;
+static FILE *pxLog;
+
+/* How many ticks the timer task is held off at each expiry of the control
+timer, in turn. */
+static const TickType_t xHoldOffs[] = { 0, 1, 2, 3, 5, 9, 1, 0 };
+#define testHOLD_OFFS		( sizeof( xHoldOffs ) / sizeof( xHoldOffs[ 0 ] ) )
+
+static void prvControlCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+}
+
+static void prvSlowCallback( TimerHandle_t xTimer )
+{
+uint32_t ulStart = ulPortHostMicroseconds();
+
+	( void ) xTimer;
+
+	while( ( ulPortHostMicroseconds() - ulStart ) < testSLOW_RUN_TIME )
+	{
+	}
+}
+
+static void prvWriteLine( const char *pcLine )
+{
+	fprintf( pxLog, "%s\n", pcLine );
+}
+
+/* Runs tools/timer_stats.py on the captured report and checks the order of
+the rows in its table, and the control timer's maximum lateness. */
+static void prvCheckReport( void )
+{
+FILE *pxReport;
+char cLine[ 256 ], cFirstRow[ 256 ] = "", cControlRow[ 256 ] = "";
+char cName[ 32 ], cP50[ 16 ], cP99[ 16 ];
+unsigned long ulCallbacks = 0, ulMaxLateness = 0;
+BaseType_t xInTable = pdFALSE;
+
+	pxReport = popen( "python3 ../../tools/timer_stats.py " testLOG_FILE, "r" );
+	TEST_CHECK( pxReport != NULL );
+
+	if( pxReport == NULL )
+	{
+		return;
+	}
+
+	while( fgets( cLine, sizeof( cLine ), pxReport ) != NULL )
+	{
+		fputs( cLine, stdout );
+
+		if( strncmp( cLine, "name ", 5 ) == 0 )
+		{
+			xInTable = pdTRUE;
+		}
+		else if( ( xInTable != pdFALSE ) && ( cFirstRow[ 0 ] == '\0' ) )
+		{
+			strcpy( cFirstRow, cLine );
+		}
+
+		if( strncmp( cLine, "control ", 8 ) == 0 )
+		{
+			strcpy( cControlRow, cLine );
+		}
+	}
+
+	TEST_CHECK( pclose( pxReport ) == 0 );
+	TEST_CHECK( strncmp( cFirstRow, "slow ", 5 ) == 0 );
+	TEST_CHECK( sscanf( cControlRow, "%31s %lu %15s %15s %lu", cName, &ulCallbacks, cP50, cP99, &ulMaxLateness ) == 5 );
+	TEST_CHECK( ulCallbacks == testEXPIRIES );
+	TEST_CHECK( ulMaxLateness == 9UL );
+}
+
+static void prvHoldOffTask( void *pvParameters )
+{
+TimerStats_t xStats;
+uint32_t ulExpected[ configTIMER_STATS_BUCKETS ] = { 0 };
+TimerHandle_t xTimers[ 2 ];
+TickType_t xWakeTime = xTaskGetTickCount(), xHoldOff;
+BaseType_t xCrossed = pdFALSE;
+UBaseType_t uxExpiry, uxBucket;
+
+	( void ) pvParameters;
+
+	TEST_CHECK( xTimerStart( xControlTimer, portMAX_DELAY ) == pdPASS );
+	TEST_CHECK( xTimerStart( xSlowTimer, portMAX_DELAY ) == pdPASS );
+
+	for( uxExpiry = 0; uxExpiry < testEXPIRIES; uxExpiry++ )
+	{
+		/* This task runs before the timer task at the tick the control timer
+		expires, and keeps it from running while the ticks pass. */
+		vTaskDelayUntil( &xWakeTime, testPERIOD );
+		xHoldOff = xHoldOffs[ uxExpiry % testHOLD_OFFS ];
+		vPortRunForTicks( xHoldOff );
+
+		/* The tick count overflowed while the timer task was held off. */
+		if( xTaskGetTickCount() < xWakeTime )
+		{
+			xCrossed = pdTRUE;
+		}
+
+		uxBucket = 0;
+		while( ( xHoldOff >> uxBucket ) != 0 )
+		{
+			uxBucket++;
+		}
+
+		ulExpected[ uxBucket ]++;
+	}
+
+	vTaskDelay( testPERIOD / 2 );
+
+	TEST_CHECK( xCrossed != pdFALSE );
+
+	vTimerGetStats( xControlTimer, &xStats );
+	TEST_CHECK( xStats.ulCallbacks == testEXPIRIES );
+	TEST_CHECK( xStats.ulMaxLateness == 9UL );
+	TEST_CHECK( memcmp( xStats.ulLateness, ulExpected, sizeof( ulExpected ) ) == 0 );
+
+	/* Every slow callback falls in the bucket for 256 to 511 us or above. */
+	vTimerGetStats( xSlowTimer, &xStats );
+	TEST_CHECK( xStats.ulCallbacks > 0UL );
+	TEST_CHECK( xStats.ulMaxRunTime >= testSLOW_RUN_TIME );
+	TEST_CHECK( xStats.ulTotalRunTime >= ( xStats.ulCallbacks * testSLOW_RUN_TIME ) );
+	for( uxBucket = 0; uxBucket < 9; uxBucket++ )
+	{
+		TEST_CHECK( xStats.ulRunTime[ uxBucket ] == 0UL );
+	}
+
+	xTimers[ 0 ] = xControlTimer;
+	xTimers[ 1 ] = xSlowTimer;
+	pxLog = fopen( testLOG_FILE, "w" );
+	TEST_CHECK( pxLog != NULL );
+	vTimerWriteStats( xTimers, 2, prvWriteLine );
+	( void ) fclose( pxLog );
+	prvCheckReport();
+
+	vTimerResetStats( xControlTimer );
+	vTimerGetStats( xControlTimer, &xStats );
+	TEST_CHECK( ( xStats.ulCallbacks == 0UL ) && ( xStats.ulMaxLateness == 0UL ) && ( xStats.ulLateness[ 0 ] == 0UL ) );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+	xControlTimer = xTimerCreate( "control", testPERIOD, pdTRUE, NULL, prvControlCallback );
+	xSlowTimer = xTimerCreate( "slow", 37, pdTRUE, NULL, prvSlowCallback );
+	TEST_CHECK( ( xControlTimer != NULL ) && ( xSlowTimer != NULL ) );
+
+	TEST_CHECK( xTaskCreate( prvHoldOffTask, "hold off", configMINIMAL_STACK_SIZE, NULL, configTIMER_TASK_PRIORITY + 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
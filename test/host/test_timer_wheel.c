@@ -0,0 +1,191 @@
+/*
+ * The active timers kept in a timing wheel behave exactly as when they are
+ * kept in the sorted lists.
+ *
+ * A task gives 300 timers, half of them auto-reload, 20000 random start, stop,
+ * reset, change of period and delay commands, while a model in this file
+ * works out which timers must expire at each tick.  After every command the
+ * active state and expiry time of the timer must match the model, and every
+ * callback must run at the tick the model expects.  The tick count starts
+ * close to its maximum, so the test also crosses a tick count overflow.
+ *
+ * Built with configUSE_TIMER_WHEEL set to 1 and to 0, so both ways of holding
+ * the active timers are checked against the same model.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "test_common.h"
+
+#define testTIMERS			300
+#define testCOMMANDS		20000
+#define testMAX_PERIOD		600
+#define testMAX_DELAY		40
+
+typedef struct ModelTimer
+{
+	BaseType_t xActive;
+	TickType_t xPeriod;
+	TickType_t xExpiry;
+} ModelTimer_t;
+
+static TimerHandle_t xTimers[ testTIMERS ];
+static ModelTimer_t xModel[ testTIMERS ];
+static unsigned long ulExpectedCallbacks, ulCallbacks, ulEarlyOrLate;
+static uint64_t ullRandom = 88172645463325252ULL;
+
+static uint32_t prvRandom( void )
+{
+	ullRandom ^= ullRandom << 13;
+	ullRandom ^= ullRandom >> 7;
+	ullRandom ^= ullRandom << 17;
+	return ( uint32_t ) ullRandom;
+}
+
+static void prvCallback( TimerHandle_t xTimer )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvTimerGetTimerID( xTimer );
+TickType_t xNow = xTaskGetTickCount();
+
+	ulCallbacks++;
+
+	/* The model has already moved an auto-reload timer's expiry on by a
+	period, and made a one-shot timer inactive. */
+	if( uxTimerGetReloadMode( xTimer ) != pdFALSE )
+	{
+		if( ( xModel[ uxIndex ].xExpiry - xModel[ uxIndex ].xPeriod ) != xNow )
+		{
+			ulEarlyOrLate++;
+		}
+	}
+	else if( ( xModel[ uxIndex ].xActive != pdFALSE ) || ( xModel[ uxIndex ].xExpiry != xNow ) )
+	{
+		ulEarlyOrLate++;
+	}
+}
+
+/* Moves the model on to xTick, which the kernel is about to reach. */
+static void prvModelTick( TickType_t xTick )
+{
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		if( ( xModel[ uxIndex ].xActive != pdFALSE ) && ( xModel[ uxIndex ].xExpiry == xTick ) )
+		{
+			ulExpectedCallbacks++;
+
+			if( uxTimerGetReloadMode( xTimers[ uxIndex ] ) != pdFALSE )
+			{
+				xModel[ uxIndex ].xExpiry += xModel[ uxIndex ].xPeriod;
+			}
+			else
+			{
+				xModel[ uxIndex ].xActive = pdFALSE;
+			}
+		}
+	}
+}
+
+/* Lets xTicks ticks pass, one at a time so the model is moved on before each
+timer callback runs. */
+static void prvDelay( TickType_t xTicks )
+{
+TickType_t x;
+
+	for( x = 0; x < xTicks; x++ )
+	{
+		prvModelTick( xTaskGetTickCount() + 1 );
+		vTaskDelay( 1 );
+	}
+}
+
+static void prvStart( UBaseType_t uxIndex )
+{
+	xModel[ uxIndex ].xActive = pdTRUE;
+	xModel[ uxIndex ].xExpiry = xTaskGetTickCount() + xModel[ uxIndex ].xPeriod;
+}
+
+static void prvControlTask( void *pvParameters )
+{
+UBaseType_t uxIndex, uxCommand, uxMismatches = 0;
+TickType_t xStart = xTaskGetTickCount(), xPeriod;
+
+	( void ) pvParameters;
+
+	for( uxCommand = 0; uxCommand < testCOMMANDS; uxCommand++ )
+	{
+		uxIndex = prvRandom() % testTIMERS;
+
+		switch( prvRandom() % 5 )
+		{
+			case 0:
+				TEST_CHECK( xTimerStart( xTimers[ uxIndex ], portMAX_DELAY ) == pdPASS );
+				prvStart( uxIndex );
+				break;
+
+			case 1:
+				TEST_CHECK( xTimerStop( xTimers[ uxIndex ], portMAX_DELAY ) == pdPASS );
+				xModel[ uxIndex ].xActive = pdFALSE;
+				break;
+
+			case 2:
+				TEST_CHECK( xTimerReset( xTimers[ uxIndex ], portMAX_DELAY ) == pdPASS );
+				prvStart( uxIndex );
+				break;
+
+			case 3:
+				xPeriod = 1 + ( prvRandom() % testMAX_PERIOD );
+				TEST_CHECK( xTimerChangePeriod( xTimers[ uxIndex ], xPeriod, portMAX_DELAY ) == pdPASS );
+				xModel[ uxIndex ].xPeriod = xPeriod;
+				prvStart( uxIndex );
+				break;
+
+			default:
+				prvDelay( prvRandom() % testMAX_DELAY );
+				break;
+		}
+
+		/* The timer task has a higher priority, so has processed the command
+		already. */
+		if( ( xTimerIsTimerActive( xTimers[ uxIndex ] ) != pdFALSE ) != ( xModel[ uxIndex ].xActive != pdFALSE ) )
+		{
+			uxMismatches++;
+		}
+		else if( ( xModel[ uxIndex ].xActive != pdFALSE ) && ( xTimerGetExpiryTime( xTimers[ uxIndex ] ) != xModel[ uxIndex ].xExpiry ) )
+		{
+			uxMismatches++;
+		}
+	}
+
+	/* Let every timer still running expire at least once. */
+	prvDelay( testMAX_PERIOD + 1 );
+
+	printf( "timer wheel %d: %lu ticks from %lu, %lu callbacks\n", configUSE_TIMER_WHEEL,
+			( unsigned long ) ( xTaskGetTickCount() - xStart ), ( unsigned long ) xStart, ulCallbacks );
+	TEST_CHECK( xTaskGetTickCount() < xStart );
+	TEST_CHECK( uxMismatches == 0 );
+	TEST_CHECK( ulEarlyOrLate == 0 );
+	TEST_CHECK( ulCallbacks == ulExpectedCallbacks );
+
+	vTaskEndScheduler();
+}
+
+int main( void )
+{
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		xModel[ uxIndex ].xPeriod = 1 + ( prvRandom() % testMAX_PERIOD );
+		xTimers[ uxIndex ] = xTimerCreate( "timer", xModel[ uxIndex ].xPeriod, ( uxIndex & 1 ) != 0 ? pdTRUE : pdFALSE, ( void * ) ( uintptr_t ) uxIndex, prvCallback );
+		TEST_CHECK( xTimers[ uxIndex ] != NULL );
+	}
+
+	TEST_CHECK( xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vTaskStartScheduler();
+
+	return TEST_RESULT();
+}
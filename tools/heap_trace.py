@@ -0,0 +1,271 @@
+#!/usr/bin/env python3
+"""Report on a FreeRTOS heap trace.
+
+Reads the "HT" lines written by vHeapTraceWriteRecords() and
+vHeapTraceWriteSnapshot() (see heap_trace.h) from a captured log and prints:
+
+  * the call sites that allocate the most memory, and the memory they still hold
+  * the memory held by each task
+  * the oldest allocations that have not been freed
+  * a map of each heap snapshot, showing how fragmentation changes over time
+
+Other lines in the log are ignored, so a serial console capture or the stdout
+of a POSIX port build can be used directly.  Call sites are shown as addresses
+unless --elf is given, in which case they are resolved with addr2line.
+
+    python3 tools/heap_trace.py uart.log
+    python3 tools/heap_trace.py --elf .pio/build/disco_f429zi/firmware.elf uart.log
+    ./posix_demo | python3 tools/heap_trace.py -
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+from collections import defaultdict
+
+LINE_RE = re.compile(r"\bHT ([MFLSRBE])\b(.*)")
+
+
+class Allocation:
+    def __init__(self, time, address, size, caller, task):
+        self.time = time
+        self.address = address
+        self.size = size
+        self.caller = caller
+        self.task = task
+
+
+class CallSite:
+    def __init__(self):
+        self.allocations = 0
+        self.bytes = 0
+        self.failures = 0
+        self.live_blocks = 0
+        self.live_bytes = 0
+        self.peak_live_bytes = 0
+
+
+class Snapshot:
+    def __init__(self, time, free_bytes, free_block_count):
+        self.time = time
+        self.free_bytes = free_bytes
+        self.free_block_count = free_block_count
+        self.regions = []
+        self.free_blocks = []
+
+    @property
+    def largest_free_block(self):
+        return max((size for _, size in self.free_blocks), default=0)
+
+    @property
+    def truncated(self):
+        return len(self.free_blocks) < self.free_block_count
+
+
+class Trace:
+    def __init__(self):
+        self.live = {}
+        self.call_sites = defaultdict(CallSite)
+        self.task_bytes = defaultdict(int)
+        self.snapshots = []
+        self.records = 0
+        self.lost = 0
+        self.unmatched_frees = 0
+        self._snapshot = None
+
+    def parse(self, stream):
+        for line in stream:
+            match = LINE_RE.search(line)
+            if match is None:
+                continue
+            fields = match.group(2).split()
+            try:
+                getattr(self, "_" + match.group(1))(fields)
+            except (ValueError, IndexError):
+                print("warning: ignoring malformed line: " + line.rstrip(),
+                      file=sys.stderr)
+
+    def _M(self, fields):
+        time, size = int(fields[0]), int(fields[2])
+        address, caller, task = (int(f, 16) for f in (fields[1], fields[3], fields[4]))
+        self.records += 1
+        site = self.call_sites[caller]
+        if address == 0:
+            site.failures += 1
+            return
+        site.allocations += 1
+        site.bytes += size
+        site.live_blocks += 1
+        site.live_bytes += size
+        site.peak_live_bytes = max(site.peak_live_bytes, site.live_bytes)
+        self.task_bytes[task] += size
+        self.live[address] = Allocation(time, address, size, caller, task)
+
+    def _F(self, fields):
+        address = int(fields[1], 16)
+        self.records += 1
+        allocation = self.live.pop(address, None)
+        if allocation is None:
+            # Allocated before the trace started, or the record was lost.
+            self.unmatched_frees += 1
+            return
+        site = self.call_sites[allocation.caller]
+        site.live_blocks -= 1
+        site.live_bytes -= allocation.size
+        self.task_bytes[allocation.task] -= allocation.size
+
+    def _L(self, fields):
+        self.lost += int(fields[0])
+
+    def _S(self, fields):
+        self._snapshot = Snapshot(int(fields[0]), int(fields[1]), int(fields[2]))
+
+    def _R(self, fields):
+        if self._snapshot is not None:
+            self._snapshot.regions.append((int(fields[0], 16), int(fields[1])))
+
+    def _B(self, fields):
+        if self._snapshot is not None:
+            self._snapshot.free_blocks.append((int(fields[0], 16), int(fields[1])))
+
+    def _E(self, fields):
+        if self._snapshot is not None:
+            self.snapshots.append(self._snapshot)
+            self._snapshot = None
+
+
+class Symbols:
+    """Resolves call site addresses with addr2line, if an ELF file is given."""
+
+    def __init__(self, elf, addr2line):
+        self.elf = elf
+        self.addr2line = addr2line
+        self.names = {}
+
+    def resolve(self, addresses):
+        if self.elf is None:
+            return
+        # The trace holds return addresses, so look up the byte before to find
+        # the call instruction.  Clearing bit 0 removes the Thumb bit.
+        wanted = [a for a in addresses if a not in self.names and a != 0]
+        if not wanted:
+            return
+        query = ["%x" % ((a & ~1) - 1) for a in wanted]
+        try:
+            output = subprocess.run([self.addr2line, "-f", "-C", "-s", "-e", self.elf] + query,
+                                    check=True, capture_output=True, text=True).stdout
+        except (OSError, subprocess.CalledProcessError) as error:
+            print("warning: addr2line failed: %s" % error, file=sys.stderr)
+            self.elf = None
+            return
+        lines = output.splitlines()
+        for i, address in enumerate(wanted):
+            function, location = lines[2 * i], lines[2 * i + 1]
+            self.names[address] = "%s (%s)" % (function, location)
+
+    def name(self, address):
+        if address == 0:
+            return "?"
+        return self.names.get(address, "0x%x" % address)
+
+
+def fragmentation(snapshot):
+    if snapshot.free_bytes == 0:
+        return 0.0
+    return 1.0 - snapshot.largest_free_block / snapshot.free_bytes
+
+
+def render_region(region, free_blocks, width):
+    """One character per region_size / width bytes: '#' used, '.' free, and
+    '+' or ':' for a cell that is less than or more than half free."""
+    start, size = region
+    cell = max(1, -(-size // width))
+    free = [0] * width
+    for block_start, block_size in free_blocks:
+        block_end = block_start + block_size
+        if block_end <= start or block_start >= start + size:
+            continue
+        position = max(block_start, start)
+        while position < min(block_end, start + size):
+            index = (position - start) // cell
+            cell_end = start + (index + 1) * cell
+            step = min(cell_end, block_end) - position
+            free[index] += step
+            position += step
+    chars = []
+    for amount in free:
+        if amount >= cell:
+            chars.append(".")
+        elif amount == 0:
+            chars.append("#")
+        elif amount * 2 >= cell:
+            chars.append(":")
+        else:
+            chars.append("+")
+    return "".join(chars)
+
+
+def report(trace, symbols, top, width, out):
+    symbols.resolve(list(trace.call_sites) + [a.caller for a in trace.live.values()])
+
+    live_bytes = sum(a.size for a in trace.live.values())
+    print("%d records, %d lost, %d frees of blocks allocated before the trace started" %
+          (trace.records, trace.lost, trace.unmatched_frees), file=out)
+    print("%d blocks (%d bytes) still allocated" % (len(trace.live), live_bytes), file=out)
+
+    sites = sorted(trace.call_sites.items(), key=lambda item: (item[1].live_bytes, item[1].bytes),
+                   reverse=True)
+    print("\nTop allocators by bytes still held:", file=out)
+    print("%10s %10s %8s %10s %8s  %s" % ("held", "peak", "blocks", "allocated", "failed", "call site"),
+          file=out)
+    for caller, site in sites[:top]:
+        print("%10d %10d %8d %10d %8d  %s" % (site.live_bytes, site.peak_live_bytes, site.live_blocks,
+                                              site.bytes, site.failures, symbols.name(caller)), file=out)
+
+    print("\nBytes held by task:", file=out)
+    for task, held in sorted(trace.task_bytes.items(), key=lambda item: item[1], reverse=True)[:top]:
+        print("%10d  %s" % (held, "before scheduler" if task == 0 else "task 0x%x" % task), file=out)
+
+    print("\nOldest blocks still allocated:", file=out)
+    for allocation in sorted(trace.live.values(), key=lambda a: a.time)[:top]:
+        print("%10d  0x%x %d bytes from %s" % (allocation.time, allocation.address, allocation.size,
+                                                symbols.name(allocation.caller)), file=out)
+
+    print("\nFragmentation map ('#' used, '.' free, '+' mostly used, ':' mostly free):", file=out)
+    print("%10s %10s %10s %6s %5s" % ("time", "free", "largest", "blocks", "frag"), file=out)
+    for snapshot in trace.snapshots:
+        print("%10d %10d %10d %6d %4.0f%%%s" % (snapshot.time, snapshot.free_bytes,
+                                               snapshot.largest_free_block, snapshot.free_block_count,
+                                               100.0 * fragmentation(snapshot),
+                                               "  (free block list truncated)" if snapshot.truncated else ""),
+              file=out)
+        for region in snapshot.regions:
+            print("    0x%08x |%s|" % (region[0], render_region(region, snapshot.free_blocks, width)),
+                  file=out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="+", help="captured trace, or - for stdin")
+    parser.add_argument("--elf", help="firmware image used to resolve call sites")
+    parser.add_argument("--addr2line", default="arm-none-eabi-addr2line",
+                        help="addr2line to use with --elf (default: %(default)s)")
+    parser.add_argument("--top", type=int, default=10, help="rows in each table (default: %(default)s)")
+    parser.add_argument("--width", type=int, default=64,
+                        help="characters per region in the map (default: %(default)s)")
+    args = parser.parse_args()
+
+    trace = Trace()
+    for name in args.log:
+        if name == "-":
+            trace.parse(sys.stdin)
+        else:
+            with open(name, errors="replace") as stream:
+                trace.parse(stream)
+
+    report(trace, Symbols(args.elf, args.addr2line), args.top, args.width, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""Report on FreeRTOS queue, semaphore and mutex statistics.
+
+Reads the "QS" reports written by vQueueWriteStats() (see queue.h) from a
+captured log and prints a table of the objects in the queue registry, ranked by
+the time tasks spent waiting on them, so the queue or lock that is holding the
+system up is at the top.  Objects that have been full, or that have caused
+priority inheritance, are flagged.
+
+If the log holds more than one report the counts are the difference between the
+first and the last, so an interval can be measured without resetting the
+statistics on the target.  Other lines in the log are ignored.
+
+    python3 tools/queue_stats.py uart.log
+    python3 tools/queue_stats.py --last uart.log
+"""
+
+import argparse
+import re
+import sys
+
+LINE_RE = re.compile(r"\bQS ([SQE])\b(.*)")
+
+TYPE_NAMES = {0: "queue", 1: "mutex", 2: "counting", 3: "binary", 4: "recursive"}
+
+# The counters in a "QS Q" line, after the handle, type, length, items waiting
+# and high water mark.
+COUNTERS = ("sends", "receives", "sends_failed", "receives_failed", "send_blocks",
+            "receive_blocks", "total_wait", "max_wait", "inheritances")
+
+
+class Entry:
+    def __init__(self, fields):
+        self.handle = int(fields[0], 16)
+        self.type = int(fields[1])
+        self.length = int(fields[2])
+        self.waiting = int(fields[3])
+        self.max_waiting = int(fields[4])
+        values = [int(f) for f in fields[5:5 + len(COUNTERS)]]
+        if len(values) != len(COUNTERS):
+            raise ValueError("too few fields")
+        for name, value in zip(COUNTERS, values):
+            setattr(self, name, value)
+        # The name is last, and may contain spaces.
+        self.name = " ".join(fields[5 + len(COUNTERS):]) or "?"
+
+    @property
+    def key(self):
+        return (self.handle, self.name)
+
+    def minus(self, earlier):
+        """The counts since an earlier report of the same object.  The max
+        values are not differences, so are left as the latest."""
+        for name in COUNTERS:
+            if name != "max_wait":
+                # Counters are 32 bits on the target and can wrap.
+                setattr(self, name, (getattr(self, name) - getattr(earlier, name)) & 0xFFFFFFFF)
+        return self
+
+    @property
+    def flags(self):
+        flags = []
+        if self.type == 0 and self.length > 0 and self.max_waiting >= self.length:
+            flags.append("full")
+        if self.inheritances > 0:
+            flags.append("inherit")
+        if self.sends_failed + self.receives_failed > 0:
+            flags.append("failed")
+        return ",".join(flags)
+
+
+class Report:
+    def __init__(self, time):
+        self.time = time
+        self.entries = {}
+
+
+class Log:
+    def __init__(self):
+        self.reports = []
+        self._report = None
+
+    def parse(self, stream):
+        for line in stream:
+            match = LINE_RE.search(line)
+            if match is None:
+                continue
+            fields = match.group(2).split()
+            try:
+                getattr(self, "_" + match.group(1))(fields)
+            except (ValueError, IndexError):
+                print("warning: ignoring malformed line: " + line.rstrip(), file=sys.stderr)
+
+    def _S(self, fields):
+        self._report = Report(int(fields[0]))
+
+    def _Q(self, fields):
+        if self._report is not None:
+            entry = Entry(fields)
+            self._report.entries[entry.key] = entry
+
+    def _E(self, fields):
+        if self._report is not None:
+            self.reports.append(self._report)
+            self._report = None
+
+
+def report(log, last_only, top, out):
+    if not log.reports:
+        print("no complete QS reports found", file=out)
+        return
+
+    last = log.reports[-1]
+    entries = list(last.entries.values())
+    if len(log.reports) > 1 and not last_only:
+        first = log.reports[0]
+        entries = [e.minus(first.entries[e.key]) if e.key in first.entries else e for e in entries]
+        print("%d reports, counts are for the %d time units from %d to %d" %
+              (len(log.reports), (last.time - first.time) & 0xFFFFFFFF, first.time, last.time), file=out)
+    else:
+        print("report at %d, counts since the statistics were last reset" % last.time, file=out)
+
+    entries.sort(key=lambda e: (e.total_wait, e.send_blocks + e.receive_blocks), reverse=True)
+    print("\n%-16s %-9s %9s %9s %9s %7s %7s %7s %7s %10s %8s %5s  %s" %
+          ("name", "type", "used", "sends", "receives", "s-fail", "r-fail", "s-block", "r-block",
+           "wait", "max-wait", "inh", "flags"), file=out)
+    for e in entries[:top]:
+        print("%-16s %-9s %4d/%-4d %9d %9d %7d %7d %7d %7d %10d %8d %5d  %s" %
+              (e.name[:16], TYPE_NAMES.get(e.type, str(e.type)), e.max_waiting, e.length, e.sends,
+               e.receives, e.sends_failed, e.receives_failed, e.send_blocks, e.receive_blocks,
+               e.total_wait, e.max_wait, e.inheritances, e.flags), file=out)
+    print("\nused is the high water mark of items held (or of the count of a semaphore), out of the length.",
+          file=out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="+", help="captured output, or - for stdin")
+    parser.add_argument("--last", action="store_true",
+                        help="show the last report as it is, rather than the change since the first")
+    parser.add_argument("--top", type=int, default=20, help="rows in the table (default: %(default)s)")
+    args = parser.parse_args()
+
+    log = Log()
+    for name in args.log:
+        if name == "-":
+            log.parse(sys.stdin)
+        else:
+            with open(name, errors="replace") as stream:
+                log.parse(stream)
+
+    report(log, args.last, args.top, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+"""Report on FreeRTOS software timer callback lateness and run time.
+
+Reads the "TS" reports written by vTimerWriteStats() (see timers.h) from a
+captured log and prints a table of the timers, ranked by the total time their
+callbacks took, so the callbacks that hold up the timer service task are at
+the top.  Lateness is in ticks, run times are in the units of
+configTIMER_STATS_TIMESTAMP().
+
+Histogram bucket 0 counts values of 0 and bucket n values from 2^(n-1) to
+2^n - 1, so the percentiles shown are the upper bound of the bucket they fall
+in.  The last bucket also counts every larger value, so is shown as ">=".
+
+If the log holds more than one report the counts are the difference between the
+first and the last.  Other lines in the log are ignored.
+
+    python3 tools/timer_stats.py uart.log
+    python3 tools/timer_stats.py --last uart.log
+"""
+
+import argparse
+import re
+import sys
+
+LINE_RE = re.compile(r"\bTS ([STLRE])\b(.*)")
+
+# The counters in a "TS T" line, after the handle.
+COUNTERS = ("callbacks", "max_late", "max_run", "total_run")
+
+
+class Timer:
+    def __init__(self, fields):
+        self.handle = int(fields[0], 16)
+        values = [int(f) for f in fields[1:1 + len(COUNTERS)]]
+        if len(values) != len(COUNTERS):
+            raise ValueError("too few fields")
+        for name, value in zip(COUNTERS, values):
+            setattr(self, name, value)
+        # The name is last, and may contain spaces.
+        self.name = " ".join(fields[1 + len(COUNTERS):]) or "?"
+        self.late = []
+        self.run = []
+
+    def minus(self, earlier):
+        """The counts since an earlier report of the same timer.  The max
+        values are not differences, so are left as the latest."""
+        mask = 0xFFFFFFFF
+        self.callbacks = (self.callbacks - earlier.callbacks) & mask
+        self.total_run = (self.total_run - earlier.total_run) & mask
+        if len(self.late) == len(earlier.late):
+            self.late = [(a - b) & mask for a, b in zip(self.late, earlier.late)]
+        if len(self.run) == len(earlier.run):
+            self.run = [(a - b) & mask for a, b in zip(self.run, earlier.run)]
+        return self
+
+
+def percentile(buckets, fraction):
+    """The upper bound of the bucket holding the given fraction of the
+    counts, as text."""
+    total = sum(buckets)
+    if total == 0:
+        return "-"
+    seen = 0
+    for n, count in enumerate(buckets):
+        seen += count
+        if seen >= fraction * total:
+            if n == len(buckets) - 1:
+                return ">=%d" % (1 << (n - 1))
+            return "%d" % ((1 << n) - 1)
+    return "-"
+
+
+class Report:
+    def __init__(self, time):
+        self.time = time
+        self.timers = {}
+
+
+class Log:
+    def __init__(self):
+        self.reports = []
+        self._report = None
+
+    def parse(self, stream):
+        for line in stream:
+            match = LINE_RE.search(line)
+            if match is None:
+                continue
+            fields = match.group(2).split()
+            try:
+                getattr(self, "_" + match.group(1))(fields)
+            except (ValueError, IndexError, KeyError):
+                print("warning: ignoring malformed line: " + line.rstrip(), file=sys.stderr)
+
+    def _S(self, fields):
+        self._report = Report(int(fields[0]))
+
+    def _T(self, fields):
+        if self._report is not None:
+            timer = Timer(fields)
+            self._report.timers[timer.handle] = timer
+
+    def _L(self, fields):
+        if self._report is not None:
+            self._report.timers[int(fields[0], 16)].late = [int(f) for f in fields[1:]]
+
+    def _R(self, fields):
+        if self._report is not None:
+            self._report.timers[int(fields[0], 16)].run = [int(f) for f in fields[1:]]
+
+    def _E(self, fields):
+        if self._report is not None:
+            self.reports.append(self._report)
+            self._report = None
+
+
+def report(log, last_only, out):
+    if not log.reports:
+        print("no complete TS reports found", file=out)
+        return
+
+    last = log.reports[-1]
+    timers = list(last.timers.values())
+    if len(log.reports) > 1 and not last_only:
+        first = log.reports[0]
+        timers = [t.minus(first.timers[t.handle]) if t.handle in first.timers else t for t in timers]
+        print("%d reports, counts are for the %d time units from %d to %d" %
+              (len(log.reports), (last.time - first.time) & 0xFFFFFFFF, first.time, last.time), file=out)
+    else:
+        print("report at %d, counts since the statistics were last reset" % last.time, file=out)
+
+    timers.sort(key=lambda t: t.total_run, reverse=True)
+    print("\n%-16s %9s %8s %8s %8s %8s %8s %8s %8s %10s" %
+          ("name", "callbacks", "late-p50", "late-p99", "late-max", "run-p50", "run-p99", "run-max",
+           "run-mean", "run-total"), file=out)
+    for t in timers:
+        mean = "%d" % (t.total_run // t.callbacks) if t.callbacks else "-"
+        print("%-16s %9d %8s %8s %8d %8s %8s %8d %8s %10d" %
+              (t.name[:16], t.callbacks, percentile(t.late, 0.5), percentile(t.late, 0.99), t.max_late,
+               percentile(t.run, 0.5), percentile(t.run, 0.99), t.max_run, mean, t.total_run), file=out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="+", help="captured output, or - for stdin")
+    parser.add_argument("--last", action="store_true",
+                        help="show the last report as it is, rather than the change since the first")
+    args = parser.parse_args()
+
+    log = Log()
+    for name in args.log:
+        if name == "-":
+            log.parse(sys.stdin)
+        else:
+            with open(name, errors="replace") as stream:
+                log.parse(stream)
+
+    report(log, args.last, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()